@@ -98,6 +98,7 @@ GF_Err set_file_udta(GF_ISOFile *dest, u32 tracknum, u32 udta_type, char *src, B
 
 extern u32 swf_flags;
 extern Float swf_flatten_angle;
+extern u32 scene_enc_window;
 extern Bool keep_sys_tracks;
 extern u32 fs_dump_flags;
 
@@ -2262,12 +2263,42 @@ GF_Err EncodeFile(char *in, GF_ISOFile *mp4, GF_SMEncodeOptions *opts, FILE *log
 	/*since we're encoding we must get MPEG4 nodes only*/
 	load.flags = GF_SM_LOAD_MPEG4_STRICT;
 	
+	if (scene_enc_window) {
+		if (opts->auto_quant) {
+			fprintf(stderr, "Automatic quantization needs the complete scene, ignoring encoding window\n");
+		} else {
+			load.au_window = scene_enc_window;
+		}
+	}
+
 	e = gf_sm_load_init(&load);
 	if (e<0) {
 		gf_sm_load_done(&load);
 		fprintf(stderr, "Cannot load context %s - %s\n", in, gf_error_to_string(e));
 		goto err_exit;
 	}
+	/*load and encode by chunks*/
+	if (load.au_window) {
+		gf_log_cbk prev_logs = NULL;
+		if (logs) {
+			gf_log_set_tool_level(GF_LOG_CODING, GF_LOG_DEBUG);
+			prev_logs = gf_log_set_callback(logs, scene_coding_log);
+		}
+		opts->src_url = in;
+		e = gf_sm_encode_to_file_streaming(&load, mp4, opts);
+		if (logs) {
+			gf_log_set_tool_level(GF_LOG_CODING, GF_LOG_ERROR);
+			gf_log_set_callback(NULL, prev_logs);
+		}
+		gf_sm_load_done(&load);
+		if (e<0) {
+			fprintf(stderr, "Error encoding file %s\n", gf_error_to_string(e));
+			goto err_exit;
+		}
+		gf_isom_set_brand_info(mp4, GF_ISOM_BRAND_MP42, 1);
+		gf_isom_modify_alternate_brand(mp4, GF_ISOM_BRAND_ISOM, GF_TRUE);
+		goto err_exit;
+	}
 	e = gf_sm_load_run(&load);
 	gf_sm_load_done(&load);
 
@@ -67,6 +67,7 @@ Bool keep_sys_tracks = GF_FALSE;
 /*some global vars for swf import :(*/
 u32 swf_flags = 0;
 Float swf_flatten_angle = 0;
+u32 scene_enc_window = 0;
 s32 laser_resolution = 0;
 static FILE *helpout = NULL;
 static u32 help_flags = 0;
@@ -592,6 +593,7 @@ GF_GPACArg m4b_senc_args[] =
  	GF_DEF_ARG("coord-bits", NULL, "number of bits used for encoding truncated coordinates (0 to 31, default 12) (LASeR encoding)", NULL, NULL, GF_ARG_INT, 0),
  	GF_DEF_ARG("scale-bits", NULL, "extra bits used for encoding truncated scales (0 to 4, default 0) (LASeR encoding)", NULL, NULL, GF_ARG_INT, 0),
  	GF_DEF_ARG("auto-quant", NULL, "resolution is given as if using -resolution but coord-bits and scale-bits are infered (LASeR encoding)", NULL, NULL, GF_ARG_INT, 0),
+ 	GF_DEF_ARG("enc-window", NULL, "load and encode BT/XMT input by chunks of given number of access units (see below)", NULL, NULL, GF_ARG_INT, 0),
  	{0}
 };
 
@@ -611,6 +613,10 @@ void PrintEncodeUsage()
 		"The generated AUs are raw BIFS (not SL-packetized), in files called FILE-ESID-AUIDX.bifs, with FILE the basename of the input file.\n"
 		"Commands with a timing of 0 in the input will modify the carousel version only (i.e. output context).\n"
 		"Commands with a timing different from 0 in the input will generate new AUs.\n"
+		"## Bounded Memory Encoding\n"
+		"By default the complete scene is loaded before being encoded. For long command streams (tickers, subtitles, ...), the [-enc-window]() option loads the input by chunks of the given number of access units, encoding and discarding each chunk before loading the next one.\n"
+		"In this mode, access units must be declared in increasing time order, BIFS node and route ID ranges not set in the BIFS config are coded on 16 bits, and automatic quantization is not available.\n"
+		"The proto ID range is only coded on 16 bits (BIFSv2Config) if the first chunk declares protos or the BIFS config is already version 2, otherwise protos declared in later chunks require setting protoIDbits in the BIFS config.\n"
 		"  \n"
 		"Options:\n"
 	);
@@ -3256,6 +3262,11 @@ u32 mp4box_parse_args_continue(int argc, char **argv, u32 *current_index)
 			smenc_opts.scale_bits = atoi(argv[i + 1]);
 			i++;
 		}
+		else if (!stricmp(arg, "-enc-window")) {
+			CHECK_NEXT_ARG
+			scene_enc_window = atoi(argv[i + 1]);
+			i++;
+		}
 		else if (!stricmp(arg, "-global-quant")) {
 			CHECK_NEXT_ARG
 			smenc_opts.resolution = atoi(argv[i + 1]);
@@ -27,6 +27,7 @@ void PrintUsage()
 	        "-dir PATH:			local filesystem path to which the files are written. If not set, memory mode is used.\n"
 	        "                    NOTE: memory mode is not yet implemented ...\n"
 	        "-service ID:		ID of the service to play. If not set, all services are dumped. If 0, no services are dumped\n"
+	        "-stats N:			prints reception rate every N seconds and at exit, use with atscreplay to measure throughput on a recorded capture\n"
 	        "\n"
 	        "\n on OSX with VM packet replay you will need to force mcast routing, eg:\n"
 	        "route add -net 239.255.1.4/32 -interface vboxnet0\n"
@@ -55,9 +56,28 @@ static void on_atscd_log(void *cbk, GF_LOG_Level ll, GF_LOG_Tool lm, const char
 	fflush(logs);
 }
 
+static void print_stats(GF_ATSCDmx *atscd)
+{
+	Double rate=0, pck_rate=0;
+	u64 st = gf_atsc3_dmx_get_first_packet_time(atscd);
+	u64 et = gf_atsc3_dmx_get_last_packet_time(atscd);
+	u64 nb_pck = gf_atsc3_dmx_get_nb_packets(atscd);
+	u64 nb_bytes = gf_atsc3_dmx_get_recv_bytes(atscd);
+
+	et -= st;
+	if (et) {
+		rate = (Double)nb_bytes*8;
+		rate /= et;
+		pck_rate = (Double)nb_pck*1000000;
+		pck_rate /= et;
+	}
+	fprintf(stderr, LLU" bytes "LLU" packets in "LLU" ms - rate %.02f mbps %.02f packets/s\n", nb_bytes, nb_pck, et/1000, rate, pck_rate);
+}
+
 int main(int argc, char **argv)
 {
 	u32 i, serviceID=0xFFFFFFFF;
+	u32 stats=0, last_stats=0;
 	Bool run = GF_TRUE;
 	GF_MemTrackerType mem_track = GF_MemTrackerNone;
 	const char *ifce = NULL;
@@ -83,9 +103,9 @@ int main(int argc, char **argv)
 	/*   gpac init   */
 	/*****************/
 #ifdef GPAC_MEMORY_TRACKING
-	gf_sys_init(mem_track);
+	gf_sys_init(mem_track, NULL);
 #else
-	gf_sys_init(GF_MemTrackerNone);
+	gf_sys_init(GF_MemTrackerNone, NULL);
 #endif
 	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
 	gf_log_set_tool_level(GF_LOG_CONTAINER, GF_LOG_INFO);
@@ -97,11 +117,12 @@ int main(int argc, char **argv)
 		if (!strcmp(arg, "-ifce")) ifce=argv[++i];
 		else if (!strcmp(arg, "-dir")) dir=argv[++i];
 		else if (!strcmp(arg, "-service")) serviceID=atoi(argv[++i]);
+		else if (!strcmp(arg, "-stats")) stats=1000*atoi(argv[++i]);
 		else if (!strcmp(arg, "-log-file") || !strcmp(arg, "-lf")) {
 			logfile = gf_fopen(argv[i+1], "wt");
 			i++;
 		} else if (!strcmp(arg, "-logs") ) {
-			if (gf_log_set_tools_levels(argv[i+1]) != GF_OK) {
+			if (gf_log_set_tools_levels(argv[i+1], GF_FALSE) != GF_OK) {
 				return 1;
 			}
 			i++;
@@ -125,6 +146,11 @@ int main(int argc, char **argv)
 		if (e == GF_IP_NETWORK_EMPTY)
 			gf_sleep(1);
 
+		if (stats && (gf_sys_clock() - last_stats >= stats)) {
+			last_stats = gf_sys_clock();
+			print_stats(atscd);
+		}
+
 		if (gf_prompt_has_input()) {
 			u8 c = gf_prompt_get_char();
 			switch (c) {
@@ -134,6 +160,7 @@ int main(int argc, char **argv)
 			}
 		}
 	}
+	if (atscd && stats) print_stats(atscd);
 	gf_atsc3_dmx_del(atscd);
 
 	if (logfile) gf_fclose(logfile);
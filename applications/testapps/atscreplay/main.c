@@ -0,0 +1,362 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - UDP capture replay for ATSC/ROUTE reception benchmarks
+ *
+ */
+
+#include <gpac/network.h>
+#include <gpac/list.h>
+
+#define PCAP_MAX_SNAPLEN	0x40000
+
+typedef struct
+{
+	u32 ip;
+	u16 port;
+	GF_Socket *sk;
+} ReplayDest;
+
+typedef struct
+{
+	FILE *f;
+	Bool swap, nano;
+	u32 link_type;
+} PCapFile;
+
+static u32 nb_loops = 1;
+static Double speed = 1.0;
+static u32 ttl = 1;
+static u32 stats = 0;
+static char *ifce = NULL;
+static char *dst_ip = NULL;
+static u16 dst_port = 0;
+static GF_List *dests = NULL;
+
+static u64 nb_sent = 0, nb_bytes = 0, nb_skipped = 0, nb_send_errors = 0;
+
+static u32 pcap_u32(PCapFile *pcap, u8 *data)
+{
+	if (pcap->swap) return GF_4CC(data[3], data[2], data[1], data[0]);
+	return GF_4CC(data[0], data[1], data[2], data[3]);
+}
+
+static GF_Err pcap_open(PCapFile *pcap, const char *src)
+{
+	u8 hdr[24];
+	u32 magic;
+	memset(pcap, 0, sizeof(PCapFile));
+	pcap->f = gf_fopen(src, "rb");
+	if (!pcap->f) return GF_URL_ERROR;
+	if (gf_fread(hdr, 24, pcap->f) != 24) return GF_NON_COMPLIANT_BITSTREAM;
+
+	magic = GF_4CC(hdr[0], hdr[1], hdr[2], hdr[3]);
+	switch (magic) {
+	case 0xA1B2C3D4:
+		break;
+	case 0xD4C3B2A1:
+		pcap->swap = GF_TRUE;
+		break;
+	case 0xA1B23C4D:
+		pcap->nano = GF_TRUE;
+		break;
+	case 0x4D3CB2A1:
+		pcap->nano = pcap->swap = GF_TRUE;
+		break;
+	default:
+		fprintf(stderr, "Unsupported capture file %s, only pcap files are supported (not pcapng)\n", src);
+		return GF_NOT_SUPPORTED;
+	}
+	pcap->link_type = pcap_u32(pcap, hdr+20) & 0x0FFFFFFF;
+	switch (pcap->link_type) {
+	//ethernet, raw IP, linux cooked v1 and v2
+	case 1:
+	case 12:
+	case 101:
+	case 113:
+	case 276:
+		break;
+	default:
+		fprintf(stderr, "Unsupported capture link type %u\n", pcap->link_type);
+		return GF_NOT_SUPPORTED;
+	}
+	return GF_OK;
+}
+
+//reads next captured frame, returns its size or 0 at end of file
+static u32 pcap_read(PCapFile *pcap, u8 *data, u64 *ts_us)
+{
+	u8 hdr[16];
+	u32 size;
+	if (gf_fread(hdr, 16, pcap->f) != 16) return 0;
+	*ts_us = pcap_u32(pcap, hdr);
+	*ts_us *= 1000000;
+	*ts_us += pcap->nano ? pcap_u32(pcap, hdr+4) / 1000 : pcap_u32(pcap, hdr+4);
+	size = pcap_u32(pcap, hdr+8);
+	if (!size || (size > PCAP_MAX_SNAPLEN)) return 0;
+	if (gf_fread(data, size, pcap->f) != size) return 0;
+	return size;
+}
+
+//locates the UDP payload in a captured frame, returns NULL if not an IPv4 UDP packet
+static u8 *pcap_get_udp(PCapFile *pcap, u8 *data, u32 size, u32 *ip, u16 *port, u32 *payload_size)
+{
+	u32 offset = 0, ether_type = 0x0800, ip_hdr_size, ip_size, udp_size;
+
+	switch (pcap->link_type) {
+	case 1:
+		if (size < 14) return NULL;
+		ether_type = (data[12]<<8) | data[13];
+		offset = 14;
+		//VLAN tags
+		while (((ether_type == 0x8100) || (ether_type == 0x88A8)) && (offset + 4 <= size)) {
+			ether_type = (data[offset+2]<<8) | data[offset+3];
+			offset += 4;
+		}
+		break;
+	case 113:
+		if (size < 16) return NULL;
+		ether_type = (data[14]<<8) | data[15];
+		offset = 16;
+		break;
+	case 276:
+		if (size < 20) return NULL;
+		ether_type = (data[0]<<8) | data[1];
+		offset = 20;
+		break;
+	default:
+		break;
+	}
+	if (ether_type != 0x0800) return NULL;
+	if (offset + 20 > size) return NULL;
+	if ((data[offset]>>4) != 4) return NULL;
+	//UDP
+	if (data[offset+9] != 17) return NULL;
+	//fragmented
+	if (((data[offset+6] & 0x1F) | data[offset+7]) || (data[offset+6] & 0x20)) return NULL;
+
+	ip_hdr_size = 4 * (data[offset] & 0xF);
+	ip_size = (data[offset+2]<<8) | data[offset+3];
+	if ((ip_size < ip_hdr_size + 8) || (offset + ip_size > size)) return NULL;
+	*ip = GF_4CC(data[offset+16], data[offset+17], data[offset+18], data[offset+19]);
+	offset += ip_hdr_size;
+
+	*port = (data[offset+2]<<8) | data[offset+3];
+	udp_size = (data[offset+4]<<8) | data[offset+5];
+	if ((udp_size < 8) || (udp_size > ip_size - ip_hdr_size)) return NULL;
+	*payload_size = udp_size - 8;
+	return data + offset + 8;
+}
+
+static GF_Socket *replay_get_socket(u32 ip, u16 port)
+{
+	GF_Err e;
+	char szIP[20];
+	u32 i, count = gf_list_count(dests);
+	ReplayDest *rd;
+	for (i=0; i<count; i++) {
+		rd = gf_list_get(dests, i);
+		if ((rd->ip == ip) && (rd->port == port)) return rd->sk;
+	}
+	GF_SAFEALLOC(rd, ReplayDest);
+	if (!rd) return NULL;
+	rd->ip = ip;
+	rd->port = port;
+	gf_list_add(dests, rd);
+
+	if (dst_ip) strncpy(szIP, dst_ip, 19);
+	else sprintf(szIP, "%u.%u.%u.%u", (ip>>24) & 0xFF, (ip>>16) & 0xFF, (ip>>8) & 0xFF, ip & 0xFF);
+	szIP[19] = 0;
+	rd->sk = gf_sk_new(GF_SOCK_TYPE_UDP);
+	if (!rd->sk) return NULL;
+	if (gf_sk_is_multicast_address(szIP)) {
+		e = gf_sk_setup_multicast(rd->sk, szIP, port, ttl, GF_TRUE, ifce);
+	} else {
+		e = gf_sk_bind(rd->sk, ifce ? ifce : "0.0.0.0", 0, szIP, port, 0);
+	}
+	if (e) {
+		fprintf(stderr, "Failed to setup socket for %s:%u: %s\n", szIP, port, gf_error_to_string(e));
+		gf_sk_del(rd->sk);
+		rd->sk = NULL;
+		return NULL;
+	}
+	fprintf(stderr, "Replaying to %s:%u\n", szIP, port);
+	return rd->sk;
+}
+
+static void print_stats(u64 start)
+{
+	Double rate=0, pck_rate=0;
+	u64 et = gf_sys_clock_high_res() - start;
+	if (et) {
+		rate = (Double)nb_bytes*8;
+		rate /= et;
+		pck_rate = (Double)nb_sent*1000000;
+		pck_rate /= et;
+	}
+	fprintf(stderr, LLU" bytes "LLU" packets in "LLU" ms - rate %.02f mbps %.02f packets/s\n", nb_bytes, nb_sent, et/1000, rate, pck_rate);
+}
+
+static GF_Err replay_file(const char *src, u8 *data, u64 *last_stats, u64 start)
+{
+	GF_Err e;
+	PCapFile pcap;
+	u64 ts, first_ts=0, play_start=0;
+	Bool first = GF_TRUE;
+
+	e = pcap_open(&pcap, src);
+	if (e) {
+		if (pcap.f) gf_fclose(pcap.f);
+		return e;
+	}
+	while (1) {
+		u32 ip, payload_size;
+		u16 port;
+		u8 *payload;
+		GF_Socket *sk;
+		u32 size = pcap_read(&pcap, data, &ts);
+		if (!size) break;
+
+		payload = pcap_get_udp(&pcap, data, size, &ip, &port, &payload_size);
+		if (!payload || !payload_size) {
+			nb_skipped++;
+			continue;
+		}
+		if (dst_ip) {
+			ip = 0;
+			port = dst_port;
+		}
+
+		//pace packets against capture time
+		if (first) {
+			first_ts = ts;
+			play_start = gf_sys_clock_high_res();
+			first = GF_FALSE;
+		} else if ((speed > 0) && (ts > first_ts)) {
+			u64 target = play_start + (u64) ((ts - first_ts) / speed);
+			while (1) {
+				u64 now = gf_sys_clock_high_res();
+				if (now >= target) break;
+				if (target - now > 2000) gf_sleep((u32) ((target - now) / 1000) - 1);
+			}
+		}
+
+		sk = replay_get_socket(ip, port);
+		if (!sk) {
+			nb_skipped++;
+			continue;
+		}
+		if (gf_sk_send(sk, payload, payload_size) != GF_OK) {
+			nb_send_errors++;
+			continue;
+		}
+		nb_sent++;
+		nb_bytes += payload_size;
+
+		if (stats && (gf_sys_clock_high_res() - *last_stats >= stats)) {
+			*last_stats = gf_sys_clock_high_res();
+			print_stats(start);
+		}
+	}
+	gf_fclose(pcap.f);
+	return GF_OK;
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: atscreplay [OPTS]\n"
+	        "Replays the UDP datagrams of a capture file to their original destination addresses, typically to feed atscdmx or in_atsc.\n"
+	        "Use atscdmx -stats on the receiving side to measure reception throughput for a given replay rate.\n"
+	        "Only pcap files (not pcapng) with ethernet, raw IP or linux cooked link types are supported; non UDP/IPv4 and fragmented packets are skipped.\n"
+	        "\n"
+	        "-i src:            capture file to replay\n"
+	        "-speed S:          replay speed relative to capture timestamps, 0 sends as fast as possible (default 1)\n"
+	        "-loop N:           number of times the capture is replayed (default 1)\n"
+	        "-dst IP:PORT:      sends all datagrams to the given address instead of the captured destinations\n"
+	        "-ifce IP:          IP adress of network interface to use\n"
+	        "-ttl N:            multicast TTL (default 1)\n"
+	        "-stats N:          prints send rate every N seconds and at exit\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i;
+	u64 start, last_stats;
+	GF_Err e = GF_OK;
+	char *src = NULL;
+	char *logs = NULL;
+	u8 *data;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-speed")) speed = atof(val);
+		else if (!strcmp(arg, "-loop")) nb_loops = atoi(val);
+		else if (!strcmp(arg, "-ifce")) ifce = val;
+		else if (!strcmp(arg, "-ttl")) ttl = atoi(val);
+		else if (!strcmp(arg, "-stats")) stats = 1000000*atoi(val);
+		else if (!strcmp(arg, "-dst")) {
+			char *sep = strrchr(val, ':');
+			if (!sep) {
+				PrintUsage();
+				return 1;
+			}
+			sep[0] = 0;
+			dst_ip = val;
+			dst_port = atoi(sep+1);
+		}
+		else if (!strcmp(arg, "-logs")) logs = val;
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!src || !nb_loops || (speed<0)) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	if (logs) gf_log_set_tools_levels(logs, GF_FALSE);
+
+	dests = gf_list_new();
+	data = gf_malloc(PCAP_MAX_SNAPLEN);
+	start = last_stats = gf_sys_clock_high_res();
+	for (i=0; i<nb_loops; i++) {
+		e = replay_file(src, data, &last_stats, start);
+		if (e) {
+			fprintf(stderr, "Failed to replay %s: %s\n", src, gf_error_to_string(e));
+			break;
+		}
+	}
+	print_stats(start);
+	if (nb_skipped || nb_send_errors)
+		fprintf(stderr, LLU" captured packets skipped - "LLU" send errors\n", nb_skipped, nb_send_errors);
+
+	while (gf_list_count(dests)) {
+		ReplayDest *rd = gf_list_pop_back(dests);
+		if (rd->sk) gf_sk_del(rd->sk);
+		gf_free(rd);
+	}
+	gf_list_del(dests);
+	gf_free(data);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
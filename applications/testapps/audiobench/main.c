@@ -0,0 +1,270 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - audio mixer format conversion and channel mapping benchmark
+ *
+ */
+
+#include <gpac/constants.h>
+#include <gpac/internal/compositor_dev.h>
+
+static u32 nb_frames = 1024;
+static u32 duration = 10;
+static u32 nb_runs = 3;
+static u32 sample_rate = 48000;
+
+typedef struct
+{
+	GF_AudioInterface ai;
+	u8 *data;
+	u32 size, bytes_consumed;
+} BenchSource;
+
+typedef struct
+{
+	const char *name;
+	u32 nb_ch;
+	u64 layout;
+} BenchLayout;
+
+#define LAYOUT_STEREO	(GF_AUDIO_CH_FRONT_LEFT|GF_AUDIO_CH_FRONT_RIGHT)
+#define LAYOUT_51	(LAYOUT_STEREO|GF_AUDIO_CH_FRONT_CENTER|GF_AUDIO_CH_LFE|GF_AUDIO_CH_SURROUND_LEFT|GF_AUDIO_CH_SURROUND_RIGHT)
+
+static const BenchLayout layouts[] =
+{
+	{"mono", 1, GF_AUDIO_CH_FRONT_CENTER},
+	{"stereo", 2, LAYOUT_STEREO},
+	{"5.1", 6, LAYOUT_51},
+};
+
+static const u32 formats[] =
+{
+	GF_AUDIO_FMT_U8, GF_AUDIO_FMT_S16, GF_AUDIO_FMT_S24, GF_AUDIO_FMT_S32, GF_AUDIO_FMT_FLT, GF_AUDIO_FMT_DBL,
+	GF_AUDIO_FMT_U8P, GF_AUDIO_FMT_S16P, GF_AUDIO_FMT_S24P, GF_AUDIO_FMT_S32P, GF_AUDIO_FMT_FLTP, GF_AUDIO_FMT_DBLP
+};
+
+static u8 *bench_fetch_frame(void *callback, u32 *size, u32 *planar_stride, u32 audio_delay_ms)
+{
+	u32 offset;
+	BenchSource *src = (BenchSource *) callback;
+	*size = src->size - src->bytes_consumed;
+	offset = src->bytes_consumed;
+	if (gf_audio_fmt_is_planar(src->ai.afmt)) {
+		*planar_stride = src->size / src->ai.chan;
+		offset /= src->ai.chan;
+	}
+	return src->data + offset;
+}
+static void bench_release_frame(void *callback, u32 nb_bytes)
+{
+	BenchSource *src = (BenchSource *) callback;
+	src->bytes_consumed += nb_bytes;
+	//loop on the same frame
+	if (src->bytes_consumed >= src->size) src->bytes_consumed = 0;
+}
+static Bool bench_get_config(struct _audiointerface *ai, Bool for_reconf)
+{
+	return GF_TRUE;
+}
+static Bool bench_is_muted(void *callback)
+{
+	return GF_FALSE;
+}
+static Fixed bench_get_speed(void *callback)
+{
+	return FIX_ONE;
+}
+static Bool bench_get_channel_volume(void *callback, Fixed *vol)
+{
+	u32 i;
+	for (i=0; i<GF_AUDIO_MIXER_MAX_CHANNELS; i++) vol[i] = FIX_ONE;
+	return GF_FALSE;
+}
+
+static void write_sample(u8 *ptr, u32 afmt, Double v)
+{
+	s32 s;
+	switch (afmt) {
+	case GF_AUDIO_FMT_U8:
+	case GF_AUDIO_FMT_U8P:
+		*ptr = (u8) (128 + (s32) (v * 127));
+		break;
+	case GF_AUDIO_FMT_S16:
+	case GF_AUDIO_FMT_S16P:
+		s = (s32) (v * 32767);
+		ptr[0] = s & 0xFF;
+		ptr[1] = (s>>8) & 0xFF;
+		break;
+	case GF_AUDIO_FMT_S24:
+	case GF_AUDIO_FMT_S24P:
+		s = (s32) (v * 8388607);
+		ptr[0] = s & 0xFF;
+		ptr[1] = (s>>8) & 0xFF;
+		ptr[2] = (s>>16) & 0xFF;
+		break;
+	case GF_AUDIO_FMT_S32:
+	case GF_AUDIO_FMT_S32P:
+		s = (s32) (v * 2147483647);
+		memcpy(ptr, &s, 4);
+		break;
+	case GF_AUDIO_FMT_FLT:
+	case GF_AUDIO_FMT_FLTP:
+	{
+		Float f = (Float) v;
+		memcpy(ptr, &f, 4);
+	}
+		break;
+	case GF_AUDIO_FMT_DBL:
+	case GF_AUDIO_FMT_DBLP:
+		memcpy(ptr, &v, 8);
+		break;
+	}
+}
+
+static void init_source(BenchSource *src, u32 afmt, const BenchLayout *layout)
+{
+	u32 i, j, bps;
+	Bool planar = gf_audio_fmt_is_planar(afmt);
+
+	memset(src, 0, sizeof(BenchSource));
+	src->ai.callback = src;
+	src->ai.FetchFrame = bench_fetch_frame;
+	src->ai.ReleaseFrame = bench_release_frame;
+	src->ai.GetConfig = bench_get_config;
+	src->ai.IsMuted = bench_is_muted;
+	src->ai.GetSpeed = bench_get_speed;
+	src->ai.GetChannelVolume = bench_get_channel_volume;
+	src->ai.samplerate = sample_rate;
+	src->ai.afmt = afmt;
+	src->ai.chan = layout->nb_ch;
+	src->ai.ch_layout = layout->layout;
+
+	bps = gf_audio_fmt_bit_depth(afmt) / 8;
+	src->size = nb_frames * layout->nb_ch * bps;
+	src->data = gf_malloc(src->size);
+	for (i=0; i<nb_frames; i++) {
+		for (j=0; j<layout->nb_ch; j++) {
+			//one tone per channel, stays within ]-1, 1[
+			Double v = 0.9 * sin(2 * 3.14159265358979 * (440 + 110*j) * i / sample_rate);
+			u32 pos = planar ? (j*nb_frames + i) : (i*layout->nb_ch + j);
+			write_sample(src->data + pos*bps, afmt, v);
+		}
+	}
+}
+
+static void run_test(u32 in_fmt, const BenchLayout *in_layout, u32 out_fmt, const BenchLayout *out_layout)
+{
+	u32 i, run, nb_calls, out_size, crc=0;
+	u64 best=0;
+	u8 *output;
+	BenchSource src;
+	GF_AudioMixer *mixer;
+	char szName[100];
+
+	init_source(&src, in_fmt, in_layout);
+	out_size = nb_frames * out_layout->nb_ch * gf_audio_fmt_bit_depth(out_fmt) / 8;
+	output = gf_malloc(out_size);
+	nb_calls = duration * sample_rate / nb_frames;
+	if (!nb_calls) nb_calls = 1;
+
+	for (run=0; run<nb_runs; run++) {
+		u64 start, now;
+		mixer = gf_mixer_new(NULL);
+		gf_mixer_add_input(mixer, &src.ai);
+		gf_mixer_set_config(mixer, sample_rate, out_layout->nb_ch, out_fmt, out_layout->layout);
+		src.bytes_consumed = 0;
+
+		start = gf_sys_clock_high_res();
+		for (i=0; i<nb_calls; i++) {
+			u32 written = gf_mixer_get_output(mixer, output, out_size, 0);
+			if (!run) crc += gf_crc_32(output, written);
+		}
+		now = gf_sys_clock_high_res() - start;
+		if (!best || (now < best)) best = now;
+		gf_mixer_del(mixer);
+	}
+
+	sprintf(szName, "%s %s -> %s %s", gf_audio_fmt_name(in_fmt), in_layout->name, gf_audio_fmt_name(out_fmt), out_layout->name);
+	fprintf(stdout, "%-36s %9.2f ms %8.1f x realtime CRC %08X\n", szName, ((Double) best) / 1000,
+		(best ? ((Double) duration) * 1000000 / best : 0), crc);
+
+	gf_free(output);
+	gf_free(src.data);
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: audiobench [OPTS]\n"
+	        "Measures audio mixer throughput for sample format conversions and channel layout mapping at a fixed sample rate.\n"
+	        "Each test feeds a synthetic tone to a mixer and reports the best run time and a checksum of the first run output.\n"
+	        "\n"
+	        "-fmt NAME:         only test given input format\n"
+	        "-ofmt NAME:        only test given output format\n"
+	        "-dur N:            duration of audio to process in seconds (default 10)\n"
+	        "-frames N:         number of audio frames per input packet and output buffer (default 1024)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 3)\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, j, k;
+	u32 only_in = 0, only_out = 0;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-fmt")) only_in = gf_audio_fmt_parse(val);
+		else if (!strcmp(arg, "-ofmt")) only_out = gf_audio_fmt_parse(val);
+		else if (!strcmp(arg, "-dur")) duration = atoi(val);
+		else if (!strcmp(arg, "-frames")) nb_frames = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_frames || !duration || !nb_runs) {
+		fprintf(stderr, "Invalid parameters\n");
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	fprintf(stdout, "Format conversions, stereo\n");
+	for (i=0; i<GF_ARRAY_LENGTH(formats); i++) {
+		if (only_in && (formats[i] != only_in)) continue;
+		for (j=0; j<GF_ARRAY_LENGTH(formats); j++) {
+			if (only_out && (formats[j] != only_out)) continue;
+			run_test(formats[i], &layouts[1], formats[j], &layouts[1]);
+		}
+	}
+
+	fprintf(stdout, "\nChannel mapping\n");
+	for (i=0; i<GF_ARRAY_LENGTH(formats); i++) {
+		if (only_in && (formats[i] != only_in)) continue;
+		for (j=0; j<GF_ARRAY_LENGTH(layouts); j++) {
+			for (k=0; k<GF_ARRAY_LENGTH(layouts); k++) {
+				if (j==k) continue;
+				run_test(formats[i], &layouts[j], only_out ? only_out : GF_AUDIO_FMT_S16, &layouts[k]);
+			}
+		}
+	}
+
+	gf_sys_close();
+	return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - HTTP cache index benchmark
+ *
+ */
+
+#include <gpac/cache.h>
+
+static u32 nb_entries = 20000;
+static u32 entry_size = 4096;
+static u32 nb_lookups = 1000000;
+static u32 nb_updates = 10000;
+
+#define CACHE_DIR	"cachebench_cache"
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: cachebench [OPTS]\n"
+	        "Measures the cost of the HTTP cache index used to bound the on-disk cache size.\n"
+	        "A cache directory is filled with data and info files as written by the downloader, one data file out of ten\n"
+	        "using the info file extension. The directory scan done before indexing for each completed download is compared\n"
+	        "with building the index once, looking up entries, updating entries after download and evicting half of the cache.\n"
+	        "\n"
+	        "-entries N:        number of cache entries (default 20000)\n"
+	        "-size N:           size of each data file in bytes (default 4096)\n"
+	        "-lookups N:        number of entry lookups (default 1000000)\n"
+	        "-updates N:        number of entry updates (default 10000)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+static void get_entry_name(u32 idx, char *name)
+{
+	//data files use the URL extension, or .dat if none
+	sprintf(name, "gpac_cache_%08X%032X%s", gf_crc_32((u8 *) &idx, 4), idx, (idx%10) ? ".m4s" : ".txt");
+}
+
+static GF_Err populate(u8 *data)
+{
+	u32 i;
+	char szName[100], szPath[GF_MAX_PATH];
+	for (i=0; i<nb_entries; i++) {
+		FILE *f;
+		get_entry_name(i, szName);
+		sprintf(szPath, "%s/%s", CACHE_DIR, szName);
+		f = gf_fopen(szPath, "wb");
+		if (!f) return GF_IO_ERR;
+		gf_fwrite(data, entry_size, f);
+		gf_fclose(f);
+		strcat(szPath, ".txt");
+		f = gf_fopen(szPath, "wt");
+		if (!f) return GF_IO_ERR;
+		fprintf(f, "[cache]\nurl=http://localhost/live/segment_%u.m4s\nContent-Length=%u\nContent-Type=video/iso.segment\n", i, entry_size);
+		gf_fclose(f);
+	}
+	return GF_OK;
+}
+
+static Bool count_files(void *cbck, char *item_name, char *item_path, GF_FileEnumInfo *file_info)
+{
+	(*(u32 *)cbck)++;
+	return GF_FALSE;
+}
+
+static void print_time(const char *name, u64 us, u32 nb_ops, const char *unit)
+{
+	fprintf(stdout, "%-24s %10.3f ms", name, ((Double) us) / 1000);
+	if (nb_ops) fprintf(stdout, " %12.0f %s/s %9.3f us/%s", ((Double) nb_ops) * 1000000 / (us ? us : 1), unit, ((Double) us) / nb_ops, unit);
+	fprintf(stdout, "\n");
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i, nb_found, nb_files, count;
+	u64 now, size, disk_size;
+	u8 *data;
+	char szName[100], szDir[GF_MAX_PATH];
+	GF_CacheIndex *index;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-entries")) nb_entries = atoi(val);
+		else if (!strcmp(arg, "-size")) entry_size = atoi(val);
+		else if (!strcmp(arg, "-lookups")) nb_lookups = atoi(val);
+		else if (!strcmp(arg, "-updates")) nb_updates = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_entries || !entry_size) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	gf_mkdir(CACHE_DIR);
+	sprintf(szDir, "%s%c", CACHE_DIR, GF_PATH_SEPARATOR);
+	data = gf_malloc(entry_size);
+	if (!data) {
+		gf_sys_close();
+		return 1;
+	}
+	memset(data, 0x5A, entry_size);
+	e = populate(data);
+	gf_free(data);
+	if (e) {
+		fprintf(stderr, "Failed to create cache files: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+	fprintf(stdout, "Cache of %u entries of %u bytes\n", nb_entries, entry_size);
+
+	//cost of the directory scan previously done for each completed download once above budget
+	now = gf_sys_clock_high_res();
+	disk_size = gf_cache_get_size(szDir);
+	print_time("directory scan", gf_sys_clock_high_res() - now, 0, NULL);
+
+	now = gf_sys_clock_high_res();
+	index = gf_cache_index_new(szDir);
+	print_time("index build", gf_sys_clock_high_res() - now, nb_entries, "entry");
+	if (!index) {
+		e = GF_OUT_OF_MEM;
+		goto exit;
+	}
+	if ((gf_cache_index_get_count(index) != nb_entries) || (gf_cache_index_get_size(index) != disk_size)) {
+		fprintf(stderr, "Index mismatch: %u entries "LLU" bytes, expecting %u entries "LLU" bytes\n", gf_cache_index_get_count(index), gf_cache_index_get_size(index), nb_entries, disk_size);
+		e = GF_CORRUPTED_DATA;
+	}
+
+	nb_found = 0;
+	now = gf_sys_clock_high_res();
+	for (i=0; i<nb_lookups; i++) {
+		get_entry_name(gf_rand() % nb_entries, szName);
+		if (gf_cache_index_touch(index, szName)) nb_found++;
+	}
+	print_time("lookup", gf_sys_clock_high_res() - now, nb_lookups, "lookup");
+	if (nb_found != nb_lookups) {
+		fprintf(stderr, "%u lookups failed\n", nb_lookups - nb_found);
+		e = GF_CORRUPTED_DATA;
+	}
+
+	//update after download, checking data and info files sizes on disk
+	now = gf_sys_clock_high_res();
+	for (i=0; i<nb_updates; i++) {
+		get_entry_name(gf_rand() % nb_entries, szName);
+		gf_cache_index_update(index, szName);
+	}
+	print_time("update", gf_sys_clock_high_res() - now, nb_updates, "update");
+
+	count = gf_cache_index_get_count(index);
+	now = gf_sys_clock_high_res();
+	size = gf_cache_index_evict(index, gf_cache_index_get_size(index) / 2);
+	count -= gf_cache_index_get_count(index);
+	print_time("evict half", gf_sys_clock_high_res() - now, count, "entry");
+
+	nb_files = 0;
+	gf_enum_directory(szDir, GF_FALSE, count_files, &nb_files, NULL);
+	disk_size = gf_cache_get_size(szDir);
+	if ((nb_files != 2*gf_cache_index_get_count(index)) || (size != disk_size)) {
+		fprintf(stderr, "Eviction mismatch: %u entries "LLU" bytes indexed, %u files "LLU" bytes on disk\n", gf_cache_index_get_count(index), size, nb_files, disk_size);
+		e = GF_CORRUPTED_DATA;
+	}
+	gf_cache_index_del(index);
+
+exit:
+	gf_cache_delete_all_cached_files(szDir);
+	gf_rmdir(CACHE_DIR);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
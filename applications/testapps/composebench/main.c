@@ -0,0 +1,214 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - headless 2D compositor frame rate benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+
+/*synthetic scene parameters*/
+static u32 width = 1920;
+static u32 height = 1080;
+static u32 nb_frames = 250;
+static u32 nb_shapes = 400;
+static u32 nb_moving = 40;
+static u32 nb_runs = 3;
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: composebench [OPTS]\n"
+	        "Measures frames/s of the compositor filter rendering a scene in software (no OpenGL) to raw frames.\n"
+	        "By default a synthetic SVG scene is generated: a grid of shapes over a static background, of which only a few\n"
+	        "are animated, so that each frame redraws several small non-overlapping dirty rectangles. The same scene is\n"
+	        "also rendered with all shapes animated to compare against a full redraw.\n"
+	        "\n"
+	        "-i scene:          BIFS/SVG/... scene to render instead of the synthetic scene\n"
+	        "-o file.svg:       write the synthetic scene and exit\n"
+	        "-size WxH:         output size (default 1920x1080)\n"
+	        "-frames N:         number of frames rendered (default 250)\n"
+	        "-shapes N:         number of shapes of synthetic scene (default 400)\n"
+	        "-moving N:         number of animated shapes of synthetic scene (default 40)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 3)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+static GF_Err generate_scene(const char *name, u32 moving)
+{
+	u32 i, cols, rows, cell_w, cell_h;
+	FILE *f = gf_fopen(name, "wt");
+	if (!f) return GF_IO_ERR;
+
+	cols = 1;
+	while (cols*cols*height < nb_shapes*width) cols++;
+	rows = (nb_shapes + cols - 1) / cols;
+	cell_w = width / cols;
+	cell_h = height / rows;
+	if (!cell_w || !cell_h) {
+		gf_fclose(f);
+		return GF_BAD_PARAM;
+	}
+
+	gf_fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%u\" height=\"%u\" viewBox=\"0 0 %u %u\">\n", width, height, width, height);
+	gf_fprintf(f, "<defs><linearGradient id=\"bg\" x1=\"0\" y1=\"0\" x2=\"1\" y2=\"1\"><stop offset=\"0\" stop-color=\"#203040\"/><stop offset=\"1\" stop-color=\"#608090\"/></linearGradient></defs>\n");
+	gf_fprintf(f, "<rect width=\"%u\" height=\"%u\" fill=\"url(#bg)\"/>\n", width, height);
+	for (i=0; i<nb_shapes; i++) {
+		u32 x = (i % cols) * cell_w + cell_w/2;
+		u32 y = (i / cols) * cell_h + cell_h/2;
+		u32 r = MIN(cell_w, cell_h) / 3;
+		u32 color = (i*0x3F1D7) & 0xFFFFFF;
+		//spread animated shapes over the grid
+		Bool animated = (moving && ((i * moving) % nb_shapes < moving)) ? GF_TRUE : GF_FALSE;
+
+		if (i%2) {
+			gf_fprintf(f, "<circle cx=\"%u\" cy=\"%u\" r=\"%u\" fill=\"#%06X\" stroke=\"black\" stroke-width=\"2\"", x, y, r, color);
+		} else {
+			gf_fprintf(f, "<rect x=\"%u\" y=\"%u\" width=\"%u\" height=\"%u\" fill=\"#%06X\" stroke=\"white\" stroke-width=\"2\"", x-r, y-r/2, 2*r, r, color);
+		}
+		if (animated) {
+			gf_fprintf(f, "><animateTransform attributeName=\"transform\" type=\"rotate\" from=\"0 %u %u\" to=\"360 %u %u\" dur=\"%us\" repeatCount=\"indefinite\"/></%s>\n", x, y, x, y, 2 + i%3, (i%2) ? "circle" : "rect");
+		} else {
+			gf_fprintf(f, "/>\n");
+		}
+	}
+	gf_fprintf(f, "</svg>\n");
+	gf_fclose(f);
+	return GF_OK;
+}
+
+/*runs scene -> compositor -> null inspect for nb_frames frames*/
+static GF_Err run_session(const char *src, u64 *duration)
+{
+	GF_Err e = GF_OK;
+	u64 start;
+	char szArgs[200];
+	GF_FilterSession *fs;
+
+	start = gf_sys_clock_high_res();
+	fs = gf_fs_new(0, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fs) return GF_OUT_OF_MEM;
+
+	gf_fs_load_source(fs, src, NULL, NULL, &e);
+	if (!e) {
+		sprintf(szArgs, "compositor:osize=%ux%u:dur=-%u:ogl=off", width, height, nb_frames);
+		gf_fs_load_filter(fs, szArgs, &e);
+	}
+	if (!e) gf_fs_load_filter(fs, "inspect:log=null", &e);
+	if (!e) e = gf_fs_run(fs);
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	*duration = gf_sys_clock_high_res() - start;
+	return e;
+}
+
+static GF_Err run_test(const char *name, const char *src)
+{
+	u32 i;
+	u64 best = 0;
+	Double sec;
+	for (i=0; i<nb_runs; i++) {
+		u64 dur;
+		GF_Err e = run_session(src, &dur);
+		if (e) {
+			fprintf(stderr, "%s failed: %s\n", name, gf_error_to_string(e));
+			return e;
+		}
+		if (!best || (dur<best)) best = dur;
+	}
+	sec = ((Double) best) / 1000000;
+	fprintf(stdout, "%-16s %9.2f ms %9.2f frames/s\n", name, sec*1000, nb_frames / sec);
+	return GF_OK;
+}
+
+static void on_progress(const void *cbk, const char *title, u64 done, u64 total)
+{
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i;
+	char *src = NULL;
+	char *dst = NULL;
+	char *logs = NULL;
+	char szSrc[GF_MAX_PATH], szName[50];
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) dst = val;
+		else if (!strcmp(arg, "-size")) sscanf(val, "%ux%u", &width, &height);
+		else if (!strcmp(arg, "-frames")) nb_frames = atoi(val);
+		else if (!strcmp(arg, "-shapes")) nb_shapes = atoi(val);
+		else if (!strcmp(arg, "-moving")) nb_moving = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) logs = val;
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!width || !height || !nb_frames || !nb_shapes || (nb_moving>nb_shapes) || !nb_runs) {
+		PrintUsage();
+		return 1;
+	}
+
+	e = gf_sys_init(GF_MemTrackerNone, NULL);
+	if (e) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	if (logs) gf_log_set_tools_levels(logs, GF_FALSE);
+	gf_set_progress_callback(NULL, on_progress);
+
+	if (dst) {
+		e = generate_scene(dst, nb_moving);
+		gf_sys_close();
+		return e ? 1 : 0;
+	}
+
+	fprintf(stdout, "Compositor %ux%u software rendering - %u frames - best of %u runs\n", width, height, nb_frames, nb_runs);
+	if (src) {
+		e = run_test("scene", src);
+		gf_sys_close();
+		return e ? 1 : 0;
+	}
+
+	sprintf(szSrc, "composebench_%ux%u.svg", width, height);
+	e = generate_scene(szSrc, nb_moving);
+	if (e) {
+		fprintf(stderr, "Failed to generate scene: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+	sprintf(szName, "%u/%u moving", nb_moving, nb_shapes);
+	e = run_test(szName, szSrc);
+	if (e || (nb_moving==nb_shapes)) goto exit;
+
+	e = generate_scene(szSrc, nb_shapes);
+	if (e) {
+		fprintf(stderr, "Failed to generate scene: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+	sprintf(szName, "%u/%u moving", nb_shapes, nb_shapes);
+	e = run_test(szName, szSrc);
+
+exit:
+	gf_file_delete(szSrc);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - font engine glyph lookup benchmark
+ *
+ */
+
+#include <gpac/internal/compositor_dev.h>
+
+static u32 nb_chars = 4000;
+static u32 first_char = 0x20;
+static u32 nb_layouts = 20;
+static u32 nb_runs = 3;
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: fontbench [OPTS]\n"
+	        "Measures text span creation in the font engine for a text made of many distinct characters, as found in CJK subtitles.\n"
+	        "The load test creates the span with a new font manager, loading every glyph from the font reader.\n"
+	        "The layout test then creates the same span several times, every glyph being already loaded.\n"
+	        "Characters not present in the font are counted as missing and are queried again for each span.\n"
+	        "\n"
+	        "-font name:        font to use (default SANS)\n"
+	        "-chars N:          number of distinct characters in the text (default 4000)\n"
+	        "-first N:          first character code, hexadecimal values use 0x prefix (default 0x20)\n"
+	        "-layouts N:        number of spans created in the layout test (default 20)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 3)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+//UTF-8 text of nb_chars consecutive characters starting at first_char, skipping surrogates
+static char *make_text()
+{
+	u32 i, c, len = 0;
+	char *text = gf_malloc(4*nb_chars + 1);
+	if (!text) return NULL;
+	for (i=0, c=first_char; i<nb_chars; i++, c++) {
+		if ((c>=0xD800) && (c<0xE000)) c = 0xE000;
+		if (c<0x80) {
+			text[len++] = (char) c;
+		} else if (c<0x800) {
+			text[len++] = (char) (0xC0 | (c>>6));
+			text[len++] = (char) (0x80 | (c & 0x3F));
+		} else if (c<0x10000) {
+			text[len++] = (char) (0xE0 | (c>>12));
+			text[len++] = (char) (0x80 | ((c>>6) & 0x3F));
+			text[len++] = (char) (0x80 | (c & 0x3F));
+		} else {
+			text[len++] = (char) (0xF0 | (c>>18));
+			text[len++] = (char) (0x80 | ((c>>12) & 0x3F));
+			text[len++] = (char) (0x80 | ((c>>6) & 0x3F));
+			text[len++] = (char) (0x80 | (c & 0x3F));
+		}
+	}
+	text[len] = 0;
+	return text;
+}
+
+static GF_Err run_test(char *font_name, char *text, u64 *load_time, u64 *layout_time, u32 *nb_glyphs, u32 *nb_missing)
+{
+	u32 i;
+	u64 start;
+	GF_Font *font;
+	GF_TextSpan *span;
+	GF_FontManager *fm = gf_font_manager_new();
+	if (!fm) return GF_OUT_OF_MEM;
+	//no font is set without font reader
+	font = gf_font_manager_set_font(fm, &font_name, 1, 0);
+	if (!font) {
+		gf_font_manager_del(fm);
+		return GF_NOT_FOUND;
+	}
+
+	start = gf_sys_clock_high_res();
+	span = gf_font_manager_create_span(fm, font, text, FIX_ONE, GF_FALSE, GF_FALSE, GF_FALSE, NULL, GF_FALSE, 0, NULL);
+	*load_time = gf_sys_clock_high_res() - start;
+	if (!span) {
+		gf_font_manager_del(fm);
+		return GF_IO_ERR;
+	}
+	*nb_glyphs = span->nb_glyphs;
+	*nb_missing = 0;
+	for (i=0; i<span->nb_glyphs; i++) {
+		if (!span->glyphs[i]) (*nb_missing)++;
+	}
+	gf_font_manager_delete_span(fm, span);
+
+	start = gf_sys_clock_high_res();
+	for (i=0; i<nb_layouts; i++) {
+		span = gf_font_manager_create_span(fm, font, text, FIX_ONE, GF_FALSE, GF_FALSE, GF_FALSE, NULL, GF_FALSE, 0, NULL);
+		if (span) gf_font_manager_delete_span(fm, span);
+	}
+	*layout_time = gf_sys_clock_high_res() - start;
+
+	gf_font_manager_del(fm);
+	return GF_OK;
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e = GF_OK;
+	u32 i, nb_glyphs=0, nb_missing=0;
+	u64 best_load=0, best_layout=0;
+	char *font_name = "SANS";
+	char *text;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-font")) font_name = val;
+		else if (!strcmp(arg, "-chars")) nb_chars = atoi(val);
+		else if (!strcmp(arg, "-first")) first_char = (u32) strtoul(val, NULL, 0);
+		else if (!strcmp(arg, "-layouts")) nb_layouts = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_chars || !first_char || !nb_layouts || !nb_runs) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	//missing glyphs are reported by the font reader
+	gf_log_set_tool_level(GF_LOG_PARSER, GF_LOG_ERROR);
+
+	text = make_text();
+	if (!text) {
+		gf_sys_close();
+		return 1;
+	}
+	for (i=0; i<nb_runs; i++) {
+		u64 load_time, layout_time;
+		e = run_test(font_name, text, &load_time, &layout_time, &nb_glyphs, &nb_missing);
+		if (e) {
+			fprintf(stderr, "Failed to create text span: %s\n", gf_error_to_string(e));
+			break;
+		}
+		if (!best_load || (load_time<best_load)) best_load = load_time;
+		if (!best_layout || (layout_time<best_layout)) best_layout = layout_time;
+	}
+	gf_free(text);
+
+	if (!e) {
+		fprintf(stdout, "Font %s: %u characters, %u missing - best of %u runs\n", font_name, nb_glyphs, nb_missing, nb_runs);
+		fprintf(stdout, "%-8s %9.3f ms %9.3f us/glyph\n", "load", ((Double) best_load) / 1000, ((Double) best_load) / nb_glyphs);
+		fprintf(stdout, "%-8s %9.3f ms %9.3f us/glyph\n", "layout", ((Double) best_layout) / 1000 / nb_layouts, ((Double) best_layout) / nb_layouts / nb_glyphs);
+	}
+	gf_sys_close();
+	return e ? 1 : 0;
+}
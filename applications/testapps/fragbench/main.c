@@ -0,0 +1,259 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - fragmented ISOBMFF box tree parse/free benchmark
+ *
+ */
+
+#include <gpac/isomedia.h>
+
+/*synthetic file parameters*/
+static u32 nb_frags = 200;
+static u32 nb_samples = 2000;
+static u32 sample_size = 16;
+static u32 gop_size = 50;
+static u32 nb_runs = 5;
+
+static u32 rand_state = 0x12345678;
+
+static u32 bench_rand()
+{
+	rand_state = rand_state * 1103515245 + 12345;
+	return rand_state >> 8;
+}
+
+static u64 get_file_size(const char *name)
+{
+	u64 size;
+	FILE *f = gf_fopen(name, "rb");
+	if (!f) return 0;
+	size = gf_fsize(f);
+	gf_fclose(f);
+	return size;
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: fragbench [OPTS]\n"
+	        "Measures parse and free rates of movie fragment box trees.\n"
+	        "A synthetic fragmented file is generated unless -i is set. Each fragment carries one track run with explicit\n"
+	        "sample durations, sizes, flags and composition offsets, and a RAP sample group.\n"
+	        "\n"
+	        "-i file.mp4:       use given fragmented file instead of a synthetic one\n"
+	        "-o file.mp4:       write the synthetic file and exit\n"
+	        "-frags N:          number of fragments of synthetic file (default 200)\n"
+	        "-samples N:        number of samples per fragment of synthetic file (default 2000)\n"
+	        "-ssize N:          sample size in bytes of synthetic file (default 16)\n"
+	        "-gop N:            RAP period in samples of synthetic file (default 50)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 5)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+static GF_Err generate_file(const char *name)
+{
+	GF_Err e;
+	u32 i, j, track, di, sn;
+	u64 dts;
+	GF_ISOSample samp;
+	GF_GenericSampleDescription udesc;
+	GF_ISOFile *file;
+
+	file = gf_isom_open(name, GF_ISOM_OPEN_WRITE, NULL);
+	if (!file) return gf_isom_last_error(NULL);
+
+	track = gf_isom_new_track(file, 1, GF_ISOM_MEDIA_VISUAL, 25000);
+	if (!track) {
+		e = gf_isom_last_error(file);
+		goto exit;
+	}
+	gf_isom_set_track_enabled(file, track, GF_TRUE);
+
+	memset(&udesc, 0, sizeof(GF_GenericSampleDescription));
+	udesc.codec_tag = GF_4CC('f','b','c','h');
+	udesc.width = 320;
+	udesc.height = 240;
+	e = gf_isom_new_generic_sample_description(file, track, NULL, NULL, &udesc, &di);
+	if (e) goto exit;
+
+	e = gf_isom_setup_track_fragment(file, 1, di, 1000, 0, 0, 0, 0, GF_FALSE);
+	if (e) goto exit;
+	e = gf_isom_finalize_for_fragment(file, 0, GF_TRUE);
+	if (e) goto exit;
+
+	memset(&samp, 0, sizeof(GF_ISOSample));
+	samp.data = gf_malloc(sample_size + 256);
+	if (!samp.data) {
+		e = GF_OUT_OF_MEM;
+		goto exit;
+	}
+	memset(samp.data, 0, sample_size + 256);
+
+	dts = 0;
+	for (i=0; i<nb_frags; i++) {
+		e = gf_isom_start_fragment(file, GF_ISOM_FRAG_MOOF_FIRST);
+		if (e) break;
+		e = gf_isom_set_traf_base_media_decode_time(file, 1, dts);
+		if (e) break;
+
+		for (j=0; j<nb_samples; j++) {
+			sn = i*nb_samples + j;
+			samp.DTS = dts;
+			samp.CTS_Offset = (sn % 3) * 1000;
+			samp.IsRAP = (sn % gop_size) ? RAP_NO : SAP_TYPE_1;
+			//vary sizes so that trun stores them
+			samp.dataLength = sample_size + (bench_rand() % 256);
+			e = gf_isom_fragment_add_sample(file, 1, &samp, di, 1000, 0, 0, GF_FALSE);
+			if (e) break;
+			if (samp.IsRAP) {
+				e = gf_isom_fragment_set_sample_rap_group(file, 1, j+1, GF_TRUE, 0);
+				if (e) break;
+			}
+			dts += 1000;
+		}
+		if (e) break;
+	}
+	gf_free(samp.data);
+
+exit:
+	if (e) {
+		gf_isom_delete(file);
+		return e;
+	}
+	return gf_isom_close(file);
+}
+
+static GF_Err run_test(const char *name, const char *src, GF_ISOOpenMode mode, u32 nb_moofs, u64 file_size)
+{
+	u32 i;
+	u64 parse_time=0, free_time=0;
+	Double sec;
+
+	for (i=0; i<nb_runs; i++) {
+		u64 start, parsed, done;
+		GF_ISOFile *file;
+
+		start = gf_sys_clock_high_res();
+		file = gf_isom_open(src, mode, NULL);
+		if (!file) return gf_isom_last_error(NULL);
+		parsed = gf_sys_clock_high_res();
+		gf_isom_close(file);
+		done = gf_sys_clock_high_res();
+
+		if (!parse_time || (parse_time + free_time > done - start)) {
+			parse_time = parsed - start;
+			free_time = done - parsed;
+		}
+	}
+	sec = ((Double) (parse_time + free_time)) / 1000000;
+	fprintf(stdout, "%-6s %9.2f ms (parse %9.2f ms free %9.2f ms) %10.2f fragments/s %8.2f MB/s\n", name,
+	        sec*1000, ((Double) parse_time) / 1000, ((Double) free_time) / 1000,
+	        nb_moofs / sec, ((Double) file_size) / sec / 1000000);
+	return GF_OK;
+}
+
+static void on_progress(const void *cbk, const char *title, u64 done, u64 total)
+{
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i, nb_moofs;
+	u64 file_size;
+	Bool gen_only = GF_FALSE;
+	char *src = NULL;
+	char *dst = NULL;
+	char szSrc[GF_MAX_PATH];
+	GF_ISOFile *file;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) {
+			dst = val;
+			gen_only = GF_TRUE;
+		}
+		else if (!strcmp(arg, "-frags")) nb_frags = atoi(val);
+		else if (!strcmp(arg, "-samples")) nb_samples = atoi(val);
+		else if (!strcmp(arg, "-ssize")) sample_size = atoi(val);
+		else if (!strcmp(arg, "-gop")) gop_size = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_frags || !nb_samples || !gop_size || !nb_runs) {
+		fprintf(stderr, "Invalid parameters\n");
+		return 1;
+	}
+
+	e = gf_sys_init(GF_MemTrackerNone, NULL);
+	if (e) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	gf_set_progress_callback(NULL, on_progress);
+
+	if (gen_only) {
+		e = generate_file(dst);
+		gf_sys_close();
+		return e ? 1 : 0;
+	}
+
+	szSrc[0] = 0;
+	if (!src) {
+		sprintf(szSrc, "fragbench_%u_%u.mp4", nb_frags, nb_samples);
+		e = generate_file(szSrc);
+		if (e) {
+			fprintf(stderr, "Failed to generate %s: %s\n", szSrc, gf_error_to_string(e));
+			goto exit;
+		}
+		src = szSrc;
+	}
+
+	file = gf_isom_open(src, GF_ISOM_OPEN_READ_DUMP, NULL);
+	if (!file) {
+		e = gf_isom_last_error(NULL);
+		fprintf(stderr, "Failed to open %s: %s\n", src, gf_error_to_string(e));
+		goto exit;
+	}
+	nb_moofs = gf_isom_get_fragments_count(file, GF_FALSE);
+	gf_isom_close(file);
+	if (!nb_moofs) {
+		fprintf(stderr, "File %s is not fragmented\n", src);
+		e = GF_BAD_PARAM;
+		goto exit;
+	}
+
+	file_size = get_file_size(src);
+	fprintf(stdout, "Source %s: %u fragments, "LLU" bytes - best of %u runs\n", src, nb_moofs, file_size, nb_runs);
+
+	//parse each fragment, merge it in sample tables and destroy it
+	e = run_test("read", src, GF_ISOM_OPEN_READ, nb_moofs, file_size);
+	if (e) goto exit;
+	//parse each fragment and destroy it
+	e = run_test("keep", src, GF_ISOM_OPEN_KEEP_FRAGMENTS, nb_moofs, file_size);
+	if (e) goto exit;
+	//parse all fragments, destroy them when closing
+	e = run_test("dump", src, GF_ISOM_OPEN_READ_DUMP, nb_moofs, file_size);
+
+exit:
+	if (szSrc[0]) gf_file_delete(szSrc);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
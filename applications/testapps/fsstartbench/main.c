@@ -0,0 +1,176 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - filter session startup and link resolution benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+
+static u32 nb_runs = 10;
+static s32 nb_threads = -1;
+
+typedef struct
+{
+	u64 best, total;
+	u32 nb;
+} BenchTime;
+
+static void bench_add(BenchTime *t, u64 us)
+{
+	if (!t->nb || (us < t->best)) t->best = us;
+	t->total += us;
+	t->nb++;
+}
+
+static void bench_print(const char *name, BenchTime *t)
+{
+	if (!t->nb) return;
+	fprintf(stdout, "%-28s best %8.3f ms - average %8.3f ms\n", name, ((Double) t->best) / 1000, ((Double) t->total) / t->nb / 1000);
+}
+
+static GF_FilterSession *bench_session_new()
+{
+	if (nb_threads<0) return gf_fs_new_defaults(0);
+	return gf_fs_new(nb_threads, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+}
+
+//session creation loads the filter registry, the registry graph is only built at the first link resolution
+static void run_session_create()
+{
+	u32 run;
+	BenchTime t_new, t_del;
+	memset(&t_new, 0, sizeof(BenchTime));
+	memset(&t_del, 0, sizeof(BenchTime));
+
+	for (run=0; run<nb_runs; run++) {
+		GF_FilterSession *fsess;
+		u64 now = gf_sys_clock_high_res();
+		fsess = bench_session_new();
+		bench_add(&t_new, gf_sys_clock_high_res() - now);
+		if (!fsess) {
+			fprintf(stderr, "Failed to create filter session\n");
+			return;
+		}
+		now = gf_sys_clock_high_res();
+		gf_fs_del(fsess);
+		bench_add(&t_del, gf_sys_clock_high_res() - now);
+	}
+	bench_print("session create", &t_new);
+	bench_print("session destroy", &t_del);
+}
+
+//full session run, dominated by registry graph build and link resolution for small inputs
+//when the destination cannot be connected (eg no muxer for the output format), the failing filters are destroyed
+//by setup failure tasks, which is used to check filter destruction against pending filter tasks on worker threads
+static void run_session_pipeline(const char *src, const char *dst)
+{
+	u32 run, nb_failed=0;
+	BenchTime t_load, t_run;
+	memset(&t_load, 0, sizeof(BenchTime));
+	memset(&t_run, 0, sizeof(BenchTime));
+
+	for (run=0; run<nb_runs; run++) {
+		GF_Err e = GF_OK;
+		GF_Filter *f;
+		u64 now;
+		GF_FilterSession *fsess = bench_session_new();
+		if (!fsess) {
+			fprintf(stderr, "Failed to create filter session\n");
+			return;
+		}
+		now = gf_sys_clock_high_res();
+		f = gf_fs_load_source(fsess, src, NULL, NULL, &e);
+		if (f) {
+			if (dst) f = gf_fs_load_destination(fsess, dst, NULL, NULL, &e);
+			else f = gf_fs_load_filter(fsess, "inspect:log=null", &e);
+		}
+		bench_add(&t_load, gf_sys_clock_high_res() - now);
+		if (!f) {
+			fprintf(stderr, "Failed to load pipeline: %s\n", gf_error_to_string(e));
+			gf_fs_del(fsess);
+			return;
+		}
+		now = gf_sys_clock_high_res();
+		e = gf_fs_run(fsess);
+		bench_add(&t_run, gf_sys_clock_high_res() - now);
+		if (gf_fs_get_last_connect_error(fsess)) {
+			nb_failed++;
+			e = GF_OK;
+		}
+		if (e<GF_OK) {
+			fprintf(stderr, "Session error: %s\n", gf_error_to_string(e));
+			gf_fs_del(fsess);
+			return;
+		}
+		gf_fs_del(fsess);
+	}
+	bench_print("pipeline load", &t_load);
+	bench_print("pipeline run", &t_run);
+	if (nb_failed)
+		fprintf(stdout, "%u runs with pipeline setup failure\n", nb_failed);
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: fsstartbench [OPTS]\n"
+	        "Measures filter session creation time and optionally the time needed to set up and run a source to destination pipeline.\n"
+	        "The filter registry graph is built at the first link resolution, so it is accounted in the pipeline run time.\n"
+	        "Use small inputs so that run time is dominated by filter graph resolution.\n"
+	        "Runs where the pipeline cannot be set up are counted and not aborted, use a destination without muxer (eg -o a.mkv) and -threads to check filter destruction on setup failure.\n"
+	        "\n"
+	        "-i src:            source to load\n"
+	        "-o dst:            destination to load. If not set and a source is given, an inspect filter with no output is used\n"
+	        "-runs N:           number of runs for each test (default 10)\n"
+	        "-threads N:        number of extra threads of the filter sessions (default: use session defaults)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i;
+	char *src = NULL;
+	char *dst = NULL;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) dst = val;
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-threads")) nb_threads = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_runs || (dst && !src)) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	fprintf(stdout, "Filter session startup - %u runs\n", nb_runs);
+	run_session_create();
+	if (src) run_session_pipeline(src, dst);
+
+	gf_sys_close();
+	return 0;
+}
@@ -0,0 +1,321 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - JavaScript filter packet rate benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+#include <gpac/isomedia.h>
+
+/*synthetic file parameters*/
+static u32 nb_samples = 200000;
+static u32 sample_size = 16;
+static u32 nb_runs = 5;
+
+#define JS_SCRIPT_NAME	"jsfbench_%s.js"
+
+/*passthrough JS filter, the per-packet code is inserted for each test*/
+static const char *js_script_start =
+	"let pids = [];\n"
+	"filter.set_name('jsfbench');\n"
+	"filter.max_pids = -1;\n"
+	"filter.set_cap({id: 'StreamType', value: 'File', inout: true, excluded: true});\n"
+	"filter.configure_pid = function(pid) {\n"
+	"	if (!pid.opid) {\n"
+	"		pid.opid = this.new_pid();\n"
+	"		pids.push(pid);\n"
+	"	}\n"
+	"	pid.opid.copy_props(pid);\n"
+	"}\n"
+	"filter.remove_pid = function(pid) {\n"
+	"	pids.splice(pids.indexOf(pid), 1);\n"
+	"	pid.opid.remove();\n"
+	"}\n"
+	"filter.process = function() {\n"
+	"	pids.forEach(pid => {\n";
+
+static const char *js_script_end =
+	"		if (pid.eos) pid.opid.eos = true;\n"
+	"	});\n"
+	"	return GF_OK;\n"
+	"}\n";
+
+typedef struct
+{
+	const char *name;
+	const char *desc;
+	const char *code;
+} JSTest;
+
+static JSTest js_tests[] =
+{
+	{"pck", "JS get_packet/forward/drop_packet for each packet",
+		"		while (1) {\n"
+		"			let pck = pid.get_packet();\n"
+		"			if (!pck) break;\n"
+		"			pid.opid.forward(pck);\n"
+		"			pid.drop_packet();\n"
+		"		}\n"
+	},
+	{"prop", "same as pck with a built-in pid property read for each packet",
+		"		while (1) {\n"
+		"			let pck = pid.get_packet();\n"
+		"			if (!pck) break;\n"
+		"			if (!pid.get_prop('StreamType')) break;\n"
+		"			pid.opid.forward(pck);\n"
+		"			pid.drop_packet();\n"
+		"		}\n"
+	},
+	{"batch", "JS forward_packets, one call per process",
+		"		pid.opid.forward_packets(pid);\n"
+	},
+};
+
+static u64 get_file_size(const char *name)
+{
+	u64 size;
+	FILE *f = gf_fopen(name, "rb");
+	if (!f) return 0;
+	size = gf_fsize(f);
+	gf_fclose(f);
+	return size;
+}
+
+void PrintUsage()
+{
+	u32 i;
+	fprintf(stderr, "USAGE: jsfbench [OPTS]\n"
+	        "Compares packet forwarding rates of JavaScript passthrough filters with the reframer filter.\n"
+	        "A synthetic MP4 file with small samples is generated unless -i is set. All tests are run on the demuxed source\n"
+	        "and the time of a session without passthrough filter is removed to get the filter only time.\n"
+	        "\n"
+	        "-i file:           use given source instead of a synthetic one\n"
+	        "-o file.mp4:       write the synthetic file and exit\n"
+	        "-samples N:        number of samples of synthetic file (default 200000)\n"
+	        "-ssize N:          sample size in bytes of synthetic file (default 16)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 5)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	        "\n"
+	        "JS tests:\n"
+	       );
+	for (i=0; i<GF_ARRAY_LENGTH(js_tests); i++) {
+		fprintf(stderr, "%-18s %s\n", js_tests[i].name, js_tests[i].desc);
+	}
+}
+
+static GF_Err generate_file(const char *name)
+{
+	GF_Err e;
+	u32 i, track, di;
+	GF_ISOSample samp;
+	GF_GenericSampleDescription udesc;
+	GF_ISOFile *file;
+
+	file = gf_isom_open(name, GF_ISOM_OPEN_WRITE, NULL);
+	if (!file) return gf_isom_last_error(NULL);
+
+	track = gf_isom_new_track(file, 1, GF_ISOM_MEDIA_VISUAL, 25000);
+	if (!track) {
+		e = gf_isom_last_error(file);
+		goto exit;
+	}
+	gf_isom_set_track_enabled(file, track, GF_TRUE);
+
+	memset(&udesc, 0, sizeof(GF_GenericSampleDescription));
+	udesc.codec_tag = GF_4CC('j','s','f','b');
+	udesc.width = 320;
+	udesc.height = 240;
+	e = gf_isom_new_generic_sample_description(file, track, NULL, NULL, &udesc, &di);
+	if (e) goto exit;
+
+	memset(&samp, 0, sizeof(GF_ISOSample));
+	samp.data = gf_malloc(sample_size);
+	if (!samp.data) {
+		e = GF_OUT_OF_MEM;
+		goto exit;
+	}
+	memset(samp.data, 0, sample_size);
+	samp.dataLength = sample_size;
+	samp.IsRAP = SAP_TYPE_1;
+
+	for (i=0; i<nb_samples; i++) {
+		samp.DTS = i*1000;
+		e = gf_isom_add_sample(file, track, di, &samp);
+		if (e) break;
+	}
+	gf_free(samp.data);
+
+exit:
+	if (e) {
+		gf_isom_delete(file);
+		return e;
+	}
+	return gf_isom_close(file);
+}
+
+static GF_Err write_script(const char *name, JSTest *test)
+{
+	FILE *f = gf_fopen(name, "wt");
+	if (!f) return GF_IO_ERR;
+	gf_fputs(js_script_start, f);
+	gf_fputs(test->code, f);
+	gf_fputs(js_script_end, f);
+	gf_fclose(f);
+	return GF_OK;
+}
+
+/*runs a session with the given source and passthrough filter if any, connected to a null inspect sink*/
+static GF_Err run_session(const char *src, const char *filter, u64 *duration)
+{
+	GF_Err e;
+	u64 start;
+	GF_FilterSession *fs;
+
+	start = gf_sys_clock_high_res();
+	fs = gf_fs_new_defaults(0);
+	if (!fs) return GF_OUT_OF_MEM;
+
+	gf_fs_load_source(fs, src, NULL, NULL, &e);
+	if (filter && !e) gf_fs_load_filter(fs, filter, &e);
+	if (!e) gf_fs_load_filter(fs, filter ? "inspect:log=null:SID=1" : "inspect:log=null", &e);
+	if (!e) e = gf_fs_run(fs);
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	*duration = gf_sys_clock_high_res() - start;
+	return e;
+}
+
+static GF_Err run_test(const char *name, const char *src, const char *filter, u32 nb_pck, u64 ref_time, u64 *best_time)
+{
+	u32 i;
+	u64 best = 0;
+	Double sec;
+	for (i=0; i<nb_runs; i++) {
+		u64 dur;
+		GF_Err e = run_session(src, filter, &dur);
+		if (e) {
+			fprintf(stderr, "%s failed: %s\n", name, gf_error_to_string(e));
+			return e;
+		}
+		if (!best || (dur<best)) best = dur;
+	}
+	if (best_time) *best_time = best;
+	sec = ((Double) best) / 1000000;
+	fprintf(stdout, "%-12s %9.2f ms %12.2f packets/s", name, sec*1000, nb_pck / sec);
+	//report time spent in the tested filter, removing time of the reference (no passthrough filter) session
+	if (ref_time && (best>ref_time)) {
+		sec = ((Double) (best - ref_time)) / 1000000;
+		fprintf(stdout, " - filter only %9.2f ms %12.2f packets/s %8.3f us/packet", sec*1000, nb_pck / sec, sec*1000000 / nb_pck);
+	}
+	fprintf(stdout, "\n");
+	return GF_OK;
+}
+
+static void on_progress(const void *cbk, const char *title, u64 done, u64 total)
+{
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i;
+	u64 ref_time;
+	char *src = NULL;
+	char *dst = NULL;
+	char szSrc[GF_MAX_PATH], szScript[GF_MAX_PATH], szFilter[GF_MAX_PATH+20];
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) dst = val;
+		else if (!strcmp(arg, "-samples")) nb_samples = atoi(val);
+		else if (!strcmp(arg, "-ssize")) sample_size = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_samples || !sample_size || !nb_runs) {
+		PrintUsage();
+		return 1;
+	}
+
+	e = gf_sys_init(GF_MemTrackerNone, NULL);
+	if (e) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	//synthetic codec is not known
+	gf_log_set_tool_level(GF_LOG_CONTAINER, GF_LOG_ERROR);
+	gf_set_progress_callback(NULL, on_progress);
+
+	if (dst) {
+		e = generate_file(dst);
+		gf_sys_close();
+		return e ? 1 : 0;
+	}
+
+	if (!src) {
+		strcpy(szSrc, "jsfbench_src.mp4");
+		e = generate_file(szSrc);
+		if (e) {
+			fprintf(stderr, "Failed to generate source: %s\n", gf_error_to_string(e));
+			goto exit;
+		}
+		src = szSrc;
+	} else {
+		szSrc[0] = 0;
+		//packet count is only used for rates, use the sample count of the first track for MP4 sources
+		if (gf_isom_probe_file(src)) {
+			GF_ISOFile *file = gf_isom_open(src, GF_ISOM_OPEN_READ, NULL);
+			if (file) {
+				nb_samples = gf_isom_get_sample_count(file, 1);
+				gf_isom_close(file);
+			}
+		}
+	}
+
+	fprintf(stdout, "Source %s: %u packets, "LLU" bytes - best of %u runs\n", src, nb_samples, get_file_size(src), nb_runs);
+
+	//reference: demux only
+	e = run_test("demux", src, NULL, nb_samples, 0, &ref_time);
+	if (e) goto exit;
+
+	e = run_test("reframer", src, "reframer:FID=1", nb_samples, ref_time, NULL);
+	if (e) goto exit;
+
+	for (i=0; i<GF_ARRAY_LENGTH(js_tests); i++) {
+		char szName[50];
+		sprintf(szScript, JS_SCRIPT_NAME, js_tests[i].name);
+		e = write_script(szScript, &js_tests[i]);
+		if (!e) {
+			sprintf(szFilter, "%s:FID=1", szScript);
+			sprintf(szName, "js %s", js_tests[i].name);
+			e = run_test(szName, src, szFilter, nb_samples, ref_time, NULL);
+		}
+		gf_file_delete(szScript);
+		if (e) goto exit;
+	}
+
+exit:
+	if (szSrc[0]) gf_file_delete(szSrc);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
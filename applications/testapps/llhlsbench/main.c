@@ -0,0 +1,301 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - LL-HLS part delivery latency test client
+ *
+ */
+
+#include <gpac/download.h>
+#include <gpac/thread.h>
+#include <gpac/network.h>
+
+static const char *pl_url = "http://127.0.0.1:8080/live_1.m3u8";
+static u32 nb_parts = 20;
+static u32 nb_clients = 1;
+static Bool poll_mode = GF_FALSE;
+
+typedef struct
+{
+	//UTC in ms of first segment
+	u64 pdt;
+	u32 msn;
+	Double part_target;
+	//newest part: segment media sequence, index in segment, URI, byte range and media end time relative to pdt
+	u32 part_msn, part_idx;
+	char part_uri[GF_MAX_PATH];
+	u64 part_offset, part_size;
+	Double part_end;
+	//number of parts of the segment being produced, and its media sequence
+	u32 nb_open_parts, next_msn;
+} PlaylistState;
+
+typedef struct
+{
+	GF_Thread *th;
+	GF_DownloadManager *dm;
+	GF_DownloadSession *sess;
+	char *data;
+	u32 size, alloc;
+
+	//latencies in ms from part end to playlist update reception and to part reception
+	u32 nb_meas, nb_req, nb_errors;
+	Double pl_min, pl_max, pl_sum;
+	Double part_min, part_max, part_sum;
+	u64 part_bytes;
+} BenchClient;
+
+static void on_data(void *cbk, GF_NETIO_Parameter *par)
+{
+	BenchClient *c = (BenchClient *) cbk;
+	if ((par->msg_type != GF_NETIO_DATA_EXCHANGE) || !par->data || !par->size) return;
+	if (c->size + par->size + 1 > c->alloc) {
+		c->alloc = c->size + par->size + 1;
+		c->data = gf_realloc(c->data, c->alloc);
+	}
+	memcpy(c->data + c->size, par->data, par->size);
+	c->size += par->size;
+	c->data[c->size] = 0;
+}
+
+static GF_Err fetch(BenchClient *c, const char *url, u64 offset, u64 size)
+{
+	GF_Err e;
+	c->size = 0;
+	c->nb_req++;
+	if (!c->sess) {
+		c->sess = gf_dm_sess_new(c->dm, url, GF_NETIO_SESSION_NOT_THREADED|GF_NETIO_SESSION_NOT_CACHED|GF_NETIO_SESSION_PERSISTENT, on_data, c, &e);
+		if (!c->sess) return e;
+	} else {
+		e = gf_dm_sess_setup_from_url(c->sess, url, GF_TRUE);
+		if (e) return e;
+	}
+	//reset range of previous request if any
+	e = gf_dm_sess_set_range(c->sess, offset, size ? offset+size-1 : 0, GF_TRUE);
+	if (e) return e;
+	e = gf_dm_sess_process(c->sess);
+	if (e>=GF_OK) e = GF_OK;
+	if (!e && size && (c->size != size)) e = GF_IO_ERR;
+	if (!e && !c->data) e = GF_IO_ERR;
+	return e;
+}
+
+static Bool parse_playlist(char *data, PlaylistState *st)
+{
+	u32 nb_seg=0, idx=0;
+	Double seg_time=0, part_time=0;
+	char *line = data;
+
+	memset(st, 0, sizeof(PlaylistState));
+	while (line && line[0]) {
+		char *next = strchr(line, '\n');
+		if (next) next[0] = 0;
+
+		if (!strncmp(line, "#EXT-X-MEDIA-SEQUENCE:", 22)) st->msn = atoi(line+22);
+		else if (!strncmp(line, "#EXT-X-PROGRAM-DATE-TIME:", 25)) {
+			if (!st->pdt) st->pdt = gf_net_parse_date(line+25);
+		}
+		else if (!strncmp(line, "#EXT-X-PART-INF:PART-TARGET=", 28)) st->part_target = atof(line+28);
+		else if (!strncmp(line, "#EXTINF:", 8)) {
+			seg_time += atof(line+8);
+			part_time = 0;
+			nb_seg++;
+			idx = 0;
+		}
+		else if (!strncmp(line, "#EXT-X-PART:", 12)) {
+			char *sep = strstr(line, "DURATION=");
+			if (sep) part_time += atof(sep+9);
+			sep = strstr(line, "URI=\"");
+			if (sep) {
+				char *end = strchr(sep+5, '"');
+				if (end && (end-sep-5 < GF_MAX_PATH)) {
+					memcpy(st->part_uri, sep+5, end-sep-5);
+					st->part_uri[end-sep-5] = 0;
+				}
+			}
+			sep = strstr(line, "BYTERANGE=\"");
+			if (sep) sscanf(sep+11, LLU"@"LLU, &st->part_size, &st->part_offset);
+			st->part_msn = st->msn + nb_seg;
+			st->part_idx = idx;
+			st->part_end = seg_time + part_time;
+			idx++;
+		}
+		if (!next) break;
+		next[0] = '\n';
+		line = next+1;
+	}
+	st->nb_open_parts = idx;
+	st->next_msn = st->msn + nb_seg;
+	return (st->pdt && st->part_uri[0] && st->part_size) ? GF_TRUE : GF_FALSE;
+}
+
+static void update_stat(Double val, u32 nb, Double *min, Double *max, Double *sum)
+{
+	if (!nb || (val < *min)) *min = val;
+	if (!nb || (val > *max)) *max = val;
+	*sum += val;
+}
+
+static u32 client_run(void *par)
+{
+	GF_Err e;
+	u32 done = 0;
+	u32 last_msn=0, last_idx=0;
+	Bool has_last = GF_FALSE;
+	char szBase[GF_MAX_PATH];
+	//base path and part URI are each up to GF_MAX_PATH long
+	char szURL[2*GF_MAX_PATH];
+	char *sep;
+	BenchClient *c = (BenchClient *) par;
+	PlaylistState st;
+
+	strcpy(szBase, pl_url);
+	sep = strrchr(szBase, '/');
+	if (sep) sep[1] = 0;
+
+	e = fetch(c, pl_url, 0, 0);
+	if (e || !parse_playlist(c->data, &st)) {
+		fprintf(stderr, "Failed to get LL-HLS playlist %s: %s\n", pl_url, e ? gf_error_to_string(e) : "no program date time or parts");
+		c->nb_errors++;
+		return 1;
+	}
+
+	while (done < nb_parts) {
+		Double pl_lat, part_lat;
+
+		if (poll_mode) {
+			//reload playlist every part duration
+			gf_sleep((u32) (st.part_target * 1000));
+			e = fetch(c, pl_url, 0, 0);
+		} else {
+			//ask for next part, blocking until it is available
+			snprintf(szURL, sizeof(szURL), "%s?_HLS_msn=%u&_HLS_part=%u", pl_url, st.next_msn, st.nb_open_parts);
+			e = fetch(c, szURL, 0, 0);
+		}
+		if (e || !parse_playlist(c->data, &st)) {
+			c->nb_errors++;
+			if (c->nb_errors>10) break;
+			continue;
+		}
+		if (has_last && (last_msn==st.part_msn) && (last_idx==st.part_idx))
+			continue;
+		has_last = GF_TRUE;
+		last_msn = st.part_msn;
+		last_idx = st.part_idx;
+
+		pl_lat = (Double) (s64) (gf_net_get_utc() - st.pdt) - st.part_end*1000;
+
+		snprintf(szURL, sizeof(szURL), "%s%s", szBase, st.part_uri);
+		e = fetch(c, szURL, st.part_offset, st.part_size);
+		if (e) {
+			c->nb_errors++;
+			continue;
+		}
+		part_lat = (Double) (s64) (gf_net_get_utc() - st.pdt) - st.part_end*1000;
+		c->part_bytes += st.part_size;
+
+		update_stat(pl_lat, c->nb_meas, &c->pl_min, &c->pl_max, &c->pl_sum);
+		update_stat(part_lat, c->nb_meas, &c->part_min, &c->part_max, &c->part_sum);
+		c->nb_meas++;
+		done++;
+	}
+	return 0;
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: llhlsbench [OPTS]\n"
+	        "Measures LL-HLS part delivery latency against a live server, for example:\n"
+	        "gpac -i src.mp4 reframer:rt=on -o http://127.0.0.1:8080/live.m3u8:rdirs=dir:segdur=2:llhls=0.5:hlsc\n"
+	        "Each client follows the newest part of the playlist and fetches it. Latency is measured from the end time of the\n"
+	        "part given by the playlist program date time to the reception of the playlist announcing it and of the part itself.\n"
+	        "\n"
+	        "-u URL:            variant playlist URL (default http://127.0.0.1:8080/live_1.m3u8)\n"
+	        "-parts N:          number of parts to fetch per client (default 20)\n"
+	        "-n N:              number of concurrent clients (default 1)\n"
+	        "-poll N:           if 1, reload playlist every part duration instead of using blocking playlist reload (default 0)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, nb_meas=0, nb_req=0, nb_errors=0;
+	u64 nb_bytes=0, start;
+	Double pl_min=0, pl_max=0, pl_sum=0, part_min=0, part_max=0, part_sum=0;
+	BenchClient *clients;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-u")) pl_url = val;
+		else if (!strcmp(arg, "-parts")) nb_parts = atoi(val);
+		else if (!strcmp(arg, "-n")) nb_clients = atoi(val);
+		else if (!strcmp(arg, "-poll")) poll_mode = atoi(val) ? GF_TRUE : GF_FALSE;
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_parts || !nb_clients) {
+		fprintf(stderr, "Invalid parameters\n");
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	clients = gf_malloc(sizeof(BenchClient) * nb_clients);
+	memset(clients, 0, sizeof(BenchClient) * nb_clients);
+
+	start = gf_sys_clock_high_res();
+	for (i=0; i<nb_clients; i++) {
+		clients[i].dm = gf_dm_new(NULL);
+		clients[i].th = gf_th_new("LLHLSClient");
+		gf_th_run(clients[i].th, client_run, &clients[i]);
+	}
+	for (i=0; i<nb_clients; i++) {
+		BenchClient *c = &clients[i];
+		gf_th_stop(c->th);
+		gf_th_del(c->th);
+		if (c->sess) gf_dm_sess_del(c->sess);
+		gf_dm_del(c->dm);
+		if (c->data) gf_free(c->data);
+
+		if (c->nb_meas) {
+			if (!nb_meas || (c->pl_min < pl_min)) pl_min = c->pl_min;
+			if (!nb_meas || (c->part_min < part_min)) part_min = c->part_min;
+			if (c->pl_max > pl_max) pl_max = c->pl_max;
+			if (c->part_max > part_max) part_max = c->part_max;
+			pl_sum += c->pl_sum;
+			part_sum += c->part_sum;
+		}
+		nb_meas += c->nb_meas;
+		nb_req += c->nb_req;
+		nb_errors += c->nb_errors;
+		nb_bytes += c->part_bytes;
+	}
+	gf_free(clients);
+
+	fprintf(stdout, "%u clients %s - %u parts ("LLU" bytes) in %u requests, %u errors, %.2f s\n", nb_clients,
+		poll_mode ? "polling" : "blocking reload", nb_meas, nb_bytes, nb_req, nb_errors, ((Double) (gf_sys_clock_high_res() - start)) / 1000000);
+	if (nb_meas) {
+		fprintf(stdout, "playlist latency ms: min %8.1f avg %8.1f max %8.1f\n", pl_min, pl_sum / nb_meas, pl_max);
+		fprintf(stdout, "part latency ms:     min %8.1f avg %8.1f max %8.1f\n", part_min, part_sum / nb_meas, part_max);
+	}
+	gf_sys_close();
+	return nb_errors ? 1 : 0;
+}
@@ -0,0 +1,479 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - MPEG-2 TS demultiplexer throughput benchmark
+ *
+ */
+
+#include <gpac/mpegts.h>
+
+/*synthetic multiplex parameters*/
+static u32 nb_progs = 40;
+static u32 duration = 4;
+static u32 prog_rate = 3000;
+static u32 nb_runs = 3;
+static u32 chunk_size = 18800;
+static u32 batch_size = 0;
+static u32 max_threads = 8;
+
+static u32 rand_state = 0x12345678;
+
+static u32 bench_rand()
+{
+	rand_state = rand_state * 1103515245 + 12345;
+	return rand_state >> 8;
+}
+
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc;
+} TSBuffer;
+
+typedef struct
+{
+	u32 pmt_pid, video_pid, audio_pid;
+	u8 pmt_cc, video_cc, audio_cc;
+} SynthProgram;
+
+typedef struct
+{
+	Bool check;
+	u64 nb_pes, nb_bytes, nb_pcr;
+	u32 pid_crc[GF_M2TS_MAX_STREAMS];
+	u8 *scratch;
+	u32 scratch_size;
+} BenchCtx;
+
+static u8 *ts_new_packet(TSBuffer *buf)
+{
+	if (buf->size + 188 > buf->alloc) {
+		buf->alloc = buf->alloc ? 2*buf->alloc : 188*10000;
+		buf->data = gf_realloc(buf->data, buf->alloc);
+	}
+	buf->size += 188;
+	return buf->data + buf->size - 188;
+}
+
+/*writes one TS packet, with PCR and/or RAP flag if set, and stuffing if needed - returns number of payload bytes written*/
+static u32 ts_write_packet(TSBuffer *buf, u32 pid, Bool pusi, u8 *cc, s64 pcr, Bool rap, const u8 *data, u32 size)
+{
+	u32 af_len = 0, pos = 4, payload;
+	Bool has_af = ((pcr>=0) || rap) ? GF_TRUE : GF_FALSE;
+	u8 *pck = ts_new_packet(buf);
+
+	if (has_af) af_len = 1 + ((pcr>=0) ? 6 : 0);
+	payload = 184 - (has_af ? 1 + af_len : 0);
+	if (size < payload) {
+		has_af = GF_TRUE;
+		af_len = 183 - size;
+		payload = size;
+	}
+	pck[0] = 0x47;
+	pck[1] = (pusi ? 0x40 : 0) | ((pid>>8) & 0x1F);
+	pck[2] = pid & 0xFF;
+	pck[3] = (has_af ? 0x30 : 0x10) | (*cc & 0xF);
+	*cc = (*cc + 1) & 0xF;
+	if (has_af) {
+		pck[4] = af_len;
+		pos = 5;
+		if (af_len) {
+			pck[5] = (rap ? 0x40 : 0) | ((pcr>=0) ? 0x10 : 0);
+			pos = 6;
+			if (pcr>=0) {
+				u64 base = pcr / 300;
+				u32 ext = (u32) (pcr % 300);
+				pck[6] = (u8) (base>>25);
+				pck[7] = (u8) (base>>17);
+				pck[8] = (u8) (base>>9);
+				pck[9] = (u8) (base>>1);
+				pck[10] = (u8) (((base&1)<<7) | 0x7E | (ext>>8));
+				pck[11] = (u8) (ext & 0xFF);
+				pos = 12;
+			}
+			memset(pck+pos, 0xFF, 5 + af_len - pos);
+			pos = 5 + af_len;
+		}
+	}
+	memcpy(pck+pos, data, payload);
+	return payload;
+}
+
+static void ts_write_section(TSBuffer *buf, u32 pid, u8 *cc, u8 *section, u32 len)
+{
+	u32 crc, pos = 0;
+	u8 tmp[184];
+	crc = gf_crc_32(section, len);
+	section[len] = (crc>>24) & 0xFF;
+	section[len+1] = (crc>>16) & 0xFF;
+	section[len+2] = (crc>>8) & 0xFF;
+	section[len+3] = crc & 0xFF;
+	len += 4;
+
+	while (pos < len) {
+		u32 size = len - pos;
+		if (!pos) {
+			if (size > 183) size = 183;
+			tmp[0] = 0;
+			memcpy(tmp+1, section, size);
+			memset(tmp+1+size, 0xFF, 183-size);
+			ts_write_packet(buf, pid, GF_TRUE, cc, -1, GF_FALSE, tmp, 184);
+		} else {
+			if (size > 184) size = 184;
+			memcpy(tmp, section+pos, size);
+			memset(tmp+size, 0xFF, 184-size);
+			ts_write_packet(buf, pid, GF_FALSE, cc, -1, GF_FALSE, tmp, 184);
+		}
+		pos += size;
+	}
+}
+
+static void ts_write_tables(TSBuffer *buf, SynthProgram *progs, u8 *pat_cc)
+{
+	u32 i, len;
+	u8 section[1024];
+
+	len = 8 + 4*nb_progs;
+	section[0] = GF_M2TS_TABLE_ID_PAT;
+	section[1] = 0xB0 | (((len+1)>>8) & 0x0F);
+	section[2] = (len+1) & 0xFF;
+	section[3] = 0;
+	section[4] = 1;
+	section[5] = 0xC1;
+	section[6] = 0;
+	section[7] = 0;
+	for (i=0; i<nb_progs; i++) {
+		section[8+4*i] = ((i+1)>>8) & 0xFF;
+		section[9+4*i] = (i+1) & 0xFF;
+		section[10+4*i] = 0xE0 | ((progs[i].pmt_pid>>8) & 0x1F);
+		section[11+4*i] = progs[i].pmt_pid & 0xFF;
+	}
+	ts_write_section(buf, GF_M2TS_PID_PAT, pat_cc, section, len);
+
+	for (i=0; i<nb_progs; i++) {
+		len = 12 + 2*5;
+		section[0] = GF_M2TS_TABLE_ID_PMT;
+		section[1] = 0xB0 | (((len+1)>>8) & 0x0F);
+		section[2] = (len+1) & 0xFF;
+		section[3] = ((i+1)>>8) & 0xFF;
+		section[4] = (i+1) & 0xFF;
+		section[5] = 0xC1;
+		section[6] = 0;
+		section[7] = 0;
+		section[8] = 0xE0 | ((progs[i].video_pid>>8) & 0x1F);
+		section[9] = progs[i].video_pid & 0xFF;
+		section[10] = 0xF0;
+		section[11] = 0;
+		section[12] = GF_M2TS_VIDEO_H264;
+		section[13] = 0xE0 | ((progs[i].video_pid>>8) & 0x1F);
+		section[14] = progs[i].video_pid & 0xFF;
+		section[15] = 0xF0;
+		section[16] = 0;
+		section[17] = GF_M2TS_AUDIO_AAC;
+		section[18] = 0xE0 | ((progs[i].audio_pid>>8) & 0x1F);
+		section[19] = progs[i].audio_pid & 0xFF;
+		section[20] = 0xF0;
+		section[21] = 0;
+		ts_write_section(buf, progs[i].pmt_pid, &progs[i].pmt_cc, section, len);
+	}
+}
+
+static void ts_write_pes(TSBuffer *buf, u32 pid, u8 *cc, u8 stream_id, u64 pts, s64 pcr, Bool rap, u8 *payload, u32 size)
+{
+	u32 pos, len;
+	Bool first = GF_TRUE;
+	//PES header in front of payload, the payload buffer has 14 bytes reserved before it
+	u8 *pes = payload - 14;
+	len = size + 8;
+	pes[0] = 0;
+	pes[1] = 0;
+	pes[2] = 1;
+	pes[3] = stream_id;
+	pes[4] = (len > 0xFFFF) ? 0 : (len>>8) & 0xFF;
+	pes[5] = (len > 0xFFFF) ? 0 : len & 0xFF;
+	pes[6] = 0x80;
+	pes[7] = 0x80;
+	pes[8] = 5;
+	pes[9] = 0x21 | (u8) ((pts>>29) & 0x0E);
+	pes[10] = (u8) (pts>>22);
+	pes[11] = (u8) (((pts>>14) & 0xFE) | 1);
+	pes[12] = (u8) (pts>>7);
+	pes[13] = (u8) (((pts<<1) & 0xFE) | 1);
+
+	size += 14;
+	pos = 0;
+	while (pos < size) {
+		pos += ts_write_packet(buf, pid, first, cc, first ? pcr : -1, first ? rap : GF_FALSE, pes+pos, size-pos);
+		first = GF_FALSE;
+	}
+}
+
+static GF_Err generate_ts(TSBuffer *buf)
+{
+	u32 i, j, nb_frames, video_size, audio_size;
+	u64 audio_time = 0;
+	u8 pat_cc = 0;
+	u8 *payload;
+	SynthProgram *progs;
+
+	if (!nb_progs || (nb_progs > 400)) return GF_BAD_PARAM;
+	progs = gf_malloc(sizeof(SynthProgram) * nb_progs);
+	if (!progs) return GF_OUT_OF_MEM;
+	memset(progs, 0, sizeof(SynthProgram) * nb_progs);
+	for (i=0; i<nb_progs; i++) {
+		progs[i].pmt_pid = 0x1000 + i;
+		progs[i].video_pid = 0x100 + 2*i;
+		progs[i].audio_pid = 0x101 + 2*i;
+	}
+
+	//25 fps video, 48 kHz AAC at 128 kbps, rest of program rate for video
+	audio_size = 128000 / 8 * 1024 / 48000;
+	video_size = (prog_rate>128) ? (prog_rate - 128) * 1000 / 8 / 25 : 1000;
+	payload = gf_malloc(14 + 4*video_size);
+	if (!payload) {
+		gf_free(progs);
+		return GF_OUT_OF_MEM;
+	}
+	for (i=0; i<14 + 4*video_size; i++) payload[i] = bench_rand();
+
+	nb_frames = duration * 25;
+	for (i=0; i<nb_frames; i++) {
+		u64 pts = 90000 + i * 3600;
+		//tables every 4 frames
+		if (!(i%4)) ts_write_tables(buf, progs, &pat_cc);
+
+		for (j=0; j<nb_progs; j++) {
+			u32 size;
+			Bool rap = (i%25) ? GF_FALSE : GF_TRUE;
+			//larger I-frames
+			size = rap ? 3*video_size : video_size/2 + (bench_rand() % video_size);
+			//PCR 500ms before frame PTS, shifted per program
+			ts_write_pes(buf, progs[j].video_pid, &progs[j].video_cc, 0xE0, pts + j, (s64) (pts + j - 45000) * 300, rap, payload + 14, size);
+		}
+		//audio frames up to the end of this video frame
+		while (audio_time * 90000 / 48000 < (u64) (i+1) * 3600) {
+			u64 apts = 90000 + audio_time * 90000 / 48000;
+			for (j=0; j<nb_progs; j++) {
+				ts_write_pes(buf, progs[j].audio_pid, &progs[j].audio_cc, 0xC0, apts + j, -1, GF_TRUE, payload + 14 + (bench_rand() % video_size), audio_size);
+			}
+			audio_time += 1024;
+		}
+	}
+	gf_free(payload);
+	gf_free(progs);
+	return GF_OK;
+}
+
+static void on_event(GF_M2TS_Demuxer *ts, u32 evt_type, void *par)
+{
+	u32 i, crc;
+	BenchCtx *ctx = (BenchCtx *) ts->user;
+	GF_M2TS_PES_PCK *pck = (GF_M2TS_PES_PCK *) par;
+
+	switch (evt_type) {
+	case GF_M2TS_EVT_PMT_FOUND:
+	{
+		GF_M2TS_Program *prog = (GF_M2TS_Program *) par;
+		for (i=0; i<gf_list_count(prog->streams); i++) {
+			GF_M2TS_ES *es = gf_list_get(prog->streams, i);
+			if (es->flags & GF_M2TS_ES_IS_PES)
+				gf_m2ts_set_pes_framing((GF_M2TS_PES *)es, GF_M2TS_PES_FRAMING_DEFAULT);
+		}
+	}
+		break;
+	case GF_M2TS_EVT_PES_PCK:
+		ctx->nb_pes++;
+		ctx->nb_bytes += pck->data_len;
+		//same copy as the demux filter output
+		if (pck->data_len > ctx->scratch_size) {
+			ctx->scratch_size = pck->data_len;
+			ctx->scratch = gf_realloc(ctx->scratch, ctx->scratch_size);
+		}
+		memcpy(ctx->scratch, pck->data, pck->data_len);
+		if (ctx->check) {
+			crc = gf_crc_32(pck->data, pck->data_len);
+			ctx->pid_crc[pck->stream->pid] = ctx->pid_crc[pck->stream->pid] * 31 + crc + (u32) pck->PTS + pck->flags;
+		}
+		break;
+	case GF_M2TS_EVT_PES_PCR:
+		ctx->nb_pcr++;
+		if (ctx->check)
+			ctx->pid_crc[pck->stream->pid] = ctx->pid_crc[pck->stream->pid] * 31 + (u32) pck->PTS;
+		break;
+	}
+}
+
+static GF_Err run_test(TSBuffer *buf, u32 nb_threads, u32 *out_crc, Bool *crc_set)
+{
+	u32 i, run;
+	u64 best = 0;
+	BenchCtx ctx;
+	u32 crc = 0;
+	Double sec;
+
+	memset(&ctx, 0, sizeof(BenchCtx));
+	for (run=0; run<nb_runs; run++) {
+		u64 start, now;
+		u32 pos = 0;
+		GF_Err e;
+		GF_M2TS_Demuxer *ts = gf_m2ts_demux_new();
+		ts->on_event = on_event;
+		ts->user = &ctx;
+		e = gf_m2ts_demux_set_threads(ts, nb_threads, batch_size);
+		if (e) {
+			gf_m2ts_demux_del(ts);
+			return e;
+		}
+		ctx.check = run ? GF_FALSE : GF_TRUE;
+		ctx.nb_pes = ctx.nb_bytes = ctx.nb_pcr = 0;
+		memset(ctx.pid_crc, 0, sizeof(u32)*GF_M2TS_MAX_STREAMS);
+
+		start = gf_sys_clock_high_res();
+		while (pos < buf->size) {
+			u32 size = buf->size - pos;
+			if (size > chunk_size) size = chunk_size;
+			gf_m2ts_process_data(ts, buf->data + pos, size);
+			pos += size;
+		}
+		gf_m2ts_flush_all(ts);
+		now = gf_sys_clock_high_res() - start;
+		gf_m2ts_demux_del(ts);
+
+		if (!run) {
+			for (i=0; i<GF_M2TS_MAX_STREAMS; i++) crc ^= ctx.pid_crc[i];
+		}
+		if (!best || (now < best)) best = now;
+	}
+	if (ctx.scratch) gf_free(ctx.scratch);
+
+	sec = ((Double) best) / 1000000;
+	fprintf(stdout, "threads %2u: %9.2f ms %8.2f MB/s %10.0f TS packets/s %9.0f PES/s - "LLU" PES "LLU" PCR checksum %08X%s\n", nb_threads,
+		sec*1000, ((Double) buf->size) / sec / 1000000, buf->size / 188 / sec, ctx.nb_pes / sec, ctx.nb_pes, ctx.nb_pcr, crc,
+		(*crc_set && (crc != *out_crc)) ? " MISMATCH" : "");
+	if (!*crc_set) {
+		*out_crc = crc;
+		*crc_set = GF_TRUE;
+	}
+	return GF_OK;
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: m2tsbench [OPTS]\n"
+	        "Measures MPEG-2 TS demultiplexer throughput with an increasing number of PES reassembly threads.\n"
+	        "A synthetic multiplex is generated unless -i is set, each program carrying one video and one audio stream with PCR on video.\n"
+	        "Each test reports the best run time and a checksum of the PES and PCR events of the first run, computed per PID and\n"
+	        "which must be the same for all thread counts.\n"
+	        "\n"
+	        "-i file.ts:        use given transport stream instead of a synthetic one\n"
+	        "-o file.ts:        write the synthetic transport stream and exit\n"
+	        "-progs N:          number of programs of synthetic multiplex (default 40)\n"
+	        "-dur N:            duration of synthetic multiplex in seconds (default 4)\n"
+	        "-rate N:           bitrate of each program of synthetic multiplex in kbps (default 3000)\n"
+	        "-threads N:        maximum number of threads, tests 1, 2, 4 ... up to N threads (default 8)\n"
+	        "-batch N:          number of pending TS packets per thread before processing (default 0, demultiplexer default)\n"
+	        "-chunk N:          size of data chunks given to the demultiplexer (default 18800)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 3)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i, crc=0;
+	Bool crc_set = GF_FALSE;
+	char *src = NULL;
+	char *dst = NULL;
+	TSBuffer buf;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) dst = val;
+		else if (!strcmp(arg, "-progs")) nb_progs = atoi(val);
+		else if (!strcmp(arg, "-dur")) duration = atoi(val);
+		else if (!strcmp(arg, "-rate")) prog_rate = atoi(val);
+		else if (!strcmp(arg, "-threads")) max_threads = atoi(val);
+		else if (!strcmp(arg, "-batch")) batch_size = atoi(val);
+		else if (!strcmp(arg, "-chunk")) chunk_size = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_progs || !duration || !max_threads || !chunk_size || !nb_runs) {
+		fprintf(stderr, "Invalid parameters\n");
+		return 1;
+	}
+
+	e = gf_sys_init(GF_MemTrackerNone, NULL);
+	if (e) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	memset(&buf, 0, sizeof(TSBuffer));
+	if (src) {
+		FILE *f = gf_fopen(src, "rb");
+		if (!f) {
+			fprintf(stderr, "Failed to open %s\n", src);
+			e = GF_URL_ERROR;
+			goto exit;
+		}
+		buf.alloc = (u32) gf_fsize(f);
+		buf.data = gf_malloc(buf.alloc);
+		buf.size = buf.data ? (u32) gf_fread(buf.data, buf.alloc, f) : 0;
+		gf_fclose(f);
+	} else {
+		e = generate_ts(&buf);
+		if (e) {
+			fprintf(stderr, "Failed to generate multiplex: %s\n", gf_error_to_string(e));
+			goto exit;
+		}
+		if (dst) {
+			FILE *f = gf_fopen(dst, "wb");
+			if (!f) {
+				fprintf(stderr, "Failed to create %s\n", dst);
+				e = GF_IO_ERR;
+			} else {
+				gf_fwrite(buf.data, buf.size, f);
+				gf_fclose(f);
+			}
+			goto exit;
+		}
+	}
+	if (!buf.size) {
+		fprintf(stderr, "No data to demultiplex\n");
+		e = GF_BAD_PARAM;
+		goto exit;
+	}
+
+	fprintf(stdout, "Source %s: %u bytes - best of %u runs\n", src ? src : "synthetic", buf.size, nb_runs);
+	for (i=1; i<=max_threads; i*=2) {
+		e = run_test(&buf, i, &crc, &crc_set);
+		if (e) {
+			fprintf(stderr, "Failed to run test with %u threads: %s\n", i, gf_error_to_string(e));
+			goto exit;
+		}
+	}
+
+exit:
+	if (buf.data) gf_free(buf.data);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
@@ -0,0 +1,331 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - live DASH/HLS manifest generation benchmark
+ *
+ */
+
+#include <gpac/mpd.h>
+
+static u32 nb_reps = 100;
+static u32 nb_sets = 10;
+static u32 nb_segs = 100;
+static u32 seg_dur = 1000;
+static u32 tsb_segs = 0;
+static u32 nb_runs = 3;
+
+#define BENCH_TIMESCALE	90000
+
+typedef struct
+{
+	u64 mpd_file, mpd_mem, m3u8;
+	u64 mpd_bytes, m3u8_bytes;
+	u32 nb_var_sent;
+} BenchStats;
+
+static GF_MPD *create_mpd()
+{
+	u32 i, j;
+	GF_MPD *mpd = gf_mpd_new();
+	GF_MPD_Period *period = gf_mpd_period_new();
+
+	mpd->xml_namespace = "urn:mpeg:dash:schema:mpd:2011";
+	mpd->base_URLs = gf_list_new();
+	mpd->locations = gf_list_new();
+	mpd->program_infos = gf_list_new();
+	mpd->periods = gf_list_new();
+	mpd->attributes = gf_list_new();
+	mpd->type = GF_MPD_TYPE_DYNAMIC;
+	mpd->profiles = gf_strdup("urn:mpeg:dash:profile:isoff-live:2011");
+	mpd->availabilityStartTime = 1600000000000;
+	mpd->min_buffer_time = seg_dur;
+	mpd->minimum_update_period = seg_dur;
+	mpd->time_shift_buffer_depth = tsb_segs * seg_dur;
+	period->ID = gf_strdup("P1");
+	gf_list_add(mpd->periods, period);
+
+	for (i=0; i<nb_sets; i++) {
+		GF_MPD_AdaptationSet *set = gf_mpd_adaptation_set_new();
+		set->segment_alignment = GF_TRUE;
+		set->starts_with_sap = 1;
+		set->max_width = 1920;
+		set->max_height = 1080;
+		gf_list_add(period->adaptation_sets, set);
+
+		for (j=i; j<nb_reps; j+=nb_sets) {
+			char szName[100];
+			GF_MPD_SegmentTemplate *tpl;
+			GF_MPD_Representation *rep = gf_mpd_representation_new();
+
+			sprintf(szName, "%d", j+1);
+			rep->id = gf_strdup(szName);
+			rep->mime_type = gf_strdup("video/mp4");
+			rep->codecs = gf_strdup("avc1.640028");
+			rep->bandwidth = 500000 + 100000*j;
+			rep->width = 1920 - 16*(j%50);
+			rep->height = 1080 - 8*(j%50);
+			rep->streamtype = GF_STREAM_VISUAL;
+			rep->timescale = rep->timescale_mpd = BENCH_TIMESCALE;
+			rep->dash_dur = ((Double) seg_dur) / 1000;
+			rep->state_seg_list = gf_list_new();
+
+			GF_SAFEALLOC(tpl, GF_MPD_SegmentTemplate);
+			sprintf(szName, "rep%d_$Number$.m4s", j+1);
+			tpl->media = gf_strdup(szName);
+			sprintf(szName, "rep%d_init.mp4", j+1);
+			tpl->initialization = gf_strdup(szName);
+			tpl->timescale = BENCH_TIMESCALE;
+			tpl->start_number = 1;
+			tpl->segment_timeline = gf_mpd_segmentimeline_new();
+			rep->segment_template = tpl;
+
+			gf_list_add(set->representations, rep);
+		}
+	}
+	return mpd;
+}
+
+//appends one segment to all representations, removing segments out of the timeshift buffer
+static void add_segment(GF_MPD *mpd, u32 seg_num, u64 seg_time, u32 dur)
+{
+	u32 i, j;
+	GF_MPD_Period *period = gf_list_get(mpd->periods, 0);
+	GF_MPD_AdaptationSet *set;
+	GF_MPD_Representation *rep;
+
+	i=0;
+	while ((set = gf_list_enum(period->adaptation_sets, &i))) {
+		j=0;
+		while ((rep = gf_list_enum(set->representations, &j))) {
+			char szName[100];
+			GF_DASH_SegmentContext *sctx;
+			GF_MPD_SegmentTimelineEntry *ent;
+			GF_MPD_SegmentTimeline *stl = rep->segment_template->segment_timeline;
+
+			ent = gf_list_last(stl->entries);
+			if (ent && (ent->duration==dur)) {
+				ent->repeat_count++;
+			} else {
+				GF_SAFEALLOC(ent, GF_MPD_SegmentTimelineEntry);
+				ent->start_time = seg_time;
+				ent->duration = dur;
+				gf_list_add(stl->entries, ent);
+			}
+
+			GF_SAFEALLOC(sctx, GF_DASH_SegmentContext);
+			sctx->time = seg_time;
+			sctx->dur = dur;
+			sctx->seg_num = seg_num;
+			sprintf(szName, "rep%s_%d.m4s", rep->id, seg_num);
+			sctx->filename = gf_strdup(szName);
+			gf_list_add(rep->state_seg_list, sctx);
+
+			if (!tsb_segs || (gf_list_count(rep->state_seg_list) <= tsb_segs))
+				continue;
+
+			sctx = gf_list_pop_front(rep->state_seg_list);
+			gf_free(sctx->filename);
+			gf_free(sctx);
+
+			ent = gf_list_get(stl->entries, 0);
+			if (ent->repeat_count) {
+				ent->repeat_count--;
+				ent->start_time += ent->duration;
+			} else {
+				gf_list_rem(stl->entries, 0);
+				gf_free(ent);
+				ent = gf_list_get(stl->entries, 0);
+				if (ent && !ent->start_time) ent->start_time = seg_time;
+			}
+			rep->segment_template->start_number++;
+		}
+	}
+}
+
+//render MPD through a temporary file and read it back, as done by the dasher for each manifest update
+static u32 write_mpd_file(GF_MPD *mpd, u8 **buf, u32 *buf_size)
+{
+	u32 size;
+	FILE *f = gf_file_temp(NULL);
+	if (!f) return 0;
+	gf_mpd_write(mpd, f, GF_FALSE);
+	size = (u32) gf_fsize(f);
+	if (size > *buf_size) {
+		*buf = gf_realloc(*buf, size);
+		*buf_size = size;
+	}
+	size = (u32) gf_fread(*buf, size, f);
+	gf_fclose(f);
+	return size;
+}
+
+//render MPD in a reused memory file and copy it out
+static u32 write_mpd_mem(GF_MPD *mpd, FILE *mem, u8 **buf, u32 *buf_size)
+{
+	u32 size;
+	const u8 *data;
+	gf_file_temp_mem_reset(mem);
+	gf_mpd_write(mpd, mem, GF_FALSE);
+	data = gf_file_temp_mem_data(mem, &size);
+	if (size > *buf_size) {
+		*buf = gf_realloc(*buf, size);
+		*buf_size = size;
+	}
+	if (size) memcpy(*buf, data, size);
+	return size;
+}
+
+//render master and variant playlists, counting variants which changed since last update
+static u32 write_m3u8(GF_MPD *mpd, FILE *mem, u32 *nb_changed)
+{
+	u32 i, j, size;
+	GF_MPD_Period *period = gf_list_get(mpd->periods, 0);
+	GF_MPD_AdaptationSet *set;
+	GF_MPD_Representation *rep;
+
+	gf_file_temp_mem_reset(mem);
+	gf_mpd_write_m3u8_master_playlist(mpd, mem, "live.m3u8", period);
+	gf_file_temp_mem_data(mem, &size);
+
+	i=0;
+	while ((set = gf_list_enum(period->adaptation_sets, &i))) {
+		j=0;
+		while ((rep = gf_list_enum(set->representations, &j))) {
+			u32 crc, var_size;
+			const u8 *data = gf_file_temp_mem_data(rep->m3u8_var_file, &var_size);
+			size += var_size;
+			crc = gf_crc_32(data, var_size);
+			if ((crc==rep->m3u8_var_crc) && (var_size==rep->m3u8_var_size)) continue;
+			rep->m3u8_var_crc = crc;
+			rep->m3u8_var_size = var_size;
+			(*nb_changed)++;
+		}
+	}
+	return size;
+}
+
+static void run_test(BenchStats *stats, Bool first_run)
+{
+	u32 i, buf_size=0, mpd_crc=0;
+	u64 seg_time=0;
+	u8 *buf=NULL;
+	GF_MPD *mpd = create_mpd();
+	FILE *mem = gf_file_temp_mem();
+	FILE *mem_m3u8 = gf_file_temp_mem();
+	BenchStats run;
+
+	memset(&run, 0, sizeof(BenchStats));
+	for (i=0; i<nb_segs; i++) {
+		u64 start, end;
+		u32 size, size_mem;
+		//alternate segment durations as produced from 29.97 fps content, so that timelines grow
+		u32 dur = seg_dur * BENCH_TIMESCALE / 1000;
+		if (i%2) dur += 3003;
+		add_segment(mpd, i+1, seg_time, dur);
+		seg_time += dur;
+		mpd->publishTime = mpd->availabilityStartTime + seg_time*1000/BENCH_TIMESCALE;
+
+		start = gf_sys_clock_high_res();
+		size = write_mpd_file(mpd, &buf, &buf_size);
+		end = gf_sys_clock_high_res();
+		run.mpd_file += end - start;
+
+		start = gf_sys_clock_high_res();
+		size_mem = write_mpd_mem(mpd, mem, &buf, &buf_size);
+		end = gf_sys_clock_high_res();
+		run.mpd_mem += end - start;
+		if (size != size_mem) {
+			fprintf(stderr, "Mismatch between file and memory MPD sizes: %u vs %u\n", size, size_mem);
+		}
+		run.mpd_bytes += size_mem;
+		if (first_run) mpd_crc += gf_crc_32(buf, size_mem);
+
+		start = gf_sys_clock_high_res();
+		run.m3u8_bytes += write_m3u8(mpd, mem_m3u8, &run.nb_var_sent);
+		end = gf_sys_clock_high_res();
+		run.m3u8 += end - start;
+	}
+	if (first_run) {
+		*stats = run;
+		fprintf(stdout, "MPD CRC %08X\n", mpd_crc);
+	} else {
+		if (run.mpd_file < stats->mpd_file) stats->mpd_file = run.mpd_file;
+		if (run.mpd_mem < stats->mpd_mem) stats->mpd_mem = run.mpd_mem;
+		if (run.m3u8 < stats->m3u8) stats->m3u8 = run.m3u8;
+	}
+	gf_fclose(mem);
+	gf_fclose(mem_m3u8);
+	if (buf) gf_free(buf);
+	gf_mpd_del(mpd);
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: mpdbench [OPTS]\n"
+	        "Measures live manifest generation cost for DASH (SegmentTimeline) and HLS (master and variant playlists).\n"
+	        "A dynamic MPD is updated after each new segment of all representations, and manifests are regenerated.\n"
+	        "MPD generation is timed through a temporary file read back into memory and through a reused memory file.\n"
+	        "\n"
+	        "-reps N:           number of representations (default 100)\n"
+	        "-sets N:           number of adaptation sets (default 10)\n"
+	        "-segs N:           number of segments, i.e. manifest updates (default 100)\n"
+	        "-dur N:            segment duration in ms (default 1000)\n"
+	        "-tsb N:            timeshift buffer in segments, 0 for no segment removal (default 0)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 3)\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i;
+	BenchStats stats;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-reps")) nb_reps = atoi(val);
+		else if (!strcmp(arg, "-sets")) nb_sets = atoi(val);
+		else if (!strcmp(arg, "-segs")) nb_segs = atoi(val);
+		else if (!strcmp(arg, "-dur")) seg_dur = atoi(val);
+		else if (!strcmp(arg, "-tsb")) tsb_segs = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_reps || !nb_sets || !nb_segs || !seg_dur || !nb_runs) {
+		fprintf(stderr, "Invalid parameters\n");
+		return 1;
+	}
+	if (nb_sets > nb_reps) nb_sets = nb_reps;
+	memset(&stats, 0, sizeof(BenchStats));
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	fprintf(stdout, "%u representations in %u sets, %u segments of %u ms - best of %u runs\n", nb_reps, nb_sets, nb_segs, seg_dur, nb_runs);
+	for (i=0; i<nb_runs; i++) {
+		run_test(&stats, i ? GF_FALSE : GF_TRUE);
+	}
+
+	fprintf(stdout, "MPD tmp file  %9.2f ms total %8.3f ms/update\n", ((Double) stats.mpd_file) / 1000, ((Double) stats.mpd_file) / 1000 / nb_segs);
+	fprintf(stdout, "MPD memory    %9.2f ms total %8.3f ms/update - "LLU" bytes\n", ((Double) stats.mpd_mem) / 1000, ((Double) stats.mpd_mem) / 1000 / nb_segs, stats.mpd_bytes);
+	fprintf(stdout, "M3U8 memory   %9.2f ms total %8.3f ms/update - "LLU" bytes, %u/%u variant playlists changed\n", ((Double) stats.m3u8) / 1000, ((Double) stats.m3u8) / 1000 / nb_segs, stats.m3u8_bytes, stats.nb_var_sent, nb_segs*nb_reps);
+
+	gf_sys_close();
+	return 0;
+}
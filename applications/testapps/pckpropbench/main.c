@@ -0,0 +1,342 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - packet property forwarding benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+
+#define PB_CODEC_ID	GF_4CC('P','B','C','K')
+#define PB_MAX_FWD	16
+
+static u32 nb_runs = 5;
+static u32 nb_packets = 200000;
+static u32 nb_fwd = 5;
+static u32 nb_props = 4;
+//0: forward only, 1: each pass-through filter also sets one property on the forwarded packet
+static u32 write_mode = 0;
+static u32 nb_received = 0;
+static u32 nb_bad_props = 0;
+
+static u8 pb_data[188];
+
+typedef struct
+{
+	GF_FilterPid *ipid, *opid;
+	u32 nb_sent;
+	u32 idx;
+} PBCtx;
+
+static const GF_FilterCapability PBSrcCaps[] =
+{
+	CAP_UINT(GF_CAPS_OUTPUT, GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+	CAP_UINT(GF_CAPS_OUTPUT, GF_PROP_PID_CODECID, PB_CODEC_ID),
+};
+
+static const GF_FilterCapability PBFwdCaps[] =
+{
+	CAP_UINT(GF_CAPS_INPUT_OUTPUT, GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+	CAP_UINT(GF_CAPS_INPUT_OUTPUT, GF_PROP_PID_CODECID, PB_CODEC_ID),
+};
+
+static const GF_FilterCapability PBSinkCaps[] =
+{
+	CAP_UINT(GF_CAPS_INPUT, GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+	CAP_UINT(GF_CAPS_INPUT, GF_PROP_PID_CODECID, PB_CODEC_ID),
+};
+
+static GF_Err pbsrc_initialize(GF_Filter *filter)
+{
+	PBCtx *ctx = gf_filter_get_udta(filter);
+	ctx->opid = gf_filter_pid_new(filter);
+	if (!ctx->opid) return GF_OUT_OF_MEM;
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_FILE) );
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_CODECID, &PROP_UINT(PB_CODEC_ID) );
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_TIMESCALE, &PROP_UINT(1000) );
+	return GF_OK;
+}
+
+static Bool pbsrc_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
+{
+	if (evt->base.type == GF_FEVT_PLAY)
+		gf_filter_post_process_task(filter);
+	return GF_TRUE;
+}
+
+static GF_Err pbsrc_process(GF_Filter *filter)
+{
+	u32 i, j;
+	PBCtx *ctx = gf_filter_get_udta(filter);
+
+	if (ctx->nb_sent == nb_packets) {
+		gf_filter_pid_set_eos(ctx->opid);
+		return GF_EOS;
+	}
+	for (i=0; i<100; i++) {
+		GF_FilterPacket *pck;
+		if (ctx->nb_sent == nb_packets) break;
+		if (gf_filter_pid_would_block(ctx->opid)) break;
+		pck = gf_filter_pck_new_shared(ctx->opid, pb_data, sizeof(pb_data), NULL);
+		if (!pck) return GF_OUT_OF_MEM;
+		gf_filter_pck_set_cts(pck, ctx->nb_sent);
+		gf_filter_pck_set_sap(pck, GF_FILTER_SAP_1);
+		for (j=0; j<nb_props; j++) {
+			gf_filter_pck_set_property(pck, GF_4CC('P','B','0'+j/10,'0'+j%10), &PROP_UINT(j) );
+		}
+		gf_filter_pck_send(pck);
+		ctx->nb_sent++;
+	}
+	return GF_OK;
+}
+
+static GF_Err pbfwd_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	PBCtx *ctx = gf_filter_get_udta(filter);
+	if (is_remove) {
+		if (ctx->opid) {
+			gf_filter_pid_remove(ctx->opid);
+			ctx->opid = NULL;
+		}
+		return GF_OK;
+	}
+	ctx->ipid = pid;
+	if (!ctx->opid) ctx->opid = gf_filter_pid_new(filter);
+	gf_filter_pid_copy_properties(ctx->opid, pid);
+	return GF_OK;
+}
+
+static GF_Err pbfwd_process(GF_Filter *filter)
+{
+	PBCtx *ctx = gf_filter_get_udta(filter);
+	while (1) {
+		GF_FilterPacket *pck = gf_filter_pid_get_packet(ctx->ipid);
+		if (!pck) {
+			if (gf_filter_pid_is_eos(ctx->ipid)) {
+				gf_filter_pid_set_eos(ctx->opid);
+				return GF_EOS;
+			}
+			return GF_OK;
+		}
+		if (write_mode) {
+			GF_FilterPacket *dst = gf_filter_pck_new_ref(ctx->opid, 0, 0, pck);
+			if (!dst) return GF_OUT_OF_MEM;
+			gf_filter_pck_merge_properties(pck, dst);
+			//triggers a copy of the property map shared with the source packet
+			gf_filter_pck_set_property(dst, GF_4CC('P','F','0'+ctx->idx/10,'0'+ctx->idx%10), &PROP_UINT(ctx->idx) );
+			gf_filter_pck_send(dst);
+		} else {
+			gf_filter_pck_forward(pck, ctx->opid);
+		}
+		gf_filter_pid_drop_packet(ctx->ipid);
+	}
+	return GF_OK;
+}
+
+static GF_Err pbsink_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	GF_FilterEvent evt;
+	PBCtx *ctx = gf_filter_get_udta(filter);
+	if (is_remove) return GF_OK;
+	ctx->ipid = pid;
+	GF_FEVT_INIT(evt, GF_FEVT_PLAY, pid);
+	gf_filter_pid_send_event(pid, &evt);
+	return GF_OK;
+}
+
+static GF_Err pbsink_process(GF_Filter *filter)
+{
+	PBCtx *ctx = gf_filter_get_udta(filter);
+	u32 expected = nb_props + (write_mode ? nb_fwd : 0);
+	while (1) {
+		u32 idx = 0, count = 0;
+		u32 p4cc;
+		const char *pname;
+		GF_FilterPacket *pck = gf_filter_pid_get_packet(ctx->ipid);
+		if (!pck) {
+			if (gf_filter_pid_is_eos(ctx->ipid)) return GF_EOS;
+			return GF_OK;
+		}
+		while (gf_filter_pck_enum_properties(pck, &idx, &p4cc, &pname))
+			count++;
+		if (count != expected) nb_bad_props++;
+		nb_received++;
+		gf_filter_pid_drop_packet(ctx->ipid);
+	}
+	return GF_OK;
+}
+
+static GF_FilterRegister PBSrcRegister = {
+	.name = "pbsrc",
+	.private_size = sizeof(PBCtx),
+	.flags = GF_FS_REG_EXPLICIT_ONLY,
+	SETCAPS(PBSrcCaps),
+	.initialize = pbsrc_initialize,
+	.process = pbsrc_process,
+	.process_event = pbsrc_process_event,
+};
+
+//a filter output cannot connect to a filter of the same register, use one register per pass-through filter
+static GF_FilterRegister PBFwdRegisters[PB_MAX_FWD];
+static char PBFwdNames[PB_MAX_FWD][10];
+
+static GF_FilterRegister PBSinkRegister = {
+	.name = "pbsink",
+	.private_size = sizeof(PBCtx),
+	.flags = GF_FS_REG_EXPLICIT_ONLY,
+	SETCAPS(PBSinkCaps),
+	.configure_pid = pbsink_configure_pid,
+	.process = pbsink_process,
+};
+
+//runs source -> nb_fwd pass-through filters -> sink, returns run time in us or 0 on error
+static u64 run_chain()
+{
+	u32 i;
+	u64 now, dur;
+	GF_Err e;
+	GF_Filter *src, *prev, *f;
+	GF_FilterSession *fsess = gf_fs_new(0, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fsess) return 0;
+	gf_fs_add_filter_register(fsess, &PBSrcRegister);
+	for (i=0; i<nb_fwd; i++)
+		gf_fs_add_filter_register(fsess, &PBFwdRegisters[i]);
+	gf_fs_add_filter_register(fsess, &PBSinkRegister);
+
+	src = gf_fs_load_filter(fsess, "pbsrc", &e);
+	if (!src) goto err;
+	prev = src;
+	for (i=0; i<nb_fwd; i++) {
+		f = gf_fs_load_filter(fsess, PBFwdNames[i], &e);
+		if (!f) goto err;
+		((PBCtx *) gf_filter_get_udta(f))->idx = i;
+		gf_filter_set_source(f, prev, NULL);
+		prev = f;
+	}
+	f = gf_fs_load_filter(fsess, "pbsink", &e);
+	if (!f) goto err;
+	gf_filter_set_source(f, prev, NULL);
+
+	nb_received = nb_bad_props = 0;
+	now = gf_sys_clock_high_res();
+	e = gf_fs_run(fsess);
+	dur = gf_sys_clock_high_res() - now;
+	if (e<GF_OK) goto err;
+	gf_fs_del(fsess);
+	if (nb_received != nb_packets) {
+		fprintf(stderr, "Sink received %u packets, %u expected\n", nb_received, nb_packets);
+		return 0;
+	}
+	if (nb_bad_props) {
+		fprintf(stderr, "%u packets received with wrong property count\n", nb_bad_props);
+		return 0;
+	}
+	return dur ? dur : 1;
+
+err:
+	fprintf(stderr, "Failed to run filter chain: %s\n", gf_error_to_string(e));
+	gf_fs_del(fsess);
+	return 0;
+}
+
+static void run_bench(const char *name, u32 props, u32 mode)
+{
+	u32 run;
+	u64 best = 0;
+	nb_props = props;
+	write_mode = mode;
+	for (run=0; run<nb_runs; run++) {
+		u64 dur = run_chain();
+		if (!dur) return;
+		if (!best || (dur<best)) best = dur;
+	}
+	fprintf(stdout, "%-8s %2u props: best %8.3f ms - %10.0f packets/s\n", name, props, ((Double) best) / 1000, ((Double) nb_packets) * 1000000 / best);
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: pckpropbench [OPTS]\n"
+	        "Measures packets/s through a chain of pass-through filters carrying per-packet properties.\n"
+	        "Each pass-through filter either forwards packets (properties shared with the source packet) or references them and sets one property (property map copied on write).\n"
+	        "A run without packet properties is done first as a baseline.\n"
+	        "\n"
+	        "-n N:              number of packets to send (default 200000)\n"
+	        "-fwd N:            number of pass-through filters (default 5, max %d)\n"
+	        "-props N:          number of properties set on each source packet (default 4, max 99)\n"
+	        "-mode M:           pass-through mode, one of forward, write or both (default both)\n"
+	        "-runs N:           number of runs for each test (default 5)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	        , PB_MAX_FWD);
+}
+
+int main(int argc, char **argv)
+{
+	u32 i;
+	u32 props = 4;
+	char *logs = NULL;
+	Bool do_fwd = GF_TRUE, do_write = GF_TRUE;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-n")) nb_packets = atoi(val);
+		else if (!strcmp(arg, "-fwd")) nb_fwd = atoi(val);
+		else if (!strcmp(arg, "-props")) props = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-mode")) {
+			do_fwd = (!strcmp(val, "forward") || !strcmp(val, "both")) ? GF_TRUE : GF_FALSE;
+			do_write = (!strcmp(val, "write") || !strcmp(val, "both")) ? GF_TRUE : GF_FALSE;
+		}
+		else if (!strcmp(arg, "-logs")) logs = val;
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_runs || !nb_packets || (nb_fwd>PB_MAX_FWD) || (props>99) || (!do_fwd && !do_write)) {
+		PrintUsage();
+		return 1;
+	}
+
+	for (i=0; i<nb_fwd; i++) {
+		GF_FilterRegister *freg = &PBFwdRegisters[i];
+		sprintf(PBFwdNames[i], "pbfwd%u", i);
+		freg->name = PBFwdNames[i];
+		freg->private_size = sizeof(PBCtx);
+		freg->flags = GF_FS_REG_EXPLICIT_ONLY;
+		freg->caps = PBFwdCaps;
+		freg->nb_caps = sizeof(PBFwdCaps)/sizeof(GF_FilterCapability);
+		freg->configure_pid = pbfwd_configure_pid;
+		freg->process = pbfwd_process;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	if (logs) gf_log_set_tools_levels(logs, GF_FALSE);
+
+	fprintf(stdout, "Packet properties through %u pass-through filters - %u packets - %u runs\n", nb_fwd, nb_packets, nb_runs);
+	if (do_fwd) {
+		run_bench("forward", 0, 0);
+		run_bench("forward", props, 0);
+	}
+	if (do_write) {
+		run_bench("write", 0, 1);
+		run_bench("write", props, 1);
+	}
+
+	gf_sys_close();
+	return 0;
+}
@@ -0,0 +1,363 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - parallel range processing of a source in a single filter session
+ *
+ */
+
+#include <gpac/filters.h>
+
+#define PR_MAX_FILTERS	10
+
+static u32 nb_ranges = 4;
+static s32 nb_threads = -1;
+static u32 nb_filters = 0;
+static const char *filters[PR_MAX_FILTERS];
+static Bool keep_chunks = GF_FALSE;
+
+/*probe sink: collects SAP times of the first visual pid (or first pid if no visual) and counts its packets*/
+typedef struct
+{
+	GF_FilterPid *pid;
+	Bool is_visual;
+	u32 timescale;
+	u64 *saps;
+	u32 nb_saps, alloc_saps;
+	u32 nb_pck;
+	u64 end;
+} PRProbe;
+
+static PRProbe probe;
+
+static const GF_FilterCapability PRProbeCaps[] =
+{
+	CAP_UINT(GF_CAPS_INPUT_EXCLUDED, GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+};
+
+static GF_Err prprobe_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	GF_FilterEvent evt;
+	const GF_PropertyValue *p;
+	Bool is_visual;
+	if (is_remove) {
+		if (probe.pid == pid) probe.pid = NULL;
+		return GF_OK;
+	}
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_STREAM_TYPE);
+	is_visual = (p && (p->value.uint==GF_STREAM_VISUAL)) ? GF_TRUE : GF_FALSE;
+	if (!probe.pid || (is_visual && !probe.is_visual)) {
+		probe.pid = pid;
+		probe.is_visual = is_visual;
+		probe.nb_saps = probe.nb_pck = 0;
+		probe.end = 0;
+		p = gf_filter_pid_get_property(pid, GF_PROP_PID_TIMESCALE);
+		probe.timescale = p ? p->value.uint : 1000;
+	}
+	GF_FEVT_INIT(evt, GF_FEVT_PLAY, pid);
+	gf_filter_pid_send_event(pid, &evt);
+	return GF_OK;
+}
+
+static GF_Err prprobe_process(GF_Filter *filter)
+{
+	u32 i, nb_eos = 0, count = gf_filter_get_ipid_count(filter);
+	for (i=0; i<count; i++) {
+		GF_FilterPid *pid = gf_filter_get_ipid(filter, i);
+		while (1) {
+			u64 cts;
+			GF_FilterPacket *pck = gf_filter_pid_get_packet(pid);
+			if (!pck) {
+				if (gf_filter_pid_is_eos(pid)) nb_eos++;
+				break;
+			}
+			cts = gf_filter_pck_get_cts(pck);
+			if ((pid == probe.pid) && (cts != GF_FILTER_NO_TS)) {
+				probe.nb_pck++;
+				if (gf_filter_pck_get_sap(pck)) {
+					if (probe.nb_saps == probe.alloc_saps) {
+						probe.alloc_saps = probe.alloc_saps ? 2*probe.alloc_saps : 100;
+						probe.saps = gf_realloc(probe.saps, sizeof(u64) * probe.alloc_saps);
+						if (!probe.saps) return GF_OUT_OF_MEM;
+					}
+					probe.saps[probe.nb_saps++] = cts;
+				}
+				if (cts + gf_filter_pck_get_duration(pck) > probe.end)
+					probe.end = cts + gf_filter_pck_get_duration(pck);
+			}
+			gf_filter_pid_drop_packet(pid);
+		}
+	}
+	if (count && (nb_eos == count)) return GF_EOS;
+	return GF_OK;
+}
+
+static GF_FilterRegister PRProbeRegister = {
+	.name = "prprobe",
+	.private_size = sizeof(u32),
+	.max_extra_pids = (u32) -1,
+	.flags = GF_FS_REG_EXPLICIT_ONLY,
+	SETCAPS(PRProbeCaps),
+	.configure_pid = prprobe_configure_pid,
+	.process = prprobe_process,
+};
+
+static GF_Err probe_source(const char *src)
+{
+	GF_Err e = GF_OK;
+	GF_FilterSession *fs = gf_fs_new(0, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fs) return GF_OUT_OF_MEM;
+	gf_fs_add_filter_register(fs, &PRProbeRegister);
+
+	probe.pid = NULL;
+	probe.is_visual = GF_FALSE;
+	probe.nb_saps = probe.nb_pck = 0;
+	probe.end = 0;
+	gf_fs_load_source(fs, src, NULL, NULL, &e);
+	if (!e) gf_fs_load_filter(fs, "prprobe", &e);
+	if (!e) e = gf_fs_run(fs);
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	if (!e && !probe.nb_saps) e = GF_NON_COMPLIANT_BITSTREAM;
+	return e;
+}
+
+/*picks range start times on SAPs, the first SAP at or after each k*duration/nb_ranges target*/
+static u32 get_range_starts(u64 *starts)
+{
+	u32 i, k, nb_starts = 1;
+	u64 first = probe.saps[0];
+	starts[0] = first;
+	i = 1;
+	for (k=1; k<nb_ranges; k++) {
+		u64 target = first + (probe.end - first) * k / nb_ranges;
+		while ((i<probe.nb_saps) && (probe.saps[i] < target)) i++;
+		if (i==probe.nb_saps) break;
+		if (probe.saps[i] > starts[nb_starts-1])
+			starts[nb_starts++] = probe.saps[i];
+		i++;
+	}
+	return nb_starts;
+}
+
+static void get_chunk_name(char *szName, const char *dst, u32 idx)
+{
+	char *ext;
+	strcpy(szName, dst);
+	ext = gf_file_ext_start(szName);
+	if (ext) {
+		ext[0] = 0;
+		ext = gf_file_ext_start(dst);
+		sprintf(szName + strlen(szName), "_chunk%u%s", idx+1, ext);
+	} else {
+		sprintf(szName + strlen(szName), "_chunk%u", idx+1);
+	}
+}
+
+/*builds one source -> reframer -> filters -> chunk chain per range in a single session, chains are processed by the session threads*/
+static GF_Err run_ranges(const char *src, const char *dst, u64 *starts, u32 nb_starts)
+{
+	GF_Err e = GF_OK;
+	u32 i, j;
+	char szArgs[GF_MAX_PATH+200], szName[GF_MAX_PATH+20];
+	GF_FilterSession *fs;
+
+	fs = gf_fs_new((nb_threads<0) ? nb_starts-1 : nb_threads, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fs) return GF_OUT_OF_MEM;
+
+	for (i=0; i<nb_starts && !e; i++) {
+		sprintf(szArgs, "FID=PRS%u", i);
+		gf_fs_load_source(fs, src, szArgs, NULL, &e);
+		if (e) break;
+		//ranges start exactly on a SAP (xround=after so that the preceding SAP is not used)
+		sprintf(szArgs, "reframer:xs="LLU"/%u:FID=PRR%u:SID=PRS%u", starts[i], probe.timescale, i, i);
+		if (i)
+			strcat(szArgs, ":xround=after");
+		//reframer excludes a frame ending exactly at the range end, so end one tick after the next range SAP
+		if (i+1<nb_starts)
+			sprintf(szArgs + strlen(szArgs), ":xe="LLU"/%u", starts[i+1]+1, probe.timescale);
+		gf_fs_load_filter(fs, szArgs, &e);
+		if (e) break;
+		for (j=0; j<nb_filters; j++) {
+			if (j)
+				sprintf(szArgs, "%s:FID=PRF%u_%u:SID=PRF%u_%u", filters[j], i, j, i, j-1);
+			else
+				sprintf(szArgs, "%s:FID=PRF%u_%u:SID=PRR%u", filters[j], i, j, i);
+			gf_fs_load_filter(fs, szArgs, &e);
+			if (e) break;
+		}
+		if (e) break;
+		if (nb_filters)
+			sprintf(szArgs, "SID=PRF%u_%u", i, nb_filters-1);
+		else
+			sprintf(szArgs, "SID=PRR%u", i);
+		get_chunk_name(szName, dst, i);
+		gf_fs_load_destination(fs, szName, szArgs, NULL, &e);
+	}
+	if (!e) e = gf_fs_run(fs);
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	return e;
+}
+
+/*concatenates chunks in order using flist*/
+static GF_Err concat_chunks(const char *dst, u32 nb_starts)
+{
+	GF_Err e = GF_OK;
+	u32 i;
+	char *srcs = NULL;
+	char szName[GF_MAX_PATH+20];
+	GF_FilterSession *fs;
+
+	gf_dynstrcat(&srcs, "flist:srcs=", NULL);
+	for (i=0; i<nb_starts; i++) {
+		get_chunk_name(szName, dst, i);
+		gf_dynstrcat(&srcs, szName, i ? "," : NULL);
+	}
+	fs = gf_fs_new(0, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fs) {
+		gf_free(srcs);
+		return GF_OUT_OF_MEM;
+	}
+	gf_fs_load_filter(fs, srcs, &e);
+	gf_free(srcs);
+	if (!e) gf_fs_load_destination(fs, dst, NULL, NULL, &e);
+	if (!e) e = gf_fs_run(fs);
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	return e;
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: prange [OPTS] -i src -o dst\n"
+	        "Processes a source as several ranges concurrently in a single filter session and concatenates the result.\n"
+	        "The source is first probed for SAP (I-frame) times. It is then split into ranges starting on SAPs, and each range is processed\n"
+	        "by its own source, reframer, filters and output chain; all chains run in one session whose threads process them in parallel.\n"
+	        "The resulting chunks are finally concatenated in order using the flist filter.\n"
+	        "This is typically used to run several instances of a single-threaded encoder.\n"
+	        "\n"
+	        "-i src:            source to process\n"
+	        "-o dst:            final output. Chunks are written next to it as dst_chunkN.ext\n"
+	        "-n N:              number of ranges (default 4)\n"
+	        "-f filter:         filter to apply to each range, in order, e.g. -f ffenc:c=avc. Can be used %d times. If not set, ranges are only remuxed\n"
+	        "-threads N:        number of extra threads of the range session (default: one thread per range)\n"
+	        "-keep:             keep chunk files\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	        , PR_MAX_FILTERS);
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i, nb_starts=0, src_pck;
+	u64 now, t_probe, t_ranges, t_concat;
+	u64 *starts = NULL;
+	char *src = NULL;
+	char *dst = NULL;
+	char *logs = NULL;
+	char szName[GF_MAX_PATH+20];
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!strcmp(arg, "-keep")) {
+			keep_chunks = GF_TRUE;
+			continue;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) dst = val;
+		else if (!strcmp(arg, "-n")) nb_ranges = atoi(val);
+		else if (!strcmp(arg, "-threads")) nb_threads = atoi(val);
+		else if (!strcmp(arg, "-f") && (nb_filters<PR_MAX_FILTERS)) filters[nb_filters++] = val;
+		else if (!strcmp(arg, "-logs")) logs = val;
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!src || !dst || !nb_ranges) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	if (logs) gf_log_set_tools_levels(logs, GF_FALSE);
+
+	now = gf_sys_clock_high_res();
+	e = probe_source(src);
+	t_probe = gf_sys_clock_high_res() - now;
+	if (e) {
+		fprintf(stderr, "Failed to probe %s: %s\n", src, gf_error_to_string(e));
+		goto exit;
+	}
+	src_pck = probe.nb_pck;
+	starts = gf_malloc(sizeof(u64) * nb_ranges);
+	nb_starts = get_range_starts(starts);
+	fprintf(stdout, "Source: %u %s frames, %u SAPs - %u ranges\n", src_pck, probe.is_visual ? "video" : "media", probe.nb_saps, nb_starts);
+	for (i=0; i<nb_starts; i++) {
+		fprintf(stdout, "range %u: start %.3f s\n", i+1, ((Double) starts[i]) / probe.timescale);
+	}
+
+	now = gf_sys_clock_high_res();
+	e = run_ranges(src, dst, starts, nb_starts);
+	t_ranges = gf_sys_clock_high_res() - now;
+	if (e) {
+		fprintf(stderr, "Failed to process ranges: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+
+	now = gf_sys_clock_high_res();
+	e = concat_chunks(dst, nb_starts);
+	t_concat = gf_sys_clock_high_res() - now;
+	if (e) {
+		fprintf(stderr, "Failed to concatenate chunks: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+
+	fprintf(stdout, "probe %.3f ms - ranges %.3f ms - concatenation %.3f ms\n", ((Double) t_probe) / 1000, ((Double) t_ranges) / 1000, ((Double) t_concat) / 1000);
+
+	//check all frames are present once in output
+	e = probe_source(dst);
+	if (e) {
+		fprintf(stderr, "Failed to probe output %s: %s\n", dst, gf_error_to_string(e));
+		goto exit;
+	}
+	if (probe.nb_pck != src_pck) {
+		fprintf(stderr, "Output has %u frames, %u in source\n", probe.nb_pck, src_pck);
+		e = GF_CORRUPTED_DATA;
+	} else {
+		fprintf(stdout, "Output: %u frames\n", probe.nb_pck);
+	}
+
+exit:
+	if (starts && !keep_chunks) {
+		for (i=0; i<nb_starts; i++) {
+			get_chunk_name(szName, dst, i);
+			gf_file_delete(szName);
+		}
+	}
+	if (starts) gf_free(starts);
+	if (probe.saps) gf_free(probe.saps);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
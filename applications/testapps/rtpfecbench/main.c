@@ -0,0 +1,451 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - RTP reordering and SMPTE 2022-1 FEC recovery benchmark
+ *
+ */
+
+#include <gpac/network.h>
+#include <gpac/internal/ietf_dev.h>
+
+static u32 nb_pck = 50000;
+static u32 fec_l = 10;
+static u32 fec_d = 10;
+static u32 reorder_pck = 200;
+static u32 reorder_delay = 100;
+static u32 burst = 1;
+static u32 pps = 5000;
+static Double loss_rate = 1.0;
+static Double reorder_rate = 0.5;
+static u32 seed = 1;
+
+//TS packets per RTP packet, as usually done for M2TS over RTP
+#define TS_PER_RTP		7
+#define PAYLOAD_SIZE	(188*TS_PER_RTP)
+#define RTP_SIZE		(12+PAYLOAD_SIZE)
+#define FEC_SIZE		(12+16+PAYLOAD_SIZE)
+#define RTP_SSRC		0x47504143
+
+//packet sent on the channel: media packet index or FEC packet
+typedef struct
+{
+	u8 data[FEC_SIZE];
+	u32 size;
+	//0: media, 1: column FEC, 2: row FEC
+	u32 type;
+} BenchPacket;
+
+typedef struct
+{
+	u32 nb_sent, nb_dropped, nb_fec_sent, nb_fec_dropped;
+	u32 nb_out, nb_corrupted;
+	u32 next_out;
+	u64 time;
+} BenchStats;
+
+static const u8 *src_data = NULL;
+static u32 src_nb_ts = 0;
+static u32 rnd_state = 1;
+
+static u32 bench_rand()
+{
+	rnd_state = rnd_state * 1103515245 + 12345;
+	return (rnd_state >> 8) & 0xFFFFFF;
+}
+
+static Bool bench_hit(Double percent)
+{
+	return (bench_rand() < (u32) (percent * 0x1000000 / 100)) ? GF_TRUE : GF_FALSE;
+}
+
+static void write_u32(u8 *p, u32 v)
+{
+	p[0] = (v>>24) & 0xFF;
+	p[1] = (v>>16) & 0xFF;
+	p[2] = (v>>8) & 0xFF;
+	p[3] = v & 0xFF;
+}
+
+//media packets are generated from their index, so that output can be checked without keeping them
+static void build_media(u8 *pck, u32 idx)
+{
+	u32 k;
+	pck[0] = 0x80;
+	pck[1] = 33;
+	pck[2] = (idx>>8) & 0xFF;
+	pck[3] = idx & 0xFF;
+	write_u32(pck+4, idx * 90);
+	write_u32(pck+8, RTP_SSRC);
+	for (k=0; k<TS_PER_RTP; k++) {
+		u8 *ts = pck + 12 + 188*k;
+		u32 ts_idx = idx*TS_PER_RTP + k;
+		if (src_data) {
+			memcpy(ts, src_data + 188 * (ts_idx % src_nb_ts), 188);
+		} else {
+			u32 i, v = ts_idx * 2654435761U;
+			ts[0] = 0x47;
+			ts[1] = 0x01;
+			ts[2] = 0x00;
+			ts[3] = 0x10 | (ts_idx & 0xF);
+			for (i=4; i<188; i++) {
+				v = v * 1664525 + 1013904223;
+				ts[i] = v >> 24;
+			}
+		}
+	}
+}
+
+//builds a SMPTE 2022-1 XOR FEC packet protecting NA packets starting at base_idx, spaced by offset
+static void build_fec(BenchPacket *bp, u32 fec_seq, u32 base_idx, u32 offset, u32 na, Bool is_row)
+{
+	u32 k, i, len_rec=0, pt_rec=0, ts_rec=0;
+	u8 media[RTP_SIZE];
+	u8 *pck = bp->data;
+	u8 *fh = pck + 12;
+
+	memset(pck, 0, FEC_SIZE);
+	pck[0] = 0x80;
+	pck[1] = 96;
+	pck[2] = (fec_seq>>8) & 0xFF;
+	pck[3] = fec_seq & 0xFF;
+	write_u32(pck+8, RTP_SSRC+1);
+
+	for (k=0; k<na; k++) {
+		build_media(media, base_idx + k*offset);
+		len_rec ^= PAYLOAD_SIZE;
+		pt_rec ^= media[1] & 0x7F;
+		ts_rec ^= ((u32) media[4]<<24) | ((u32) media[5]<<16) | ((u32) media[6]<<8) | media[7];
+		for (i=0; i<PAYLOAD_SIZE; i++)
+			fh[16+i] ^= media[12+i];
+	}
+	fh[0] = (base_idx>>8) & 0xFF;
+	fh[1] = base_idx & 0xFF;
+	fh[2] = (len_rec>>8) & 0xFF;
+	fh[3] = len_rec & 0xFF;
+	fh[4] = 0x80 | pt_rec;
+	write_u32(fh+8, ts_rec);
+	//D bit: 0 for columns, 1 for rows - type 0 (XOR)
+	fh[12] = is_row ? 0x40 : 0;
+	fh[13] = offset;
+	fh[14] = na;
+	bp->size = FEC_SIZE;
+	bp->type = is_row ? 2 : 1;
+}
+
+//generates the packets of one LxD matrix as received after loss and reordering
+static u32 build_block(BenchPacket *pcks, u32 base_idx, u32 nb_media, Bool with_fec, u32 *fec_seq, BenchStats *st, u32 *burst_left)
+{
+	u32 i, j, nb=0;
+	for (i=0; i<nb_media; i++) {
+		BenchPacket *bp = &pcks[nb];
+		build_media(bp->data, base_idx+i);
+		bp->size = RTP_SIZE;
+		bp->type = 0;
+		st->nb_sent++;
+		if (*burst_left || bench_hit(loss_rate)) {
+			if (! *burst_left) *burst_left = burst;
+			(*burst_left)--;
+			st->nb_dropped++;
+		} else {
+			nb++;
+		}
+		//row FEC sent after each row
+		if (with_fec && (nb_media == fec_l*fec_d) && ((i+1) % fec_l == 0)) {
+			build_fec(&pcks[nb], (*fec_seq)++, base_idx + i + 1 - fec_l, 1, fec_l, GF_TRUE);
+			st->nb_fec_sent++;
+			if (bench_hit(loss_rate)) st->nb_fec_dropped++;
+			else nb++;
+		}
+	}
+	//column FEC sent after the matrix
+	if (with_fec && (nb_media == fec_l*fec_d)) {
+		for (j=0; j<fec_l; j++) {
+			build_fec(&pcks[nb], (*fec_seq)++, base_idx + j, fec_l, fec_d, GF_FALSE);
+			st->nb_fec_sent++;
+			if (bench_hit(loss_rate)) st->nb_fec_dropped++;
+			else nb++;
+		}
+	}
+	//swap adjacent packets
+	for (i=0; i+1<nb; i++) {
+		if (bench_hit(reorder_rate)) {
+			BenchPacket tmp;
+			memcpy(&tmp, &pcks[i], sizeof(BenchPacket));
+			memcpy(&pcks[i], &pcks[i+1], sizeof(BenchPacket));
+			memcpy(&pcks[i+1], &tmp, sizeof(BenchPacket));
+			i++;
+		}
+	}
+	return nb;
+}
+
+static void check_output(BenchStats *st, const u8 *pck, u32 size, u8 *ref)
+{
+	u32 idx;
+	//get packet index from sequence number, output is in increasing order
+	u16 diff = (u16) ((((u32) pck[2]<<8) | pck[3]) - st->next_out);
+	idx = st->next_out + diff;
+	st->next_out = idx+1;
+	st->nb_out++;
+	build_media(ref, idx);
+	if ((size != RTP_SIZE) || memcmp(pck+12, ref+12, PAYLOAD_SIZE) || memcmp(pck+4, ref+4, 8) || ((pck[1]&0x7F) != 33))
+		st->nb_corrupted++;
+}
+
+static void run_reorder(Bool with_fec)
+{
+	u32 i, nb_blocks, block_size, fec_seq=0, burst_left=0;
+	u8 ref[RTP_SIZE];
+	u8 *outs;
+	u32 nb_outs, max_outs;
+	u32 *out_sizes;
+	BenchStats st;
+	BenchPacket *pcks;
+	GF_RTPReorder *po;
+
+	memset(&st, 0, sizeof(BenchStats));
+	rnd_state = seed;
+	po = gf_rtp_reorderer_new(reorder_pck, reorder_delay);
+	if (!po) {
+		fprintf(stderr, "Failed to create reorderer\n");
+		return;
+	}
+	if (with_fec) gf_rtp_reorderer_enable_fec(po);
+
+	block_size = fec_l*fec_d;
+	nb_blocks = (nb_pck + block_size - 1) / block_size;
+	pcks = gf_malloc(sizeof(BenchPacket) * (block_size + fec_l + fec_d));
+	//output copies, as done when dispatching to filter packets
+	max_outs = 2*reorder_pck + block_size;
+	outs = gf_malloc(RTP_SIZE * max_outs);
+	out_sizes = gf_malloc(sizeof(u32) * max_outs);
+
+	for (i=0; i<nb_blocks; i++) {
+		u32 j, nb;
+		u64 now;
+		nb = build_block(pcks, i*block_size, MIN(block_size, nb_pck - i*block_size), with_fec, &fec_seq, &st, &burst_left);
+
+		nb_outs = 0;
+		now = gf_sys_clock_high_res();
+		for (j=0; j<nb; j++) {
+			BenchPacket *bp = &pcks[j];
+			if (bp->type) {
+				gf_rtp_reorderer_add_fec(po, bp->data, bp->size);
+			} else {
+				gf_rtp_reorderer_add(po, bp->data, bp->size, ((u32) bp->data[2]<<8) | bp->data[3]);
+			}
+			while (nb_outs<max_outs) {
+				u32 size;
+				u8 *pck = gf_rtp_reorderer_get(po, &size, (i+1==nb_blocks) && (j+1==nb));
+				if (!pck) break;
+				memcpy(outs + RTP_SIZE*nb_outs, pck, MIN(size, RTP_SIZE));
+				out_sizes[nb_outs] = size;
+				nb_outs++;
+			}
+		}
+		st.time += gf_sys_clock_high_res() - now;
+
+		for (j=0; j<nb_outs; j++)
+			check_output(&st, outs + RTP_SIZE*j, out_sizes[j], ref);
+	}
+	//flush
+	while (1) {
+		u32 size;
+		u8 *pck = gf_rtp_reorderer_get(po, &size, GF_TRUE);
+		if (!pck) break;
+		memcpy(outs, pck, MIN(size, RTP_SIZE));
+		check_output(&st, outs, size, ref);
+	}
+
+	fprintf(stdout, "%-10s sent %u (%u dropped) FEC %u (%u dropped) - output %u (%u corrupted) - lost %u recovered %u dup %u late %u - %.3f ms (FEC %.3f ms) %.1f ns/pck\n",
+		with_fec ? "FEC" : "no FEC",
+		st.nb_sent, st.nb_dropped, st.nb_fec_sent, st.nb_fec_dropped,
+		st.nb_out, st.nb_corrupted,
+		po->nb_lost, po->nb_recovered, po->nb_dup, po->nb_late,
+		((Double) st.time) / 1000, ((Double) po->fec_time) / 1000,
+		((Double) st.time) * 1000 / (st.nb_sent - st.nb_dropped + st.nb_fec_sent - st.nb_fec_dropped)
+	);
+
+	gf_free(outs);
+	gf_free(out_sizes);
+	gf_free(pcks);
+	gf_rtp_reorderer_del(po);
+}
+
+//acts as a lossy sender for the sockin filter, media on port, column FEC on port+2 and row FEC on port+4
+static void run_send(const char *dst)
+{
+	u32 i, nb_blocks, block_size, fec_seq=0, burst_left=0, nb_done=0;
+	u16 port = 1234;
+	char host[GF_MAX_IP_NAME_LEN];
+	char *sep;
+	u64 start;
+	GF_Socket *socks[3];
+	BenchStats st;
+	BenchPacket *pcks;
+
+	memset(&st, 0, sizeof(BenchStats));
+	rnd_state = seed;
+	if (strnicmp(dst, "udp://", 6)) {
+		fprintf(stderr, "Destination must be udp://host:port\n");
+		return;
+	}
+	strncpy(host, dst+6, GF_MAX_IP_NAME_LEN-1);
+	host[GF_MAX_IP_NAME_LEN-1] = 0;
+	sep = strrchr(host, ':');
+	if (sep) {
+		port = atoi(sep+1);
+		sep[0] = 0;
+	}
+	for (i=0; i<3; i++) {
+		GF_Err e = GF_IO_ERR;
+		socks[i] = gf_sk_new(GF_SOCK_TYPE_UDP);
+		if (socks[i]) {
+			//same setup as sockout
+			if (gf_sk_is_multicast_address(host))
+				e = gf_sk_setup_multicast(socks[i], host, port + 2*i, 1, 0, NULL);
+			else
+				e = gf_sk_bind(socks[i], NULL, port + 2*i, host, port + 2*i, GF_SOCK_REUSE_PORT | GF_SOCK_FAKE_BIND);
+		}
+		if (e) {
+			if (socks[i]) gf_sk_del(socks[i]);
+			fprintf(stderr, "Failed to setup socket for %s:%d\n", host, port + 2*i);
+			while (i) {
+				i--;
+				gf_sk_del(socks[i]);
+			}
+			return;
+		}
+	}
+
+	block_size = fec_l*fec_d;
+	nb_blocks = (nb_pck + block_size - 1) / block_size;
+	pcks = gf_malloc(sizeof(BenchPacket) * (block_size + fec_l + fec_d));
+	start = gf_sys_clock_high_res();
+	for (i=0; i<nb_blocks; i++) {
+		u32 j, nb;
+		nb = build_block(pcks, i*block_size, MIN(block_size, nb_pck - i*block_size), GF_TRUE, &fec_seq, &st, &burst_left);
+		for (j=0; j<nb; j++) {
+			//pace output
+			while ((u64) nb_done * 1000000 > (gf_sys_clock_high_res() - start) * pps)
+				gf_sleep(1);
+			gf_sk_send(socks[pcks[j].type], pcks[j].data, pcks[j].size);
+			nb_done++;
+		}
+	}
+	fprintf(stdout, "Sent %u media packets (%u dropped) and %u FEC packets (%u dropped) to %s:%d in %u ms\n", st.nb_sent, st.nb_dropped, st.nb_fec_sent, st.nb_fec_dropped, host, port, (u32) ((gf_sys_clock_high_res() - start)/1000));
+
+	gf_free(pcks);
+	for (i=0; i<3; i++) gf_sk_del(socks[i]);
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: rtpfecbench [OPTS]\n"
+	        "Generates MPEG-2 TS over RTP packets with SMPTE 2022-1 LxD column and row FEC, applies random loss and reordering\n"
+	        "and measures packet recovery and CPU cost of the RTP reorderer, with and without FEC.\n"
+	        "With -send, packets are sent over UDP instead (media on port, column FEC on port+2, row FEC on port+4), e.g. for\n"
+	        "gpac -i udp://127.0.0.1:1234/:fec:reorder_pck=200:reorder_delay=100 -o dump.ts\n"
+	        "\n"
+	        "-i file.ts:        use TS packets from file instead of synthetic ones\n"
+	        "-n N:              number of media packets (default 50000)\n"
+	        "-L N:              FEC matrix columns (default 10)\n"
+	        "-D N:              FEC matrix rows (default 10)\n"
+	        "-loss F:           percentage of packets lost (default 1.0)\n"
+	        "-burst N:          number of consecutive media packets lost per loss event (default 1)\n"
+	        "-reorder F:        percentage of swapped adjacent packets (default 0.5)\n"
+	        "-pck N:            reorderer max packets (default 200)\n"
+	        "-delay N:          reorderer max delay in ms (default 100)\n"
+	        "-seed N:           random seed (default 1)\n"
+	        "-send udp://H:P:   send packets to the given destination\n"
+	        "-pps N:            packets per second in send mode (default 5000)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i;
+	char *src = NULL;
+	char *dst = NULL;
+	u8 *data = NULL;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-n")) nb_pck = atoi(val);
+		else if (!strcmp(arg, "-L")) fec_l = atoi(val);
+		else if (!strcmp(arg, "-D")) fec_d = atoi(val);
+		else if (!strcmp(arg, "-loss")) loss_rate = atof(val);
+		else if (!strcmp(arg, "-burst")) burst = atoi(val);
+		else if (!strcmp(arg, "-reorder")) reorder_rate = atof(val);
+		else if (!strcmp(arg, "-pck")) reorder_pck = atoi(val);
+		else if (!strcmp(arg, "-delay")) reorder_delay = atoi(val);
+		else if (!strcmp(arg, "-seed")) seed = atoi(val);
+		else if (!strcmp(arg, "-send")) dst = val;
+		else if (!strcmp(arg, "-pps")) pps = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	//2022-1 limits
+	if (!nb_pck || !burst || !pps || (fec_l<1) || (fec_l>20) || (fec_d<4) || (fec_d>20) || (fec_l*fec_d>100)) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	if (src) {
+		u32 size;
+		FILE *f = gf_fopen(src, "rb");
+		if (!f) {
+			fprintf(stderr, "Failed to open %s\n", src);
+			gf_sys_close();
+			return 1;
+		}
+		size = (u32) gf_fsize(f);
+		data = gf_malloc(size);
+		if (data) size = (u32) gf_fread(data, size, f);
+		gf_fclose(f);
+		if (!data || (size<188) || (data[0] != 0x47)) {
+			fprintf(stderr, "%s is not a transport stream of 188 bytes packets\n", src);
+			if (data) gf_free(data);
+			gf_sys_close();
+			return 1;
+		}
+		src_data = data;
+		src_nb_ts = size / 188;
+		//send the file once
+		if (dst) nb_pck = (src_nb_ts + TS_PER_RTP - 1) / TS_PER_RTP;
+	}
+
+	if (dst) {
+		run_send(dst);
+	} else {
+		fprintf(stdout, "%u packets - FEC %ux%u - loss %.2f%% (burst %u) - reorder %.2f%% - reorderer %u packets %u ms\n", nb_pck, fec_l, fec_d, loss_rate, burst, reorder_rate, reorder_pck, reorder_delay);
+		run_reorder(GF_FALSE);
+		run_reorder(GF_TRUE);
+	}
+
+	if (data) gf_free(data);
+	gf_sys_close();
+	return 0;
+}
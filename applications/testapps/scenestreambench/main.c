@@ -0,0 +1,266 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - scene streaming encoder benchmark
+ *
+ */
+
+#include <gpac/scene_manager.h>
+
+#if !defined(WIN32) && !defined(_WIN32_WCE)
+#include <sys/resource.h>
+#endif
+
+static u32 nb_runs = 3;
+
+typedef struct
+{
+	u64 best, total;
+	u32 nb;
+} BenchTime;
+
+static void bench_add(BenchTime *t, u64 us)
+{
+	if (!t->nb || (us < t->best)) t->best = us;
+	t->total += us;
+	t->nb++;
+}
+
+static void bench_print(const char *name, BenchTime *t)
+{
+	if (!t->nb) return;
+	fprintf(stdout, "%-28s best %9.3f ms - average %9.3f ms\n", name, ((Double) t->best) / 1000, ((Double) t->total) / t->nb / 1000);
+}
+
+//peak resident memory of the process in kB, 0 if unknown
+static u64 get_peak_mem()
+{
+#if !defined(WIN32) && !defined(_WIN32_WCE)
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru)) return 0;
+#if defined(__APPLE__)
+	return ru.ru_maxrss / 1024;
+#else
+	return ru.ru_maxrss;
+#endif
+#else
+	return 0;
+#endif
+}
+
+static u32 get_file_size_kb(const char *name)
+{
+	u64 size;
+	FILE *f = gf_fopen(name, "rb");
+	if (!f) return 0;
+	size = gf_fsize(f);
+	gf_fclose(f);
+	return (u32) (size/1024);
+}
+
+//generates a ticker / subtitle command stream: one text update per second, a node inserted every 10s and removed 5s later
+static GF_Err gen_scene(const char *dst, u32 duration)
+{
+	u32 i;
+	FILE *bt = gf_fopen(dst, "wt");
+	if (!bt) return GF_IO_ERR;
+
+	fprintf(bt, "InitialObjectDescriptor {\n objectDescriptorID 1\n audioProfileLevelIndication 255\n visualProfileLevelIndication 254\n"
+	        " sceneProfileLevelIndication 1\n graphicsProfileLevelIndication 1\n ODProfileLevelIndication 1\n"
+	        " esDescr [\n  ES_Descriptor {\n   ES_ID 1\n   decConfigDescr DecoderConfigDescriptor {\n    streamType 3\n"
+	        "    decSpecificInfo BIFSConfig {\n     isCommandStream true\n     pixelMetric true\n     pixelWidth 640\n     pixelHeight 360\n"
+	        "     nodeIDbits %u\n     routeIDbits 1\n    }\n   }\n  }\n ]\n}\n\n", gf_get_bit_size(duration/10 + 3));
+
+	fprintf(bt, "OrderedGroup {\n children [\n  Background2D { backColor 0 0 0 }\n  Transform2D {\n   translation 0 -140\n   children [\n"
+	        "    Shape {\n     appearance Appearance { material Material2D { emissiveColor 1 1 1 filled TRUE } }\n"
+	        "     geometry DEF TXT Text { string [\"\"] fontStyle FontStyle { justify [\"MIDDLE\" \"MIDDLE\"] size 20 } }\n"
+	        "    }\n   ]\n  }\n  DEF G Group { children [] }\n ]\n}\n\n");
+
+	for (i=1; i<=duration; i++) {
+		fprintf(bt, "AT %u {\n  REPLACE TXT.string BY [\"subtitle line %u for this benchmark\", \"second line %u with some more text\"]\n", i*1000, i, i);
+		if (!(i%10)) {
+			fprintf(bt, "  APPEND TO G.children DEF N%u Transform2D {\n   translation %d 100\n   children [ Shape { appearance Appearance { material Material2D { emissiveColor 1 0 0 filled TRUE } } geometry Rectangle { size 40 20 } } ]\n  }\n", i/10, (s32) (i%300) - 150);
+		} else if ((i%10)==5 && (i>10)) {
+			fprintf(bt, "  DELETE N%u\n", (i-5)/10);
+		}
+		fprintf(bt, "}\n");
+	}
+	gf_fclose(bt);
+	return GF_OK;
+}
+
+static GF_Err encode_scene(const char *src, const char *dst, u32 au_window, u64 *load_time, u64 *enc_time)
+{
+	GF_Err e;
+	u64 now;
+	GF_SceneLoader load;
+	GF_SceneManager *ctx;
+	GF_SceneGraph *sg;
+	GF_ISOFile *mp4;
+
+	*load_time = *enc_time = 0;
+	mp4 = gf_isom_open(dst, GF_ISOM_WRITE_EDIT, NULL);
+	if (!mp4) return gf_isom_last_error(NULL);
+
+	sg = gf_sg_new();
+	ctx = gf_sm_new(sg);
+	memset(&load, 0, sizeof(GF_SceneLoader));
+	load.fileName = src;
+	load.ctx = ctx;
+	load.flags = GF_SM_LOAD_MPEG4_STRICT;
+	load.au_window = au_window;
+
+	now = gf_sys_clock_high_res();
+	e = gf_sm_load_init(&load);
+	if (!e) {
+		if (au_window) {
+			//load and encode are interleaved, only the total is meaningful
+			e = gf_sm_encode_to_file_streaming(&load, mp4, NULL);
+			*enc_time = gf_sys_clock_high_res() - now;
+		} else {
+			e = gf_sm_load_run(&load);
+			*load_time = gf_sys_clock_high_res() - now;
+			now = gf_sys_clock_high_res();
+			if (!e) e = gf_sm_encode_to_file(ctx, mp4, NULL);
+			*enc_time = gf_sys_clock_high_res() - now;
+		}
+	}
+	gf_sm_load_done(&load);
+	gf_sm_del(ctx);
+	gf_sg_del(sg);
+	if (e) {
+		gf_isom_delete(mp4);
+		return e;
+	}
+	return gf_isom_close(mp4);
+}
+
+static void run_encode(const char *src, const char *dst, u32 au_window)
+{
+	u32 run;
+	char szName[100];
+	BenchTime t_load, t_enc;
+	memset(&t_load, 0, sizeof(BenchTime));
+	memset(&t_enc, 0, sizeof(BenchTime));
+
+	for (run=0; run<nb_runs; run++) {
+		u64 load_time, enc_time;
+		GF_Err e = encode_scene(src, dst, au_window, &load_time, &enc_time);
+		if (e) {
+			fprintf(stderr, "Failed to encode %s: %s\n", src, gf_error_to_string(e));
+			return;
+		}
+		if (!au_window) bench_add(&t_load, load_time);
+		bench_add(&t_enc, load_time + enc_time);
+	}
+	if (au_window) {
+		sprintf(szName, "stream (window %u) total", au_window);
+	} else {
+		bench_print("full load", &t_load);
+		strcpy(szName, "full load+encode");
+	}
+	bench_print(szName, &t_enc);
+	fprintf(stdout, "%-28s output %9u kB - peak memory %9u kB\n", "", get_file_size_kb(dst), (u32) get_peak_mem());
+}
+
+static void on_progress(const void *cbk, const char *title, u64 done, u64 total)
+{
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: scenestreambench [OPTS]\n"
+	        "Compares loading then encoding a complete BT/XMT-A scene with streaming load and encode by chunks of access units.\n"
+	        "If no source is given, a BT ticker / subtitle command stream is generated.\n"
+	        "Peak memory is the peak resident size of the process: since the streaming test runs first, the full load peak only includes the streaming one if it is larger.\n"
+	        "\n"
+	        "-i src:            BT or XMT-A source to encode\n"
+	        "-o dst:            output file (default scenestream.mp4, deleted at the end)\n"
+	        "-dur N:            duration in seconds of the generated scene (default 14400)\n"
+	        "-win N:            number of access units per chunk in streaming mode (default 128)\n"
+	        "-mode M:           test to run, one of stream, full or both (default both)\n"
+	        "-runs N:           number of runs for each test (default 3)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i;
+	u32 duration = 14400;
+	u32 au_window = 128;
+	Bool do_full = GF_TRUE, do_stream = GF_TRUE;
+	Bool gen_src = GF_FALSE, del_dst = GF_FALSE;
+	char *src = NULL;
+	char *dst = NULL;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) dst = val;
+		else if (!strcmp(arg, "-dur")) duration = atoi(val);
+		else if (!strcmp(arg, "-win")) au_window = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else if (!strcmp(arg, "-mode")) {
+			if (!strcmp(val, "full")) do_stream = GF_FALSE;
+			else if (!strcmp(val, "stream")) do_full = GF_FALSE;
+			else if (strcmp(val, "both")) {
+				PrintUsage();
+				return 1;
+			}
+		}
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_runs || !au_window || (!src && !duration)) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	gf_set_progress_callback(NULL, on_progress);
+
+	if (!dst) {
+		dst = "scenestream.mp4";
+		del_dst = GF_TRUE;
+	}
+	if (!src) {
+		GF_Err e;
+		src = "scenestream.bt";
+		gen_src = GF_TRUE;
+		e = gen_scene(src, duration);
+		if (e) {
+			fprintf(stderr, "Failed to generate scene: %s\n", gf_error_to_string(e));
+			gf_sys_close();
+			return 1;
+		}
+		fprintf(stdout, "Generated %u access units scene - %u kB\n", duration, get_file_size_kb(src));
+	}
+
+	fprintf(stdout, "Scene encoding - %u runs - base memory %u kB\n", nb_runs, (u32) get_peak_mem());
+	if (do_stream) run_encode(src, dst, au_window);
+	if (do_full) run_encode(src, dst, 0);
+
+	if (gen_src) gf_file_delete(src);
+	if (del_dst) gf_file_delete(dst);
+	gf_sys_close();
+	return 0;
+}
@@ -0,0 +1,561 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - HEVC tile split/merge/aggregation benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+#include <gpac/bitstream.h>
+#include <gpac/media_tools.h>
+
+/*synthetic stream parameters*/
+static u32 width = 1920;
+static u32 height = 1080;
+static u32 nb_cols = 3;
+static u32 nb_rows = 3;
+static u32 nb_frames = 250;
+static u32 gop_size = 25;
+static u32 tile_size = 2000;
+static u32 nb_runs = 3;
+
+/*CTB size is 64 for all generated streams*/
+#define BENCH_CTB_SIZE	64
+
+static u32 rand_state = 0x12345678;
+
+static u64 get_file_size(const char *name)
+{
+	u64 size;
+	FILE *f = gf_fopen(name, "rb");
+	if (!f) return 0;
+	size = gf_fsize(f);
+	gf_fclose(f);
+	return size;
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: tilebench [OPTS]\n"
+	        "Measures HEVC tile split (hevcsplit), split+merge (hevcsplit+hevcmerge) and tile aggregation (tileagg) rates.\n"
+	        "A synthetic tiled HEVC stream is generated unless -i is set. Slice data of the synthetic stream is random, only\n"
+	        "parameter sets and slice headers are valid, which is enough for these filters since they never decode slice data.\n"
+	        "Parameter sets rewritten by hevcsplit and hevcmerge are also checked not to be followed by trailing zero bytes.\n"
+	        "\n"
+	        "-i file.hvc:       use given tiled HEVC stream instead of a synthetic one\n"
+	        "-o file.hvc:       write the synthetic stream to file and exit\n"
+	        "-size WxH:         size of synthetic stream (default 1920x1080)\n"
+	        "-tiles CxR:        tile grid of synthetic stream (default 3x3)\n"
+	        "-frames N:         number of frames of synthetic stream (default 250)\n"
+	        "-gop N:            IDR period in frames of synthetic stream (default 25)\n"
+	        "-tsize N:          slice payload size in bytes per tile and frame of synthetic stream (default 2000)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 3)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+static void bs_write_ue(GF_BitStream *bs, u32 val)
+{
+	u32 nb_bits = 0;
+	u32 v = val + 1;
+	while (v >> nb_bits) nb_bits++;
+	gf_bs_write_int(bs, 0, nb_bits - 1);
+	gf_bs_write_int(bs, v, nb_bits);
+}
+
+static void bs_write_se(GF_BitStream *bs, s32 val)
+{
+	if (val > 0) bs_write_ue(bs, 2*val - 1);
+	else bs_write_ue(bs, -2*val);
+}
+
+static void write_nal_header(GF_BitStream *bs, u32 nal_type)
+{
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, nal_type, 6);
+	gf_bs_write_int(bs, 0, 6);
+	gf_bs_write_int(bs, 1, 3);
+}
+
+static void write_ptl(GF_BitStream *bs)
+{
+	//main profile, level 5.1
+	gf_bs_write_int(bs, 0, 2);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 1, 5);
+	gf_bs_write_int(bs, 0x60000000, 32);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_long_int(bs, 0, 44);
+	gf_bs_write_int(bs, 153, 8);
+}
+
+static void write_trailing_bits(GF_BitStream *bs)
+{
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_align(bs);
+}
+
+/*flush bitstream content as an annexB NAL, optionally followed by raw payload, and reset the bitstream*/
+static GF_BitStream *write_nal(FILE *out, GF_BitStream *bs, u8 *payload, u32 payload_size)
+{
+	u8 *data = NULL, *epb;
+	u32 i, size, epb_size, nb_zeros;
+	static const u8 start_code[4] = {0, 0, 0, 1};
+
+	gf_bs_get_content(bs, &data, &size);
+	gf_bs_del(bs);
+	data = gf_realloc(data, size + payload_size);
+	if (payload_size) memcpy(data + size, payload, payload_size);
+	size += payload_size;
+
+	//insert emulation prevention bytes
+	epb = gf_malloc(size + size/2 + 1);
+	epb_size = nb_zeros = 0;
+	for (i=0; i<size; i++) {
+		if ((nb_zeros==2) && (data[i]<0x04)) {
+			epb[epb_size++] = 0x03;
+			nb_zeros = 0;
+		}
+		epb[epb_size++] = data[i];
+		if (!data[i]) nb_zeros++;
+		else nb_zeros = 0;
+	}
+	gf_fwrite(start_code, 4, out);
+	gf_fwrite(epb, epb_size, out);
+	gf_free(epb);
+	gf_free(data);
+	return gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
+}
+
+static u32 get_bit_size(u32 val)
+{
+	u32 nb_bits = 0;
+	while (val > (u32) (1 << nb_bits)) nb_bits++;
+	return nb_bits;
+}
+
+static GF_Err generate_stream(const char *dst)
+{
+	u32 i, f, c, r, pic_w_ctb, pic_h_ctb, addr_bits;
+	u8 *payload;
+	GF_BitStream *bs;
+	FILE *out = gf_fopen(dst, "wb");
+	if (!out) {
+		fprintf(stderr, "Cannot create %s\n", dst);
+		return GF_IO_ERR;
+	}
+	pic_w_ctb = (width + BENCH_CTB_SIZE - 1) / BENCH_CTB_SIZE;
+	pic_h_ctb = (height + BENCH_CTB_SIZE - 1) / BENCH_CTB_SIZE;
+	addr_bits = get_bit_size(pic_w_ctb * pic_h_ctb);
+
+	bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
+
+	//VPS
+	write_nal_header(bs, GF_HEVC_NALU_VID_PARAM);
+	gf_bs_write_int(bs, 0, 4);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 0, 6);
+	gf_bs_write_int(bs, 0, 3);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 0xFFFF, 16);
+	write_ptl(bs);
+	gf_bs_write_int(bs, 1, 1);
+	bs_write_ue(bs, 1);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 0);
+	gf_bs_write_int(bs, 0, 6);
+	bs_write_ue(bs, 0);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	write_trailing_bits(bs);
+	bs = write_nal(out, bs, NULL, 0);
+
+	//SPS: 4:2:0 8 bits, 64x64 CTBs, single short term RPS referencing the previous picture
+	write_nal_header(bs, GF_HEVC_NALU_SEQ_PARAM);
+	gf_bs_write_int(bs, 0, 4);
+	gf_bs_write_int(bs, 0, 3);
+	gf_bs_write_int(bs, 1, 1);
+	write_ptl(bs);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 1);
+	bs_write_ue(bs, width);
+	bs_write_ue(bs, height);
+	gf_bs_write_int(bs, 0, 1);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 4);
+	gf_bs_write_int(bs, 1, 1);
+	bs_write_ue(bs, 1);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 3);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 3);
+	bs_write_ue(bs, 1);
+	bs_write_ue(bs, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	bs_write_ue(bs, 1);
+	bs_write_ue(bs, 1);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 0);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	write_trailing_bits(bs);
+	bs = write_nal(out, bs, NULL, 0);
+
+	//PPS: uniform tile grid, no loop filter across tiles
+	write_nal_header(bs, GF_HEVC_NALU_PIC_PARAM);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 0);
+	gf_bs_write_int(bs, 0, 7);
+	bs_write_ue(bs, 0);
+	bs_write_ue(bs, 0);
+	bs_write_se(bs, 0);
+	gf_bs_write_int(bs, 0, 3);
+	bs_write_se(bs, 0);
+	bs_write_se(bs, 0);
+	gf_bs_write_int(bs, 0, 4);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 0, 1);
+	bs_write_ue(bs, nb_cols - 1);
+	bs_write_ue(bs, nb_rows - 1);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	bs_write_ue(bs, 0);
+	gf_bs_write_int(bs, 0, 1);
+	gf_bs_write_int(bs, 0, 1);
+	write_trailing_bits(bs);
+	bs = write_nal(out, bs, NULL, 0);
+
+	payload = gf_malloc(tile_size);
+	for (f=0; f<nb_frames; f++) {
+		Bool is_idr = (f % gop_size) ? GF_FALSE : GF_TRUE;
+		for (r=0; r<nb_rows; r++) {
+			for (c=0; c<nb_cols; c++) {
+				u32 tile_idx = r*nb_cols + c;
+				u32 addr = (r * pic_h_ctb / nb_rows) * pic_w_ctb + (c * pic_w_ctb / nb_cols);
+
+							write_nal_header(bs, is_idr ? GF_HEVC_NALU_SLICE_IDR_N_LP : GF_HEVC_NALU_SLICE_TRAIL_R);
+				gf_bs_write_int(bs, tile_idx ? 0 : 1, 1);
+				if (is_idr) gf_bs_write_int(bs, 0, 1);
+				bs_write_ue(bs, 0);
+				if (tile_idx) gf_bs_write_int(bs, addr, addr_bits);
+				//slice_type, I (2) or P (1)
+				bs_write_ue(bs, is_idr ? 2 : 1);
+				if (!is_idr) {
+					gf_bs_write_int(bs, (f % gop_size) & 0xFF, 8);
+					//short_term_ref_pic_set_sps_flag
+					gf_bs_write_int(bs, 1, 1);
+					//num_ref_idx_active_override_flag
+					gf_bs_write_int(bs, 0, 1);
+					//five_minus_max_num_merge_cand
+					bs_write_ue(bs, 0);
+				}
+				bs_write_se(bs, (s32) (tile_idx % 5) - 2);
+				//slice_loop_filter_across_slices_enabled_flag
+				gf_bs_write_int(bs, 0, 1);
+				//num_entry_point_offsets
+				bs_write_ue(bs, 0);
+				write_trailing_bits(bs);
+
+				for (i=0; i<tile_size; i++) {
+					rand_state = rand_state * 1103515245 + 12345;
+					payload[i] = (u8) (rand_state >> 16);
+				}
+				payload[tile_size-1] = 0x80;
+				bs = write_nal(out, bs, payload, tile_size);
+			}
+		}
+	}
+	gf_free(payload);
+	gf_bs_del(bs);
+	gf_fclose(out);
+	return GF_OK;
+}
+
+/*runs a session with the given source, filter chain and optional destination*/
+static GF_Err run_session(const char *src, const char **chain, const char *dst, u64 *duration)
+{
+	GF_Err e;
+	u32 i;
+	u64 start;
+	GF_FilterSession *fs;
+
+	start = gf_sys_clock_high_res();
+	fs = gf_fs_new_defaults(0);
+	if (!fs) return GF_OUT_OF_MEM;
+
+	gf_fs_load_source(fs, src, NULL, NULL, &e);
+	for (i=0; chain[i] && !e; i++) {
+		gf_fs_load_filter(fs, chain[i], &e);
+	}
+	if (dst && !e) gf_fs_load_destination(fs, dst, NULL, NULL, &e);
+	if (!e) e = gf_fs_run(fs);
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	*duration = gf_sys_clock_high_res() - start;
+	return e;
+}
+
+static GF_Err run_test(const char *name, const char *src, const char **chain, u32 nb_slices, u64 file_size, u64 ref_time)
+{
+	u32 i;
+	u64 best = 0;
+	Double sec;
+	for (i=0; i<nb_runs; i++) {
+		u64 dur;
+		GF_Err e = run_session(src, chain, NULL, &dur);
+		if (e) {
+			fprintf(stderr, "%s failed: %s\n", name, gf_error_to_string(e));
+			return e;
+		}
+		if (!best || (dur<best)) best = dur;
+	}
+	sec = ((Double) best) / 1000000;
+	fprintf(stdout, "%-12s %9.2f ms %9.2f fps %10.2f slices/s %8.2f MB/s", name, sec*1000, nb_frames / sec, nb_slices / sec, file_size / sec / 1000000);
+	//report time spent in the tested filters, removing time of the reference (parsing only) session
+	if (ref_time && (best>ref_time)) {
+		sec = ((Double) (best - ref_time)) / 1000000;
+		fprintf(stdout, " - filter only %9.2f ms %10.2f slices/s", sec*1000, nb_slices / sec);
+	}
+	fprintf(stdout, "\n");
+	return GF_OK;
+}
+
+/*checks rewritten VPS/SPS/PPS of an Annex B file end with their rbsp_stop_one_bit, ie are not followed by extra zero bytes
+the generated stream parameter sets contain emulation prevention bytes*/
+static GF_Err check_param_sets(const char *name)
+{
+	u32 i, size, nal_start=0, nb_ps=0;
+	u8 *data;
+	GF_Err e = gf_file_load_data(name, &data, &size);
+	if (e) return e;
+
+	for (i=0; i<=size; i++) {
+		u32 nal_type;
+		//a NAL ends at the next start code or at the end of the file
+		if ((i<size) && ((i+4>size) || data[i] || data[i+1] || data[i+2] || (data[i+3]!=1)))
+			continue;
+		if (nal_start && (i>nal_start)) {
+			nal_type = (data[nal_start]>>1) & 0x3F;
+			if ((nal_type>=GF_HEVC_NALU_VID_PARAM) && (nal_type<=GF_HEVC_NALU_PIC_PARAM)) {
+				nb_ps++;
+				if (!data[i-1]) {
+					fprintf(stderr, "Parameter set type %u at offset %u in %s has trailing zero bytes\n", nal_type, nal_start, name);
+					e = GF_NON_COMPLIANT_BITSTREAM;
+					break;
+				}
+			}
+		}
+		nal_start = i+4;
+		i += 3;
+	}
+	gf_free(data);
+	if (!e && !nb_ps) {
+		fprintf(stderr, "No parameter set found in %s\n", name);
+		e = GF_NON_COMPLIANT_BITSTREAM;
+	}
+	return e;
+}
+
+static void on_progress(const void *cbk, const char *title, u64 done, u64 total)
+{
+}
+
+static GF_Err make_tiled_mp4(const char *src, const char *dst)
+{
+	GF_Err e;
+	u64 dur;
+	GF_ISOFile *file;
+	const char *chain[1];
+	char szMux[GF_MAX_PATH+10];
+
+	//mux to an intermediate file, edit mode cannot rewrite its own source
+	sprintf(szMux, "%s_mux.mp4", dst);
+	chain[0] = NULL;
+	e = run_session(src, chain, szMux, &dur);
+	if (e) return e;
+
+	file = gf_isom_open(szMux, GF_ISOM_OPEN_EDIT, NULL);
+	if (!file) {
+		e = gf_isom_last_error(NULL);
+	} else {
+		e = gf_media_split_hevc_tiles(file, 0);
+		if (!e) e = gf_isom_set_final_name(file, (char *) dst);
+		if (e) gf_isom_delete(file);
+		else e = gf_isom_close(file);
+	}
+	gf_file_delete(szMux);
+	return e;
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i, nb_slices;
+	u64 file_size, ref_time;
+	Bool gen_only = GF_FALSE;
+	char *src = NULL;
+	char *dst = NULL;
+	char szSrc[GF_MAX_PATH], szMP4[GF_MAX_PATH];
+	const char *chain[4];
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-o")) {
+			dst = val;
+			gen_only = GF_TRUE;
+		}
+		else if (!strcmp(arg, "-size")) sscanf(val, "%ux%u", &width, &height);
+		else if (!strcmp(arg, "-tiles")) sscanf(val, "%ux%u", &nb_cols, &nb_rows);
+		else if (!strcmp(arg, "-frames")) nb_frames = atoi(val);
+		else if (!strcmp(arg, "-gop")) gop_size = atoi(val);
+		else if (!strcmp(arg, "-tsize")) tile_size = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_cols || !nb_rows || !nb_frames || !gop_size || !tile_size || !nb_runs || (width % 8) || (height % 8)) {
+		fprintf(stderr, "Invalid parameters, size must be a multiple of 8\n");
+		return 1;
+	}
+	if ((nb_cols * BENCH_CTB_SIZE > width) || (nb_rows * BENCH_CTB_SIZE > height)) {
+		fprintf(stderr, "Too many tiles for the frame size\n");
+		return 1;
+	}
+
+	e = gf_sys_init(GF_MemTrackerNone, NULL);
+	if (e) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	gf_set_progress_callback(NULL, on_progress);
+
+	if (gen_only) {
+		e = generate_stream(dst);
+		gf_sys_close();
+		return e ? 1 : 0;
+	}
+
+	if (!src) {
+		sprintf(szSrc, "tilebench_%ux%u_%ux%u.hvc", width, height, nb_cols, nb_rows);
+		e = generate_stream(szSrc);
+		if (e) goto exit;
+		src = szSrc;
+	} else {
+		szSrc[0] = 0;
+	}
+	sprintf(szMP4, "tilebench_%ux%u_%ux%u.mp4", width, height, nb_cols, nb_rows);
+
+	file_size = get_file_size(src);
+	nb_slices = nb_frames * nb_cols * nb_rows;
+	fprintf(stdout, "Source %s: %u frames, %ux%u tiles, "LLU" bytes - best of %u runs\n", src, nb_frames, nb_cols, nb_rows, file_size, nb_runs);
+
+	//reference: parsing only
+	chain[0] = "inspect:log=null";
+	chain[1] = NULL;
+	e = run_test("parse", src, chain, nb_slices, file_size, 0);
+	if (e) goto exit;
+	ref_time = 0;
+	{
+		u64 dur;
+		for (i=0; i<nb_runs; i++) {
+			run_session(src, chain, NULL, &dur);
+			if (!ref_time || (dur<ref_time)) ref_time = dur;
+		}
+	}
+
+	//split
+	chain[0] = "hevcsplit:FID=1";
+	chain[1] = "inspect:log=null:SID=1";
+	chain[2] = NULL;
+	e = run_test("split", src, chain, nb_slices, file_size, ref_time);
+	if (e) goto exit;
+
+	//split and merge back
+	chain[0] = "hevcsplit:FID=1";
+	chain[1] = "hevcmerge:FID=2:SID=1";
+	chain[2] = "inspect:log=null:SID=2";
+	chain[3] = NULL;
+	e = run_test("split+merge", src, chain, nb_slices, file_size, ref_time);
+	if (e) goto exit;
+
+	//check rewritten parameter sets
+	chain[0] = "hevcsplit:FID=1";
+	chain[1] = NULL;
+	e = run_session(src, chain, "tilebench_check.hvc:SID=1", &ref_time);
+	if (!e) e = check_param_sets("tilebench_check.hvc");
+	if (!e) {
+		chain[1] = "hevcmerge:FID=2:SID=1";
+		chain[2] = NULL;
+		e = run_session(src, chain, "tilebench_check.hvc:SID=2", &ref_time);
+		if (!e) e = check_param_sets("tilebench_check.hvc");
+	}
+	gf_file_delete("tilebench_check.hvc");
+	if (e) {
+		fprintf(stderr, "Parameter set check failed: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+	fprintf(stdout, "Parameter sets check OK\n");
+
+	//aggregation of tile tracks
+	e = make_tiled_mp4(src, szMP4);
+	if (e) {
+		fprintf(stderr, "Failed to create tiled MP4: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+	chain[0] = "inspect:log=null";
+	chain[1] = NULL;
+	e = run_session(szMP4, chain, NULL, &ref_time);
+	if (!e) {
+		u64 dur;
+		for (i=1; i<nb_runs; i++) {
+			run_session(szMP4, chain, NULL, &dur);
+			if (dur<ref_time) ref_time = dur;
+		}
+		chain[0] = "tileagg:FID=1";
+		chain[1] = "inspect:log=null:SID=1";
+		chain[2] = NULL;
+		e = run_test("aggregate", szMP4, chain, nb_slices, get_file_size(szMP4), ref_time);
+	}
+
+exit:
+	if (szSrc[0]) gf_file_delete(szSrc);
+	gf_file_delete(szMP4);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
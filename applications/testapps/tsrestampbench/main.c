@@ -0,0 +1,349 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - MPEG-2 TS header scan, restamping and splitting benchmark
+ *
+ */
+
+#include <gpac/mpegts.h>
+
+static u32 nb_runs = 5;
+static u32 chunk_size = 188*1000;
+static s64 ts_shift = 90000*3600;
+
+#define MAX_INFOS	1024
+
+typedef struct
+{
+	u8 *data;
+	u32 size, pck_size;
+} TSBuffer;
+
+typedef struct
+{
+	//copy mode: output buffer of the program
+	u8 *buf;
+	u32 pos;
+	//zero-copy mode: pending run in current chunk
+	const u8 *run_start;
+	u32 run_size;
+} BenchProgram;
+
+typedef struct
+{
+	Bool zc;
+	const u8 *chunk;
+	u32 chunk_size;
+	u64 nb_pck, nb_out;
+	GF_List *progs;
+} SplitCtx;
+
+static Double get_gbps(u32 size, u64 us)
+{
+	if (!us) return 0;
+	return ((Double) size) * 8 / us / 1000;
+}
+
+//per-packet header parsing as done by the TS demultiplexer, for reference
+static u32 scan_reference(const u8 *data, u32 size, u32 pck_size)
+{
+	GF_M2TS_PacketInfo infos[MAX_INFOS];
+	u32 pos = (pck_size==192) ? 4 : 0;
+	u32 nb = 0, nb_infos = 0;
+	while (pos + 188 <= size) {
+		const u8 *p = data + pos;
+		u32 af;
+		if (p[0] != 0x47) break;
+		af = (p[3] >> 4) & 0x3;
+		if ((p[1] & 0x40) || (af & 2)) {
+			GF_M2TS_PacketInfo *info = &infos[nb_infos];
+			info->offset = pos;
+			info->pid = ((p[1] & 0x1f) << 8) | p[2];
+			info->af_len = (af & 2) ? p[4] : 0;
+			info->flags = 0;
+			if (p[1] & 0x40) info->flags |= GF_M2TS_SCAN_PUSI;
+			if (af & 2) info->flags |= GF_M2TS_SCAN_AF;
+			if (af & 1) info->flags |= GF_M2TS_SCAN_PAYLOAD;
+			if ((af & 2) && (p[4] >= 7) && (p[5] & 0x10)) info->flags |= GF_M2TS_SCAN_PCR;
+			nb++;
+			nb_infos++;
+			if (nb_infos == MAX_INFOS) nb_infos = 0;
+		}
+		pos += pck_size;
+	}
+	return nb;
+}
+
+static u32 scan_all(const u8 *data, u32 size, u32 pck_size, Bool all_packets)
+{
+	GF_M2TS_PacketInfo infos[MAX_INFOS];
+	u32 pos = 0, nb = 0;
+	while (pos + pck_size <= size) {
+		u32 nb_infos;
+		u32 done = gf_m2ts_scan_packets(data + pos, size - pos, pck_size, all_packets, infos, MAX_INFOS, &nb_infos);
+		nb += nb_infos;
+		if (!done) break;
+		pos += done;
+	}
+	return nb;
+}
+
+static void run_scan(TSBuffer *buf)
+{
+	u32 mode, run, nb=0;
+	const char *names[] = {"per-packet reference", "scan PUSI/AF packets", "scan all packets"};
+
+	for (mode=0; mode<3; mode++) {
+		u64 best = 0;
+		for (run=0; run<nb_runs; run++) {
+			u64 now = gf_sys_clock_high_res();
+			if (!mode) nb = scan_reference(buf->data, buf->size, buf->pck_size);
+			else nb = scan_all(buf->data, buf->size, buf->pck_size, (mode==2) ? GF_TRUE : GF_FALSE);
+			now = gf_sys_clock_high_res() - now;
+			if (!best || (now < best)) best = now;
+		}
+		fprintf(stdout, "%-28s %9.2f ms %8.2f Gbit/s - %u packets reported\n", names[mode], ((Double) best) / 1000, get_gbps(buf->size, best), nb);
+	}
+}
+
+static void run_restamp(TSBuffer *buf)
+{
+	u32 i, run, pos=0, nb_pes_pids=0;
+	u64 best = 0;
+	u8 *work;
+	Bool ok = GF_TRUE;
+	u8 is_pes[GF_M2TS_MAX_STREAMS];
+	GF_M2TS_PacketInfo infos[MAX_INFOS];
+
+	if (buf->pck_size != 188) {
+		fprintf(stdout, "restamp: only supported for 188 bytes packets\n");
+		return;
+	}
+	//PES PIDs are the ones with a payload unit starting with a start code
+	memset(is_pes, 0, sizeof(u8)*GF_M2TS_MAX_STREAMS);
+	while (pos + 188 <= buf->size) {
+		u32 nb_infos;
+		u32 done = gf_m2ts_scan_packets(buf->data + pos, buf->size - pos, 188, GF_FALSE, infos, MAX_INFOS, &nb_infos);
+		for (i=0; i<nb_infos; i++) {
+			u8 *p = buf->data + pos + infos[i].offset;
+			u32 offset = 4;
+			if (!(infos[i].flags & GF_M2TS_SCAN_PUSI) || !(infos[i].flags & GF_M2TS_SCAN_PAYLOAD)) continue;
+			if (infos[i].flags & GF_M2TS_SCAN_AF) offset += 1 + infos[i].af_len;
+			if (offset + 3 > 188) continue;
+			if (!p[offset] && !p[offset+1] && (p[offset+2]==1) && !is_pes[infos[i].pid]) {
+				is_pes[infos[i].pid] = 1;
+				nb_pes_pids++;
+			}
+		}
+		if (!done) break;
+		pos += done;
+	}
+
+	work = gf_malloc(buf->size);
+	for (run=0; run<nb_runs; run++) {
+		u64 now;
+		GF_Err e;
+		memcpy(work, buf->data, buf->size);
+		now = gf_sys_clock_high_res();
+		e = gf_m2ts_restamp(work, buf->size, ts_shift, is_pes);
+		now = gf_sys_clock_high_res() - now;
+		if (e) {
+			fprintf(stdout, "restamp failed: %s\n", gf_error_to_string(e));
+			ok = GF_FALSE;
+			break;
+		}
+		if (!best || (now < best)) best = now;
+		//check shifting back gives the source data
+		if (!run) {
+			gf_m2ts_restamp(work, buf->size, -ts_shift, is_pes);
+			if (memcmp(work, buf->data, buf->size)) ok = GF_FALSE;
+		}
+	}
+	gf_free(work);
+	fprintf(stdout, "%-28s %9.2f ms %8.2f Gbit/s - %u PES PIDs, round trip %s\n", "restamp", ((Double) best) / 1000, get_gbps(buf->size, best), nb_pes_pids, ok ? "OK" : "FAILED");
+}
+
+static void split_flush_run(SplitCtx *ctx, BenchProgram *prog)
+{
+	if (!prog->run_size) return;
+	//a reference packet would be sent here
+	ctx->nb_out++;
+	prog->run_start = NULL;
+	prog->run_size = 0;
+}
+
+static void split_on_event(GF_M2TS_Demuxer *ts, u32 evt_type, void *par)
+{
+	GF_M2TS_TSPCK *tspck = (GF_M2TS_TSPCK *) par;
+	SplitCtx *ctx = (SplitCtx *) ts->user;
+	BenchProgram *prog;
+	u32 size = ts->prefix_present ? 192 : 188;
+	const u8 *data;
+
+	if (evt_type != GF_M2TS_EVT_PCK) return;
+	if (!tspck->stream || !tspck->stream->program) return;
+	ctx->nb_pck++;
+
+	prog = tspck->stream->program->user;
+	if (!prog) {
+		GF_SAFEALLOC(prog, BenchProgram);
+		if (!prog) return;
+		prog->buf = gf_malloc(188*1000);
+		tspck->stream->program->user = prog;
+		gf_list_add(ctx->progs, prog);
+	}
+	data = ts->prefix_present ? tspck->data - 4 : tspck->data;
+
+	if (ctx->zc && (data >= ctx->chunk) && (data + size <= ctx->chunk + ctx->chunk_size)) {
+		if (prog->run_size && (prog->run_start + prog->run_size == data)) {
+			prog->run_size += size;
+			return;
+		}
+		split_flush_run(ctx, prog);
+		prog->run_start = data;
+		prog->run_size = size;
+		return;
+	}
+	//copy mode, packed by 1000 packets
+	if (prog->pos + size > 188*1000) {
+		prog->pos = 0;
+		ctx->nb_out++;
+	}
+	memcpy(prog->buf + prog->pos, data, size);
+	prog->pos += size;
+}
+
+static void run_split(TSBuffer *buf, Bool zc)
+{
+	u32 i, run;
+	u64 best = 0;
+	SplitCtx ctx;
+
+	memset(&ctx, 0, sizeof(SplitCtx));
+	ctx.zc = zc;
+	ctx.progs = gf_list_new();
+	for (run=0; run<nb_runs; run++) {
+		u64 now;
+		u32 pos = 0;
+		GF_M2TS_Demuxer *ts = gf_m2ts_demux_new();
+		ts->on_event = split_on_event;
+		ts->split_mode = GF_TRUE;
+		ts->user = &ctx;
+		ctx.nb_pck = ctx.nb_out = 0;
+
+		now = gf_sys_clock_high_res();
+		while (pos < buf->size) {
+			u32 size = buf->size - pos;
+			if (size > chunk_size) size = chunk_size;
+			ctx.chunk = buf->data + pos;
+			ctx.chunk_size = size;
+			gf_m2ts_process_data(ts, buf->data + pos, size);
+			for (i=0; i<gf_list_count(ctx.progs); i++) {
+				split_flush_run(&ctx, gf_list_get(ctx.progs, i));
+			}
+			pos += size;
+		}
+		now = gf_sys_clock_high_res() - now;
+		if (!best || (now < best)) best = now;
+		gf_m2ts_demux_del(ts);
+
+		while (gf_list_count(ctx.progs)) {
+			BenchProgram *prog = gf_list_pop_back(ctx.progs);
+			gf_free(prog->buf);
+			gf_free(prog);
+		}
+	}
+	gf_list_del(ctx.progs);
+	fprintf(stdout, "%-28s %9.2f ms %8.2f Gbit/s - "LLU" packets in "LLU" output packets\n", zc ? "split zero-copy" : "split copy", ((Double) best) / 1000, get_gbps(buf->size, best), ctx.nb_pck, ctx.nb_out);
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: tsrestampbench -i file.ts [OPTS]\n"
+	        "Measures throughput of MPEG-2 TS packet header scanning, timestamp shifting and program splitting on a file loaded in memory.\n"
+	        "Restamping is checked by shifting the data back and comparing with the source.\n"
+	        "Split tests run the demultiplexer in split mode and either copy packets per program or track runs of packets\n"
+	        "of a program in each input chunk, as done by tssplit in zero-copy mode.\n"
+	        "\n"
+	        "-i file.ts:        source transport stream\n"
+	        "-shift N:          timestamp shift in 90 kHz units (default 324000000, one hour)\n"
+	        "-chunk N:          size of data chunks given to the demultiplexer in split tests (default 188000)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 5)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+int main(int argc, char **argv)
+{
+	u32 i;
+	char *src = NULL;
+	FILE *f;
+	TSBuffer buf;
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-i")) src = val;
+		else if (!strcmp(arg, "-shift")) sscanf(val, LLD, &ts_shift);
+		else if (!strcmp(arg, "-chunk")) chunk_size = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!src || !chunk_size || !nb_runs) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (gf_sys_init(GF_MemTrackerNone, NULL)) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	memset(&buf, 0, sizeof(TSBuffer));
+	f = gf_fopen(src, "rb");
+	if (!f) {
+		fprintf(stderr, "Failed to open %s\n", src);
+		gf_sys_close();
+		return 1;
+	}
+	buf.size = (u32) gf_fsize(f);
+	buf.data = gf_malloc(buf.size);
+	if (buf.data) buf.size = (u32) gf_fread(buf.data, buf.size, f);
+	gf_fclose(f);
+
+	if (buf.data && (buf.size > 2*192) && (buf.data[0]==0x47) && (buf.data[188]==0x47)) buf.pck_size = 188;
+	else if (buf.data && (buf.size > 2*192) && (buf.data[4]==0x47) && (buf.data[196]==0x47)) buf.pck_size = 192;
+	if (!buf.pck_size) {
+		fprintf(stderr, "%s is not a transport stream starting with a sync byte\n", src);
+		if (buf.data) gf_free(buf.data);
+		gf_sys_close();
+		return 1;
+	}
+	//only keep complete packets
+	buf.size -= buf.size % buf.pck_size;
+
+	fprintf(stdout, "Source %s: %u bytes, %u packets of %u bytes - best of %u runs\n", src, buf.size, buf.size / buf.pck_size, buf.pck_size, nb_runs);
+	run_scan(&buf);
+	run_restamp(&buf);
+	run_split(&buf, GF_FALSE);
+	run_split(&buf, GF_TRUE);
+
+	gf_free(buf.data);
+	gf_sys_close();
+	return 0;
+}
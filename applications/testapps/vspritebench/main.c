@@ -0,0 +1,204 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - thumbnail sprite sheet generation benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+
+/*synthetic source parameters*/
+static u32 width = 320;
+static u32 height = 180;
+static u32 nb_frames = 500;
+static u32 grid_x = 5;
+static u32 grid_y = 5;
+static u32 nb_chains = 4;
+static u32 nb_runs = 3;
+
+static u64 get_file_size(const char *name)
+{
+	u64 size;
+	FILE *f = gf_fopen(name, "rb");
+	if (!f) return 0;
+	size = gf_fsize(f);
+	gf_fclose(f);
+	return size;
+}
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: vspritebench [OPTS]\n"
+	        "Measures sprite sheet generation rates of the vsprite filter, alone and followed by the PNG encoder.\n"
+	        "A synthetic raw RGB source is generated and every frame is kept in the sprites. The encoding test is also run\n"
+	        "with several source/vsprite/encoder chains in a single multi-threaded session, one thread per chain.\n"
+	        "\n"
+	        "-o file.rgb:       write the synthetic source and exit\n"
+	        "-size WxH:         frame size of synthetic source (default 320x180)\n"
+	        "-frames N:         number of frames of synthetic source (default 500)\n"
+	        "-grid CxR:         sprite grid (default 5x5)\n"
+	        "-chains N:         number of parallel chains for the multi-threaded test (default 4)\n"
+	        "-runs N:           number of runs for each test, the best run is reported (default 3)\n"
+	        "-logs log_args:    sets log tools and levels, formatted as a ':'-separated list of toolX[:toolZ]@levelX\n"
+	       );
+}
+
+static GF_Err generate_source(const char *name)
+{
+	u32 i, j;
+	u8 *frame;
+	FILE *f = gf_fopen(name, "wb");
+	if (!f) return GF_IO_ERR;
+	frame = gf_malloc(width * height * 3);
+	if (!frame) {
+		gf_fclose(f);
+		return GF_OUT_OF_MEM;
+	}
+	for (i=0; i<nb_frames; i++) {
+		//moving gradient, so that encoded sprites are not trivially compressible
+		for (j=0; j<width*height*3; j++) {
+			frame[j] = (u8) (j/3 + (j/(width*3)) + i*7);
+		}
+		if (gf_fwrite(frame, width * height * 3, f) != width * height * 3) break;
+	}
+	gf_free(frame);
+	gf_fclose(f);
+	return (i==nb_frames) ? GF_OK : GF_IO_ERR;
+}
+
+/*runs nb_src chains source -> vsprite [-> encoder] -> null inspect in a session with one thread per chain*/
+static GF_Err run_session(const char *src, const char *enc, u32 nb_src, u64 *duration)
+{
+	GF_Err e = GF_OK;
+	u32 i;
+	u64 start;
+	char szArgs[GF_MAX_PATH+100];
+	GF_FilterSession *fs;
+
+	start = gf_sys_clock_high_res();
+	fs = gf_fs_new(nb_src-1, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fs) return GF_OUT_OF_MEM;
+
+	for (i=0; i<nb_src && !e; i++) {
+		sprintf(szArgs, "%s:size=%ux%u:spfmt=rgb:fps=25:FID=S%u", src, width, height, i);
+		gf_fs_load_source(fs, szArgs, NULL, NULL, &e);
+		if (e) break;
+		sprintf(szArgs, "vsprite:grid=%ux%u:step=0:FID=V%u:SID=S%u", grid_x, grid_y, i, i);
+		gf_fs_load_filter(fs, szArgs, &e);
+		if (e) break;
+		if (enc) {
+			sprintf(szArgs, "%s:FID=E%u:SID=V%u", enc, i, i);
+			gf_fs_load_filter(fs, szArgs, &e);
+			if (e) break;
+			sprintf(szArgs, "inspect:log=null:SID=E%u", i);
+		} else {
+			sprintf(szArgs, "inspect:log=null:SID=V%u", i);
+		}
+		gf_fs_load_filter(fs, szArgs, &e);
+	}
+	if (!e) e = gf_fs_run(fs);
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	*duration = gf_sys_clock_high_res() - start;
+	return e;
+}
+
+static GF_Err run_test(const char *name, const char *src, const char *enc, u32 nb_src)
+{
+	u32 i, nb_sprites;
+	u64 best = 0;
+	Double sec;
+	for (i=0; i<nb_runs; i++) {
+		u64 dur;
+		GF_Err e = run_session(src, enc, nb_src, &dur);
+		if (e) {
+			fprintf(stderr, "%s failed: %s\n", name, gf_error_to_string(e));
+			return e;
+		}
+		if (!best || (dur<best)) best = dur;
+	}
+	nb_sprites = nb_src * ((nb_frames + grid_x*grid_y - 1) / (grid_x*grid_y));
+	sec = ((Double) best) / 1000000;
+	fprintf(stdout, "%-16s %9.2f ms %9.2f sprites/s %10.2f frames/s\n", name, sec*1000, nb_sprites / sec, nb_src * nb_frames / sec);
+	return GF_OK;
+}
+
+static void on_progress(const void *cbk, const char *title, u64 done, u64 total)
+{
+}
+
+int main(int argc, char **argv)
+{
+	GF_Err e;
+	u32 i;
+	char *dst = NULL;
+	char szSrc[GF_MAX_PATH], szName[50];
+
+	for (i=1; i<(u32) argc; i++) {
+		char *arg = argv[i];
+		char *val = (i+1<(u32) argc) ? argv[i+1] : NULL;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "-help")) {
+			PrintUsage();
+			return 0;
+		}
+		if (!val) {
+			PrintUsage();
+			return 1;
+		}
+		i++;
+		if (!strcmp(arg, "-o")) dst = val;
+		else if (!strcmp(arg, "-size")) sscanf(val, "%ux%u", &width, &height);
+		else if (!strcmp(arg, "-frames")) nb_frames = atoi(val);
+		else if (!strcmp(arg, "-grid")) sscanf(val, "%ux%u", &grid_x, &grid_y);
+		else if (!strcmp(arg, "-chains")) nb_chains = atoi(val);
+		else if (!strcmp(arg, "-runs")) nb_runs = atoi(val);
+		else if (!strcmp(arg, "-logs")) gf_log_set_tools_levels(val, GF_FALSE);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!width || !height || !nb_frames || !grid_x || !grid_y || !nb_chains || !nb_runs) {
+		PrintUsage();
+		return 1;
+	}
+
+	e = gf_sys_init(GF_MemTrackerNone, NULL);
+	if (e) return 1;
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+	gf_set_progress_callback(NULL, on_progress);
+
+	if (dst) {
+		e = generate_source(dst);
+		gf_sys_close();
+		return e ? 1 : 0;
+	}
+
+	sprintf(szSrc, "vspritebench_%ux%u.rgb", width, height);
+	e = generate_source(szSrc);
+	if (e) {
+		fprintf(stderr, "Failed to generate source: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+	fprintf(stdout, "Source %ux%u RGB: %u frames, "LLU" bytes - %ux%u sprites - best of %u runs\n", width, height, nb_frames, get_file_size(szSrc), grid_x, grid_y, nb_runs);
+
+	e = run_test("vsprite", szSrc, NULL, 1);
+	if (e) goto exit;
+	e = run_test("vsprite+png", szSrc, "pngenc", 1);
+	if (e) goto exit;
+	if (nb_chains>1) {
+		sprintf(szName, "vsprite+png x%u", nb_chains);
+		e = run_test(szName, szSrc, "pngenc", nb_chains);
+	}
+
+exit:
+	gf_file_delete(szSrc);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
@@ -251,6 +251,7 @@ LOCAL_SRC_FILES := \
 	../../../../src/filters/unit_test_filter.c \
 	../../../../src/filters/vcrop.c \
 	../../../../src/filters/vflip.c \
+	../../../../src/filters/vsprite.c \
 	../../../../src/filters/write_generic.c \
 	../../../../src/filters/write_nhml.c \
 	../../../../src/filters/write_nhnt.c \
@@ -406,6 +407,7 @@ LOCAL_SRC_FILES := \
 	../../../../src/utils/path2d.c \
 	../../../../src/utils/path2d_stroker.c \
 	../../../../src/utils/sha1.c \
+	../../../../src/utils/sha256.c \
 	../../../../src/utils/token.c \
 	../../../../src/utils/uni_bidi.c \
 	../../../../src/utils/unicode.c \
@@ -571,6 +571,16 @@ Returns the size of the associated buffer/file.
  */
 GF_Err gf_bs_transfer(GF_BitStream *dst, GF_BitStream *src, Bool keep_src);
 
+/*!
+\brief copy bits from source bitstream to destination bitstream
+
+Copies bits from the current position of the source bitstream to the current position of the destination bitstream. None of the bitstreams need to be byte-aligned; bytes are copied at once rather than bit by bit whenever possible.
+\param dst the target bitstream. If NULL, the bits are skipped in the source bitstream
+\param src the source bitstream, in read mode
+\param nbBits the number of bits to copy
+ */
+void gf_bs_copy_bits(GF_BitStream *dst, GF_BitStream *src, u64 nbBits);
+
 
 /*!
 \brief Flushes bitstream content to disk
@@ -218,6 +218,67 @@ Delete all cached files in given directory starting with startpattern
  */
 GF_Err gf_cache_delete_all_cached_files(const char * directory);
 
+/*! cache index object*/
+typedef struct __gf_cache_index GF_CacheIndex;
+
+/*!
+Creates an index of the cached files in a directory, scanning the directory once. The index tracks the size of each data and info file pair, in least recently used order, and is then updated by the cache entries attached to it
+\param directory the cache directory
+\return the new cache index, or NULL if error
+ */
+GF_CacheIndex *gf_cache_index_new(const char *directory);
+
+/*!
+Destroys a cache index. Files are not deleted
+\param index the cache index
+ */
+void gf_cache_index_del(GF_CacheIndex *index);
+
+/*!
+Gets the total size of the indexed files
+\param index the cache index
+\return size in bytes
+ */
+u64 gf_cache_index_get_size(GF_CacheIndex *index);
+
+/*!
+Gets the number of indexed data files
+\param index the cache index
+\return number of data files
+ */
+u32 gf_cache_index_get_count(GF_CacheIndex *index);
+
+/*!
+Attaches a cache entry to a cache index. The entry marks its files as most recently used when a session uses it, updates their size when written and removes them from the index when they are deleted
+\param index the cache index
+\param entry the cache entry
+ */
+void gf_cache_index_attach_entry(GF_CacheIndex *index, DownloadedCacheEntry entry);
+
+/*!
+Marks the files of a data file as most recently used
+\param index the cache index
+\param name name of the data file, without directory
+\return GF_TRUE if the data file is indexed, GF_FALSE otherwise
+ */
+Bool gf_cache_index_touch(GF_CacheIndex *index, const char *name);
+
+/*!
+Updates the size of the files of a data file from disk, adding them to the index as most recently used if needed or removing them if no longer present
+\param index the cache index
+\param name name of the data file, without directory
+\return error if any
+ */
+GF_Err gf_cache_index_update(GF_CacheIndex *index, const char *name);
+
+/*!
+Deletes least recently used data and info files until the indexed size is below the given limit. Files of cache entries used by a session are never deleted
+\param index the cache index
+\param max_size the maximum cache size in bytes
+\return the indexed size after cleanup
+ */
+u64 gf_cache_index_evict(GF_CacheIndex *index, u64 max_size);
+
 
 /*!
 
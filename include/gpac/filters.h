@@ -389,7 +389,7 @@ void gf_fs_remove_filter_register(GF_FilterSession *session, GF_FilterRegister *
 \param task_execute the callback function for the task. The callback can return GF_TRUE to reschedule the task, in which case the task will be rescheduled
 immediately or after reschedule_ms.
 \param udta_callback callback user data passed back to the task_execute function
-\param log_name log name of the task. If NULL, default is "user_task"
+\param log_name log name of the task. If NULL, default is "user_task". The name is not copied and must remain valid until the task is destroyed
 \return the error code if any
 */
 GF_Err gf_fs_post_user_task(GF_FilterSession *session, Bool (*task_execute) (GF_FilterSession *fsess, void *callback, u32 *reschedule_ms), void *udta_callback, const char *log_name);
@@ -984,6 +984,7 @@ enum
 	GF_PROP_PID_MUX_SRC = GF_4CC('M','S','R','C'),
 	GF_PROP_PID_DASH_MODE = GF_4CC('D','M','O','D'),
 	GF_PROP_PID_DASH_DUR = GF_4CC('D','D','U','R'),
+	GF_PROP_PID_LLHLS = GF_4CC('L','L','H','L'),
 	GF_PROP_PID_DASH_MULTI_PID = GF_4CC('D','M','S','D'),
 	GF_PROP_PID_DASH_MULTI_PID_IDX = GF_4CC('D','M','S','I'),
 	GF_PROP_PID_DASH_MULTI_TRACK = GF_4CC('D','M','T','K'),
@@ -1277,6 +1278,8 @@ typedef enum
 	GF_FEVT_PLAY_HINT,
 	/*! file delete event, sent upstream by dahser to notify file deletion*/
 	GF_FEVT_FILE_DELETE,
+	/*! fragment size info, sent down from muxers to manifest generators (LL-HLS parts)*/
+	GF_FEVT_FRAGMENT_SIZE,
 } GF_FEventType;
 
 /*! type: the type of the event*/
@@ -1367,6 +1370,22 @@ typedef struct
 	u64 idx_range_end;
 } GF_FEVT_SegmentSize;
 
+/*! Event structure for GF_FEVT_FRAGMENT_SIZE*/
+typedef struct
+{
+	FILTER_EVENT_BASE
+	/*! set if this is the last fragment of the segment*/
+	Bool is_last;
+	/*! offset of the fragment in the segment file*/
+	u64 offset;
+	/*! size of the fragment in bytes*/
+	u32 size;
+	/*! duration of the fragment*/
+	GF_Fraction64 duration;
+	/*! set if the fragment starts with a SAP*/
+	Bool independent;
+} GF_FEVT_FragmentSize;
+
 /*! Event structure for GF_FEVT_ATTACH_SCENE and GF_FEVT_RESET_SCENE
 For GF_FEVT_RESET_SCENE, THIS IS A DIRECT FILTER CALL NOT THREADSAFE, filters processing this event SHALL run on the main thread*/
 typedef struct
@@ -1451,6 +1470,7 @@ union __gf_filter_event
 	GF_FEVT_BufferRequirement buffer_req;
 	GF_FEVT_SegmentSize seg_size;
 	GF_FEVT_FileDelete file_del;
+	GF_FEVT_FragmentSize frag_size;
 };
 
 /*! Gets readable name for event type
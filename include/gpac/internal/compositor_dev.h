@@ -1461,6 +1461,11 @@ struct _gf_font
 	GF_Font *next;
 	/*list of glyphs in the font*/
 	GF_Glyph *glyph;
+	/*last glyph in list, and open-addressing hash table of glyphs by ID - only used for fonts owned by the font manager (no get_glyphs)*/
+	GF_Glyph *last_glyph;
+	GF_Glyph **glyph_table;
+	/*nb_glyphs is the number of glyphs in the list, the table may be NULL if it could not be allocated*/
+	u32 glyph_table_size, nb_glyphs;
 
 	char *name;
 	u32 em_size;
@@ -51,22 +51,61 @@ typedef struct
 } GF_RTCPHeader;
 
 
-typedef struct __PRO_item
+/*reorder slot states*/
+enum
 {
-	struct __PRO_item *next;
-	u32 pck_seq_num;
-	void *pck;
-	u32 size;
-} GF_POItem;
+	/*slot is free*/
+	GF_PO_SLOT_EMPTY=0,
+	/*packet received and waiting for output*/
+	GF_PO_SLOT_PENDING,
+	/*packet output, kept for FEC recovery until the slot is reused*/
+	GF_PO_SLOT_OUTPUT,
+};
+
+/*reorder slot, the slot for a packet is given by its sequence number modulo the ring size*/
+typedef struct
+{
+	u8 *pck;
+	u32 size, alloc_size;
+	/*extended (32 bit) sequence number*/
+	u32 ext_seq_num;
+	u8 state;
+} GF_POSlot;
+
+/*SMPTE 2022-1 FEC packet, stored from the FEC header*/
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc_size;
+	/*extended sequence number of the first protected packet*/
+	u32 sn_base;
+	/*sequence number offset between protected packets and number of protected packets*/
+	u32 offset, na;
+	Bool used;
+} GF_POFec;
 
 typedef struct __PO
 {
-	struct __PRO_item *in;
-	u32 head_seqnum;
+	GF_POSlot *slots;
+	u32 nb_slots;
+	/*number of output slots kept behind the head for FEC recovery*/
+	u32 history;
+	/*extended sequence number of the next packet to output, and highest extended sequence number received*/
+	u32 head_seqnum, max_seqnum;
 	u32 Count;
 	u32 MaxCount;
 	u32 IsInit;
 	u32 MaxDelay, LastTime;
+	/*a packet was received too far ahead of the head, pending packets are flushed before resyncing on it*/
+	GF_POSlot resync;
+
+	/*FEC packets, NULL if FEC is not enabled*/
+	GF_POFec *fec;
+	u32 nb_fec, fec_idx;
+
+	/*statistics*/
+	u32 nb_pck, nb_lost, nb_recovered, nb_dup, nb_late;
+	u64 fec_time;
 } GF_RTPReorder;
 
 /* creates new RTP reorderer
@@ -77,10 +116,14 @@ GF_RTPReorder *gf_rtp_reorderer_new(u32 MaxCount, u32 MaxDelay);
 void gf_rtp_reorderer_del(GF_RTPReorder *po);
 /*reset the Queue*/
 void gf_rtp_reorderer_reset(GF_RTPReorder *po);
+/*enables SMPTE 2022-1 FEC recovery, resets the queue*/
+GF_Err gf_rtp_reorderer_enable_fec(GF_RTPReorder *po);
 
 /*Adds a packet to the queue. Packet Data is memcopied*/
 GF_Err gf_rtp_reorderer_add(GF_RTPReorder *po, const void * pck, u32 pck_size, u32 pck_seqnum);
-/*gets the output of the queue. Packet Data IS YOURS to delete*/
+/*Adds a SMPTE 2022-1 FEC packet (row or column) including its RTP header. Packet Data is memcopied*/
+GF_Err gf_rtp_reorderer_add_fec(GF_RTPReorder *po, const void * pck, u32 pck_size);
+/*gets the output of the queue. Packet Data is owned by the reorderer and is valid until the next call to add or get*/
 void *gf_rtp_reorderer_get(GF_RTPReorder *po, u32 *pck_size, Bool force_flush);
 
 
@@ -1914,6 +1914,17 @@ typedef struct
 	GF_TrafMapEntry *frag_starts;
 } GF_TrafToSampleMap;
 
+/*fragment index entry, built while parsing fragments*/
+typedef struct
+{
+	/*file offset of the moof*/
+	u64 moof_offset;
+	/*latest start time in seconds of all track fragments*/
+	Double start_time;
+	/*set if all track fragments start with a SAP*/
+	Bool is_sap;
+} GF_FragmentIndexEntry;
+
 typedef struct
 {
 	GF_ISOM_BOX
@@ -3713,6 +3724,8 @@ void gf_isom_datamap_flush(GF_DataMap *map);
 #define GF_ISOM_RESET_FRAG_DEPEND_FLAGS(flags) flags = flags & 0xFFFFF
 
 GF_TrackExtendsBox *GetTrex(GF_MovieBox *moov, GF_ISOTrackID TrackID);
+/*indexes fragments available in the file but not yet parsed, reading only moof boxes, until a fragment starting with a SAP after start_time is found*/
+void gf_isom_fragment_index_scan(GF_ISOFile *mov, Double start_time);
 #endif
 
 enum
@@ -3819,6 +3832,19 @@ struct __tag_isom {
 	GF_SegmentIndexBox *main_sidx;
 	u64 main_sidx_end_pos;
 
+	/*index of fragments parsed from the start of the file, used for seeking when no sidx is present*/
+	GF_FragmentIndexEntry *frag_index;
+	u32 frag_index_count, frag_index_alloc;
+	/*set once fragment file offsets are no longer known (data reset without seek in source, segments)*/
+	Bool frag_index_frozen;
+	/*file offset of the next top-level box to check when scanning fragments ahead of parsing*/
+	u64 frag_index_scan_pos;
+	/*file offset of the first byte of the data being parsed*/
+	u64 frag_index_base;
+	/*file offset of the last fragment returned for a seek, used as base when the data offset is reset*/
+	u64 frag_index_seek_offset;
+	Bool frag_index_seek_pending;
+
 #endif
 	GF_ProducerReferenceTimeBox *last_producer_ref_time;
 
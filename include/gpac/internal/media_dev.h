@@ -62,6 +62,9 @@ u32 gf_media_nalu_next_start_code(const u8 *data, u32 data_len, u32 *sc_size);
 
 u32 gf_media_nalu_emulation_bytes_remove_count(const u8 *buffer, u32 nal_size);
 u32 gf_media_nalu_remove_emulation_bytes(const u8 *buffer_src, u8 *buffer_dst, u32 nal_size);
+/*copies the remaining bits of a NAL read with emulation prevention byte removal, until no more bytes are available in bs_in
+the source rbsp_trailing_bits are rewritten since bs_out may not be at the same bit position, byte alignment of bs_out is done by caller*/
+void gf_media_nalu_copy_rbsp_end(GF_BitStream *bs_in, GF_BitStream *bs_out);
 
 u32 gf_bs_get_ue(GF_BitStream *bs);
 s32 gf_bs_get_se(GF_BitStream *bs);
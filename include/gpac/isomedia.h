@@ -3543,10 +3543,10 @@ u32 gf_isom_segment_get_track_fragment_decode_time(GF_ISOFile *isom_file, u32 mo
 */
 void gf_isom_set_single_moof_mode(GF_ISOFile *isom_file, Bool mode);
 
-/*! gets closest file offset for the given time, when the file uses an segment index (sidx)
+/*! gets closest file offset for the given time, when the file uses an segment index (sidx). If no segment index is present, the movie fragments parsed so far, completed by scanning the moof boxes available in the file, are used if they carry a decode time (tfdt), and the offset of the last fragment starting with a SAP before the given time is returned
 \param isom_file the target ISO file
 \param start_time the start time in seconds
-\param offset set to the file offset of the segment containing the desired time
+\param offset set to the file offset of the segment or fragment containing the desired time
 \return error if any
 */
 GF_Err gf_isom_get_file_offset_for_time(GF_ISOFile *isom_file, Double start_time, u64 *offset);
@@ -3668,7 +3668,7 @@ Bool gf_isom_sample_is_fragment_start(GF_ISOFile *isom_file, u32 trackNumber, u3
 */
 GF_Err gf_isom_reset_tables(GF_ISOFile *isom_file, Bool reset_sample_count);
 
-/*! sets the offset for parsing from the input buffer to 0 (used to reclaim input buffer)
+/*! sets the offset for parsing from the input buffer to 0 (used to reclaim input buffer). If called right after \ref gf_isom_get_file_offset_for_time returned a fragment offset, the input buffer is assumed to start at this offset and the fragment index is kept, otherwise the fragment index is discarded
 \param isom_file the target ISO file
 \param top_box_start set to the byte offset in the source buffer of the first top level box
 \return error if any
@@ -513,6 +513,19 @@ typedef struct
 	Bool subdur_forced;
 } GF_DASH_SegmenterContext;
 
+/*! Fragment context - GPAC internal, used to produce LL-HLS parts*/
+typedef struct
+{
+	/*! offset of fragment in segment file*/
+	u64 offset;
+	/*! size of fragment in bytes*/
+	u32 size;
+	/*! duration in representation timescale*/
+	u64 dur;
+	/*! fragment starts with a SAP*/
+	Bool independent;
+} GF_DASH_FragmentContext;
+
 /*! Segment context - GPAC internal, used to produce HLS manifests and segment lists/timeline*/
 typedef struct
 {
@@ -534,6 +547,14 @@ typedef struct
 	u64 index_offset;
 	/*! segment number */
 	u32 seg_num;
+	/*! number of LL-HLS parts in segment*/
+	u32 nb_frags;
+	/*! number of allocated LL-HLS parts*/
+	u32 alloc_frags;
+	/*! LL-HLS parts of segment*/
+	GF_DASH_FragmentContext *frags;
+	/*! set once all LL-HLS parts of the segment are known*/
+	Bool llhls_done;
 } GF_DASH_SegmentContext;
 
 /*! Representation*/
@@ -600,8 +621,12 @@ typedef struct {
 	const char *m3u8_name;
 	/*! generated m3u8 name if no user-assigned one*/
 	char *m3u8_var_name;
-	/*! temp file for m3u8 generation*/
+	/*! memory file for m3u8 generation, reused across playlist updates*/
 	FILE *m3u8_var_file;
+	/*! CRC of last sent m3u8 variant playlist*/
+	u32 m3u8_var_crc;
+	/*! size of last sent m3u8 variant playlist, 0 if not yet sent*/
+	u32 m3u8_var_size;
 } GF_MPD_Representation;
 
 /*! AdaptationSet*/
@@ -803,6 +828,8 @@ typedef struct {
 	Bool create_m3u8_files;
 	/*! indicates to insert clock reference in variant playlists*/
 	Bool m3u8_time;
+	/*! LL-HLS target part duration in seconds, 0 if LL-HLS is not used*/
+	Double llhls_part_dur;
 } GF_MPD;
 
 /*! parses an MPD Element (and subtree) from DOM
@@ -352,6 +352,46 @@ Bool gf_m2ts_probe_data(const u8 *data, u32 size);
 */
 GF_Err gf_m2ts_restamp(u8 *buffer, u32 size, s64 ts_shift, u8 is_pes[GF_M2TS_MAX_STREAMS]);
 
+/*! TS packet scan flags*/
+enum
+{
+	/*! payload unit start indicator is set*/
+	GF_M2TS_SCAN_PUSI = 1,
+	/*! packet has an adaptation field*/
+	GF_M2TS_SCAN_AF = 1<<1,
+	/*! packet has a payload*/
+	GF_M2TS_SCAN_PAYLOAD = 1<<2,
+	/*! adaptation field carries a PCR*/
+	GF_M2TS_SCAN_PCR = 1<<3,
+	/*! packet is scrambled*/
+	GF_M2TS_SCAN_SCRAMBLED = 1<<4,
+};
+
+/*! TS packet header info, as extracted by \ref gf_m2ts_scan_packets*/
+typedef struct
+{
+	/*! offset of the packet sync byte in the scanned buffer*/
+	u32 offset;
+	/*! packet PID*/
+	u16 pid;
+	/*! packet flags, combination of GF_M2TS_SCAN_* flags*/
+	u8 flags;
+	/*! adaptation field length, not including the length byte - 0 if no adaptation field*/
+	u8 af_len;
+} GF_M2TS_PacketInfo;
+
+/*! scans headers of a set of TS packets. Unless all_packets is set, only packets starting a payload unit or carrying an adaptation field are reported, and headers of several packets are tested at once to skip runs of continuation packets
+\param data data buffer to scan, starting at a packet boundary
+\param size size of buffer
+\param pck_size packet size, 188 or 192 (4 bytes prefix before each packet)
+\param all_packets if GF_TRUE, all packets are reported
+\param infos array of packet infos to fill
+\param max_infos number of elements in infos
+\param nb_infos set to number of packet infos filled
+\return number of bytes scanned. This is less than size if infos is full, if the buffer does not end on a packet boundary or if the packet at this offset does not start with a sync byte
+*/
+u32 gf_m2ts_scan_packets(const u8 *data, u32 size, u32 pck_size, Bool all_packets, GF_M2TS_PacketInfo *infos, u32 max_infos, u32 *nb_infos);
+
 /*! PES data framing modes*/
 typedef enum
 {
@@ -1098,6 +1138,9 @@ struct tag_m2ts_demux
 	if set, on_event shall be non-null
 	*/
 	Bool split_mode;
+
+	/*! worker threads for PES reassembly, NULL if disabled - see \ref gf_m2ts_demux_set_threads*/
+	struct __m2ts_dmx_workers *workers;
 };
 
 //! @endcond
@@ -1134,6 +1177,23 @@ GF_Err gf_m2ts_set_pes_framing(GF_M2TS_PES *pes, GF_M2TSPesFraming mode);
 */
 GF_Err gf_m2ts_process_data(GF_M2TS_Demuxer *demux, u8 *data, u32 data_size);
 
+/*! enables multi-threaded PES reassembly.
+
+Packets of PES streams are routed per PID to a set of workers, and PES reassembly and reframing of each PID is done by a single worker. Packet headers, adaptation fields, PCR and sections are still processed by the calling thread.
+Events produced by the workers are queued and dispatched by the calling thread, in TS packet order, when \ref gf_m2ts_demux_dispatch is called or when enough packets are pending. While dispatching queued events, the demultiplexer packet number is the number of the TS packet which triggered the event.
+Multi-threaded reassembly is disabled in split mode or when PES timing notification is enabled.
+\param demux the target MPEG-2 TS demultiplexer
+\param nb_threads number of workers, including the calling thread. A value of 0 or 1 disables multi-threaded reassembly
+\param batch_size maximum number of pending packets per worker before processing them. If 0, a default value is used
+\return error if any
+*/
+GF_Err gf_m2ts_demux_set_threads(GF_M2TS_Demuxer *demux, u32 nb_threads, u32 batch_size);
+
+/*! processes all packets pending in the PES workers and dispatches the resulting events. Does nothing if multi-threaded reassembly is not enabled
+\param demux the target MPEG-2 TS demultiplexer
+*/
+void gf_m2ts_demux_dispatch(GF_M2TS_Demuxer *demux);
+
 /*! initializes DSM-CC object carousel reception
 \param demux the target MPEG-2 TS demultiplexer
 */
@@ -307,6 +307,9 @@ typedef struct __scene_loader
 	/*! force stream ID*/
 	u16 force_es_id;
 
+	/*! if not 0, \ref gf_sm_load_run returns once this number of access units have been loaded, and GF_EOS once the input is completely loaded (BT and XMT-A only). Access units present in the context when \ref gf_sm_load_run returns are complete*/
+	u32 au_window;
+
 //! @cond Doxygen_Suppress
 	/*private to loader*/
 	void *loader_priv;
@@ -388,6 +391,17 @@ typedef struct
 */
 GF_Err gf_sm_encode_to_file(GF_SceneManager *sman, GF_ISOFile *mp4, GF_SMEncodeOptions *opt);
 
+/*! loads and encodes a scene into a destination MP4 file with bounded memory usage.
+The loader is run by chunks of au_window access units (128 if not set), and loaded BIFS and LASeR access units are encoded, applied to the scene graph and discarded before loading the next chunk. Other streams (OD, ...) are kept in memory and encoded once the input is completely loaded.
+
+Input access units must be declared in increasing time order. Since IDs used by the next chunks are not known, node, route and proto ID ranges not set in the BIFS configuration are coded on 16 bits.
+\param sload the scene loader, initialized through \ref gf_sm_load_init
+\param mp4 the destination ISOBMFF file
+\param opt the encoding options
+\return error if any
+*/
+GF_Err gf_sm_encode_to_file_streaming(GF_SceneLoader *sload, GF_ISOFile *mp4, GF_SMEncodeOptions *opt);
+
 #endif /*GPAC_DISABLE_SCENE_ENCODER*/
 
 
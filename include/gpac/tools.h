@@ -82,6 +82,13 @@ Macro formating a 4-character code (or 4CC) "abcd" as 0xAABBCCDD
 */
 const char *gf_4cc_to_str(u32 type);
 
+/*! converts four character code to string in the given buffer, safe to use from several threads
+\param type a four character code
+\param szType buffer in which the string is written
+\return szType
+*/
+const char *gf_4cc_to_str_safe(u32 type, char szType[GF_4CC_MSIZE]);
+
 /*! @} */
 
 /*!
@@ -1399,6 +1406,32 @@ Creates a new temporary file in binary mode
  */
 FILE *gf_file_temp(char ** const fileName);
 
+/*!
+\brief Temporary Memory File Creation
+
+Creates a new temporary file stored in a growable memory buffer. The returned object can be used with gf_fwrite, gf_fprintf, gf_fputs, gf_fputc, gf_fread, gf_fseek and gf_ftell, and must be destroyed using gf_fclose
+\return stream handle to the new memory file
+ */
+FILE *gf_file_temp_mem();
+
+/*!
+\brief Temporary Memory File Data
+
+Gets the content of a temporary memory file
+\param fp memory file created with \ref gf_file_temp_mem
+\param size set to the number of bytes written in the file
+\return pointer to the file content, owned by the file and valid until the next write or close. NULL if not a memory file or if nothing has been written
+ */
+const u8 *gf_file_temp_mem_data(FILE *fp, u32 *size);
+
+/*!
+\brief Temporary Memory File Reset
+
+Truncates a temporary memory file to zero length, keeping its allocated memory for further writes
+\param fp memory file created with \ref gf_file_temp_mem
+ */
+void gf_file_temp_mem_reset(FILE *fp);
+
 
 /*!
 \brief File Modification Time
@@ -1775,6 +1808,41 @@ GF_Err gf_sha1_file(const char *filename, u8 digest[GF_SHA1_DIGEST_SIZE]);
 \param digest buffer to store message digest
  */
 void gf_sha1_csum(u8 *buf, u32 buflen, u8 digest[GF_SHA1_DIGEST_SIZE]);
+
+/*! SHA-256 context*/
+typedef struct __sha256_context GF_SHA256Context;
+
+/*! SHA-256 message size */
+#define GF_SHA256_DIGEST_SIZE		32
+
+/*! create SHA-256 context
+\return the SHA-256 context*/
+GF_SHA256Context *gf_sha256_starts();
+/*! adds byte to the SHA-256 context
+\param ctx the target SHA-256 context
+\param input data to hash
+\param length size of data in bytes
+*/
+void gf_sha256_update(GF_SHA256Context *ctx, u8 *input, u32 length);
+/*! generates SHA-256 of all bytes ingested - this destroys the context
+\param ctx the target SHA-256 context
+\param digest buffer to store message digest
+*/
+void gf_sha256_finish(GF_SHA256Context *ctx, u8 digest[GF_SHA256_DIGEST_SIZE] );
+
+/*! gets SHA-256 message digest of a file
+\param filename name of file to hash
+\param digest buffer to store message digest
+\return error if any
+*/
+GF_Err gf_sha256_file(const char *filename, u8 digest[GF_SHA256_DIGEST_SIZE]);
+
+/*! gets SHA-256 of input buffer
+\param buf input buffer to hash
+\param buflen size of input buffer in bytes
+\param digest buffer to store message digest
+ */
+void gf_sha256_csum(u8 *buf, u32 buflen, u8 digest[GF_SHA256_DIGEST_SIZE]);
 /*! @} */
 
 
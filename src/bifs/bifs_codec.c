@@ -488,6 +488,11 @@ GF_Err gf_bifs_encoder_set_source_url(GF_BifsEncoder *codec, const char *src_url
 	return GF_OK;
 }
 
+/*removes a destroyed node from the USE candidates, needed when encoded commands are applied to the scene graph*/
+void gf_bifs_encoder_node_destroyed(GF_BifsEncoder *codec, GF_Node *node)
+{
+	if (codec) gf_list_del_item(codec->encoded_nodes, node);
+}
 
 #endif /*GPAC_DISABLE_BIFS_ENC*/
 
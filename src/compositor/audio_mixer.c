@@ -25,6 +25,18 @@
 
 #include <gpac/internal/compositor_dev.h>
 
+#if defined(GPAC_64_BITS)
+# if defined(WIN32) && !defined(__GNUC__)
+#  include <intrin.h>
+#  define GPAC_HAS_SSE2
+# else
+#  ifdef __SSE2__
+#   include <emmintrin.h>
+#   define GPAC_HAS_SSE2
+#  endif
+# endif
+#endif
+
 /*
 	Notes about the mixer:
 	1- spatialization is out of scope for the mixer (eg that's the sound node responsability)
@@ -51,6 +63,11 @@ typedef struct
 	Fixed pan[GF_AUDIO_MIXER_MAX_CHANNELS];
 
 	s32 (*get_sample)(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride);
+	/*converts nb_samples of the given channel, used when no resampling is needed*/
+	void (*get_samples)(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples);
+	/*converted input channels when channel mapping is needed*/
+	s32 *conv_buf;
+	u32 conv_size;
 	Bool is_planar;
 	Bool muted;
 } MixerInput;
@@ -135,6 +152,7 @@ void gf_mixer_remove_all(GF_AudioMixer *am)
 		for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		if (in->conv_buf) gf_free(in->conv_buf);
 		gf_free(in);
 	}
 	am->isEmpty = GF_TRUE;
@@ -221,6 +239,7 @@ void gf_mixer_remove_input(GF_AudioMixer *am, GF_AudioInterface *src)
 		for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		if (in->conv_buf) gf_free(in->conv_buf);
 		gf_free(in);
 		break;
 	}
@@ -304,9 +323,10 @@ s32 input_sample_s24p(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 p
 	return make_s24_int(&data[sample_offset*3 + channel*planar_stride]) * MIX_S24_SCALE;
 }
 
+//1.0 in float precision is out of s32 range
 #define TRUNC_FLT_DBL(_a) \
 	if (_a<-1.0) return GF_INT_MIN;\
-	else if (_a>1.0) return GF_INT_MAX;\
+	else if (_a>=1.0) return GF_INT_MAX;\
 	return (s32) (_a * GF_INT_MAX);\
 
 s32 input_sample_flt(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride)
@@ -358,6 +378,168 @@ s32 input_sample_u8p(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 pl
 	return res * MIX_U8_SCALE;
 }
 
+/*block converters, used when the input is not resampled*/
+
+static void samples_s16_to_s32(s16 *src, u32 nb_ch, u32 channel, s32 *dst, u32 nb_samples)
+{
+	u32 i=0;
+#ifdef GPAC_HAS_SSE2
+	if (nb_ch==1) {
+		for (; i+8<=nb_samples; i+=8) {
+			__m128i v = _mm_loadu_si128((__m128i *) (src+i));
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+			//x*MIX_S16_SCALE = (x<<16) - x
+			_mm_storeu_si128((__m128i *) (dst+i), _mm_sub_epi32(_mm_slli_epi32(lo, 16), lo));
+			_mm_storeu_si128((__m128i *) (dst+i+4), _mm_sub_epi32(_mm_slli_epi32(hi, 16), hi));
+		}
+	} else if (nb_ch==2) {
+		//4 stereo frames per load, even lanes are left channel
+		for (; i+4<=nb_samples; i+=4) {
+			__m128i v = _mm_loadu_si128((__m128i *) (src+2*i));
+			if (channel) v = _mm_srai_epi32(v, 16);
+			else v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+			_mm_storeu_si128((__m128i *) (dst+i), _mm_sub_epi32(_mm_slli_epi32(v, 16), v));
+		}
+	}
+#endif
+	src += channel + i*nb_ch;
+	for (; i<nb_samples; i++) {
+		dst[i] = ((s32) *src) * MIX_S16_SCALE;
+		src += nb_ch;
+	}
+}
+
+static void samples_flt_to_s32(Float *src, u32 nb_ch, u32 channel, s32 *dst, u32 nb_samples)
+{
+	u32 i=0;
+#ifdef GPAC_HAS_SSE2
+	if (nb_ch<=2) {
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 minus_one = _mm_set1_ps(-1.0f);
+		const __m128 scale = _mm_set1_ps((Float) GF_INT_MAX);
+		const __m128i max_val = _mm_set1_epi32(GF_INT_MAX);
+		for (; i+4<=nb_samples; i+=4) {
+			__m128 v, sat;
+			__m128i res;
+			if (nb_ch==1) {
+				v = _mm_loadu_ps(src+i);
+			} else {
+				__m128 a = _mm_loadu_ps(src+2*i);
+				__m128 b = _mm_loadu_ps(src+2*i+4);
+				if (channel) v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+				else v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+			}
+			//same as TRUNC_FLT_DBL
+			sat = _mm_cmpge_ps(v, one);
+			v = _mm_max_ps(v, minus_one);
+			res = _mm_cvttps_epi32(_mm_mul_ps(v, scale));
+			res = _mm_or_si128(_mm_andnot_si128(_mm_castps_si128(sat), res), _mm_and_si128(_mm_castps_si128(sat), max_val));
+			_mm_storeu_si128((__m128i *) (dst+i), res);
+		}
+	}
+#endif
+	src += channel + i*nb_ch;
+	for (; i<nb_samples; i++) {
+		Float samp = *src;
+		if (samp<-1.0) dst[i] = GF_INT_MIN;
+		else if (samp>=1.0) dst[i] = GF_INT_MAX;
+		else dst[i] = (s32) (samp * GF_INT_MAX);
+		src += nb_ch;
+	}
+}
+
+static void samples_dbl_to_s32(Double *src, u32 nb_ch, s32 *dst, u32 nb_samples)
+{
+	u32 i;
+	for (i=0; i<nb_samples; i++) {
+		Double samp = *src;
+		if (samp<-1.0) dst[i] = GF_INT_MIN;
+		else if (samp>=1.0) dst[i] = GF_INT_MAX;
+		else dst[i] = (s32) (samp * GF_INT_MAX);
+		src += nb_ch;
+	}
+}
+
+static void samples_s24_to_s32(u8 *src, u32 nb_ch, s32 *dst, u32 nb_samples)
+{
+	u32 i;
+	for (i=0; i<nb_samples; i++) {
+		//sign extend from the MSB byte
+		s32 val = ((s32) (((u32) src[0]<<8) | ((u32) src[1]<<16) | ((u32) src[2]<<24))) >> 8;
+		dst[i] = val * MIX_S24_SCALE;
+		src += 3*nb_ch;
+	}
+}
+
+static void samples_u8_to_s32(u8 *src, u32 nb_ch, s32 *dst, u32 nb_samples)
+{
+	u32 i;
+	for (i=0; i<nb_samples; i++) {
+		dst[i] = ((s32) *src - 128) * MIX_U8_SCALE;
+		src += nb_ch;
+	}
+}
+
+static void input_samples_s32(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	u32 i;
+	s32 *src = ((s32 *)data) + sample_offset*nb_ch + channel;
+	if (nb_ch==1) {
+		memcpy(dst, src, sizeof(s32)*nb_samples);
+		return;
+	}
+	for (i=0; i<nb_samples; i++) {
+		dst[i] = *src;
+		src += nb_ch;
+	}
+}
+static void input_samples_s32p(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	s32 *src = (s32 *)data;
+	memcpy(dst, src + sample_offset + planar_stride*channel/4, sizeof(s32)*nb_samples);
+}
+static void input_samples_s24(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_s24_to_s32(data + sample_offset*nb_ch*3 + 3*channel, nb_ch, dst, nb_samples);
+}
+static void input_samples_s24p(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_s24_to_s32(data + sample_offset*3 + channel*planar_stride, 1, dst, nb_samples);
+}
+static void input_samples_flt(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_flt_to_s32(((Float *)data) + sample_offset*nb_ch, nb_ch, channel, dst, nb_samples);
+}
+static void input_samples_fltp(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_flt_to_s32(((Float *)data) + sample_offset + planar_stride*channel/4, 1, 0, dst, nb_samples);
+}
+static void input_samples_dbl(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_dbl_to_s32(((Double *)data) + sample_offset*nb_ch + channel, nb_ch, dst, nb_samples);
+}
+static void input_samples_dblp(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_dbl_to_s32(((Double *)data) + sample_offset + planar_stride*channel/8, 1, dst, nb_samples);
+}
+static void input_samples_s16(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_s16_to_s32(((s16 *)data) + sample_offset*nb_ch, nb_ch, channel, dst, nb_samples);
+}
+static void input_samples_s16p(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_s16_to_s32(((s16 *)data) + sample_offset + planar_stride*channel/2, 1, 0, dst, nb_samples);
+}
+static void input_samples_u8(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_u8_to_s32(data + sample_offset*nb_ch + channel, nb_ch, dst, nb_samples);
+}
+static void input_samples_u8p(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride, s32 *dst, u32 nb_samples)
+{
+	samples_u8_to_s32(data + sample_offset + planar_stride*channel, 1, dst, nb_samples);
+}
+
 static void gf_am_configure_source(MixerInput *in)
 {
 	in->bit_depth = gf_audio_fmt_bit_depth(in->src->afmt);
@@ -366,39 +548,51 @@ static void gf_am_configure_source(MixerInput *in)
 	switch (in->src->afmt) {
 	case GF_AUDIO_FMT_S32:
 		in->get_sample = input_sample_s32;
+		in->get_samples = input_samples_s32;
 		break;
 	case GF_AUDIO_FMT_S32P:
 		in->get_sample = input_sample_s32p;
+		in->get_samples = input_samples_s32p;
 		break;
 	case GF_AUDIO_FMT_S24:
 		in->get_sample = input_sample_s24;
+		in->get_samples = input_samples_s24;
 		break;
 	case GF_AUDIO_FMT_S24P:
 		in->get_sample = input_sample_s24p;
+		in->get_samples = input_samples_s24p;
 		break;
 	case GF_AUDIO_FMT_FLT:
 		in->get_sample = input_sample_flt;
+		in->get_samples = input_samples_flt;
 		break;
 	case GF_AUDIO_FMT_FLTP:
 		in->get_sample = input_sample_fltp;
+		in->get_samples = input_samples_fltp;
 		break;
 	case GF_AUDIO_FMT_DBL:
 		in->get_sample = input_sample_dbl;
+		in->get_samples = input_samples_dbl;
 		break;
 	case GF_AUDIO_FMT_DBLP:
 		in->get_sample = input_sample_dblp;
+		in->get_samples = input_samples_dblp;
 		break;
 	case GF_AUDIO_FMT_S16:
 		in->get_sample = input_sample_s16;
+		in->get_samples = input_samples_s16;
 		break;
 	case GF_AUDIO_FMT_S16P:
 		in->get_sample = input_sample_s16p;
+		in->get_samples = input_samples_s16p;
 		break;
 	case GF_AUDIO_FMT_U8:
 		in->get_sample = input_sample_u8;
+		in->get_samples = input_samples_u8;
 		break;
 	case GF_AUDIO_FMT_U8P:
 		in->get_sample = input_sample_u8p;
+		in->get_samples = input_samples_u8p;
 		break;
 	}
 }
@@ -652,6 +846,82 @@ static GFINLINE void gf_mixer_map_channels(s32 *inChan, u32 nb_in, u64 in_ch_lay
 	}
 }
 
+/*gets the channel routing performed by gf_mixer_map_channels for this input: 2 if the input channel is copied to the output channel, 1 if half of it is added
+returns GF_TRUE if this is a plain copy*/
+static Bool gf_mixer_get_channel_matrix(MixerInput *in, u32 nb_out, u64 out_ch_layout, u8 matrix[GF_AUDIO_MIXER_MAX_CHANNELS][GF_AUDIO_MIXER_MAX_CHANNELS])
+{
+	u32 i, j, nb_in = in->src->chan;
+	Bool is_copy = (nb_in==nb_out) ? GF_TRUE : GF_FALSE;
+	s32 chans[GF_AUDIO_MIXER_MAX_CHANNELS];
+
+	for (i=0; i<nb_in; i++) {
+		memset(chans, 0, sizeof(s32)*GF_AUDIO_MIXER_MAX_CHANNELS);
+		chans[i] = 2;
+		gf_mixer_map_channels(chans, nb_in, in->src->ch_layout, in->src->forced_layout, nb_out, out_ch_layout);
+		for (j=0; j<nb_out; j++) {
+			matrix[j][i] = (u8) chans[j];
+			if (matrix[j][i] != ((i==j) ? 2 : 0)) is_copy = GF_FALSE;
+		}
+	}
+	return is_copy;
+}
+
+/*no resampling nor volume: convert full blocks of input and map channels without per-sample interpolation*/
+static Bool gf_mixer_fetch_input_direct(GF_AudioMixer *am, MixerInput *in, u8 *in_data, u32 src_size, u32 src_samp, u32 planar_stride)
+{
+	u32 i, j, k, nb_samples, in_ch, out_ch;
+	u8 matrix[GF_AUDIO_MIXER_MAX_CHANNELS][GF_AUDIO_MIXER_MAX_CHANNELS];
+
+	in_ch = in->src->chan;
+	out_ch = am->nb_channels;
+	nb_samples = in->out_samples_to_write - in->out_samples_written;
+	if (nb_samples > src_samp) nb_samples = src_samp;
+
+	if (gf_mixer_get_channel_matrix(in, out_ch, am->channel_layout, matrix)) {
+		for (j=0; j<out_ch; j++) {
+			in->get_samples(in_data, in_ch, 0, j, planar_stride, in->ch_buf[j] + in->out_samples_written, nb_samples);
+		}
+	} else {
+		if (in->conv_size < nb_samples * in_ch) {
+			in->conv_buf = gf_realloc(in->conv_buf, sizeof(s32) * nb_samples * in_ch);
+			if (!in->conv_buf) {
+				in->conv_size = 0;
+				return GF_FALSE;
+			}
+			in->conv_size = nb_samples * in_ch;
+		}
+		for (i=0; i<in_ch; i++) {
+			in->get_samples(in_data, in_ch, 0, i, planar_stride, in->conv_buf + i*nb_samples, nb_samples);
+		}
+		for (j=0; j<out_ch; j++) {
+			s32 *dst = in->ch_buf[j] + in->out_samples_written;
+			memset(dst, 0, sizeof(s32)*nb_samples);
+			//stereo to mono averages before dividing
+			if ((in_ch==2) && (out_ch==1)) {
+				s32 *l = in->conv_buf;
+				s32 *r = in->conv_buf + nb_samples;
+				for (k=0; k<nb_samples; k++) dst[k] = (l[k] + r[k]) / 2;
+				continue;
+			}
+			for (i=0; i<in_ch; i++) {
+				s32 *src = in->conv_buf + i*nb_samples;
+				if (matrix[j][i]==2) {
+					for (k=0; k<nb_samples; k++) dst[k] += src[k];
+				} else if (matrix[j][i]==1) {
+					for (k=0; k<nb_samples; k++) dst[k] += src[k] / 2;
+				}
+			}
+		}
+	}
+
+	in->out_samples_written += nb_samples;
+	in->has_prev = GF_FALSE;
+	in->in_bytes_used = (nb_samples==src_samp) ? src_size : (nb_samples * in->bit_depth * in_ch / 8);
+	/*cf below, make sure we call release*/
+	in->in_bytes_used += 1;
+	return GF_TRUE;
+}
+
 static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_delay)
 {
 	u32 i, j, in_ch, out_ch, prev, next, src_samp, ratio, src_size;
@@ -684,6 +954,18 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 		return;
 	}
 
+	/*same rate, no pending sample and no volume change, convert by blocks*/
+	if ((ratio==255) && !in->has_prev && (in->speed <= am->max_speed)) {
+		Bool use_pan = GF_FALSE;
+		if (!in->src->forced_layout) {
+			for (j=0; j<in_ch; j++) {
+				if (in->pan[j]!=FIX_ONE) use_pan = GF_TRUE;
+			}
+		}
+		if (!use_pan && gf_mixer_fetch_input_direct(am, in, in_data, src_size, src_samp, planar_stride))
+			return;
+	}
+
 	/*while space to fill and input data, convert*/
 	use_prev = in->has_prev;
 	memset(inChan, 0, sizeof(s32)*GF_AUDIO_MIXER_MAX_CHANNELS);
@@ -106,11 +106,12 @@ void gf_font_del(GF_Font *font)
 			glyph = next;
 		}
 	}
+	if (font->glyph_table) gf_free(font->glyph_table);
 	gf_free(font->name);
 	gf_free(font);
 }
 
-
+GF_EXPORT
 void gf_font_manager_del(GF_FontManager *fm)
 {
 	GF_Font *font;
@@ -305,18 +306,94 @@ GF_Font *gf_font_manager_set_font_ex(GF_FontManager *fm, char **alt_fonts, u32 n
 
 	return the_font;
 }
+GF_EXPORT
 GF_Font *gf_font_manager_set_font(GF_FontManager *fm, char **alt_fonts, u32 nb_fonts, u32 styles)
 {
 	return gf_font_manager_set_font_ex(fm, alt_fonts, nb_fonts, styles, 0);
 }
 
-static GF_Glyph *gf_font_get_glyph(GF_FontManager *fm, GF_Font *font, u32 name)
+#define GLYPH_HASH(_id, _size)	((((u32) (_id)) * 2654435761U) & ((_size)-1))
+
+static GF_Glyph *gf_font_find_glyph(GF_Font *font, u32 name)
 {
-	GF_Glyph *glyph = font->glyph;
-	while (glyph) {
+	u32 idx;
+	GF_Glyph *glyph;
+	/*glyphs of embedded fonts (SVG fonts) are added and removed by their owner, walk the list
+	this is also used when the glyph table could not be allocated*/
+	if (font->get_glyphs || !font->glyph_table) {
+		glyph = font->glyph;
+		while (glyph) {
+			if (glyph->ID==name) return glyph;
+			glyph = glyph->next;
+		}
+		return NULL;
+	}
+	idx = GLYPH_HASH(name, font->glyph_table_size);
+	while ((glyph = font->glyph_table[idx]) != NULL) {
 		if (glyph->ID==name) return glyph;
-		glyph = glyph->next;
+		idx = (idx+1) & (font->glyph_table_size-1);
 	}
+	return NULL;
+}
+
+static void gf_font_table_insert(GF_Glyph **table, u32 size, GF_Glyph *glyph)
+{
+	u32 idx = GLYPH_HASH(glyph->ID, size);
+	while (table[idx]) idx = (idx+1) & (size-1);
+	table[idx] = glyph;
+}
+
+static void gf_font_add_glyph(GF_Font *font, GF_Glyph *glyph)
+{
+	if (!font->glyph) {
+		font->glyph = glyph;
+	} else if (font->last_glyph && !font->get_glyphs) {
+		font->last_glyph->next = glyph;
+	} else {
+		GF_Glyph *a_glyph = font->glyph;
+		while (a_glyph->next) a_glyph = a_glyph->next;
+		a_glyph->next = glyph;
+	}
+	font->last_glyph = glyph;
+	if (font->get_glyphs) return;
+	font->nb_glyphs++;
+
+	/*keep load factor below 1/2*/
+	if (2*font->nb_glyphs > font->glyph_table_size) {
+		GF_Glyph *a_glyph;
+		GF_Glyph **new_table;
+		u32 new_size = font->glyph_table_size ? 2*font->glyph_table_size : 64;
+		while (new_size < 2*font->nb_glyphs) new_size *= 2;
+		new_table = gf_malloc(sizeof(GF_Glyph *) * new_size);
+		if (new_table) {
+			memset(new_table, 0, sizeof(GF_Glyph *) * new_size);
+			/*rebuild from the glyph list, which includes the new glyph*/
+			a_glyph = font->glyph;
+			while (a_glyph) {
+				gf_font_table_insert(new_table, new_size, a_glyph);
+				a_glyph = a_glyph->next;
+			}
+			if (font->glyph_table) gf_free(font->glyph_table);
+			font->glyph_table = new_table;
+			font->glyph_table_size = new_size;
+			return;
+		}
+		/*keep using the current table while a free slot is left after insertion, otherwise drop it:
+		lookups then walk the list and the next insertion retries the rebuild*/
+		if (!font->glyph_table || (font->nb_glyphs >= font->glyph_table_size)) {
+			if (font->glyph_table) gf_free(font->glyph_table);
+			font->glyph_table = NULL;
+			font->glyph_table_size = 0;
+			return;
+		}
+	}
+	gf_font_table_insert(font->glyph_table, font->glyph_table_size, glyph);
+}
+
+static GF_Glyph *gf_font_get_glyph(GF_FontManager *fm, GF_Font *font, u32 name)
+{
+	GF_Glyph *glyph = gf_font_find_glyph(font, name);
+	if (glyph) return glyph;
 
 	if (name==GF_CARET_CHAR) {
 		GF_SAFEALLOC(glyph, GF_Glyph);
@@ -354,12 +431,7 @@ static GF_Glyph *gf_font_get_glyph(GF_FontManager *fm, GF_Font *font, u32 name)
 	}
 	if (!glyph) return NULL;
 
-	if (!font->glyph) font->glyph = glyph;
-	else {
-		GF_Glyph *a_glyph = font->glyph;
-		while (a_glyph->next) a_glyph = a_glyph->next;
-		a_glyph->next = glyph;
-	}
+	gf_font_add_glyph(font, glyph);
 	/*space character - this may need adjustment for other empty glyphs*/
 	if (glyph->path && !glyph->path->n_points) {
 		glyph->path->bbox.x = 0;
@@ -454,7 +526,7 @@ typedef struct _span_internal
 #endif
 } GF_SpanExtensions;
 
-
+GF_EXPORT
 void gf_font_manager_delete_span(GF_FontManager *fm, GF_TextSpan *span)
 {
 	if (span->user && span->font->spans) gf_list_del_item(span->font->spans, span);
@@ -576,6 +576,20 @@ static void register_dirty_rect(GF_RectArray *ra, GF_IRect *rc)
 }
 
 
+/*checks if a context intersects at least one dirty rectangle; if not, the context is not drawn but its textures
+are flagged as used to avoid releasing them*/
+static Bool visual_2d_context_in_dirty_area(GF_VisualManager *visual, DrawableContext *ctx)
+{
+	u32 i;
+	for (i=0; i<visual->to_redraw.count; i++) {
+		if (gf_irect_overlaps(&ctx->bi->clip, &visual->to_redraw.list[i].rect))
+			return GF_TRUE;
+	}
+	if (ctx->aspect.fill_texture) ctx->aspect.fill_texture->flags |= GF_SR_TEXTURE_USED;
+	if (ctx->aspect.line_texture) ctx->aspect.line_texture->flags |= GF_SR_TEXTURE_USED;
+	return GF_FALSE;
+}
+
 Bool visual_2d_terminate_draw(GF_VisualManager *visual, GF_TraverseState *tr_state)
 {
 	u32 k, i, count, num_nodes, num_changed;
@@ -593,6 +607,7 @@ Bool visual_2d_terminate_draw(GF_VisualManager *visual, GF_TraverseState *tr_sta
 	Bool has_clear = 0;
 	Bool has_changed = 0;
 	Bool redraw_all_on_background_change = GF_TRUE;
+	Bool skip_clean_ctx;
 
 	/*in direct mode the visual is always redrawn*/
 	if (tr_state->immediate_draw) {
@@ -819,6 +834,14 @@ skip_background:
 
 	visual->draw_node_index = 0;
 
+	/*shapes not intersecting any dirty rectangle are skipped, avoiding texture setup and outline computing.
+	This is not done in hybrid GL mode where textures are drawn by OpenGL regardless of dirty rectangles,
+	nor for nodes using their own draw routine (text, layers, ...)*/
+	skip_clean_ctx = GF_TRUE;
+#ifndef GPAC_DISABLE_3D
+	if (visual->compositor->hybrid_opengl && !visual->offscreen) skip_clean_ctx = GF_FALSE;
+#endif
+
 	ctx = visual->context;
 	while (ctx && ctx->drawable) {
 
@@ -830,7 +853,7 @@ skip_background:
 
 			if (ctx->drawable->flags & DRAWABLE_USE_TRAVERSE_DRAW) {
 				gf_node_traverse(ctx->drawable->node, tr_state);
-			} else {
+			} else if (!skip_clean_ctx || visual_2d_context_in_dirty_area(visual, ctx)) {
 				drawable_draw(ctx->drawable, tr_state);
 			}
 		}
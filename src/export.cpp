@@ -86,6 +86,7 @@
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_get_default_cache_directory) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_4cc_to_str) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_4cc_to_str_safe) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_error_to_string) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rand_init) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rand) )
@@ -123,6 +124,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_file_delete) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_file_move) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_file_temp) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_temp_mem) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_temp_mem_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_temp_mem_reset) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_file_modification_time) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fwrite) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fopen) )
@@ -238,6 +242,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_get_size) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_get_refreshed_size) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_transfer) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_bs_copy_bits) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_flush) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_bits_available) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_get_bit_offset) )
@@ -429,6 +434,16 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_setup_from_url) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_get_global_rate) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_wget) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_get_size) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_delete_all_cached_files) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_del) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_get_size) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_get_count) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_attach_entry) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_touch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_update) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_cache_index_evict) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_xml_sax_new) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_xml_sax_del) )
@@ -1075,6 +1090,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_rvc_config) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_sample_rap_group) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_sample_roll_group) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_fragment_set_sample_rap_group) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_sample_cenc_group) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_composition_offset_mode) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_add_sample_group_info) )
@@ -1316,6 +1332,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_reorderer_reset) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_reorderer_add) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_reorderer_get) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_reorderer_enable_fec) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_reorderer_add_fec) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_reset_ssrc) )
 
@@ -1429,6 +1447,11 @@
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_sha1_csum) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sha1_file) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sha256_starts) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sha256_update) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sha256_finish) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sha256_csum) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sha256_file) )
 
 #ifndef GPAC_DISABLE_AV_PARSERS
 #pragma comment (linker, EXPORT_SYMBOL(gf_m4v_parser_new) )
@@ -1520,6 +1543,7 @@
 
 #if !defined(GPAC_DISABLE_SCENE_ENCODER) && !defined(GPAC_DISABLE_ISOM_WRITE)
 #pragma comment (linker, EXPORT_SYMBOL(gf_sm_encode_to_file) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sm_encode_to_file_streaming) )
 #endif
 
 #ifndef GPAC_DISABLE_SCENE_DUMP
@@ -1943,8 +1967,10 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_sc_texture_stop_no_unregister) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_font_manager_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_font_manager_del) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_font_manager_set_font) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_font_manager_create_span) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_font_manager_delete_span) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_font_manager_refresh_span_bounds) )
 
 #endif
@@ -1954,11 +1980,15 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_demux_new) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_demux_del) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_process_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_demux_set_threads) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_demux_dispatch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_flush_all) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_reset_parsers) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_reset_parsers_for_program) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_set_pes_framing) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_get_stream_name) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_restamp) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_scan_packets) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_get_sdt_info) )
 
 
@@ -2005,6 +2035,11 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_m3u8_parse_master_playlist) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_mpd_write) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_mpd_write_file) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_mpd_write_m3u8_master_playlist) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_mpd_period_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_mpd_adaptation_set_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_mpd_representation_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_mpd_segmentimeline_new) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_mpd_get_base_url_count) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_mpd_resolve_url) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_mpd_get_duration) )
@@ -2291,6 +2326,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_props_get_description) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_filters_registers_count) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_get_filter_register) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_fs_add_filter_register) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_lock_filters) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_get_filters_count) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_get_filter_stats) )
@@ -2422,13 +2422,43 @@ struct _gf_filter_setup_failure
 	GF_Filter *filter;
 	GF_Filter *notify_filter;
 	Bool do_disconnect;
+	u32 nb_requeue;
 } filter_setup_failure;
 
+//number of immediate requeues of the setup failure task while the filter has pending tasks, before backing off
+#define SETUP_FAILURE_REQUEUE_NOWAIT	10
+//max number of requeues of the setup failure task, the filter is then left for destruction at session end
+#define SETUP_FAILURE_REQUEUE_MAX	100
+
 static void gf_filter_setup_failure_task(GF_FSTask *task)
 {
 	s32 res;
 	GF_Err e;
-	GF_Filter *f = ((struct _gf_filter_setup_failure *)task->udta)->filter;
+	struct _gf_filter_setup_failure *st = (struct _gf_filter_setup_failure *)task->udta;
+	GF_Filter *f = st->filter;
+
+	//this task is not attached to the filter and may run on another thread while a task of the filter (pid init or
+	//delete, ...) is still being processed, in which case the filter is still referenced by the scheduler: wait
+	gf_mx_p(f->tasks_mx);
+	if (gf_fq_count(f->tasks)) {
+		gf_mx_v(f->tasks_mx);
+		st->nb_requeue++;
+		if (st->nb_requeue > SETUP_FAILURE_REQUEUE_MAX) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_FILTER, ("Filter %s still has %d pending tasks after setup failure, will be destroyed at session end\n", f->name, gf_fq_count(f->tasks)));
+			f->session->last_connect_error = st->e;
+			gf_free(st);
+			return;
+		}
+		//pending filter tasks are usually done quickly, back off if not to avoid spinning on the task list
+		if (st->nb_requeue > SETUP_FAILURE_REQUEUE_NOWAIT) {
+			u32 delay = st->nb_requeue - SETUP_FAILURE_REQUEUE_NOWAIT;
+			task->schedule_next_time = gf_sys_clock_high_res() + 1000 * MIN(delay, 20);
+		}
+		task->requeue_request = GF_TRUE;
+		return;
+	}
+	gf_mx_v(f->tasks_mx);
+
 	if (task->udta) {
 		e = ((struct _gf_filter_setup_failure *)task->udta)->e;
 		gf_free(task->udta);
@@ -2473,6 +2503,7 @@ void gf_filter_notification_failure(GF_Filter *filter, GF_Err reason, Bool force
 
 	stack = gf_malloc(sizeof(struct _gf_filter_setup_failure));
 	stack->e = reason;
+	stack->nb_requeue = 0;
 	stack->notify_filter = filter->on_setup_error_filter;
 	stack->filter = filter;
 	stack->do_disconnect = force_disconnect;
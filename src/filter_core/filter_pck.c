@@ -36,6 +36,28 @@ static void gf_filter_pck_reset_props(GF_FilterPacket *pck, GF_FilterPid *pid)
 	pck->session = pid->filter->session;
 }
 
+//packet property maps are shared between packets (merge, ref props, reassembly) and copied on first write
+static GF_Err gf_filter_pck_props_make_writable(GF_FilterPacket *pck)
+{
+	GF_Err e;
+	GF_PropertyMap *map, *shared = pck->props;
+	if (!shared) {
+		pck->props = gf_props_new(pck->pid->filter);
+		return pck->props ? GF_OK : GF_OUT_OF_MEM;
+	}
+	if (shared->reference_count == 1) return GF_OK;
+
+	map = gf_props_new(pck->pid->filter);
+	if (!map) return GF_OUT_OF_MEM;
+	e = gf_props_merge_property(map, shared, NULL, NULL);
+	pck->props = map;
+	assert(shared->reference_count);
+	if (safe_int_dec(&shared->reference_count) == 0) {
+		gf_props_del(shared);
+	}
+	return e;
+}
+
 GF_EXPORT
 GF_Err gf_filter_pck_merge_properties_filter(GF_FilterPacket *pck_src, GF_FilterPacket *pck_dst, gf_filter_prop_filter filter_prop, void *cbk)
 {
@@ -54,11 +76,14 @@ GF_Err gf_filter_pck_merge_properties_filter(GF_FilterPacket *pck_src, GF_Filter
 	if (!pck_src->props) {
 		return GF_OK;
 	}
-	if (!pck_dst->props) {
-		pck_dst->props = gf_props_new(pck_dst->pid->filter);
-
-		if (!pck_dst->props) return GF_OUT_OF_MEM;
+	//no filtering and no properties yet, share source map
+	if (!pck_dst->props && !filter_prop) {
+		pck_dst->props = pck_src->props;
+		safe_int_inc(&pck_dst->props->reference_count);
+		return GF_OK;
 	}
+	if (gf_filter_pck_props_make_writable(pck_dst) != GF_OK) return GF_OUT_OF_MEM;
+
 	return gf_props_merge_property(pck_dst->props, pck_src->props, filter_prop, cbk);
 }
 
@@ -1071,17 +1096,9 @@ GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 					inst->pck->reference = NULL;
 					inst->pck->destructor = NULL;
 					inst->pck->frame_ifce = NULL;
-					if (pck->props) {
-						GF_Err e;
-						inst->pck->props = gf_props_new(pck->pid->filter);
-						if (inst->pck->props) {
-							e = gf_props_merge_property(inst->pck->props, pck->props, NULL, NULL);
-						} else {
-							e = GF_OUT_OF_MEM;
-						}
-						if (e) {
-							GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Filter %s: failed to copy properties for cloned packet: %s\n", pid->filter->name, gf_error_to_string(e) ));
-						}
+					//share property map with the source packet
+					if (inst->pck->props) {
+						safe_int_inc(&inst->pck->props->reference_count);
 					}
 					if (inst->pck->pid_props) {
 						safe_int_inc(&inst->pck->pid_props->reference_count);
@@ -1263,7 +1280,9 @@ static GF_Err gf_filter_pck_set_property_full(GF_FilterPacket *pck, u32 prop_4cc
 
 	if (!pck->props) {
 		pck->props = gf_props_new(pck->pid->filter);
+		if (!pck->props) return GF_OUT_OF_MEM;
 	} else {
+		if (gf_filter_pck_props_make_writable(pck) != GF_OK) return GF_OUT_OF_MEM;
 		gf_props_remove_property(pck->props, hash, prop_4cc, prop_name ? prop_name : dyn_name);
 	}
 	if (!value) return GF_OK;
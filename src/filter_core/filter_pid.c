@@ -1576,6 +1576,14 @@ static Bool cap_code_match(u32 c1, u32 c2)
 	return GF_FALSE;
 }
 
+//most caps are stream types and codec IDs, check them without going through the generic property comparison
+static GFINLINE Bool cap_prop_equal(const GF_PropertyValue *p1, const GF_PropertyValue *p2)
+{
+	if ((p1->type==GF_PROP_UINT) && (p2->type==GF_PROP_UINT))
+		return (p1->value.uint==p2->value.uint) ? GF_TRUE : GF_FALSE;
+	return gf_props_equal(p1, p2);
+}
+
 
 Bool gf_filter_pid_caps_match(GF_FilterPid *src_pid_or_ipid, const GF_FilterRegister *freg, GF_Filter *filter_inst, u8 *priority, u32 *dst_bundle_idx, GF_Filter *dst_filter, s32 for_bundle_idx)
 {
@@ -1758,7 +1766,7 @@ Bool gf_filter_pid_caps_match(GF_FilterPid *src_pid_or_ipid, const GF_FilterRegi
 				}
 
 				if (!prop_equal) {
-					prop_equal = gf_props_equal(pid_cap, &a_cap->val);
+					prop_equal = cap_prop_equal(pid_cap, &a_cap->val);
 					//excluded cap: if value match, don't match this cap at all
 					if (a_cap->flags & GF_CAPFLAG_EXCLUDED) {
 						if (prop_equal) {
@@ -2031,7 +2039,7 @@ u32 gf_filter_caps_to_caps_match(const GF_FilterRegister *src, u32 src_bundle_id
 
 				nb_caps_tested++;
 				//we found a property of that type , check if equal equal
-				prop_equal = gf_props_equal(&in_cap->val, &an_out_cap->val);
+				prop_equal = cap_prop_equal(&in_cap->val, &an_out_cap->val);
 				if ((in_cap->flags & GF_CAPFLAG_EXCLUDED) && !(an_out_cap->flags & GF_CAPFLAG_EXCLUDED) ) {
 					//prop type matched, output includes it and input excludes it: no match, don't look any further
 					if (prop_equal) {
@@ -2383,6 +2391,174 @@ static u32 gf_filter_pid_enable_edges(GF_FilterSession *fsess, GF_FilterRegDesc
 }
 
 
+//hashed bit of a property code or value in precompiled caps masks
+static GFINLINE u64 cap_hash_bit(u32 val)
+{
+	return 1ULL << ((u32) (val * 0x9E3779B1) >> 26);
+}
+//file extension and mime are considered as the same property, as in cap_code_match
+static GFINLINE u64 cap_code_bit(u32 code)
+{
+	if (code==GF_PROP_PID_MIME) code = GF_PROP_PID_FILE_EXT;
+	return cap_hash_bit(code);
+}
+static const u32 cap_value_codes[CAPS_NB_VALUE_CODES] = {GF_PROP_PID_STREAM_TYPE, GF_PROP_PID_CODECID};
+
+static s32 cap_value_code_idx(u32 code)
+{
+	u32 i;
+	for (i=0; i<CAPS_NB_VALUE_CODES; i++) {
+		if (cap_value_codes[i]==code) return i;
+	}
+	return -1;
+}
+
+static u64 cap_value_bit(const GF_FilterCapability *cap)
+{
+	//not hashable, can match any value
+	if (cap->val.type != GF_PROP_UINT) return 0xFFFFFFFFFFFFFFFFULL;
+	return cap_hash_bit(cap->val.value.uint);
+}
+
+static u32 caps_nb_bundle_slots(const GF_FilterCapability *caps, u32 nb_caps)
+{
+	u32 i, nb_slots = 1;
+	for (i=0; i<nb_caps; i++) {
+		if (!(caps[i].flags & GF_CAPFLAG_IN_BUNDLE)) nb_slots++;
+	}
+	return nb_slots;
+}
+
+/*precompiles caps of a register descriptor, using the same bundle indexing as gf_filter_caps_to_caps_match:
+- for each input bundle, the codes of all non-optional input caps of the bundle, and the values of these caps for stream type and codec ID
+(any value if the bundle excludes some values)
+- for each output bundle, the codes of output caps checked by gf_filter_caps_to_caps_match for this bundle (static caps of previous
+bundles included) which can only be matched by an input cap with the same code, and all possible values of these caps for stream type
+and codec ID. Caps identified by name only, excluded caps and caps with an excluded alternative are ignored.
+
+A destination input bundle missing one of these codes or values cannot match the source output bundle. Since codes and values are hashed,
+the test may only give false positives, which are then rejected by the full check*/
+static void gf_filter_reg_desc_compile_caps(GF_FilterRegDesc *reg_desc, const GF_FilterCapability *in_caps, u32 nb_in_caps)
+{
+	u32 i, j, k, bidx, start;
+	GF_CapsBundleMask static_req;
+	const GF_FilterCapability *caps = reg_desc->freg->caps;
+	u32 nb_caps = reg_desc->freg->nb_caps;
+
+	reg_desc->nb_bundles = gf_filter_caps_bundle_count(caps, nb_caps);
+	reg_desc->has_output = gf_filter_has_out_caps(caps, nb_caps);
+	reg_desc->nb_out_masks = reg_desc->has_output ? caps_nb_bundle_slots(caps, nb_caps) : 0;
+	//no input bundle: matching depends on configure_pid, don't filter
+	reg_desc->nb_in_masks = gf_filter_caps_bundle_count(in_caps, nb_in_caps) ? caps_nb_bundle_slots(in_caps, nb_in_caps) : 0;
+	if (!reg_desc->nb_in_masks && !reg_desc->nb_out_masks) return;
+
+	reg_desc->in_masks = gf_malloc(sizeof(GF_CapsBundleMask) * (reg_desc->nb_in_masks + reg_desc->nb_out_masks));
+	if (!reg_desc->in_masks) {
+		reg_desc->nb_in_masks = reg_desc->nb_out_masks = 0;
+		return;
+	}
+	memset(reg_desc->in_masks, 0, sizeof(GF_CapsBundleMask) * (reg_desc->nb_in_masks + reg_desc->nb_out_masks));
+	reg_desc->out_masks = reg_desc->nb_out_masks ? reg_desc->in_masks + reg_desc->nb_in_masks : NULL;
+
+	if (reg_desc->nb_in_masks) {
+		bidx = 0;
+		for (i=0; i<nb_in_caps; i++) {
+			s32 vidx;
+			GF_CapsBundleMask *mask = &reg_desc->in_masks[bidx];
+			const GF_FilterCapability *cap = &in_caps[i];
+			if (!(cap->flags & GF_CAPFLAG_IN_BUNDLE)) {
+				bidx++;
+				continue;
+			}
+			if (!(cap->flags & GF_CAPFLAG_INPUT) || (cap->flags & GF_CAPFLAG_OPTIONAL) || !cap->code) continue;
+			mask->codes |= cap_code_bit(cap->code);
+			vidx = cap_value_code_idx(cap->code);
+			if (vidx<0) continue;
+			//excluded values, any other value is accepted
+			if (cap->flags & GF_CAPFLAG_EXCLUDED) mask->values[vidx] = 0xFFFFFFFFFFFFFFFFULL;
+			else mask->values[vidx] |= cap_value_bit(cap);
+		}
+	}
+	if (!reg_desc->nb_out_masks) return;
+
+	memset(&static_req, 0, sizeof(GF_CapsBundleMask));
+	bidx = 0;
+	start = 0;
+	for (i=0; i<=nb_caps; i++) {
+		GF_CapsBundleMask req, sreq;
+		if ((i<nb_caps) && (caps[i].flags & GF_CAPFLAG_IN_BUNDLE)) continue;
+
+		memset(&req, 0, sizeof(GF_CapsBundleMask));
+		memset(&sreq, 0, sizeof(GF_CapsBundleMask));
+		for (j=start; j<i; j++) {
+			s32 vidx;
+			u64 values = 0;
+			Bool skip = GF_FALSE;
+			const GF_FilterCapability *cap = &caps[j];
+			if (!(cap->flags & GF_CAPFLAG_OUTPUT) || !cap->code || (cap->flags & GF_CAPFLAG_EXCLUDED)) continue;
+
+			vidx = cap_value_code_idx(cap->code);
+			for (k=start; k<i; k++) {
+				const GF_FilterCapability *a_cap = &caps[k];
+				if (!(a_cap->flags & GF_CAPFLAG_OUTPUT)) continue;
+				//only the first cap with a given code or name is checked
+				if ((k<j) && ((a_cap->code == cap->code) || (cap->name && a_cap->name && !strcmp(cap->name, a_cap->name)))) {
+					skip = GF_TRUE;
+					break;
+				}
+				if (!cap_code_match(cap->code, a_cap->code)) continue;
+				//an excluded alternative may be matched by the absence of the property
+				if (a_cap->flags & GF_CAPFLAG_EXCLUDED) {
+					skip = GF_TRUE;
+					break;
+				}
+				//any of the alternative values may be matched
+				if (vidx>=0) values |= cap_value_bit(a_cap);
+			}
+			if (skip) continue;
+			req.codes |= cap_code_bit(cap->code);
+			if (vidx>=0) req.values[vidx] |= values;
+			if (cap->flags & GF_CAPFLAG_STATIC) {
+				sreq.codes |= cap_code_bit(cap->code);
+				if (vidx>=0) sreq.values[vidx] |= values;
+			}
+		}
+		if (bidx < reg_desc->nb_out_masks) {
+			GF_CapsBundleMask *mask = &reg_desc->out_masks[bidx];
+			mask->codes = req.codes | static_req.codes;
+			for (k=0; k<CAPS_NB_VALUE_CODES; k++)
+				mask->values[k] = req.values[k] | static_req.values[k];
+		}
+		static_req.codes |= sreq.codes;
+		for (k=0; k<CAPS_NB_VALUE_CODES; k++)
+			static_req.values[k] |= sreq.values[k];
+		bidx++;
+		start = i+1;
+	}
+}
+
+//returns GF_FALSE if output bundle of src cannot match input bundle of dst
+static GFINLINE Bool gf_filter_reg_desc_may_match(GF_FilterRegDesc *src, u32 src_bundle, GF_FilterRegDesc *dst, u32 dst_bundle)
+{
+	u32 i;
+	GF_CapsBundleMask *out, *in;
+	if ((src_bundle >= src->nb_out_masks) || (dst_bundle >= dst->nb_in_masks)) return GF_TRUE;
+	out = &src->out_masks[src_bundle];
+	in = &dst->in_masks[dst_bundle];
+	if (out->codes & ~in->codes) return GF_FALSE;
+	for (i=0; i<CAPS_NB_VALUE_CODES; i++) {
+		if (out->values[i] && !(out->values[i] & in->values[i])) return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
+static void gf_filter_reg_desc_del(GF_FilterRegDesc *reg_desc)
+{
+	if (reg_desc->edges) gf_free(reg_desc->edges);
+	if (reg_desc->in_masks) gf_free(reg_desc->in_masks);
+	gf_free(reg_desc);
+}
+
 static GF_FilterRegDesc *gf_filter_reg_build_graph(GF_List *links, const GF_FilterRegister *freg, GF_CapsBundleStore *capstore, GF_FilterPid *src_pid, GF_Filter *dst_filter)
 {
 	u32 nb_dst_caps, nb_regs, i, nb_caps;
@@ -2402,6 +2578,11 @@ static GF_FilterRegDesc *gf_filter_reg_build_graph(GF_List *links, const GF_Filt
 	if (!reg_desc) return NULL;
 
 	reg_desc->freg = freg;
+	//input caps as used by gf_filter_caps_to_caps_match
+	if (dst_filter && (dst_filter->freg==freg) && dst_filter->forced_caps)
+		gf_filter_reg_desc_compile_caps(reg_desc, dst_filter->forced_caps, dst_filter->nb_forced_caps);
+	else
+		gf_filter_reg_desc_compile_caps(reg_desc, freg->caps, freg->nb_caps);
 
 	nb_dst_caps = gf_filter_caps_bundle_count(caps, nb_caps);
 
@@ -2418,12 +2599,12 @@ static GF_FilterRegDesc *gf_filter_reg_build_graph(GF_List *links, const GF_Filt
 		if (a_reg->freg == freg) continue;
 
 		//check which cap of this filter matches our destination
-		nb_src_caps = gf_filter_caps_bundle_count(a_reg->freg->caps, a_reg->freg->nb_caps);
+		nb_src_caps = a_reg->nb_bundles;
 		for (k=0; k<nb_src_caps; k++) {
 			for (l=0; l<nb_dst_caps; l++) {
 				s32 bundle_idx;
 
-				if (gf_filter_has_out_caps(a_reg->freg->caps, a_reg->freg->nb_caps)) {
+				if (a_reg->has_output && gf_filter_reg_desc_may_match(a_reg, k, reg_desc, l)) {
 					u32 loaded_filter_only_flags = 0;
 
 					path_weight = gf_filter_caps_to_caps_match(a_reg->freg, k, (const GF_FilterRegister *) freg, dst_filter, &bundle_idx, l, &loaded_filter_only_flags, capstore);
@@ -2454,7 +2635,7 @@ static GF_FilterRegDesc *gf_filter_reg_build_graph(GF_List *links, const GF_Filt
 					}
 				}
 
-				if ( freg_has_output ) {
+				if ( freg_has_output && gf_filter_reg_desc_may_match(reg_desc, l, a_reg, k)) {
 					u32 loaded_filter_only_flags = 0;
 
 					path_weight = gf_filter_caps_to_caps_match(freg, l, a_reg->freg, dst_filter, &bundle_idx, k, &loaded_filter_only_flags, capstore);
@@ -2558,14 +2739,12 @@ void gf_filter_sess_reset_graph(GF_FilterSession *fsess, const GF_FilterRegister
 		if (reg_idx>=0) {
 			GF_FilterRegDesc *rdesc = gf_list_get(fsess->links, reg_idx);
 			gf_list_rem(fsess->links, reg_idx);
-			gf_free(rdesc->edges);
-			gf_free(rdesc);
+			gf_filter_reg_desc_del(rdesc);
 		}
 	} else {
 		while (gf_list_count(fsess->links)) {
 			GF_FilterRegDesc *rdesc = gf_list_pop_back(fsess->links);
-			gf_free(rdesc->edges);
-			gf_free(rdesc);
+			gf_filter_reg_desc_del(rdesc);
 		}
 	}
 	gf_mx_v(fsess->links_mx);
@@ -2922,8 +3101,7 @@ static void gf_filter_pid_resolve_link_dijkstra(GF_FilterPid *pid, GF_Filter *ds
 	}
 	gf_list_del(dijkstra_nodes);
 
-	gf_free(reg_dst->edges);
-	gf_free(reg_dst);
+	gf_filter_reg_desc_del(reg_dst);
 }
 
 
@@ -5460,6 +5638,7 @@ const char *gf_filter_event_name(GF_FEventType type)
 	case GF_FEVT_CAPS_CHANGE: return "CAPS_CHANGED";
 	case GF_FEVT_CONNECT_FAIL: return "CONNECT_FAIL";
 	case GF_FEVT_PLAY_HINT: return "PLAY_HINT";
+	case GF_FEVT_FRAGMENT_SIZE: return "FRAGMENT_SIZE";
 	default:
 		return "UNKNOWN";
 	}
@@ -1265,6 +1265,7 @@ GF_BuiltInProperty GF_BuiltInProps [] =
 	{ GF_PROP_PID_MUX_SRC, "MuxSrc", "Name of mux source(s), set by dasher to direct its outputs", GF_PROP_STRING, GF_PROP_FLAG_GSF_REM},
 	{ GF_PROP_PID_DASH_MODE, "DashMode", "DASH mode to be used by muxer if any, set by dasher. 0 is no DASH, 1 is regular DASH, 2 is VoD", GF_PROP_UINT, GF_PROP_FLAG_GSF_REM},
 	{ GF_PROP_PID_DASH_DUR, "DashDur", "DASH target segment duration in seconds to muxer if any, set by dasher", GF_PROP_DOUBLE, GF_PROP_FLAG_GSF_REM},
+	{ GF_PROP_PID_LLHLS, "LLHLS", "LL-HLS target part duration in seconds to muxer if any, set by dasher. Muxer signals each part to dasher and HTTP server keeps segments in memory", GF_PROP_DOUBLE, GF_PROP_FLAG_GSF_REM},
 	{ GF_PROP_PID_DASH_MULTI_PID, NULL, "Pointer to the GF_List of input pids for multi-stsd entries segments, set by dasher", GF_PROP_POINTER, GF_PROP_FLAG_GSF_REM},
 	{ GF_PROP_PID_DASH_MULTI_PID_IDX, NULL, "1-based index of PID in the multi PID list, set by dasher", GF_PROP_UINT, GF_PROP_FLAG_GSF_REM},
 	{ GF_PROP_PID_DASH_MULTI_TRACK, NULL, "Pointer to the GF_List of input pids for multi-tracks segments, set by dasher", GF_PROP_POINTER, GF_PROP_FLAG_GSF_REM},
@@ -1524,7 +1525,7 @@ const char *gf_props_dump_val_ex(const GF_PropertyValue *att, char dump[GF_PROP_
 		for (i=0; i<count; i++) {
 			char szItem[1024];
 			if (is_4cc) {
-				sprintf(szItem, "%s", gf_4cc_to_str(att->value.uint_list.vals[i]) );
+				gf_4cc_to_str_safe(att->value.uint_list.vals[i], szItem);
 			} else {
 				sprintf(szItem, "%u", att->value.uint_list.vals[i]);
 			}
@@ -1578,7 +1579,7 @@ const char *gf_props_dump(u32 p4cc, const GF_PropertyValue *att, char dump[GF_PR
 	case GF_PROP_PID_SUBTYPE:
 	case GF_PROP_PID_ISOM_SUBTYPE:
 	case GF_PROP_PID_ISOM_MBRAND:
-		return gf_4cc_to_str(att->value.uint);
+		return gf_4cc_to_str_safe(att->value.uint, dump);
 	case GF_PROP_PID_PLAYBACK_MODE:
 		if (att->value.uint == GF_PLAYBACK_MODE_SEEK) return "seek";
 		else if (att->value.uint == GF_PLAYBACK_MODE_REWIND) return "rewind";
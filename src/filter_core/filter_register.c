@@ -110,6 +110,7 @@ const GF_FilterRegister *vout_register(GF_FilterSession *session);
 #endif
 const GF_FilterRegister *vcrop_register(GF_FilterSession *session);
 const GF_FilterRegister *vflip_register(GF_FilterSession *session);
+const GF_FilterRegister *vsprite_register(GF_FilterSession *session);
 const GF_FilterRegister *rawvidreframe_register(GF_FilterSession *session);
 const GF_FilterRegister *pcmreframe_register(GF_FilterSession *session);
 const GF_FilterRegister *jpgenc_register(GF_FilterSession *session);
@@ -233,6 +234,7 @@ void gf_fs_reg_all(GF_FilterSession *fsess, GF_FilterSession *a_sess)
 #endif
 	gf_fs_add_filter_register(fsess, vcrop_register(a_sess) );
 	gf_fs_add_filter_register(fsess, vflip_register(a_sess) );
+	gf_fs_add_filter_register(fsess, vsprite_register(a_sess) );
 	gf_fs_add_filter_register(fsess, rawvidreframe_register(a_sess) );
 	gf_fs_add_filter_register(fsess, pcmreframe_register(a_sess) );
 	gf_fs_add_filter_register(fsess, jpgenc_register(a_sess) );
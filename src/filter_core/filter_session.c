@@ -84,6 +84,7 @@ static GFINLINE void gf_fs_sema_io(GF_FilterSession *fsess, Bool notify, Bool ma
 	}
 }
 
+GF_EXPORT
 void gf_fs_add_filter_register(GF_FilterSession *fsess, const GF_FilterRegister *freg)
 {
 	if (!freg) return;
@@ -137,6 +138,9 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, u
 
 	u32 i, count;
 	GF_FilterSession *fsess, *a_sess;
+#ifndef GPAC_DISABLE_LOG
+	u64 start_time = gf_sys_clock_high_res();
+#endif
 
 	//safety check: all built-in properties shall have unique 4CCs
 	if ( ! gf_props_4cc_check_props())
@@ -316,7 +320,9 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, u
 	fsess->gl_providers = gf_list_new();
 #endif
 
-	if (! (fsess->flags & GF_FS_FLAG_NO_GRAPH_CACHE))
+	//the registry graph is built at the first link resolution, so that sessions with only direct connections don't pay for it
+	//we still build it at startup when dumping connections
+	if (fsess->flags & GF_FS_FLAG_PRINT_CONNECTIONS)
 		gf_filter_sess_build_graph(fsess, NULL);
 
 	fsess->init_done = GF_TRUE;
@@ -334,6 +340,7 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, u
 			if (sep) sep[0] = '=';
 		}
 	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_FILTER, ("Filter session created in "LLU" us\n", gf_sys_clock_high_res() - start_time));
 
 	return fsess;
 }
@@ -393,6 +400,193 @@ void gf_fs_push_arg(GF_FilterSession *session, const char *szArg, Bool was_found
 }
 
 
+static u32 gf_fs_trace_writer(void *par);
+
+static void gf_fs_trace_open(GF_FilterSession *fsess, const char *trace_file)
+{
+	u32 i, count;
+	fsess->trace_file = gf_fopen(trace_file, "wt");
+	if (!fsess->trace_file) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_SCHEDULER, ("Failed to open scheduler trace file %s\n", trace_file));
+		return;
+	}
+	fsess->trace_start_time = gf_sys_clock_high_res();
+	//JSON array format, the closing bracket is optional for trace viewers so the file can be loaded while the session runs
+	gf_fprintf(fsess->trace_file, "[\n");
+
+	fsess->trace_buf_size = 0x10000;
+	fsess->trace_buf = gf_malloc(fsess->trace_buf_size);
+	fsess->main_th.trace_events = gf_malloc(sizeof(GF_FSTraceEvent) * GF_FS_TRACE_EVENTS);
+	fsess->main_th.trace_th_idx = 0;
+	count = gf_list_count(fsess->threads);
+	for (i=0; i<count; i++) {
+		GF_SessionThread *sess_th = gf_list_get(fsess->threads, i);
+		sess_th->trace_events = gf_malloc(sizeof(GF_FSTraceEvent) * GF_FS_TRACE_EVENTS);
+		sess_th->trace_th_idx = i+1;
+	}
+	fsess->trace_sema = gf_sema_new(GF_INT_MAX, 0);
+	fsess->trace_th = gf_th_new("SchedulerTrace");
+	gf_th_run(fsess->trace_th, gf_fs_trace_writer, fsess);
+}
+
+//copy a name in a trace event, removing any UTF-8 sequence cut by truncation
+static void gf_fs_trace_copy_name(char *dst, const char *name)
+{
+	u32 len = name ? (u32) strlen(name) : 0;
+	if (len >= GF_FS_TRACE_NAME_LEN) {
+		len = GF_FS_TRACE_NAME_LEN-1;
+		//first byte not copied is a continuation byte, remove the start of the sequence
+		if ((name[len] & 0xC0) == 0x80) {
+			while (len && ((name[len] & 0xC0) != 0xC0)) len--;
+		}
+	}
+	if (len) memcpy(dst, name, len);
+	dst[len] = 0;
+}
+
+//filter and task names are user-defined (filter names, JS task names), escape them as JSON strings
+//dst must hold 6 bytes per source character, \u00XX being the longest escape sequence
+static char *gf_fs_trace_put_str(char *dst, const char *str)
+{
+	while (*str) {
+		u8 c = (u8) *str;
+		if ((c=='"') || (c=='\\')) {
+			*dst++ = '\\';
+			*dst++ = c;
+		} else if (c<0x20) {
+			sprintf(dst, "\\u%04X", c);
+			dst += 6;
+		} else {
+			*dst++ = c;
+		}
+		str++;
+	}
+	return dst;
+}
+
+static char *gf_fs_trace_put_lit(char *dst, const char *str)
+{
+	u32 len = (u32) strlen(str);
+	memcpy(dst, str, len);
+	return dst + len;
+}
+
+//printf is the main cost of writing events, format integers directly
+static char *gf_fs_trace_put_int(char *dst, u64 val)
+{
+	char szVal[20];
+	u32 len = 0;
+	do {
+		szVal[len++] = '0' + (char) (val % 10);
+		val /= 10;
+	} while (val);
+	while (len) *dst++ = szVal[--len];
+	return dst;
+}
+
+//max size of a formatted event
+#define GF_FS_TRACE_EVENT_MAX_SIZE	(2*6*GF_FS_TRACE_NAME_LEN + 512)
+
+//writes events available in a session thread ring, called by the trace writer thread or at session end
+static void gf_fs_trace_flush(GF_FilterSession *fsess, GF_SessionThread *sess_th)
+{
+	char *buf = fsess->trace_buf;
+	u32 nb_read = sess_th->trace_nb_read;
+	u32 nb_written = sess_th->trace_nb_written;
+	if (!sess_th->trace_events || (nb_read == nb_written)) return;
+
+	while (nb_read != nb_written) {
+		GF_FSTraceEvent *evt = &sess_th->trace_events[nb_read % GF_FS_TRACE_EVENTS];
+		if (buf + GF_FS_TRACE_EVENT_MAX_SIZE > fsess->trace_buf + fsess->trace_buf_size) {
+			gf_fwrite(fsess->trace_buf, (u32) (buf - fsess->trace_buf), fsess->trace_file);
+			buf = fsess->trace_buf;
+		}
+		if (fsess->trace_has_events) buf = gf_fs_trace_put_lit(buf, ",\n");
+		fsess->trace_has_events = GF_TRUE;
+
+		buf = gf_fs_trace_put_lit(buf, "{\"name\":\"");
+		buf = gf_fs_trace_put_str(buf, evt->task_name[0] ? evt->task_name : "none");
+		buf = gf_fs_trace_put_lit(buf, evt->filter_name[0] ? "\",\"cat\":\"filter\",\"ph\":\"X\",\"ts\":" : "\",\"cat\":\"session\",\"ph\":\"X\",\"ts\":");
+		buf = gf_fs_trace_put_int(buf, evt->start - fsess->trace_start_time);
+		buf = gf_fs_trace_put_lit(buf, ",\"dur\":");
+		buf = gf_fs_trace_put_int(buf, evt->duration);
+		buf = gf_fs_trace_put_lit(buf, ",\"pid\":0,\"tid\":");
+		buf = gf_fs_trace_put_int(buf, sess_th->trace_th_idx);
+		buf = gf_fs_trace_put_lit(buf, ",\"args\":{\"filter\":\"");
+		buf = gf_fs_trace_put_str(buf, evt->filter_name);
+		buf = gf_fs_trace_put_lit(buf, "\",\"pck\":");
+		buf = gf_fs_trace_put_int(buf, evt->nb_pck);
+		buf = gf_fs_trace_put_lit(buf, ",\"bytes\":");
+		buf = gf_fs_trace_put_int(buf, evt->nb_bytes);
+		buf = gf_fs_trace_put_lit(buf, ",\"sent\":");
+		buf = gf_fs_trace_put_int(buf, evt->nb_pck_sent);
+		buf = gf_fs_trace_put_lit(buf, ",\"tasks_pending\":");
+		buf = gf_fs_trace_put_int(buf, evt->tasks_pending);
+		buf = gf_fs_trace_put_lit(buf, ",\"pending_packets\":");
+		buf = gf_fs_trace_put_int(buf, evt->pending_packets);
+		buf = gf_fs_trace_put_lit(buf, ",\"would_block\":");
+		buf = gf_fs_trace_put_int(buf, evt->would_block);
+		buf = gf_fs_trace_put_lit(buf, evt->requeue ? ",\"requeue\":true}}" : ",\"requeue\":false}}");
+		nb_read++;
+	}
+	gf_fwrite(fsess->trace_buf, (u32) (buf - fsess->trace_buf), fsess->trace_file);
+	//release the ring slots once events are formatted
+	safe_int_add(&sess_th->trace_nb_read, nb_written - sess_th->trace_nb_read);
+}
+
+static void gf_fs_trace_flush_all(GF_FilterSession *fsess)
+{
+	u32 i, count = gf_list_count(fsess->threads);
+	gf_fs_trace_flush(fsess, &fsess->main_th);
+	for (i=0; i<count; i++) {
+		gf_fs_trace_flush(fsess, gf_list_get(fsess->threads, i));
+	}
+}
+
+//events are formatted and written by a dedicated thread so that session threads only copy events in their ring
+//the writer wakes up when a ring is half full and at least every 100 ms so that the trace file can be inspected live
+static u32 gf_fs_trace_writer(void *par)
+{
+	GF_FilterSession *fsess = par;
+	while (!fsess->trace_stop) {
+		gf_sema_wait_for(fsess->trace_sema, 100);
+		gf_fs_trace_flush_all(fsess);
+		gf_fflush(fsess->trace_file);
+	}
+	return 0;
+}
+
+static void gf_fs_trace_close(GF_FilterSession *fsess)
+{
+	u32 i, count;
+	if (!fsess->trace_file) return;
+
+	fsess->trace_stop = GF_TRUE;
+	gf_sema_notify(fsess->trace_sema, 1);
+	gf_th_del(fsess->trace_th);
+	fsess->trace_th = NULL;
+	gf_sema_del(fsess->trace_sema);
+	fsess->trace_sema = NULL;
+
+	gf_fs_trace_flush_all(fsess);
+	gf_free(fsess->main_th.trace_events);
+	fsess->main_th.trace_events = NULL;
+	count = gf_list_count(fsess->threads);
+	for (i=0; i<count; i++) {
+		GF_SessionThread *sess_th = gf_list_get(fsess->threads, i);
+		gf_free(sess_th->trace_events);
+		sess_th->trace_events = NULL;
+	}
+	if (fsess->trace_nb_dropped) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_SCHEDULER, ("Scheduler trace: %u events dropped, trace writer too slow\n", fsess->trace_nb_dropped));
+	}
+	gf_fprintf(fsess->trace_file, "\n]\n");
+	gf_fclose(fsess->trace_file);
+	fsess->trace_file = NULL;
+	gf_free(fsess->trace_buf);
+	fsess->trace_buf = NULL;
+}
+
 GF_EXPORT
 GF_FilterSession *gf_fs_new_defaults(u32 inflags)
 {
@@ -458,6 +652,10 @@ GF_FilterSession *gf_fs_new_defaults(u32 inflags)
 	if (opt)
 		gf_fs_set_separators(fsess, opt);
 
+	opt = gf_opts_get_key("core", "sched-trace");
+	if (opt)
+		gf_fs_trace_open(fsess, opt);
+
 	return fsess;
 }
 
@@ -641,6 +839,8 @@ void gf_fs_del(GF_FilterSession *fsess)
 	if (fsess->tasks_reservoir)
 		gf_fq_del(fsess->tasks_reservoir, gf_void_del);
 
+	gf_fs_trace_close(fsess);
+
 	if (fsess->threads) {
 		if (fsess->main_thread_tasks)
 			gf_fq_del(fsess->main_thread_tasks, gf_void_del);
@@ -1099,6 +1299,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 		Bool requeue = GF_FALSE;
 		u64 active_start, task_time;
 		GF_FSTask *task=NULL;
+		GF_FSTraceEvent *trace_evt=NULL;
 #ifdef CHECK_TASK_LIST_INTEGRITY
 		GF_Filter *prev_current_filter = NULL;
 		Bool skip_filter_task_check = GF_FALSE;
@@ -1454,9 +1655,31 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %u task#%d %p executing Filter %s::%s (%d tasks pending, %d(%d) process task queued)\n", sys_thid, sess_thread->nb_tasks, task, task->filter ? task->filter->name : "none", task->log_name, fsess->tasks_pending, task->filter ? task->filter->process_task_queued : 0, task->filter ? gf_fq_count(task->filter->tasks) : 0));
 
+		if (sess_thread->trace_events) {
+			if (sess_thread->trace_nb_written - sess_thread->trace_nb_read < GF_FS_TRACE_EVENTS) {
+				trace_evt = &sess_thread->trace_events[sess_thread->trace_nb_written % GF_FS_TRACE_EVENTS];
+			} else {
+				safe_int_inc(&fsess->trace_nb_dropped);
+			}
+		}
+		if (trace_evt) {
+			gf_fs_trace_copy_name(trace_evt->task_name, task->log_name);
+			trace_evt->filter_name[0] = 0;
+			trace_evt->nb_pck = trace_evt->nb_bytes = trace_evt->nb_pck_sent = 0;
+			trace_evt->pending_packets = trace_evt->would_block = 0;
+			if (task->filter) {
+				gf_fs_trace_copy_name(trace_evt->filter_name, task->filter->name);
+				//store counters before the task, replaced by deltas once done
+				trace_evt->nb_pck = (u32) task->filter->nb_pck_processed;
+				trace_evt->nb_bytes = (u32) task->filter->nb_bytes_processed;
+				trace_evt->nb_pck_sent = (u32) task->filter->nb_pck_sent;
+			}
+		}
+
 		safe_int_inc(& fsess->tasks_in_process );
 		assert( task->run_task );
 		task_time = gf_sys_clock_high_res();
+		if (trace_evt) trace_evt->start = task_time;
 
 		task->can_swap = GF_FALSE;
 		task->requeue_request = GF_FALSE;
@@ -1469,6 +1692,25 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 		//may now be NULL if task was a filter destruction task
 		current_filter = task->filter;
 
+		if (trace_evt) {
+			trace_evt->duration = task_time;
+			trace_evt->requeue = requeue;
+			trace_evt->tasks_pending = fsess->tasks_pending;
+			if (current_filter) {
+				trace_evt->nb_pck = (u32) current_filter->nb_pck_processed - trace_evt->nb_pck;
+				trace_evt->nb_bytes = (u32) current_filter->nb_bytes_processed - trace_evt->nb_bytes;
+				trace_evt->nb_pck_sent = (u32) current_filter->nb_pck_sent - trace_evt->nb_pck_sent;
+				trace_evt->pending_packets = current_filter->pending_packets;
+				trace_evt->would_block = current_filter->would_block;
+			} else {
+				trace_evt->nb_pck = trace_evt->nb_bytes = trace_evt->nb_pck_sent = 0;
+			}
+			trace_evt = NULL;
+			//publish the event to the trace writer, waking it up when the ring is half full
+			if (safe_int_inc(&sess_thread->trace_nb_written) - sess_thread->trace_nb_read == GF_FS_TRACE_EVENTS/2)
+				gf_sema_notify(fsess->trace_sema, 1);
+		}
+
 #ifdef CHECK_TASK_LIST_INTEGRITY
 		prev_current_filter = task->filter;
 #endif
@@ -2493,6 +2735,15 @@ Bool gf_filter_send_gf_event(GF_Filter *filter, GF_Event *evt)
 }
 
 
+//the registry graph is built on demand by the first link resolution, build it before browsing links outside of link resolution
+static void gf_fs_build_graph_if_needed(GF_FilterSession *fsess)
+{
+	gf_mx_p(fsess->links_mx);
+	if (!fsess->links || ! gf_list_count( fsess->links))
+		gf_filter_sess_build_graph(fsess, NULL);
+	gf_mx_v(fsess->links_mx);
+}
+
 static void gf_fs_print_jsf_connection(GF_FilterSession *session, char *filter_name, void (*print_fn)(FILE *output, GF_SysPrintArgFlags flags, const char *fmt, ...) )
 {
 	GF_CapsBundleStore capstore;
@@ -2504,6 +2755,8 @@ static void gf_fs_print_jsf_connection(GF_FilterSession *session, char *filter_n
 	GF_FilterRegister loaded_freg;
 	Bool has_output, has_input;
 
+	gf_fs_build_graph_if_needed(session);
+
 	js_filter = gf_fs_load_filter(session, filter_name, &e);
 	if (!js_filter) return;
 
@@ -2611,6 +2864,7 @@ void gf_fs_print_all_connections(GF_FilterSession *session, char *filter_name, v
 	u32 i, j, count;
 	u32 llev = gf_log_get_tool_level(GF_LOG_FILTER);
 
+	gf_fs_build_graph_if_needed(session);
 	gf_log_set_tool_level(GF_LOG_FILTER, GF_LOG_INFO);
 	//load JS to inspect its connections
 	if (filter_name && strstr(filter_name, ".js")) {
@@ -3019,12 +3273,14 @@ Bool gf_fs_ui_event(GF_FilterSession *session, GF_Event *uievt)
 
 void gf_fs_check_graph_load(GF_FilterSession *fsess, Bool for_load)
 {
+	//when caching the graph, it is built on demand by the first link resolution
+	if (! (fsess->flags & GF_FS_FLAG_NO_GRAPH_CACHE))
+		return;
+
 	if (for_load) {
-		if (!fsess->links || ! gf_list_count( fsess->links))
-			gf_filter_sess_build_graph(fsess, NULL);
+		gf_fs_build_graph_if_needed(fsess);
 	} else {
-		if (fsess->flags & GF_FS_FLAG_NO_GRAPH_CACHE)
-			gf_filter_sess_reset_graph(fsess, NULL);
+		gf_filter_sess_reset_graph(fsess, NULL);
 	}
 }
 
@@ -267,6 +267,28 @@ void gf_fs_post_task_ex(GF_FilterSession *fsess, gf_fs_task_callback task_fun, G
 void gf_filter_pid_send_event_downstream(GF_FSTask *task);
 
 
+//max length of filter and task names copied in scheduler trace events
+#define GF_FS_TRACE_NAME_LEN	32
+//size of the per-thread scheduler trace event ring, events are dropped when the ring is full
+#define GF_FS_TRACE_EVENTS	4096
+
+typedef struct
+{
+	//copy of task name, since some task names are allocated and freed with the task (JS tasks)
+	char task_name[GF_FS_TRACE_NAME_LEN];
+	//copy of filter name, since the filter may be destroyed before events are written
+	char filter_name[GF_FS_TRACE_NAME_LEN];
+	//start time and duration of task in microseconds
+	u64 start, duration;
+	//packets and bytes processed, packets sent by the filter during the task
+	u32 nb_pck, nb_bytes, nb_pck_sent;
+	//number of tasks pending in session and number of packets pending in filter input queues after the task
+	u32 tasks_pending, pending_packets;
+	//number of output pids blocking for the filter after the task
+	u32 would_block;
+	Bool requeue;
+} GF_FSTraceEvent;
+
 typedef struct __gf_fs_thread
 {
 	//NULL for main thread
@@ -285,6 +307,12 @@ typedef struct __gf_fs_thread
 	char rmt_name[20];
 #endif
 
+	//scheduler trace event ring, events are only written by this thread and only read by the trace writer thread
+	GF_FSTraceEvent *trace_events;
+	//number of events written by this thread and read by the trace writer, ring index is count modulo GF_FS_TRACE_EVENTS
+	volatile u32 trace_nb_written, trace_nb_read;
+	u32 trace_th_idx;
+
 } GF_SessionThread;
 
 typedef struct
@@ -423,6 +451,18 @@ struct __gf_filter_session
 	//internal video output to hidden window for GL context
 	struct _video_out *gl_driver;
 
+	//scheduler trace output, NULL if disabled
+	FILE *trace_file;
+	//trace writer thread, formatting and writing events from the session threads rings
+	GF_Thread *trace_th;
+	GF_Semaphore *trace_sema;
+	volatile Bool trace_stop;
+	volatile u32 trace_nb_dropped;
+	u64 trace_start_time;
+	Bool trace_has_events;
+	char *trace_buf;
+	u32 trace_buf_size;
+
 #ifdef GPAC_HAS_QJS
 	struct JSContext *js_ctx;
 	GF_List *jstasks;
@@ -982,6 +1022,18 @@ typedef struct
 	s32 src_stream_type;
 } GF_FilterRegEdge;
 
+//number of properties with value masks in precompiled caps (stream type and codec ID)
+#define CAPS_NB_VALUE_CODES	2
+
+//precompiled caps of a bundle, see gf_filter_reg_desc_compile_caps
+typedef struct
+{
+	//hashed property codes
+	u64 codes;
+	//hashed values for stream type and codec ID
+	u64 values[CAPS_NB_VALUE_CODES];
+} GF_CapsBundleMask;
+
 typedef struct __freg_desc
 {
 	const GF_FilterRegister *freg;
@@ -992,6 +1044,11 @@ typedef struct __freg_desc
 	u32 cap_idx;
 	u8 priority;
 	u8 in_edges_enabling;
+
+	//precompiled caps indexed by cap bundle, NULL if not computed
+	u32 nb_bundles, nb_in_masks, nb_out_masks;
+	Bool has_output;
+	GF_CapsBundleMask *in_masks, *out_masks;
 } GF_FilterRegDesc;
 
 #ifdef GPAC_MEMORY_TRACKING
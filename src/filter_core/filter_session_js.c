@@ -40,6 +40,8 @@ typedef struct __jsfs_task
 	JSValue _obj;
 	u32 type;
 	JSContext *ctx;
+	//task name, kept for the task lifetime since the session does not copy it
+	char *name;
 } JSFS_Task;
 
 static void jsfs_mark(JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark_func)
@@ -208,6 +210,7 @@ static Bool jsfs_task_exec(GF_FilterSession *fs, void *udta, u32 *timeout_ms)
 		JS_FreeValue(task->ctx, task->fun);
 		JS_FreeValue(task->ctx, task->_obj);
 		gf_list_del_item(fs->jstasks, task);
+		if (task->name) gf_free(task->name);
 		gf_free(task);
 		return GF_FALSE;
 	}
@@ -233,9 +236,10 @@ static JSValue jsfs_post_task(JSContext *ctx, JSValueConst this_val, int argc, J
 	task->_obj = JS_DupValue(ctx, this_val);
 	gf_list_add(fs->jstasks, task);
 
-	gf_fs_post_user_task(fs, jsfs_task_exec, task, tname ? tname : "task");
+	task->name = gf_strdup(tname ? tname : "task");
 	if (tname)
 		JS_FreeCString(ctx, tname);
+	gf_fs_post_user_task(fs, jsfs_task_exec, task, task->name);
 
     return JS_UNDEFINED;
 }
@@ -373,6 +377,7 @@ static JSValue jsfs_set_fun_callback(JSContext *ctx, JSValueConst this_val, int
 			JS_FreeValue(ctx, task->fun);
 			JS_FreeValue(ctx, task->_obj);
 			gf_list_del_item(fs->jstasks, task);
+			if (task->name) gf_free(task->name);
 			gf_free(task);
 		}
 		if (cbk_type == 1)
@@ -1205,6 +1210,7 @@ void gf_fs_unload_script(GF_FilterSession *fs, void *js_ctx)
 			continue;
 		JS_FreeValue(task->ctx, task->fun);
 		JS_FreeValue(task->ctx, task->_obj);
+		if (task->name) gf_free(task->name);
 		gf_free(task);
 		gf_list_rem(fs->jstasks, i);
 		i--;
@@ -92,6 +92,13 @@ enum
 	DASHER_MUX_AUTO,
 };
 
+enum
+{
+	DASHER_MANIFEST_ALL=0,
+	DASHER_MANIFEST_MPD_ONLY,
+	DASHER_MANIFEST_HLS_ONLY,
+};
+
 typedef struct
 {
 	u32 bs_switch, profile, cp, ntp;
@@ -122,6 +129,7 @@ typedef struct
 	Bool sigfrag;
 	u32 sbound;
 	char *utcs;
+	Double llhls;
 
 
 	//internal
@@ -181,6 +189,13 @@ typedef struct
 	Bool utc_initialized;
 	DasherUTCTimingType utc_timing_type;
 	s32 utc_diff;
+
+	//memory file used to render manifests, reused across updates
+	FILE *manifest_mem;
+	//CRC and size of last M3U8 master playlist sent on each output pid
+	u32 m3u8_master_crc[2], m3u8_master_size[2];
+	//LL-HLS parts signaled since last variant playlists update
+	Bool llhls_update;
 } GF_DasherCtx;
 
 typedef enum
@@ -996,6 +1011,10 @@ static GF_Err dasher_setup_mpd(GF_DasherCtx *ctx)
 	GF_MPD_ProgramInfo *info;
 	ctx->mpd = gf_mpd_new();
 	ctx->mpd->xml_namespace = "urn:mpeg:dash:schema:mpd:2011";
+	if (ctx->llhls>0) {
+		if (ctx->do_m3u8) ctx->mpd->llhls_part_dur = ctx->llhls;
+		else GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] LL-HLS requires HLS output, ignoring\n"));
+	}
 	ctx->mpd->base_URLs = gf_list_new();
 	ctx->mpd->locations = gf_list_new();
 	ctx->mpd->program_infos = gf_list_new();
@@ -2361,6 +2380,7 @@ static void dasher_open_pid(GF_Filter *filter, GF_DasherCtx *ctx, GF_DashStream
 	gf_filter_pid_set_property(ds->opid, GF_PROP_PID_MUX_SRC, &PROP_STRING(szSRC) );
 	gf_filter_pid_set_property(ds->opid, GF_PROP_PID_DASH_MODE, &PROP_UINT(ctx->sseg ? 2 : 1) );
 	gf_filter_pid_set_property(ds->opid, GF_PROP_PID_DASH_DUR, &PROP_DOUBLE(ds->dash_dur) );
+	gf_filter_pid_set_property(ds->opid, GF_PROP_PID_LLHLS, ctx->mpd->llhls_part_dur ? &PROP_DOUBLE(ctx->mpd->llhls_part_dur) : NULL);
 
 	if (ds->id != ds->pid_id) {
 		dasher_update_dep_list(ctx, ds, "isom:scal");
@@ -3245,19 +3265,19 @@ static void dasher_update_period_duration(GF_DasherCtx *ctx, Bool is_period_swit
 	}
 }
 
-static void dasher_transfer_file(FILE *f, GF_FilterPid *opid, const char *name)
+static void dasher_send_manifest_data(FILE *f, GF_FilterPid *opid, const char *name)
 {
 	GF_FilterPacket *pck;
-	u32 size, nb_read;
+	u32 size;
 	u8 *output;
-
-	size = (u32) gf_fsize(f);
+	const u8 *data = gf_file_temp_mem_data(f, &size);
 
 	pck = gf_filter_pck_new_alloc(opid, size, &output);
-	nb_read = (u32) gf_fread(output, size, f);
-	if (nb_read != size) {
-		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] Error reading temp MPD file, read %d bytes but file size is %d\n", nb_read, size ));
+	if (!pck) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] Failed to allocate manifest packet of %d bytes\n", size));
+		return;
 	}
+	if (size) memcpy(output, data, size);
 	gf_filter_pck_set_framing(pck, GF_TRUE, GF_TRUE);
 	gf_filter_pck_set_seek_flag(pck, GF_TRUE);
 	if (name) {
@@ -3266,12 +3286,25 @@ static void dasher_transfer_file(FILE *f, GF_FilterPid *opid, const char *name)
 	gf_filter_pck_send(pck);
 }
 
+//checks if a playlist changed since last sent, updating the stored CRC and size
+static Bool dasher_manifest_changed(FILE *f, u32 *last_crc, u32 *last_size)
+{
+	u32 size, crc;
+	const u8 *data = gf_file_temp_mem_data(f, &size);
+	crc = data ? gf_crc_32(data, size) : 0;
+	if (*last_size && (*last_size == size) && (*last_crc == crc))
+		return GF_FALSE;
+	*last_crc = crc;
+	*last_size = size;
+	return GF_TRUE;
+}
+
 static u64 dasher_get_utc(GF_DasherCtx *ctx)
 {
 	return gf_net_get_utc() - ctx->utc_diff;
 }
 
-GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_only)
+GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, u32 mode)
 {
 	GF_Err e;
 	u32 i, max_opid;
@@ -3287,7 +3320,9 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 		GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] patch for old regression tests hit, changing max seg dur from 1022 to 1080\nPlease notify GPAC devs to remove this, and do not use fot_test modes in dash filter\n"));
 	}
 
-	ctx->mpd->publishTime = dasher_get_utc(ctx);
+	//LL-HLS part update, only variant playlists are modified
+	if (mode!=DASHER_MANIFEST_HLS_ONLY)
+		ctx->mpd->publishTime = dasher_get_utc(ctx);
 	if (ctx->utc_timing_type==DASHER_UTCREF_INBAND) {
 		GF_MPD_Descriptor *d = gf_list_get(ctx->mpd->utc_timings, 0);
 		if (d) {
@@ -3338,7 +3373,6 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 	max_opid = (ctx->dual && ctx->opid_alt) ? 2 : 1;
 	for (i=0; i < max_opid; i++) {
 		Bool do_m3u8 = GF_FALSE;
-		tmp = gf_file_temp(NULL);
 		GF_FilterPid *opid;
 
 		if (i==0) {
@@ -3353,8 +3387,21 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 			opid = ctx->opid_alt;
 		}
 
+		if (do_m3u8 && (mode==DASHER_MANIFEST_MPD_ONLY)) continue;
+		if (!do_m3u8 && (mode==DASHER_MANIFEST_HLS_ONLY)) continue;
+
+		if (!ctx->manifest_mem) {
+			ctx->manifest_mem = gf_file_temp_mem();
+			if (!ctx->manifest_mem) {
+				if (ctx->current_period->period)
+					ctx->current_period->period->duration = last_period_dur;
+				return GF_OUT_OF_MEM;
+			}
+		}
+		tmp = ctx->manifest_mem;
+		gf_file_temp_mem_reset(tmp);
+
 		if (do_m3u8) {
-			if (for_mpd_only) continue;
 			ctx->mpd->m3u8_time = ctx->hlsc;
 			e = gf_mpd_write_m3u8_master_playlist(ctx->mpd, tmp, ctx->out_path, gf_list_get(ctx->mpd->periods, 0) );
 		} else {
@@ -3363,7 +3410,6 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 
 		if (e) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] failed to write %s file: %s\n", do_m3u8 ? "M3U8" : "MPD", gf_error_to_string(e) ));
-			gf_fclose(tmp);
 			if (ctx->current_period->period)
 				ctx->current_period->period->duration = last_period_dur;
 			return e;
@@ -3374,8 +3420,11 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 				GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] manifest MPD is too big for HbbTV 1.5. Limit is 100kB, current size is "LLU"kB\n", gf_ftell(tmp) / 1024));
 		}
 
-		dasher_transfer_file(tmp, opid, NULL);
-		gf_fclose(tmp);
+		//the master playlist only changes when the set of variants changes, don't resend it
+		if (do_m3u8 && !dasher_manifest_changed(tmp, &ctx->m3u8_master_crc[i], &ctx->m3u8_master_size[i]))
+			continue;
+
+		dasher_send_manifest_data(tmp, opid, NULL);
 	}
 
 	if (ctx->current_period->period)
@@ -3403,6 +3452,10 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 					char *outfile = rep->m3u8_var_name;
 					Bool do_free = GF_FALSE;
 
+					//variant playlist not modified since last update
+					if (!dasher_manifest_changed(rep->m3u8_var_file, &rep->m3u8_var_crc, &rep->m3u8_var_size))
+						continue;
+
 					if (rep->m3u8_name) {
 						outfile = (char *) rep->m3u8_name;
 						if (ctx->out_path) {
@@ -3410,9 +3463,7 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 							do_free = GF_TRUE;
 						}
 					}
-					dasher_transfer_file(rep->m3u8_var_file, ctx->opid, outfile);
-					gf_fclose(rep->m3u8_var_file);
-					rep->m3u8_var_file = NULL;
+					dasher_send_manifest_data(rep->m3u8_var_file, ctx->opid, outfile);
 					if (do_free) gf_free(outfile);
 				}
 			}
@@ -3420,7 +3471,7 @@ GF_Err dasher_send_manifest(GF_Filter *filter, GF_DasherCtx *ctx, Bool for_mpd_o
 	}
 
 
-	if (ctx->state) {
+	if (ctx->state && (mode!=DASHER_MANIFEST_HLS_ONLY)) {
 		tmp = gf_fopen(ctx->state, "w");
 		if (!tmp) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] failed to open context MPD %s for write\n", ctx->state ));
@@ -3690,6 +3741,8 @@ static GF_Err dasher_reload_context(GF_Filter *filter, GF_DasherCtx *ctx)
 
 	if (!ctx->mpd->xml_namespace)
 		ctx->mpd->xml_namespace = "urn:mpeg:dash:schema:mpd:2011";
+	if ((ctx->llhls>0) && ctx->do_m3u8)
+		ctx->mpd->llhls_part_dur = ctx->llhls;
 
 	if (e != GF_OK) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] Cannot reload MPD state %s: %s\n", ctx->state, gf_error_to_string(e) ));
@@ -3954,7 +4007,7 @@ static void dasher_udpate_periods_and_manifest(GF_Filter *filter, GF_DasherCtx *
 
 	//we have a MPD ready, flush it
 	if (ctx->mpd)
-		dasher_send_manifest(filter, ctx, GF_FALSE);
+		dasher_send_manifest(filter, ctx, DASHER_MANIFEST_ALL);
 }
 
 typedef struct
@@ -5673,6 +5726,12 @@ static GF_Err dasher_process(GF_Filter *filter)
 		return GF_EOS;
 	if (ctx->setup_failure) return ctx->setup_failure;
 
+	//new LL-HLS parts, update variant playlists
+	if (ctx->llhls_update) {
+		ctx->llhls_update = GF_FALSE;
+		dasher_send_manifest(filter, ctx, DASHER_MANIFEST_HLS_ONLY);
+	}
+
 	nb_init = has_init = nb_reg_done = 0;
 
 	count = gf_list_count(ctx->current_period->streams);
@@ -5883,7 +5942,7 @@ static GF_Err dasher_process(GF_Filter *filter)
 
 			//ready to write MPD for the first time in dynamic mode with template
 			if (has_init && (nb_init==count) && (ctx->dmode==GF_MPD_TYPE_DYNAMIC) && ctx->tpl && ctx->do_mpd) {
-				e = dasher_send_manifest(filter, ctx, GF_TRUE);
+				e = dasher_send_manifest(filter, ctx, DASHER_MANIFEST_MPD_ONLY);
 				if (e) return e;
 			}
 			cts -= ds->first_cts;
@@ -6375,7 +6434,7 @@ static GF_Err dasher_process(GF_Filter *filter)
 				dasher_update_period_duration(ctx, GF_FALSE);
 
 			if (update_manifest)
-				dasher_send_manifest(filter, ctx, GF_FALSE);
+				dasher_send_manifest(filter, ctx, DASHER_MANIFEST_ALL);
 		}
 
 	}
@@ -6493,6 +6552,53 @@ static void dasher_resume_subdur(GF_Filter *filter, GF_DasherCtx *ctx)
 	gf_filter_post_process_task(filter);
 }
 
+static void dasher_llhls_part(GF_Filter *filter, GF_DasherCtx *ctx, const GF_FilterEvent *evt)
+{
+	u32 i, count;
+	GF_DASH_SegmentContext *sctx;
+	GF_DASH_FragmentContext *frag;
+	GF_DashStream *ds = NULL;
+
+	count = gf_list_count(ctx->pids);
+	for (i=0; i<count; i++) {
+		ds = gf_list_get(ctx->pids, i);
+		if (ds->opid == evt->base.on_pid) break;
+		ds = NULL;
+	}
+	if (!ds || !ctx->mpd || !ctx->mpd->llhls_part_dur) return;
+	if (ds->muxed_base)
+		ds = ds->muxed_base;
+
+	//part of the segment currently produced by the muxer
+	sctx = gf_list_get(ds->pending_segment_states, 0);
+	if (!sctx) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] Received part info event but no pending segments\n"));
+		return;
+	}
+	if (evt->frag_size.size) {
+		if (sctx->nb_frags == sctx->alloc_frags) {
+			sctx->alloc_frags = sctx->alloc_frags ? 2*sctx->alloc_frags : 10;
+			sctx->frags = gf_realloc(sctx->frags, sizeof(GF_DASH_FragmentContext) * sctx->alloc_frags);
+			if (!sctx->frags) {
+				sctx->nb_frags = sctx->alloc_frags = 0;
+				return;
+			}
+		}
+		frag = &sctx->frags[sctx->nb_frags];
+		sctx->nb_frags++;
+		frag->offset = evt->frag_size.offset;
+		frag->size = evt->frag_size.size;
+		frag->dur = evt->frag_size.duration.num;
+		if (evt->frag_size.duration.den && (evt->frag_size.duration.den != ds->timescale))
+			frag->dur = frag->dur * ds->timescale / evt->frag_size.duration.den;
+		frag->independent = evt->frag_size.independent;
+	}
+	if (evt->frag_size.is_last)
+		sctx->llhls_done = GF_TRUE;
+
+	ctx->llhls_update = GF_TRUE;
+	gf_filter_post_process_task(filter);
+}
 
 static Bool dasher_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 {
@@ -6527,6 +6633,11 @@ static Bool dasher_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		return GF_FALSE;
 	}
 
+	if (evt->base.type == GF_FEVT_FRAGMENT_SIZE) {
+		dasher_llhls_part(filter, ctx, evt);
+		return GF_TRUE;
+	}
+
 	if (evt->base.type != GF_FEVT_SEGMENT_SIZE) return GF_FALSE;
 
 	count = gf_list_count(ctx->pids);
@@ -6551,6 +6662,7 @@ static Bool dasher_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 			sctx->file_offset = evt->seg_size.media_range_start;
 			sctx->index_size = 1 + (u32) (evt->seg_size.idx_range_end - evt->seg_size.idx_range_start);
 			sctx->index_offset = evt->seg_size.idx_range_start;
+			sctx->llhls_done = GF_TRUE;
 		}
 
 		//in state mode we store everything
@@ -6837,6 +6949,25 @@ static GF_Err dasher_initialize(GF_Filter *filter)
 	if ((ctx->tsb>=0) && (ctx->dmode!=GF_DASH_STATIC))
 		ctx->purge_segments = GF_TRUE;
 
+	if (ctx->llhls>0) {
+		if (ctx->dmode!=GF_DASH_DYNAMIC) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] LL-HLS requires dynamic mode, disabling\n"));
+			ctx->llhls = 0;
+		} else if (ctx->m2ts || (ctx->muxtype!=DASHER_MUX_ISOM)) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] LL-HLS only supported for ISOBMFF segments, disabling\n"));
+			ctx->llhls = 0;
+		} else if (ctx->sseg || ctx->sfile) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] LL-HLS not supported in single file or single segment mode, disabling\n"));
+			ctx->llhls = 0;
+		} else if (ctx->subs_sidx>=0) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] LL-HLS not supported with segment index, disabling\n"));
+			ctx->llhls = 0;
+		} else if (ctx->llhls >= ctx->segdur) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] LL-HLS part duration %g greater than segment duration %g, disabling\n", ctx->llhls, ctx->segdur));
+			ctx->llhls = 0;
+		}
+	}
+
 	if (ctx->state && ctx->sreg) {
 		u32 diff;
 		u64 next_gen_ntp;
@@ -6873,6 +7004,7 @@ static void dasher_finalize(GF_Filter *filter)
 	gf_free(ctx->next_period);
 	if (ctx->out_path) gf_free(ctx->out_path);
 	gf_list_del(ctx->postponed_pids);
+	if (ctx->manifest_mem) gf_fclose(ctx->manifest_mem);
 }
 
 #define MPD_EXTS "mpd|m3u8|3gm|ism"
@@ -7003,6 +7135,7 @@ static const GF_FilterArgs DasherArgs[] =
 	{ OFFS(loop), "loop sources when dashing with subdur and state. If not set, a new period is created once the sources are over", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(split), "enable cloning samples for text/metadata/scene description streams, marking further clones as redundant", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(hlsc), "insert clock reference in variant playlist in live HLS", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(llhls), "target part duration in seconds for low-latency HLS, 0 disables - see filter help", GF_PROP_DOUBLE, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(cues), "set cue file - see filter help", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(strict_cues), "strict mode for cues, complains if spliting is not on SAP type 1/2/3 or if unused cue is found", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(strict_sap), "strict mode for sap\n"
@@ -7163,6 +7296,16 @@ GF_FilterRegister DasherRegister = {
 			"EX -i seglist.txt:Template=$XInit=init$$q1/$Number$ -o dash.mpd:sigfrag:profile=live\n"
 			"This will generate a DASH manifest in live Profile based on the input files. The input file will contain `init.mp4`, `q1/1.m4s`, `q1/2.m4s`...\n"
 			"\n"
+			"## Low-latency HLS\n"
+			"The segmenter can produce low-latency HLS playlists using [-llhls](), giving the target part duration in seconds.\n"
+			"In this mode, the muxer signals each fragment (part) it writes and variant playlists are updated for each part with:\n"
+			"- EXT-X-PART entries for the last segments and the segment being produced, using byte ranges in the segment file\n"
+			"- EXT-X-PRELOAD-HINT for the next part of the segment being produced\n"
+			"- EXT-X-SERVER-CONTROL signaling blocking playlist reload, which must be implemented by the HTTP server (see `httpout` filter)\n"
+			"This mode is only supported for dynamic HLS with ISOBMFF segments, without segment index, single file or single segment.\n"
+			"EX -i live.mp4 -o http://localhost:8080/live.m3u8:rdirs=dir:segdur=2:llhls=0.5:hlsc\n"
+			"This will produce 2 seconds segments with 0.5 second parts served by the HTTP server.\n"
+			"\n"
 			"## Muxer development considerations\n"
 			"Output muxers allowing segmented output must obey the following:\n"
 			"- inspect packet properties\n"
@@ -7172,6 +7315,7 @@ GF_FilterRegister DasherRegister = {
 			" - EODS: property is set on packets with no payload and no timestamp to signal the end of a DASH segment. This is only used when stoping/resuming the segmentation process, in order to flush segments without dispatching an EOS (see [-subdur]() )\n"
 			"- for each segment done, send a downstream event on the first connected PID signaling the size of the segment and the size of its index if any\n"
 			"- for muxers with init data, send a downstream event signaling the size of the init and the size of the global index if any\n"
+			"- if LLHLS property is set, send a downstream event for each fragment written signaling its size, offset and duration in the segment\n"
 			"- the following filter options are passed to muxers, which should declare them as arguments:\n"
 			" - noinit: disables output of init segment for the muxer (used to handle bitstream switching with single init in DASH)\n"
 			" - frag: indicates muxer shall use fragmented format (used for ISOBMFF mostly)\n"
@@ -7182,6 +7326,7 @@ GF_FilterRegister DasherRegister = {
 			"The segmenter will add the following properties to the output PIDs:\n"
 			"- DashMode: identifies VoD (single file with global index) or regular DASH mode used by segmenter\n"
 			"- DashDur: identifies target DASH segment duration - this can be used to estimate the SIDX size for example\n"
+			"- LLHLS: identifies target LL-HLS part duration, if any\n"
 			)
 	.private_size = sizeof(GF_DasherCtx),
 	.args = DasherArgs,
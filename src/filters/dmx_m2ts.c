@@ -60,6 +60,7 @@ typedef struct
 	//opts
 	const char *temi_url;
 	Bool dsmcc, seeksrc;
+	s32 threads;
 
 	GF_Filter *filter;
 	GF_FilterPid *ipid;
@@ -88,7 +89,7 @@ typedef struct
 } GF_M2TSDmxCtx;
 
 
-static void m2tsdmx_estimate_duration(GF_M2TSDmxCtx *ctx, GF_M2TS_ES *stream)
+static void m2tsdmx_estimate_duration(GF_M2TSDmxCtx *ctx, GF_M2TS_ES *stream, u64 pcr)
 {
 	Bool changed;
 	Double pck_dur;
@@ -106,24 +107,24 @@ static void m2tsdmx_estimate_duration(GF_M2TSDmxCtx *ctx, GF_M2TS_ES *stream)
 	}
 
 	if (!ctx->first_pcr_found) {
-		ctx->first_pcr_found = stream->program->last_pcr_value;
+		ctx->first_pcr_found = pcr;
 		ctx->pcr_pid = stream->pid;
 		ctx->nb_pck_at_pcr = ctx->ts->pck_number;
 		return;
 	}
 	if (ctx->pcr_pid != stream->pid) return;
-	if (stream->program->last_pcr_value < ctx->first_pcr_found) {
-		ctx->first_pcr_found = stream->program->last_pcr_value;
+	if (pcr < ctx->first_pcr_found) {
+		ctx->first_pcr_found = pcr;
 		ctx->pcr_pid = stream->pid;
 		ctx->nb_pck_at_pcr = ctx->ts->pck_number;
 		return;
 	}
-	if (stream->program->last_pcr_value - ctx->first_pcr_found <= 2*27000000)
+	if (pcr - ctx->first_pcr_found <= 2*27000000)
 		return;
 
 	changed = GF_FALSE;
 
-	pck_dur = (Double) (stream->program->last_pcr_value - ctx->first_pcr_found);
+	pck_dur = (Double) (pcr - ctx->first_pcr_found);
 	pck_dur /= (ctx->ts->pck_number - ctx->nb_pck_at_pcr);
 	pck_dur /= 27000;
 
@@ -134,7 +135,7 @@ static void m2tsdmx_estimate_duration(GF_M2TSDmxCtx *ctx, GF_M2TS_ES *stream)
 		ctx->duration.den = 1000;
 		changed = GF_TRUE;
 	}
-	ctx->first_pcr_found = stream->program->last_pcr_value;
+	ctx->first_pcr_found = pcr;
 	ctx->pcr_pid = stream->pid;
 	ctx->nb_pck_at_pcr = ctx->ts->pck_number;
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[M2TSDmx] Estimated duration based on instant bitrate: %g sec\n", pck_dur/1000));
@@ -156,7 +157,7 @@ static void m2tsdmx_on_event_duration_probe(GF_M2TS_Demuxer *ts, u32 evt_type, v
 	if (evt_type == GF_M2TS_EVT_PES_PCR) {
 		GF_M2TS_PES_PCK *pck = ((GF_M2TS_PES_PCK *) param);
 
-		if (pck->stream) m2tsdmx_estimate_duration(ctx, (GF_M2TS_ES *) pck->stream);
+		if (pck->stream) m2tsdmx_estimate_duration(ctx, (GF_M2TS_ES *) pck->stream, pck->PTS);
 	}
 }
 
@@ -644,7 +645,7 @@ static void m2tsdmx_on_event(GF_M2TS_Demuxer *ts, u32 evt_type, void *param)
 		Bool discontinuity = ( ((GF_M2TS_PES_PCK *) param)->flags & GF_M2TS_PES_PCK_DISCONTINUITY) ? 1 : 0;
 
 		assert(pck->stream);
-		m2tsdmx_estimate_duration(ctx, (GF_M2TS_ES *) pck->stream);
+		m2tsdmx_estimate_duration(ctx, (GF_M2TS_ES *) pck->stream, pck->PTS);
 
 		if (ctx->map_time_on_prog_id && (ctx->map_time_on_prog_id==pck->stream->program->number)) {
 			map_time = GF_TRUE;
@@ -801,6 +802,26 @@ static void m2tsdmx_on_event(GF_M2TS_Demuxer *ts, u32 evt_type, void *param)
 	}
 }
 
+static void m2tsdmx_setup_threads(GF_M2TSDmxCtx *ctx)
+{
+	GF_Err e;
+	u32 nb_threads = ctx->threads;
+	if (ctx->threads<0) {
+		GF_SystemRTInfo rti;
+		nb_threads = 0;
+		if (gf_sys_get_rti(0, &rti, 0))
+			nb_threads = rti.nb_cores;
+	}
+	if (nb_threads<=1) return;
+
+	e = gf_m2ts_demux_set_threads(ctx->ts, nb_threads, 0);
+	if (e) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TSDmx] Failed to setup %d PES threads: %s, using single-threaded demux\n", nb_threads, gf_error_to_string(e) ));
+	} else {
+		GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[M2TSDmx] Using %d threads for PES reassembly\n", nb_threads));
+	}
+}
+
 static GF_Err m2tsdmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
 	const GF_PropertyValue *p;;
@@ -847,6 +868,7 @@ static GF_Err m2tsdmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 		ctx->ts = gf_m2ts_demux_new();
 		ctx->ts->on_event = m2tsdmx_on_event;
 		ctx->ts->user = filter;
+		m2tsdmx_setup_threads(ctx);
 	} else if (!p) {
 		GF_FilterEvent evt;
 		ctx->duration.num = 1;
@@ -1026,6 +1048,7 @@ static GF_Err m2tsdmx_initialize(GF_Filter *filter)
 	if (ctx->dsmcc) {
 		gf_m2ts_demux_dmscc_init(ctx->ts);
 	}
+	m2tsdmx_setup_threads(ctx);
 
 	return GF_OK;
 }
@@ -1082,6 +1105,10 @@ static GF_Err m2tsdmx_process(GF_Filter *filter)
 
 	gf_filter_pid_drop_packet(ctx->ipid);
 
+	//with PES threads, packets are processed by batches: flush them once the input queue is drained
+	if (ctx->ts->workers && !gf_filter_pid_get_packet(ctx->ipid))
+		gf_m2ts_demux_dispatch(ctx->ts);
+
 	if (ctx->mux_tune_state==DMX_TUNE_WAIT_SEEK) {
 		GF_FilterEvent fevt;
 		GF_FEVT_INIT(fevt, GF_FEVT_SOURCE_SEEK, ctx->ipid);
@@ -1120,6 +1147,7 @@ static const GF_FilterArgs M2TSDmxArgs[] =
 	{ OFFS(temi_url), "force TEMI URL", GF_PROP_NAME, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(dsmcc), "enable DSMCC receiver", GF_PROP_BOOL, "no", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(seeksrc), "seek local source file back to origin once all programs are setup", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(threads), "number of threads for PES reassembly (see filter help). A value of 0 or 1 disables multi-threaded reassembly, a negative value uses one thread per core", GF_PROP_SINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -1127,7 +1155,13 @@ static const GF_FilterArgs M2TSDmxArgs[] =
 GF_FilterRegister M2TSDmxRegister = {
 	.name = "m2tsdmx",
 	GF_FS_SET_DESCRIPTION("MPEG-2 TS demuxer")
-	GF_FS_SET_HELP("This filter demultiplexes MPEG-2 Transport Stream files/data into a set of media PIDs and frames.")
+	GF_FS_SET_HELP("This filter demultiplexes MPEG-2 Transport Stream files/data into a set of media PIDs and frames.\n"
+	"  \n"
+	"# Multi-threaded demultiplexing\n"
+	"When [-threads]() is set, TS packets are first routed per PID by the filter, which also handles adaptation fields, PCR and tables. "
+	"Packets of each PES stream are then reassembled by a single worker thread, PIDs being balanced between workers based on their bitrate. "
+	"Output packets are sent in TS order once the current batch of TS packets is processed, or when no more input data is available.\n"
+	"This is mostly useful for multiplexes with many programs, such as complete DVB transport streams.\n")
 	.private_size = sizeof(GF_M2TSDmxCtx),
 	.initialize = m2tsdmx_initialize,
 	.finalize = m2tsdmx_finalize,
@@ -60,6 +60,14 @@ typedef struct
 	u64 file_size;
 } FileListEntry;
 
+//source opened ahead of time, with its PIDs connected but not yet played
+typedef struct
+{
+	GF_Filter *fsrc;
+	s32 file_list_idx;
+	GF_List *ipids;
+} FileListPrefetch;
+
 enum
 {
 	FL_SORT_NONE=0,
@@ -79,6 +87,7 @@ typedef struct
 	GF_List *srcs;
 	GF_Fraction fdur;
 	u32 timescale;
+	u32 prefetch;
 
 	GF_FilterPid *file_pid;
 	char *file_path;
@@ -106,6 +115,12 @@ typedef struct
 
 	Bool wait_update;
 	u64 last_file_modif_time;
+
+	GF_List *prefetched;
+	//file switch time measurement, in microseconds
+	u64 switch_start, switch_max, switch_total;
+	u32 nb_switch;
+	Bool switch_prefetched;
 } GF_FileListCtx;
 
 static const GF_FilterCapability FileListCapsSrc[] =
@@ -149,12 +164,23 @@ Bool filelist_merge_prop(void *cbk, u32 prop_4cc, const char *prop_name, const G
 	return GF_TRUE;
 }
 
+static FileListPrefetch *filelist_get_prefetch(GF_FileListCtx *ctx, GF_FilterPid *pid)
+{
+	u32 i, count = ctx->prefetched ? gf_list_count(ctx->prefetched) : 0;
+	for (i=0; i<count; i++) {
+		FileListPrefetch *pf = gf_list_get(ctx->prefetched, i);
+		if (gf_filter_pid_is_filter_in_parents(pid, pf->fsrc))
+			return pf;
+	}
+	return NULL;
+}
+
+static GF_Err filelist_attach_ipid(GF_Filter *filter, GF_FileListCtx *ctx, GF_FilterPid *pid);
+
 GF_Err filelist_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
 	FileListPid *iopid;
-	const GF_PropertyValue *p;
-	u32 i, count;
-	Bool reassign = GF_FALSE;
+	FileListPrefetch *pf;
 	GF_FileListCtx *ctx = gf_filter_get_udta(filter);
 
 	if (is_remove) {
@@ -162,11 +188,22 @@ GF_Err filelist_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remo
 			ctx->file_pid = NULL;
 		else {
 			iopid = gf_filter_pid_get_udta(pid);
-			if (iopid) iopid->ipid = NULL;
+			//output may already be reassigned to a prefetched source PID
+			if (iopid && (iopid->ipid==pid)) iopid->ipid = NULL;
+			pf = filelist_get_prefetch(ctx, pid);
+			if (pf) gf_list_del_item(pf->ipids, pid);
 		}
 		return GF_OK;
 	}
 
+	//PID of a prefetched source, only attach it when switching to this source
+	pf = filelist_get_prefetch(ctx, pid);
+	if (pf) {
+		if (gf_list_find(pf->ipids, pid)<0)
+			gf_list_add(pf->ipids, pid);
+		return GF_OK;
+	}
+
 	if (!ctx->file_pid && !ctx->file_list) {
 		if (! gf_filter_pid_check_caps(pid))
 			return GF_NOT_SUPPORTED;
@@ -182,6 +219,16 @@ GF_Err filelist_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remo
 	}
 	if (ctx->file_pid == pid) return GF_OK;
 
+	return filelist_attach_ipid(filter, ctx, pid);
+}
+
+static GF_Err filelist_attach_ipid(GF_Filter *filter, GF_FileListCtx *ctx, GF_FilterPid *pid)
+{
+	FileListPid *iopid;
+	const GF_PropertyValue *p;
+	u32 i, count;
+	Bool reassign = GF_FALSE;
+
 	iopid = NULL;
 	count = gf_list_count(ctx->io_pids);
 	for (i=0; i<count; i++) {
@@ -488,6 +535,69 @@ Bool filelist_next_url(GF_FileListCtx *ctx, char szURL[GF_MAX_PATH])
 	return GF_TRUE;
 }
 
+//get index of entry following idx in file list, -1 if none
+static s32 filelist_peek_next_idx(GF_FileListCtx *ctx, s32 idx)
+{
+	s32 nb_files = gf_list_count(ctx->file_list);
+	if (ctx->revert) {
+		if (!idx) {
+			if (!ctx->floop) return -1;
+			idx = nb_files;
+		}
+		return idx-1;
+	}
+	idx++;
+	if (idx >= nb_files) {
+		if (!ctx->floop) return -1;
+		idx = 0;
+	}
+	return idx;
+}
+
+static void filelist_del_prefetch(GF_Filter *filter, FileListPrefetch *pf, Bool remove_src)
+{
+	if (remove_src)
+		gf_filter_remove_src(filter, pf->fsrc);
+	gf_list_del(pf->ipids);
+	gf_free(pf);
+}
+
+//open the next entries of the file list so that demuxer setup and PID negotiation are done before switching
+static void filelist_prefetch(GF_Filter *filter, GF_FileListCtx *ctx)
+{
+	s32 idx;
+	FileListPrefetch *pf;
+	if (!ctx->prefetch || !ctx->file_list || ctx->do_cat) return;
+
+	pf = gf_list_last(ctx->prefetched);
+	idx = pf ? pf->file_list_idx : ctx->file_list_idx;
+	while (gf_list_count(ctx->prefetched) < ctx->prefetch) {
+		GF_Err e;
+		GF_Filter *fsrc;
+		FileListEntry *fentry;
+		idx = filelist_peek_next_idx(ctx, idx);
+		//end of list or wrapped to the current file
+		if ((idx<0) || (idx==ctx->file_list_idx)) break;
+
+		fentry = gf_list_get(ctx->file_list, idx);
+		fsrc = gf_filter_connect_source(filter, fentry->file_name, ctx->file_path, GF_TRUE, &e);
+		if (e) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_AUTHOR, ("[FileList] Failed to prefetch file %s: %s\n", fentry->file_name, gf_error_to_string(e) ));
+			break;
+		}
+		GF_SAFEALLOC(pf, FileListPrefetch);
+		if (!pf) {
+			gf_filter_remove_src(filter, fsrc);
+			break;
+		}
+		pf->fsrc = fsrc;
+		pf->file_list_idx = idx;
+		pf->ipids = gf_list_new();
+		gf_list_add(ctx->prefetched, pf);
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_AUTHOR, ("[FileList] Prefetching file %s\n", fentry->file_name));
+	}
+}
+
 GF_Err filelist_process(GF_Filter *filter)
 {
 	Bool start, end;
@@ -537,13 +647,29 @@ GF_Err filelist_process(GF_Filter *filter)
 
 	if (ctx->load_next) {
 		GF_Filter *fsrc;
+		FileListPrefetch *pf = NULL;
 		u32 s_idx;
 		char *url;
 		char szURL[GF_MAX_PATH];
 		Bool next_url_ok;
 
+		ctx->switch_start = gf_sys_clock_high_res();
 		next_url_ok = filelist_next_url(ctx, szURL);
 
+		//check if next file was prefetched, discard prefetched sources otherwise
+		if (ctx->prefetch && ctx->file_list) {
+			pf = gf_list_get(ctx->prefetched, 0);
+			if (pf && next_url_ok && !ctx->do_cat && (pf->file_list_idx == ctx->file_list_idx)) {
+				gf_list_rem(ctx->prefetched, 0);
+			} else {
+				pf = NULL;
+				while (gf_list_count(ctx->prefetched)) {
+					filelist_del_prefetch(filter, gf_list_pop_back(ctx->prefetched), GF_TRUE);
+				}
+			}
+		}
+		ctx->switch_prefetched = pf ? GF_TRUE : GF_FALSE;
+
 		if (!next_url_ok && ctx->ka) {
 			gf_filter_ask_rt_reschedule(filter, ctx->ka*1000);
 			return GF_OK;
@@ -576,7 +702,16 @@ GF_Err filelist_process(GF_Filter *filter)
 			}
 		}
 		s_idx = 0;
-		url = szURL;
+		url = pf ? NULL : szURL;
+		//prefetched source, attach the PIDs already configured
+		if (pf) {
+			gf_list_add(ctx->filter_srcs, pf->fsrc);
+			for (i=0; i<gf_list_count(pf->ipids); i++) {
+				filelist_attach_ipid(filter, ctx, gf_list_get(pf->ipids, i));
+			}
+			filelist_del_prefetch(filter, pf, GF_FALSE);
+			count = gf_list_count(ctx->io_pids);
+		}
 		while (url) {
 			char *sep = strstr(url, " && ");
 			if (sep) sep[0] = 0;
@@ -613,7 +748,9 @@ GF_Err filelist_process(GF_Filter *filter)
 			url = sep+4;
 		}
 		//wait for PIDs to connect
-		GF_LOG(GF_LOG_INFO, GF_LOG_AUTHOR, ("[FileList] Switching to file %s\n", szURL));
+		GF_LOG(GF_LOG_INFO, GF_LOG_AUTHOR, ("[FileList] Switching to file %s%s\n", szURL, ctx->switch_prefetched ? " (prefetched)" : ""));
+
+		filelist_prefetch(filter, ctx);
 
 	}
 
@@ -655,6 +792,15 @@ GF_Err filelist_process(GF_Filter *filter)
 			iopid->dts_sub *= iopid->o_timescale;
 			iopid->dts_sub /= 1000000;
 		}
+		//first packets of new file available on all PIDs, switch is done
+		if (ctx->switch_start) {
+			u64 switch_time = gf_sys_clock_high_res() - ctx->switch_start;
+			ctx->switch_start = 0;
+			ctx->nb_switch++;
+			ctx->switch_total += switch_time;
+			if (ctx->switch_max < switch_time) ctx->switch_max = switch_time;
+			GF_LOG(GF_LOG_INFO, GF_LOG_AUTHOR, ("[FileList] File switch done in "LLU" us%s\n", switch_time, ctx->switch_prefetched ? " (prefetched)" : ""));
+		}
 	}
 
 	nb_done = nb_inactive = 0;
@@ -867,6 +1013,7 @@ GF_Err filelist_initialize(GF_Filter *filter)
 	ctx->io_pids = gf_list_new();
 
 	ctx->filter_srcs = gf_list_new();
+	ctx->prefetched = gf_list_new();
 	if (ctx->ka)
 		ctx->floop = 0;
 
@@ -938,6 +1085,13 @@ GF_Err filelist_initialize(GF_Filter *filter)
 void filelist_finalize(GF_Filter *filter)
 {
 	GF_FileListCtx *ctx = gf_filter_get_udta(filter);
+	if (ctx->nb_switch) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_AUTHOR, ("[FileList] %d file switches, average switch time "LLU" us, max "LLU" us\n", ctx->nb_switch, ctx->switch_total / ctx->nb_switch, ctx->switch_max));
+	}
+	while (gf_list_count(ctx->prefetched)) {
+		filelist_del_prefetch(filter, gf_list_pop_back(ctx->prefetched), GF_FALSE);
+	}
+	gf_list_del(ctx->prefetched);
 	while (gf_list_count(ctx->io_pids)) {
 		FileListPid *iopid = gf_list_pop_back(ctx->io_pids);
 		gf_free(iopid);
@@ -964,6 +1118,7 @@ static const GF_FilterArgs GF_FileListArgs[] =
 	{ OFFS(fdur), "for source files with a single frame, sets frame duration. 0/NaN fraction means reuse source timing which is usually not set!", GF_PROP_FRACTION, "1/25", NULL, 0},
 	{ OFFS(revert), "revert list of files (not playlist)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(timescale), "force output timescale on all pids. 0 uses the timescale of the first pid found", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(prefetch), "number of entries of srcs to open ahead of time, so that switching to the next file does not wait for source probing and PID configuration", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(ka), "keep playlist alive (disable loop), waiting the for a new input to be added or `#end` to end playlist. The value specify the refresh rate in ms", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
 
 	{ OFFS(fsort), "sort list of files\n"
@@ -1009,6 +1164,9 @@ GF_FilterRegister FileListRegister = {
 		"- each frame (coming from each file) is assigned a duration equal to the difference of modification time between the file and the next file\n"
 		"- the last frame is assigned the same duration as the previous one\n"
 		"\n"
+		"The next entries of the list can be opened ahead of time using [-prefetch](). The prefetched sources are probed and their PIDs configured while the current source is playing, and only played when switching to them.\n"
+		"Prefetched sources are discarded if the next entry to play is not the expected one, e.g. when it is concatenated to the current source.\n"
+		"\n"
 		"# Playlist mode\n"
 		"The playlist mode is activated when opening a playlist file (extension txt or m3u).\n"
 		"In this mode, directives can be given in a comment line, i.e. a line starting with '#' before the line with the file name.\n"
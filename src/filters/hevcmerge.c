@@ -214,15 +214,8 @@ static void hevcmerge_rewrite_pps(GF_HEVCMergeCtx *ctx, char *in_PPS, u32 in_PPS
 	loop_filter_flag = gf_bs_read_int(ctx->bs_nal_in, 1);
 	gf_bs_write_int(ctx->bs_nal_out, loop_filter_flag, 1);
 
-	// copy and write the rest of the bits in the byte
-	while (gf_bs_get_bit_position(ctx->bs_nal_in) != 8) {
-		gf_bs_write_int(ctx->bs_nal_out, gf_bs_read_int(ctx->bs_nal_in, 1), 1);
-	}
-
-	//copy and write the rest of the bytes
-	while (gf_bs_get_size(ctx->bs_nal_in) != gf_bs_get_position(ctx->bs_nal_in)) {
-		gf_bs_write_int(ctx->bs_nal_out, gf_bs_read_u8(ctx->bs_nal_in), 8); //watchout, not aligned in destination bitstream
-	}
+	//copy the rest of the bits - watchout, not aligned in destination bitstream
+	gf_media_nalu_copy_rbsp_end(ctx->bs_nal_in, ctx->bs_nal_out);
 
 	gf_bs_align(ctx->bs_nal_out);
 
@@ -326,18 +319,14 @@ u32 hevcmerge_rewrite_slice(GF_HEVCMergeCtx *ctx, HEVCTilePidCtx *tile_pid, char
 	//else first slice in pic, no address
 
 	//copy over bits until start of slice_qp_delta
-	while (slice_qp_delta_start != (gf_bs_get_position(ctx->bs_nal_in) - 1) * 8 + gf_bs_get_bit_position(ctx->bs_nal_in)) {
-		gf_bs_write_int(ctx->bs_nal_out, gf_bs_read_int(ctx->bs_nal_in, 1), 1);
-	}
+	gf_bs_copy_bits(ctx->bs_nal_out, ctx->bs_nal_in, slice_qp_delta_start - gf_bs_get_bit_offset(ctx->bs_nal_in));
 	//compute new qp delta
 	new_slice_qp_delta = hevc->s_info.pps->pic_init_qp_minus26 + hevc->s_info.slice_qp_delta - ctx->base_pps_init_qp_delta_minus26;
 	gf_bs_set_se(ctx->bs_nal_out, new_slice_qp_delta);
 	gf_bs_get_se(ctx->bs_nal_in);
 
 	//copy over until num_entry_points
-	while (num_entry_point_start != (gf_bs_get_position(ctx->bs_nal_in) - 1) * 8 + gf_bs_get_bit_position(ctx->bs_nal_in)) {
-		gf_bs_write_int(ctx->bs_nal_out, gf_bs_read_int(ctx->bs_nal_in, 1), 1);
-	}
+	gf_bs_copy_bits(ctx->bs_nal_out, ctx->bs_nal_in, num_entry_point_start - gf_bs_get_bit_offset(ctx->bs_nal_in));
 	//write num_entry_points to 0 (always present since we use tiling)
 	gf_bs_set_ue(ctx->bs_nal_out, 0);
 
@@ -348,8 +337,7 @@ u32 hevcmerge_rewrite_slice(GF_HEVCMergeCtx *ctx, HEVCTilePidCtx *tile_pid, char
 
 	//we may have unparsed data in the source bitstream (slice header) due to entry points or slice segment extensions
 	//TODO: we might want to copy over the slice extension header bits
-	while (header_end != (gf_bs_get_position(ctx->bs_nal_in) - 1) * 8 + gf_bs_get_bit_position(ctx->bs_nal_in))
-		gf_bs_read_int(ctx->bs_nal_in, 1);
+	gf_bs_copy_bits(NULL, ctx->bs_nal_in, header_end - gf_bs_get_bit_offset(ctx->bs_nal_in));
 
 	//read byte_alignment() is bit=1 + x bit=0
 	al = gf_bs_read_int(ctx->bs_nal_in, 1);
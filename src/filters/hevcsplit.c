@@ -331,15 +331,8 @@ void hevc_rewrite_sps(char *in_SPS, u32 in_SPS_length, u32 width, u32 height, ch
 		}
 	}
 
-	//copy and write the rest of the bits in the byte
-	while (gf_bs_get_bit_position(bs_in) != 8) {
-		gf_bs_write_int(bs_out, gf_bs_read_int(bs_in, 1), 1);
-	}
-
-	//copy and write the rest of the bytes
-	while (gf_bs_get_size(bs_in) != gf_bs_get_position(bs_in)) {
-		gf_bs_write_int(bs_out, gf_bs_read_u8(bs_in), 8); //watchout, not aligned in destination bitstream
-	}
+	//copy the rest of the bits - watchout, not aligned in destination bitstream
+	gf_media_nalu_copy_rbsp_end(bs_in, bs_out);
 
 
 	gf_bs_align(bs_out);						//align
@@ -413,15 +406,8 @@ static void hevcsplit_rewrite_pps_no_grid(GF_HEVCSplitCtx *ctx, char *in_PPS, u3
 	loop_filter_across_slices_enabled_flag = gf_bs_read_int(ctx->bs_nal_in, 1);
 	gf_bs_write_int(ctx->bs_nal_out, loop_filter_across_slices_enabled_flag, 1);
 
-	//copy and write the rest of the bits in the byte
-	while (gf_bs_get_bit_position(ctx->bs_nal_in) != 8) {
-		gf_bs_write_int(ctx->bs_nal_out, gf_bs_read_int(ctx->bs_nal_in, 1), 1);
-	}
-
-	//copy and write the rest of the bytes
-	while (gf_bs_get_size(ctx->bs_nal_in) != gf_bs_get_position(ctx->bs_nal_in)) {
-		gf_bs_write_int(ctx->bs_nal_out, gf_bs_read_u8(ctx->bs_nal_in), 8); //watchout, not aligned in destination bitstream
-	}
+	//copy the rest of the bits - watchout, not aligned in destination bitstream
+	gf_media_nalu_copy_rbsp_end(ctx->bs_nal_in, ctx->bs_nal_out);
 
 	//align
 	gf_bs_align(ctx->bs_nal_out);
@@ -516,9 +502,7 @@ static u32 hevcsplit_remove_slice_address(GF_HEVCSplitCtx *ctx, u8 *in_slice, u3
 	//nothing to write for slice address, we remove the address
 
 	//copy over until num_entry_points
-	while (num_entry_point_start != (gf_bs_get_position(ctx->bs_nal_in) - 1) * 8 + gf_bs_get_bit_position(ctx->bs_nal_in)) {
-		gf_bs_write_int(ctx->bs_nal_out, gf_bs_read_int(ctx->bs_nal_in, 1), 1);
-	}
+	gf_bs_copy_bits(ctx->bs_nal_out, ctx->bs_nal_in, num_entry_point_start - gf_bs_get_bit_offset(ctx->bs_nal_in));
 
 	//no tilin, don't write num_entry_points
 
@@ -528,8 +512,7 @@ static u32 hevcsplit_remove_slice_address(GF_HEVCSplitCtx *ctx, u8 *in_slice, u3
 
 	//we may have unparsed data in the source bitstream (slice header) due to entry points or slice segment extensions
 	//TODO: we might want to copy over the slice extension header bits
-	while (header_end != (gf_bs_get_position(ctx->bs_nal_in) - 1) * 8 + gf_bs_get_bit_position(ctx->bs_nal_in))
-		gf_bs_read_int(ctx->bs_nal_in, 1);
+	gf_bs_copy_bits(NULL, ctx->bs_nal_in, header_end - gf_bs_get_bit_offset(ctx->bs_nal_in));
 
 	//read byte_alignment() is bit=1 + x bit=0
 	al = gf_bs_read_int(ctx->bs_nal_in, 1);
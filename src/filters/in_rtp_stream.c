@@ -738,6 +738,13 @@ u32 rtpin_stream_read(GF_RTPInStream *stream)
 			stream->rtpin->udp_timeout = 0;
 			rtpin_stream_on_rtp_pck(stream, stream->buffer, size);
 		}
+		//several packets may be ready in the reorderer once a missing one is received or given up
+		while (1) {
+			size = gf_rtp_flush_rtp(stream->rtp_ch, stream->buffer, stream->rtpin->block_size);
+			if (!size) break;
+			tot_size += size;
+			rtpin_stream_on_rtp_pck(stream, stream->buffer, size);
+		}
 	}
 	if (!tot_size) return 0;
 
@@ -39,6 +39,7 @@ typedef struct
 	Bool pck_out;
 #ifndef GPAC_DISABLE_STREAMING
 	GF_RTPReorder *rtp_reorder;
+	u64 nb_rtp_out;
 #else
 	Bool is_rtp;
 #endif
@@ -64,6 +65,7 @@ typedef struct
 #ifndef GPAC_DISABLE_STREAMING
 	u32 reorder_pck;
 	u32 reorder_delay;
+	Bool fec;
 #endif
 
 	GF_SockInClient sock_c;
@@ -75,8 +77,44 @@ typedef struct
 
 	GF_SockGroup *active_sockets;
 	u64 last_rcv_time;
+#ifndef GPAC_DISABLE_STREAMING
+	//column and row FEC sockets
+	GF_Socket *fec_sockets[2];
+#endif
 } GF_SockInCtx;
 
+#ifndef GPAC_DISABLE_STREAMING
+static GF_Err sockin_setup_fec(GF_SockInCtx *ctx, const char *url, u16 port)
+{
+	u32 i;
+	for (i=0; i<2; i++) {
+		GF_Err e;
+		//SMPTE 2022-1: column FEC on port+2, row FEC on port+4
+		u16 fec_port = port + 2*(i+1);
+		GF_Socket *sk = gf_sk_new(GF_SOCK_TYPE_UDP);
+		if (!sk) return GF_IP_NETWORK_FAILURE;
+		if (gf_sk_is_multicast_address(url)) {
+			e = gf_sk_setup_multicast(sk, url, fec_port, 0, 0, ctx->ifce);
+		} else {
+			e = gf_sk_bind(sk, ctx->ifce, fec_port, url, fec_port, GF_SOCK_REUSE_PORT);
+			if (!e)
+				e = gf_sk_connect(sk, url, fec_port, NULL);
+		}
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[SockIn] Failed to open FEC socket on port %d: %s\n", fec_port, gf_error_to_string(e) ));
+			gf_sk_del(sk);
+			return e;
+		}
+		gf_sk_set_buffer_size(sk, 0, ctx->sockbuf);
+		gf_sk_set_block_mode(sk, GF_TRUE);
+		gf_sk_group_register(ctx->active_sockets, sk);
+		ctx->fec_sockets[i] = sk;
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] FEC enabled on ports %d and %d\n", port+2, port+4));
+	return GF_OK;
+}
+#endif
+
 
 
 static GF_Err sockin_initialize(GF_Filter *filter)
@@ -155,6 +193,13 @@ static GF_Err sockin_initialize(GF_Filter *filter)
 		e = gf_sk_connect(ctx->sock_c.socket, url, port, ctx->ifce);
 	}
 
+#ifndef GPAC_DISABLE_STREAMING
+	if (!e && ctx->fec) {
+		if (ctx->is_udp) e = sockin_setup_fec(ctx, url, port);
+		else ctx->fec = GF_FALSE;
+	}
+#endif
+
 	if (str) str[0] = ':';
 
 	if (e) {
@@ -205,6 +250,10 @@ static void sockin_finalize(GF_Filter *filter)
 		gf_list_del(ctx->clients);
 	}
 	sockin_client_reset(&ctx->sock_c);
+#ifndef GPAC_DISABLE_STREAMING
+	if (ctx->fec_sockets[0]) gf_sk_del(ctx->fec_sockets[0]);
+	if (ctx->fec_sockets[1]) gf_sk_del(ctx->fec_sockets[1]);
+#endif
 	if (ctx->buffer) gf_free(ctx->buffer);
 	if (ctx->active_sockets) gf_sk_group_del(ctx->active_sockets);
 }
@@ -220,16 +269,47 @@ static GF_FilterProbeScore sockin_probe_url(const char *url, const char *mime_ty
 	return GF_FPROBE_NOT_SUPPORTED;
 }
 
-static void sockin_rtp_destructor(GF_Filter *filter, GF_FilterPid *pid, GF_FilterPacket *pck)
+#ifndef GPAC_DISABLE_STREAMING
+//send all packets ready in the reorderer, the returned data is owned by the reorderer so it is copied
+static void sockin_rtp_flush(GF_SockInClient *sock_c, Bool force_flush)
 {
-	u32 size;
-	char *data;
-	GF_SockInClient *sc = (GF_SockInClient *) gf_filter_pid_get_udta(pid);
-	sc->pck_out = GF_FALSE;
-	data = (char *) gf_filter_pck_get_data(pck, &size);
-	if (data) gf_free(data);
+	while (1) {
+		u8 *out_data;
+		GF_FilterPacket *dst_pck;
+		u32 size;
+		char *pck = (char *) gf_rtp_reorderer_get(sock_c->rtp_reorder, &size, force_flush);
+		if (!pck) break;
+		if (size<=12) continue;
+
+		dst_pck = gf_filter_pck_new_alloc(sock_c->pid, size-12, &out_data);
+		if (!dst_pck) break;
+		memcpy(out_data, pck+12, size-12);
+		//same framing as raw UDP
+		gf_filter_pck_set_framing(dst_pck, sock_c->nb_rtp_out ? GF_FALSE : GF_TRUE, GF_FALSE);
+		gf_filter_pck_send(dst_pck);
+		sock_c->nb_rtp_out++;
+	}
 }
 
+static void sockin_read_fec(GF_SockInCtx *ctx)
+{
+	u32 i;
+	for (i=0; i<2; i++) {
+		if (!ctx->fec_sockets[i]) continue;
+		if (!gf_sk_group_sock_is_set(ctx->active_sockets, ctx->fec_sockets[i], GF_SK_SELECT_READ)) continue;
+
+		while (1) {
+			u32 nb_read=0;
+			GF_Err e = gf_sk_receive_no_select(ctx->fec_sockets[i], ctx->buffer, ctx->block_size, &nb_read);
+			if (e || !nb_read) break;
+			//FEC received before media, cannot be used
+			if (!ctx->sock_c.rtp_reorder) continue;
+			gf_rtp_reorderer_add_fec(ctx->sock_c.rtp_reorder, ctx->buffer, nb_read);
+		}
+	}
+}
+#endif
+
 static Bool sockin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 {
 	if (!evt->base.on_pid) return GF_FALSE;
@@ -282,6 +362,8 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 	if (!nb_read) return GF_OK;
 	sock_c->nb_bytes += nb_read;
 	sock_c->done = GF_FALSE;
+	//restart UDP timeout
+	ctx->last_rcv_time = 0;
 
 	//we allocated one more byte for that
 	ctx->buffer[nb_read] = 0;
@@ -295,6 +377,8 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 			if ((ctx->buffer[0] != 0x47) && ((ctx->buffer[1] & 0x7F) == 33) ) {
 #ifndef GPAC_DISABLE_STREAMING
 				sock_c->rtp_reorder = gf_rtp_reorderer_new(ctx->reorder_pck, ctx->reorder_delay);
+				if (sock_c->rtp_reorder && ctx->fec)
+					gf_rtp_reorderer_enable_fec(sock_c->rtp_reorder);
 #else
 			ctx-	>is_rtp = GF_TRUE;
 #endif
@@ -327,16 +411,9 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 
 #ifndef GPAC_DISABLE_STREAMING
 	if (sock_c->rtp_reorder) {
-		char *pck;
 		u16 seq_num = ((ctx->buffer[2] << 8) & 0xFF00) | (ctx->buffer[3] & 0xFF);
 		gf_rtp_reorderer_add(sock_c->rtp_reorder, (void *) ctx->buffer, nb_read, seq_num);
-
-		pck = (char *) gf_rtp_reorderer_get(sock_c->rtp_reorder, &nb_read, GF_FALSE);
-		if (pck) {
-			dst_pck = gf_filter_pck_new_shared(sock_c->pid, pck+12, nb_read-12, sockin_rtp_destructor);
-			gf_filter_pck_set_framing(dst_pck, GF_TRUE, GF_TRUE);
-			gf_filter_pck_send(dst_pck);
-		}
+		sockin_rtp_flush(sock_c, GF_FALSE);
 		return GF_OK;
 	}
 #else
@@ -374,6 +451,10 @@ static Bool sockin_check_eos(GF_SockInCtx *ctx)
 		return GF_FALSE;
 	}
 	if (ctx->sock_c.pid && !ctx->sock_c.done) {
+#ifndef GPAC_DISABLE_STREAMING
+		if (ctx->sock_c.rtp_reorder)
+			sockin_rtp_flush(&ctx->sock_c, GF_TRUE);
+#endif
 		gf_filter_pid_set_eos(ctx->sock_c.pid);
 		ctx->sock_c.done = GF_TRUE;
 	}
@@ -389,6 +470,11 @@ static GF_Err sockin_process(GF_Filter *filter)
 
 	e = gf_sk_group_select(ctx->active_sockets, 10, GF_SK_SELECT_READ);
 	if (e==GF_IP_NETWORK_EMPTY) {
+#ifndef GPAC_DISABLE_STREAMING
+		//release packets waiting for a missing one
+		if (ctx->sock_c.rtp_reorder && !ctx->sock_c.done)
+			sockin_rtp_flush(&ctx->sock_c, GF_FALSE);
+#endif
 		if (ctx->is_udp) {
 			if (sockin_check_eos(ctx) )
 				return GF_EOS;
@@ -402,6 +488,10 @@ static GF_Err sockin_process(GF_Filter *filter)
 	}
 	else if (e) return e;
 
+#ifndef GPAC_DISABLE_STREAMING
+	if (ctx->fec) sockin_read_fec(ctx);
+#endif
+
 	if (gf_sk_group_sock_is_set(ctx->active_sockets, ctx->sock_c.socket, GF_SK_SELECT_READ)) {
 		if (!ctx->listen) {
 			return sockin_read_client(filter, ctx, &ctx->sock_c);
@@ -493,6 +583,7 @@ static const GF_FilterArgs SockInArgs[] =
 #ifndef GPAC_DISABLE_STREAMING
 	{ OFFS(reorder_pck), "number of packets delay for RTP reordering (M2TS over RTP) ", GF_PROP_UINT, "100", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(reorder_delay), "number of ms delay for RTP reordering (M2TS over RTP)", GF_PROP_UINT, "10", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(fec), "enable SMPTE 2022-1 FEC recovery for M2TS over RTP, using column and row FEC streams on UDP port+2 and port+4", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 #endif
 	{0}
 };
@@ -520,6 +611,10 @@ GF_FilterRegister SockInRegister = {
 	""
 #else
 	"Your platform does not supports unix domain sockets, udpu:// and tcpu:// schemes not supported."
+#endif
+#ifndef GPAC_DISABLE_STREAMING
+		"\nMPEG-2 TS over RTP is reordered using [-reorder_pck]() and [-reorder_delay](). When [-fec]() is set, SMPTE 2022-1 column and row FEC packets are received on the two next even UDP ports and used to recover lost packets. The reorder window should then cover the FEC matrix size (e.g. `reorder_pck=200:reorder_delay=100`).\n"
+		"Packet loss and recovery statistics are logged at the end of the session using `-logs=rtp@info`.\n"
 #endif
 	,
 #endif //GPAC_DISABLE_DOC
@@ -27,6 +27,7 @@
 #include <gpac/constants.h>
 #include <gpac/list.h>
 #include <gpac/xml.h>
+#include <gpac/thread.h>
 #include <gpac/internal/media_dev.h>
 
 typedef struct
@@ -60,6 +61,9 @@ typedef struct
 	GF_Fraction tmcd_rate;
 	u32 tmcd_flags;
 	u32 tmcd_fpt;
+
+	//index of the worker dumping the packets of this pid
+	u32 shard;
 } PidCtx;
 
 enum
@@ -80,7 +84,31 @@ enum
 	INSPECT_TEST_ENCX,
 };
 
+//packet queued for dumping by a worker
+typedef struct
+{
+	GF_FilterPacket *pck;
+	PidCtx *pctx;
+	u64 pck_num;
+	//index of the worker dumping the packet
+	u32 shard;
+	//location of the packet dump in the worker output
+	u32 offset, size;
+} InspectQueuedPacket;
+
 typedef struct
+{
+	struct __inspect_ctx *ctx;
+	GF_Thread *th;
+	GF_Semaphore *run;
+	//memory output of the worker, copied to the pid output once the batch is done
+	FILE *out;
+	u32 nb_pcks;
+} InspectShard;
+
+#define INSPECT_BATCH_SIZE	256
+
+typedef struct __inspect_ctx
 {
 	u32 mode;
 	Bool interleave;
@@ -88,12 +116,13 @@ typedef struct
 	Bool deep;
 	char *log;
 	char *fmt;
-	Bool props, hdr, allp, info, pcr, analyze, xml;
+	Bool props, hdr, allp, info, pcr, analyze, xml, json;
 	Double speed, start;
 	u32 test;
 	GF_Fraction dur;
 	Bool dump_crc, dtype;
 	Bool fftmcd;
+	s32 threads;
 
 	FILE *dump;
 
@@ -101,39 +130,66 @@ typedef struct
 
 	Bool is_prober, probe_done, hdr_done, dump_pck;
 	Bool args_updated;
+
+	//multi-threaded packet dump: packets are queued and dumped by batch, split in packet ranges across workers
+	//or, when analyzing, each pid being always dumped by the same worker
+	InspectShard *shards;
+	u32 nb_shards, nb_pids_assigned;
+	InspectQueuedPacket *queue;
+	u32 nb_queued;
+	GF_Semaphore *done;
+	Bool exit;
 } GF_InspectCtx;
 
-#define DUMP_ATT_STR(_name, _val) if (ctx->xml) { \
+#define DUMP_ATT_STR(_name, _val) if (ctx->json) { \
+		gf_fprintf(dump, ",\"%s\":\"%s\"", _name, _val); \
+	} else if (ctx->xml) { \
 		gf_fprintf(dump, " %s=\"%s\"", _name, _val); \
 	} else { \
 		gf_fprintf(dump, " %s %s", _name, _val); \
 	}
 
-#define DUMP_ATT_LLU(_name, _val) if (ctx->xml) { \
+#define DUMP_ATT_NA(_name) if (ctx->json) { \
+		gf_fprintf(dump, ",\"%s\":null", _name); \
+	} else { \
+		DUMP_ATT_STR(_name, "N/A") \
+	}
+
+#define DUMP_ATT_LLU(_name, _val) if (ctx->json) { \
+		gf_fprintf(dump, ",\"%s\":"LLU, _name, _val); \
+	} else if (ctx->xml) { \
 		gf_fprintf(dump, " %s=\""LLU"\"", _name, _val);\
 	} else {\
 		gf_fprintf(dump, " %s "LLU, _name, _val);\
 	}
 
-#define DUMP_ATT_U(_name, _val) if (ctx->xml) { \
+#define DUMP_ATT_U(_name, _val) if (ctx->json) { \
+		gf_fprintf(dump, ",\"%s\":%u", _name, _val); \
+	} else if (ctx->xml) { \
 		gf_fprintf(dump, " %s=\"%u\"", _name, _val);\
 	} else {\
 		gf_fprintf(dump, " %s %u", _name, _val);\
 	}
 
-#define DUMP_ATT_D(_name, _val) if (ctx->xml) { \
+#define DUMP_ATT_D(_name, _val) if (ctx->json) { \
+		gf_fprintf(dump, ",\"%s\":%d", _name, _val); \
+	} else if (ctx->xml) { \
 		gf_fprintf(dump, " %s=\"%d\"", _name, _val);\
 	} else {\
 		gf_fprintf(dump, " %s %d", _name, _val);\
 	}
 
-#define DUMP_ATT_X(_name, _val)  if (ctx->xml) { \
+#define DUMP_ATT_X(_name, _val)  if (ctx->json) { \
+		gf_fprintf(dump, ",\"%s\":\"0x%08X\"", _name, _val); \
+	} else if (ctx->xml) { \
 		gf_fprintf(dump, " %s=\"0x%08X\"", _name, _val);\
 	} else {\
 		gf_fprintf(dump, " %s 0x%08X", _name, _val);\
 	}
 
-#define DUMP_ATT_F(_name, _val)  if (ctx->xml) { \
+#define DUMP_ATT_F(_name, _val)  if (ctx->json) { \
+		gf_fprintf(dump, ",\"%s\":%f", _name, _val); \
+	} else if (ctx->xml) { \
 		gf_fprintf(dump, " %s=\"%f\"", _name, _val);\
 	} else {\
 		gf_fprintf(dump, " %s %f", _name, _val);\
@@ -784,6 +840,7 @@ static void gf_inspect_dump_prores_internal(FILE *dump, u8 *ptr, u64 frame_size,
 	GF_ProResFrameInfo prores_frame;
 	GF_Err e;
 	GF_BitStream *bs;
+	char sz4cc[GF_4CC_MSIZE];
 	if (pctx) {
 		gf_bs_reassign_buffer(pctx->bs, ptr, frame_size);
 		bs = pctx->bs;
@@ -799,11 +856,11 @@ static void gf_inspect_dump_prores_internal(FILE *dump, u8 *ptr, u64 frame_size,
 	}
 	gf_fprintf(dump, "   <ProResFrame framesize=\"%d\" frameID=\"%s\" version=\"%d\""
 		, prores_frame.frame_size
-		, gf_4cc_to_str(prores_frame.frame_identifier)
+		, gf_4cc_to_str_safe(prores_frame.frame_identifier, sz4cc)
 		, prores_frame.version
 	);
 	gf_fprintf(dump, " encoderID=\"%s\" width=\"%d\" height=\"%d\""
-		, gf_4cc_to_str(prores_frame.encoder_id)
+		, gf_4cc_to_str_safe(prores_frame.encoder_id, sz4cc)
 		, prores_frame.width
 		, prores_frame.height
 	);
@@ -1082,11 +1139,15 @@ static void finalize_dump(GF_InspectCtx *ctx, u32 streamtype, Bool concat)
 	}
 }
 
+static void inspect_del_threads(GF_InspectCtx *ctx);
+
 static void inspect_finalize(GF_Filter *filter)
 {
 	Bool concat=GF_FALSE;
 	GF_InspectCtx *ctx = (GF_InspectCtx *) gf_filter_get_udta(filter);
 
+	inspect_del_threads(ctx);
+
 	if (ctx->dump) {
 		if ((ctx->dump!=stderr) && (ctx->dump!=stdout)) concat=GF_TRUE;
 		else if (!ctx->interleave) concat=GF_TRUE;
@@ -1133,22 +1194,21 @@ static void inspect_finalize(GF_Filter *filter)
 
 }
 
+//packet properties may be dumped by several threads for a given pid, TEMI dumps don't use the pid bitstream
 static void dump_temi_loc(GF_InspectCtx *ctx, PidCtx *pctx, FILE *dump, const char *pname, const GF_PropertyValue *att)
 {
 	u32 val;
 	Double dval;
+	GF_BitStream *bs;
 	if (ctx->xml) {
 		gf_fprintf(dump, " <TEMILocation");
 	} else {
 		gf_fprintf(dump, " TEMILocation");
 	}
-	if (!pctx->bs)
-		pctx->bs = gf_bs_new(att->value.data.ptr, att->value.data.size, GF_BITSTREAM_READ);
-	else
-		gf_bs_reassign_buffer(pctx->bs, att->value.data.ptr, att->value.data.size);
+	bs = gf_bs_new(att->value.data.ptr, att->value.data.size, GF_BITSTREAM_READ);
 
 	while (1) {
-		u8 achar =  gf_bs_read_u8(pctx->bs);
+		u8 achar =  gf_bs_read_u8(bs);
 		if (!achar) break;
 	}
 
@@ -1156,24 +1216,25 @@ static void dump_temi_loc(GF_InspectCtx *ctx, PidCtx *pctx, FILE *dump, const ch
 
 	DUMP_ATT_D("timeline", val)
 	DUMP_ATT_STR("url", att->value.data.ptr)
-	if (gf_bs_read_int(pctx->bs, 1)) {
+	if (gf_bs_read_int(bs, 1)) {
 		DUMP_ATT_D("announce", 1)
 	}
-	if (gf_bs_read_int(pctx->bs, 1)) {
+	if (gf_bs_read_int(bs, 1)) {
 		DUMP_ATT_D("splicing", 1)
 	}
-	if (gf_bs_read_int(pctx->bs, 1)) {
+	if (gf_bs_read_int(bs, 1)) {
 		DUMP_ATT_D("reload", 1)
 	}
-	gf_bs_read_int(pctx->bs, 5);
-	dval =	gf_bs_read_double(pctx->bs);
+	gf_bs_read_int(bs, 5);
+	dval =	gf_bs_read_double(bs);
 	if (dval) {
 		DUMP_ATT_F("splice_start", dval)
 	}
-	dval =	gf_bs_read_double(pctx->bs);
+	dval =	gf_bs_read_double(bs);
 	if (dval) {
 		DUMP_ATT_F("splice_end", dval)
 	}
+	gf_bs_del(bs);
 	if (ctx->xml) {
 		gf_fprintf(dump, "/>\n");
 	} else {
@@ -1185,41 +1246,40 @@ static void dump_temi_time(GF_InspectCtx *ctx, PidCtx *pctx, FILE *dump, const c
 {
 	u32 val;
 	u64 lval;
+	GF_BitStream *bs;
 	if (ctx->xml) {
 		gf_fprintf(dump, " <TEMITiming");
 	} else {
 		gf_fprintf(dump, " TEMITiming");
 	}
 	val = atoi(pname+7);
-	if (!pctx->bs)
-		pctx->bs = gf_bs_new(att->value.data.ptr, att->value.data.size, GF_BITSTREAM_READ);
-	else
-		gf_bs_reassign_buffer(pctx->bs, att->value.data.ptr, att->value.data.size);
+	bs = gf_bs_new(att->value.data.ptr, att->value.data.size, GF_BITSTREAM_READ);
 
 	DUMP_ATT_D("timeline", val)
-	val = gf_bs_read_u32(pctx->bs);
+	val = gf_bs_read_u32(bs);
 	DUMP_ATT_D("media_timescale", val)
-	lval = gf_bs_read_u64(pctx->bs);
+	lval = gf_bs_read_u64(bs);
 	DUMP_ATT_LLU("media_timestamp", lval)
-	lval = gf_bs_read_u64(pctx->bs);
+	lval = gf_bs_read_u64(bs);
 	DUMP_ATT_LLU("media_pts", lval)
 
-	if (gf_bs_read_int(pctx->bs, 1)) {
+	if (gf_bs_read_int(bs, 1)) {
 		DUMP_ATT_D("reload", 1)
 	}
-	if (gf_bs_read_int(pctx->bs, 1)) {
+	if (gf_bs_read_int(bs, 1)) {
 		DUMP_ATT_D("paused", 1)
 	}
-	if (gf_bs_read_int(pctx->bs, 1)) {
+	if (gf_bs_read_int(bs, 1)) {
 		DUMP_ATT_D("discontinuity", 1)
 	}
-	val = gf_bs_read_int(pctx->bs, 1);
-	gf_bs_read_int(pctx->bs, 4);
+	val = gf_bs_read_int(bs, 1);
+	gf_bs_read_int(bs, 4);
 
 	if (val) {
-		lval = gf_bs_read_u64(pctx->bs);
+		lval = gf_bs_read_u64(bs);
 		DUMP_ATT_LLU("ntp", lval)
 	}
+	gf_bs_del(bs);
 	if (ctx->xml) {
 		gf_fprintf(dump, "/>\n");
 	} else {
@@ -1227,30 +1287,26 @@ static void dump_temi_time(GF_InspectCtx *ctx, PidCtx *pctx, FILE *dump, const c
 	}
 }
 
-static void inspect_dump_property(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, const char *pname, const GF_PropertyValue *att, PidCtx *pctx)
+static Bool inspect_skip_property(GF_InspectCtx *ctx, u32 p4cc, const GF_PropertyValue *att)
 {
-	char szDump[GF_PROP_DUMP_ARG_SIZE];
-
-	if (!pname) pname = gf_props_4cc_get_name(p4cc);
-
 	if (p4cc==GF_PROP_PID_DOWNLOAD_SESSION)
-		return;
+		return GF_TRUE;
 
 	if (gf_sys_is_test_mode() || ctx->test) {
 		switch (p4cc) {
 		case GF_PROP_PID_FILEPATH:
 		case GF_PROP_PID_URL:
-			return;
+			return GF_TRUE;
 		case GF_PROP_PID_FILE_CACHED:
 		case GF_PROP_PID_DURATION:
 			if ((ctx->test==INSPECT_TEST_NETWORK) || (ctx->test==INSPECT_TEST_NETX))
-				return;
+				return GF_TRUE;
 			break;
 		case GF_PROP_PID_DECODER_CONFIG:
 		case GF_PROP_PID_DECODER_CONFIG_ENHANCEMENT:
 		case GF_PROP_PID_DOWN_SIZE:
 			if (ctx->test>=INSPECT_TEST_ENCODE)
-				return;
+				return GF_TRUE;
 			break;
 		case GF_PROP_PID_MEDIA_DATA_SIZE:
 		case GF_PROP_PID_BITRATE:
@@ -1259,26 +1315,38 @@ static void inspect_dump_property(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, cons
 		case GF_PROP_PID_MAX_FRAME_SIZE:
 		case GF_PROP_PID_DBSIZE:
 			if (ctx->test==INSPECT_TEST_ENCX)
-				return;
+				return GF_TRUE;
 			break;
 
 		case GF_PROP_PID_ISOM_TRACK_TEMPLATE:
 		case GF_PROP_PID_ISOM_MOVIE_TIME:
 			if (ctx->test==INSPECT_TEST_NETX)
-				return;
+				return GF_TRUE;
 			break;
 
 		case GF_PROP_PID_ISOM_TREX_TEMPLATE:
 		case GF_PROP_PID_ISOM_STSD_TEMPLATE:
 			//TODO once all OK: remove this test and regenerate all hashes
 			if (gf_sys_is_test_mode())
-				return;
+				return GF_TRUE;
 		default:
 			if (gf_sys_is_test_mode() && (att->type==GF_PROP_POINTER) )
-				return;
+				return GF_TRUE;
 			break;
 		}
 	}
+	return GF_FALSE;
+}
+
+static void inspect_dump_property(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, const char *pname, const GF_PropertyValue *att, PidCtx *pctx)
+{
+	char szDump[GF_PROP_DUMP_ARG_SIZE];
+	char sz4cc[GF_4CC_MSIZE];
+
+	if (!pname) pname = gf_props_4cc_get_name(p4cc);
+
+	if (inspect_skip_property(ctx, p4cc, att))
+		return;
 
 	if (ctx->xml) {
 		if (ctx->dtype)
@@ -1298,7 +1366,7 @@ static void inspect_dump_property(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, cons
 					switch (p4cc) {
 					case GF_PROP_PID_ISOM_BRANDS:
 						if (! gf_sys_is_test_mode()) {
-							gf_fprintf(dump, "%s", gf_4cc_to_str(att->value.uint_list.vals[k]) );
+							gf_fprintf(dump, "%s", gf_4cc_to_str_safe(att->value.uint_list.vals[k], sz4cc) );
 							break;
 						}
 					default:
@@ -1319,18 +1387,18 @@ static void inspect_dump_property(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, cons
 			}
 			gf_free(pname_no_space);
 		} else {
-			gf_fprintf(dump, " %s=\"%s\"", pname ? pname : gf_4cc_to_str(p4cc), gf_props_dump(p4cc, att, szDump, ctx->dump_data));
+			gf_fprintf(dump, " %s=\"%s\"", pname ? pname : gf_4cc_to_str_safe(p4cc, sz4cc), gf_props_dump(p4cc, att, szDump, ctx->dump_data));
 		}
 	} else {
 		if (ctx->dtype) {
-			gf_fprintf(dump, "\t%s (%s): ", pname ? pname : gf_4cc_to_str(p4cc), gf_props_get_type_name(att->type));
+			gf_fprintf(dump, "\t%s (%s): ", pname ? pname : gf_4cc_to_str_safe(p4cc, sz4cc), gf_props_get_type_name(att->type));
 		} else {
 			if (!p4cc && !strncmp(pname, "temi_l", 6))
 				dump_temi_loc(ctx, pctx, dump, pname, att);
 			else if (!p4cc && !strncmp(pname, "temi_t", 6))
 				dump_temi_time(ctx, pctx, dump, pname, att);
 			else
-				gf_fprintf(dump, "\t%s: ", pname ? pname : gf_4cc_to_str(p4cc));
+				gf_fprintf(dump, "\t%s: ", pname ? pname : gf_4cc_to_str_safe(p4cc, sz4cc));
 		}
 
 		if (att->type==GF_PROP_UINT_LIST) {
@@ -1340,7 +1408,7 @@ static void inspect_dump_property(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, cons
 				switch (p4cc) {
 				case GF_PROP_PID_ISOM_BRANDS:
 					if (! gf_sys_is_test_mode()) {
-						gf_fprintf(dump, "%s", gf_4cc_to_str(att->value.uint_list.vals[k]) );
+						gf_fprintf(dump, "%s", gf_4cc_to_str_safe(att->value.uint_list.vals[k], sz4cc) );
 						break;
 					}
 				default:
@@ -1361,6 +1429,75 @@ static void inspect_dump_property(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, cons
 	}
 }
 
+static void inspect_dump_json_string(FILE *dump, const char *str)
+{
+	gf_fputc('"', dump);
+	while (str && *str) {
+		u8 c = (u8) *str;
+		if ((c=='"') || (c=='\\')) {
+			gf_fputc('\\', dump);
+			gf_fputc(c, dump);
+		} else if (c<0x20) {
+			gf_fprintf(dump, "\\u%04X", c);
+		} else {
+			gf_fputc(c, dump);
+		}
+		str++;
+	}
+	gf_fputc('"', dump);
+}
+
+//dump a property as a member of the "properties" object, opened at the first dumped property
+static void inspect_dump_property_json(GF_InspectCtx *ctx, FILE *dump, u32 p4cc, const char *pname, const GF_PropertyValue *att, u32 *nb_props)
+{
+	char szDump[GF_PROP_DUMP_ARG_SIZE];
+	char sz4cc[GF_4CC_MSIZE];
+	const char *val;
+
+	if (!pname) pname = gf_props_4cc_get_name(p4cc);
+	if (inspect_skip_property(ctx, p4cc, att))
+		return;
+
+	gf_fprintf(dump, (*nb_props) ? "," : ",\"properties\":{");
+	(*nb_props)++;
+	inspect_dump_json_string(dump, pname ? pname : gf_4cc_to_str_safe(p4cc, sz4cc));
+	gf_fputc(':', dump);
+
+	switch (att->type) {
+	case GF_PROP_STRING_LIST:
+	{
+		u32 k, plist_count = gf_list_count(att->value.string_list);
+		gf_fputc('[', dump);
+		for (k=0; k < plist_count; k++) {
+			if (k) gf_fputc(',', dump);
+			inspect_dump_json_string(dump, (const char *) gf_list_get(att->value.string_list, k));
+		}
+		gf_fputc(']', dump);
+		return;
+	}
+	case GF_PROP_BOOL:
+		gf_fprintf(dump, "%s", att->value.boolean ? "true" : "false");
+		return;
+	case GF_PROP_SINT:
+	case GF_PROP_UINT:
+	case GF_PROP_LSINT:
+	case GF_PROP_LUINT:
+	case GF_PROP_FLOAT:
+	case GF_PROP_DOUBLE:
+		val = gf_props_dump(p4cc, att, szDump, ctx->dump_data);
+		//enumerated values (codec ID, stream type, ...) are dumped by name
+		if (val && val[0] && (strspn(val, "0123456789+-.eE") == strlen(val))) {
+			gf_fprintf(dump, "%s", val);
+			return;
+		}
+		break;
+	default:
+		val = gf_props_dump(p4cc, att, szDump, ctx->dump_data);
+		break;
+	}
+	inspect_dump_json_string(dump, val);
+}
+
 static void inspect_dump_packet_fmt(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket *pck, PidCtx *pctx, u64 pck_num)
 {
 	char szDump[GF_PROP_DUMP_ARG_SIZE];
@@ -1727,7 +1864,9 @@ static void inspect_dump_packet(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket
 		if (!fifce) return;
 	}
 
-	if (ctx->xml) {
+	if (ctx->json) {
+		gf_fprintf(dump, "{\"PID\":%d,\"packet\":"LLU, pid_idx, pck_num);
+	} else if (ctx->xml) {
 		gf_fprintf(dump, "<Packet number=\""LLU"\"", pck_num);
 		if (ctx->interleave)
 			gf_fprintf(dump, " PID=\"%d\"", pid_idx);
@@ -1736,7 +1875,12 @@ static void inspect_dump_packet(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket
 	}
 	if (ck_type) {
 		ts = gf_filter_pck_get_cts(pck);
-		if (ctx->xml) {
+		if (ctx->json) {
+			if (ts==GF_FILTER_NO_TS) gf_fprintf(dump, ",\"PCR\":null");
+			else gf_fprintf(dump, ",\"PCR\":"LLU, ts );
+			if (ck_type!=GF_FILTER_CLOCK_PCR) gf_fprintf(dump, ",\"discontinuity\":true");
+			gf_fprintf(dump, "}\n");
+		} else if (ctx->xml) {
 			if (ts==GF_FILTER_NO_TS) gf_fprintf(dump, " PCR=\"N/A\"");
 			else gf_fprintf(dump, " PCR=\""LLU"\" ", ts );
 			if (ck_type!=GF_FILTER_CLOCK_PCR) gf_fprintf(dump, " discontinuity=\"true\"");
@@ -1747,12 +1891,14 @@ static void inspect_dump_packet(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket
 		}
 		return;
 	}
-	if (ctx->xml) {
-		if (fifce) gf_fprintf(dump, " framing=\"interface\"");
-		else if (start && end) gf_fprintf(dump, " framing=\"complete\"");
-		else if (start) gf_fprintf(dump, " framing=\"start\"");
-		else if (end) gf_fprintf(dump, " framing=\"end\"");
-		else gf_fprintf(dump, " framing=\"continuation\"");
+	if (ctx->xml || ctx->json) {
+		const char *framing;
+		if (fifce) framing = "interface";
+		else if (start && end) framing = "complete";
+		else if (start) framing = "start";
+		else if (end) framing = "end";
+		else framing = "continuation";
+		DUMP_ATT_STR("framing", framing)
 	} else {
 		if (fifce) gf_fprintf(dump, "interface");
 		else if (start && end) gf_fprintf(dump, "full frame");
@@ -1761,17 +1907,17 @@ static void inspect_dump_packet(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket
 		else gf_fprintf(dump, "frame continuation");
 	}
 	ts = gf_filter_pck_get_dts(pck);
-	if (ts==GF_FILTER_NO_TS) DUMP_ATT_STR("dts", "N/A")
+	if (ts==GF_FILTER_NO_TS) DUMP_ATT_NA("dts")
 	else DUMP_ATT_LLU("dts", ts )
 
 	ts = gf_filter_pck_get_cts(pck);
-	if (ts==GF_FILTER_NO_TS) DUMP_ATT_STR("cts", "N/A")
+	if (ts==GF_FILTER_NO_TS) DUMP_ATT_NA("cts")
 	else DUMP_ATT_LLU("cts", ts )
 
 	DUMP_ATT_U("dur", gf_filter_pck_get_duration(pck) )
 	sap = gf_filter_pck_get_sap(pck);
 	if (sap==GF_FILTER_SAP_4_PROL) {
-		DUMP_ATT_STR(sap, "4 (prol)");
+		DUMP_ATT_STR("sap", "4 (prol)");
 	} else {
 		DUMP_ATT_U("sap", gf_filter_pck_get_sap(pck) )
 	}
@@ -1780,7 +1926,7 @@ static void inspect_dump_packet(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket
 	DUMP_ATT_D("seek", gf_filter_pck_get_seek_flag(pck) )
 
 	ts = gf_filter_pck_get_byte_offset(pck);
-	if (ts==GF_FILTER_NO_BO) DUMP_ATT_STR("bo", "N/A")
+	if (ts==GF_FILTER_NO_BO) DUMP_ATT_NA("bo")
 	else DUMP_ATT_LLU("bo", ts )
 
 	DUMP_ATT_U("roll", gf_filter_pck_get_roll_info(pck) )
@@ -1799,15 +1945,21 @@ static void inspect_dump_packet(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket
 	if (!data) size = 0;
 	if (ctx->dump_data) {
 		u32 i;
-		DUMP_ATT_STR("data", "")
+		if (ctx->json) {
+			gf_fprintf(dump, ",\"data\":\"");
+		} else {
+			DUMP_ATT_STR("data", "")
+		}
 		for (i=0; i<size; i++) {
 			gf_fprintf(dump, "%02X", (unsigned char) data[i]);
 		}
-		if (ctx->xml) gf_fprintf(dump, "\"");
+		if (ctx->xml || ctx->json) gf_fprintf(dump, "\"");
 	} else if (fifce) {
 		u32 i;
 		char *name = fifce->get_gl_texture ? "Interface_GLTexID" : "Interface_NumPlanes";
-		if (ctx->xml) {
+		if (ctx->json) {
+			gf_fprintf(dump, ",\"%s\":\"", name);
+		} else if (ctx->xml) {
 			gf_fprintf(dump, " %s=\"", name);
 		} else {
 			gf_fprintf(dump, " %s ", name);
@@ -1832,12 +1984,24 @@ static void inspect_dump_packet(GF_InspectCtx *ctx, FILE *dump, GF_FilterPacket
 			gf_fprintf(dump, "%d", i);
 		}
 
-		if (ctx->xml) {
+		if (ctx->xml || ctx->json) {
 			gf_fprintf(dump, "\"");
 		}
 	} else if (data) {
 		DUMP_ATT_X("CRC32", gf_crc_32(data, size) )
 	}
+	if (ctx->json) {
+		u32 nb_props = 0;
+		while (ctx->props) {
+			u32 prop_4cc;
+			const char *prop_name;
+			const GF_PropertyValue * p = gf_filter_pck_enum_properties(pck, &idx, &prop_4cc, &prop_name);
+			if (!p) break;
+			inspect_dump_property_json(ctx, dump, prop_4cc, prop_name, p, &nb_props);
+		}
+		gf_fprintf(dump, nb_props ? "}}\n" : "}\n");
+		return;
+	}
 	if (ctx->xml) {
 		if (!ctx->props) goto props_done;
 
@@ -2034,6 +2198,25 @@ static void inspect_dump_pid(GF_InspectCtx *ctx, FILE *dump, GF_FilterPid *pid,
 	if (!ctx->dump) return;
 	if (ctx->test==INSPECT_TEST_NOPROP) return;
 
+	if (ctx->json) {
+		u32 nb_props = 0;
+		gf_fprintf(dump, "{\"PID\":%d,\"name\":", pid_idx);
+		inspect_dump_json_string(dump, gf_filter_pid_get_name(pid));
+		gf_fprintf(dump, ",\"event\":\"%s\"", is_info ? "info" : is_remove ? "remove" : is_connect ? "configure" : "reconfigure");
+		if (pck_for_config)
+			gf_fprintf(dump, ",\"packetsSinceLastConfig\":"LLU, pck_for_config);
+
+		while (!is_info || ctx->info) {
+			u32 prop_4cc;
+			const char *prop_name;
+			p = is_info ? gf_filter_pid_enum_info(pid, &idx, &prop_4cc, &prop_name) : gf_filter_pid_enum_properties(pid, &idx, &prop_4cc, &prop_name);
+			if (!p) break;
+			inspect_dump_property_json(ctx, dump, prop_4cc, prop_name, p, &nb_props);
+		}
+		gf_fprintf(dump, nb_props ? "}}\n" : "}\n");
+		return;
+	}
+
 	//disconnect of src pid (not yet supported)
 	if (ctx->xml) {
 		if (is_info) {
@@ -2377,15 +2560,157 @@ static void inspect_dump_pid(GF_InspectCtx *ctx, FILE *dump, GF_FilterPid *pid,
 	gf_fprintf(dump, "</%s>\n", elt_name);
 }
 
+static void inspect_shard_process(GF_InspectCtx *ctx, u32 shard_idx)
+{
+	u32 i;
+	FILE *out = ctx->shards[shard_idx].out;
+	for (i=0; i<ctx->nb_queued; i++) {
+		InspectQueuedPacket *qp = &ctx->queue[i];
+		if (qp->shard != shard_idx) continue;
+		qp->offset = (u32) gf_ftell(out);
+		inspect_dump_packet(ctx, out, qp->pck, qp->pctx->idx, qp->pck_num, qp->pctx);
+		qp->size = (u32) gf_ftell(out) - qp->offset;
+	}
+}
+
+static u32 inspect_worker_run(void *par)
+{
+	InspectShard *shard = (InspectShard *)par;
+	GF_InspectCtx *ctx = shard->ctx;
+	u32 shard_idx = (u32) (shard - ctx->shards);
+	while (1) {
+		gf_sema_wait(shard->run);
+		if (ctx->exit) break;
+		inspect_shard_process(ctx, shard_idx);
+		gf_sema_notify(ctx->done, 1);
+	}
+	return 0;
+}
+
+//dump all queued packets and write their dumps to the pid outputs in queue order
+static void inspect_flush_queue(GF_InspectCtx *ctx)
+{
+	u32 i, nb_run=0;
+	const u8 *data[256];
+	if (!ctx->nb_queued) return;
+
+	//parsers state is per pid when analyzing, otherwise packet dump does not use the pid state and the batch
+	//is split in contiguous packet ranges
+	for (i=0; i<ctx->nb_queued; i++) {
+		InspectQueuedPacket *qp = &ctx->queue[i];
+		if (ctx->analyze) qp->shard = qp->pctx->shard;
+		else qp->shard = i * ctx->nb_shards / ctx->nb_queued;
+		ctx->shards[qp->shard].nb_pcks++;
+	}
+
+	for (i=1; i<ctx->nb_shards; i++) {
+		if (!ctx->shards[i].nb_pcks) continue;
+		gf_sema_notify(ctx->shards[i].run, 1);
+		nb_run++;
+	}
+	//first worker is run by the calling thread
+	if (ctx->shards[0].nb_pcks)
+		inspect_shard_process(ctx, 0);
+	for (i=0; i<nb_run; i++)
+		gf_sema_wait(ctx->done);
+
+	for (i=0; i<ctx->nb_shards; i++) {
+		data[i] = gf_file_temp_mem_data(ctx->shards[i].out, NULL);
+		ctx->shards[i].nb_pcks = 0;
+	}
+
+	for (i=0; i<ctx->nb_queued; i++) {
+		InspectQueuedPacket *qp = &ctx->queue[i];
+		if (qp->size && qp->pctx->tmp)
+			gf_fwrite(data[qp->shard] + qp->offset, qp->size, qp->pctx->tmp);
+		gf_filter_pck_unref(qp->pck);
+	}
+	ctx->nb_queued = 0;
+	for (i=0; i<ctx->nb_shards; i++)
+		gf_file_temp_mem_reset(ctx->shards[i].out);
+}
+
+static void inspect_del_threads(GF_InspectCtx *ctx)
+{
+	u32 i;
+	if (ctx->shards) inspect_flush_queue(ctx);
+	ctx->exit = GF_TRUE;
+	for (i=0; i<ctx->nb_shards; i++) {
+		InspectShard *shard = &ctx->shards[i];
+		if (shard->th) {
+			gf_sema_notify(shard->run, 1);
+			gf_th_stop(shard->th);
+			gf_th_del(shard->th);
+		}
+		if (shard->run) gf_sema_del(shard->run);
+		if (shard->out) gf_fclose(shard->out);
+	}
+	if (ctx->shards) gf_free(ctx->shards);
+	ctx->shards = NULL;
+	ctx->nb_shards = 0;
+	if (ctx->queue) gf_free(ctx->queue);
+	ctx->queue = NULL;
+	if (ctx->done) gf_sema_del(ctx->done);
+	ctx->done = NULL;
+}
+
+static GF_Err inspect_setup_threads(GF_InspectCtx *ctx)
+{
+	u32 i, nb_threads = ctx->threads;
+	if (ctx->threads<0) {
+		GF_SystemRTInfo rti;
+		nb_threads = 0;
+		if (gf_sys_get_rti(0, &rti, 0))
+			nb_threads = rti.nb_cores;
+	}
+	if (nb_threads<=1) return GF_OK;
+	//worker output pointers are kept on the stack when merging
+	if (nb_threads>256) nb_threads = 256;
+
+	ctx->shards = gf_malloc(sizeof(InspectShard) * nb_threads);
+	ctx->queue = gf_malloc(sizeof(InspectQueuedPacket) * INSPECT_BATCH_SIZE);
+	ctx->done = gf_sema_new(nb_threads, 0);
+	if (!ctx->shards || !ctx->queue || !ctx->done) {
+		inspect_del_threads(ctx);
+		return GF_OUT_OF_MEM;
+	}
+	memset(ctx->shards, 0, sizeof(InspectShard) * nb_threads);
+	ctx->nb_shards = nb_threads;
+	for (i=0; i<nb_threads; i++) {
+		InspectShard *shard = &ctx->shards[i];
+		shard->ctx = ctx;
+		shard->out = gf_file_temp_mem();
+		if (!shard->out) {
+			inspect_del_threads(ctx);
+			return GF_OUT_OF_MEM;
+		}
+		//first worker is run by the calling thread
+		if (!i) continue;
+		shard->run = gf_sema_new(1, 0);
+		shard->th = gf_th_new("InspectWorker");
+		if (!shard->run || !shard->th || gf_th_run(shard->th, inspect_worker_run, shard)) {
+			inspect_del_threads(ctx);
+			return GF_IO_ERR;
+		}
+	}
+	return GF_OK;
+}
+
 static GF_Err inspect_process(GF_Filter *filter)
 {
-	u32 i, count, nb_done=0;
+	u32 i, count, nb_done=0, nb_pck=0;
 	GF_InspectCtx *ctx = (GF_InspectCtx *) gf_filter_get_udta(filter);
 
 	count = gf_list_count(ctx->src_pids);
 
 	if (ctx->args_updated) {
+		inspect_flush_queue(ctx);
 		ctx->args_updated = GF_FALSE;
+		if (ctx->json) {
+			ctx->analyze = GF_FALSE;
+			ctx->xml = GF_FALSE;
+			ctx->fmt = NULL;
+		}
 		for (i=0; i<count; i++) {
 			PidCtx *pctx = gf_list_get(ctx->src_pids, i);
 			switch (ctx->mode) {
@@ -2414,6 +2739,8 @@ static GF_Err inspect_process(GF_Filter *filter)
 			continue;
 
 		if (pctx->dump_pid) {
+			//pid dump uses the parsers state and the pid output, dump pending packets first
+			inspect_flush_queue(ctx);
 			inspect_dump_pid(ctx, pctx->tmp, pctx->src_pid, pctx->idx, pctx->init_pid_config_done ? GF_FALSE : GF_TRUE, GF_FALSE, pctx->pck_for_config, (pctx->dump_pid==2) ? GF_TRUE : GF_FALSE, pctx);
 			pctx->dump_pid = 0;
 			pctx->init_pid_config_done = 1;
@@ -2430,6 +2757,7 @@ static GF_Err inspect_process(GF_Filter *filter)
 		
 		pctx->pck_for_config++;
 		pctx->pck_num++;
+		nb_pck++;
 
 		if (ctx->dump_pck) {
 
@@ -2437,6 +2765,15 @@ static GF_Err inspect_process(GF_Filter *filter)
 				nb_done++;
 			} else if (ctx->fmt) {
 				inspect_dump_packet_fmt(ctx, pctx->tmp, pck, pctx, pctx->pck_num);
+			} else if (ctx->nb_shards && pctx->tmp) {
+				InspectQueuedPacket *qp = &ctx->queue[ctx->nb_queued];
+				qp->pck = pck;
+				gf_filter_pck_ref(&qp->pck);
+				qp->pctx = pctx;
+				qp->pck_num = pctx->pck_num;
+				ctx->nb_queued++;
+				if (ctx->nb_queued == INSPECT_BATCH_SIZE)
+					inspect_flush_queue(ctx);
 			} else {
 				inspect_dump_packet(ctx, pctx->tmp, pck, pctx->idx, pctx->pck_num, pctx);
 			}
@@ -2458,6 +2795,10 @@ static GF_Err inspect_process(GF_Filter *filter)
 		}
 		gf_filter_pid_drop_packet(pctx->src_pid);
 	}
+	//no more input for now, don't keep packets pending
+	if (!nb_pck)
+		inspect_flush_queue(ctx);
+
 	if (ctx->is_prober && !ctx->probe_done && (nb_done==count) && !ctx->allp) {
 		for (i=0; i<count; i++) {
 			PidCtx *pctx = gf_list_get(ctx->src_pids, i);
@@ -2480,6 +2821,9 @@ static GF_Err inspect_config_input(GF_Filter *filter, GF_FilterPid *pid, Bool is
 
 	if (!ctx->src_pids) ctx->src_pids = gf_list_new();
 
+	//pid indexes and parsers may change, dump pending packets first
+	inspect_flush_queue(ctx);
+
 	pctx = gf_filter_pid_get_udta(pid);
 	if (pctx) {
 		assert(pctx->src_pid == pid);
@@ -2527,6 +2871,11 @@ static GF_Err inspect_config_input(GF_Filter *filter, GF_FilterPid *pid, Bool is
 
 	pctx->idx = gf_list_find(ctx->src_pids, pctx) + 1;
 
+	if (ctx->nb_shards) {
+		pctx->shard = ctx->nb_pids_assigned % ctx->nb_shards;
+		ctx->nb_pids_assigned++;
+	}
+
 	if (! ctx->interleave && !pctx->tmp && ctx->dump) {
 		pctx->tmp = gf_file_temp(NULL);
 		if (ctx->xml)
@@ -2605,9 +2954,20 @@ GF_Err inspect_initialize(GF_Filter *filter)
 			return GF_IO_ERR;
 		}
 	}
+	if (ctx->json) {
+		if (ctx->analyze) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[Inspect] Bitstream analysis not available with JSON output, disabling\n"));
+		}
+		ctx->analyze = GF_FALSE;
+		ctx->xml = GF_FALSE;
+		ctx->fmt = NULL;
+	}
 	if (ctx->analyze) {
 		ctx->xml = GF_TRUE;
 	}
+	if (ctx->dump && inspect_setup_threads(ctx)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[Inspect] Failed to setup %d dump threads, using single-threaded dump\n", ctx->threads));
+	}
 
 	if (ctx->xml && ctx->dump) {
 		ctx->fmt = NULL;
@@ -2668,7 +3028,9 @@ static const GF_FilterArgs InspectArgs[] =
 	{ OFFS(start), "set playback start offset. Negative value means percent of media dur with -1 <=> dur", GF_PROP_DOUBLE, "0.0", NULL, 0},
 	{ OFFS(dur), "set inspect duration", GF_PROP_FRACTION, "0/0", NULL, 0},
 	{ OFFS(analyze), "analyze sample content (NALU, OBU)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED|GF_FS_ARG_UPDATE},
+	{ OFFS(threads), "number of threads for packet dump (see filter help). A value of 0 or 1 disables multi-threaded dump, a negative value uses one thread per core", GF_PROP_SINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(xml), "use xml formatting (implied if (-analyze]() is set) and disable [-fmt]()", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_UPDATE},
+	{ OFFS(json), "use JSON lines formatting, one object per line for each PID event and packet (see filter help). Disables [-fmt](), [-xml]() and [-analyze]()", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(fftmcd), "consider timecodes use ffmpeg-compatible signaling rather than QT compliant one", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT|GF_FS_ARG_UPDATE},
 	{ OFFS(dtype), "dump property type", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_UPDATE},
 	{ OFFS(test), "skip predefined set of properties, used for test mode\n"
@@ -2736,7 +3098,15 @@ const GF_FilterRegister InspectRegister = {
 	 			"  \n"\
 	 			"An unrecognized keywork or missing property will resolve to an empty string.\n"\
 	 			"\n"\
-	 			"Note: when dumping in interleaved mode, there is no guarantee that the packets will be dumped in their original sequence order since the inspector fetches one packet at a time on each PID.\n")
+	 			"Note: when dumping in interleaved mode, there is no guarantee that the packets will be dumped in their original sequence order since the inspector fetches one packet at a time on each PID.\n"\
+	 			"\n"\
+	 			"When [-threads]() is set, packets are dumped by batch using several threads. Without [-analyze](), each batch is split in packet ranges across threads. "\
+	 			"With [-analyze](), each PID is always dumped by the same thread since bitstream analysis depends on previous packets of the PID, so only sources with several PIDs benefit from threads. "\
+	 			"Each thread dumps in memory, and dumps are written to the output in the order the packets were received, so the output is the same as with a single thread. "\
+	 			"Multi-threaded dump is not used with [-fmt]().\n"\
+	 			"\n"\
+	 			"When [-json]() is set, each PID event and each packet is dumped as a single-line JSON object, with a `PID` member and either an `event` member (configure, reconfigure, remove or info) or a `packet` member (packet number). "\
+	 			"Packet fields use the names of the XML dump, unavailable timestamps and byte offsets are `null`, and PID or packet properties are dumped in a `properties` object.\n")
 	.private_size = sizeof(GF_InspectCtx),
 	.flags = GF_FS_REG_EXPLICIT_ONLY,
 	.max_extra_pids = (u32) -1,
@@ -143,6 +143,11 @@ typedef struct
 
 	Bool unload_session_api;
 	Bool disable_filter;
+
+	//cache of JS atoms for built-in property names
+	JSAtom *prop_atoms;
+	u32 *prop_ids;
+	u32 nb_prop_atoms, alloc_prop_atoms;
 } GF_JSFilterCtx;
 
 enum
@@ -219,6 +224,60 @@ typedef struct
 
 } GF_JSFilterInstanceCtx;
 
+/*gets built-in property ID from a JS value, either a 4CC number or a property name
+property names are cached as atoms, avoiding string conversion and name lookup for each call*/
+static u32 jsf_get_prop_id(GF_JSFilterCtx *jsf, JSContext *ctx, JSValueConst name_val)
+{
+	u32 i, p4cc;
+	JSAtom atom;
+	const char *name;
+
+	if (JS_IsNumber(name_val)) {
+		s32 val;
+		if (JS_ToInt32(ctx, &val, name_val)) return 0;
+		return (u32) val;
+	}
+	atom = JS_ValueToAtom(ctx, name_val);
+	if (!atom) return 0;
+	for (i=0; i<jsf->nb_prop_atoms; i++) {
+		if (jsf->prop_atoms[i] == atom) {
+			JS_FreeAtom(ctx, atom);
+			return jsf->prop_ids[i];
+		}
+	}
+	name = JS_AtomToCString(ctx, atom);
+	p4cc = name ? gf_props_get_id(name) : 0;
+	JS_FreeCString(ctx, name);
+	if (!p4cc) {
+		JS_FreeAtom(ctx, atom);
+		return 0;
+	}
+	if (jsf->nb_prop_atoms == jsf->alloc_prop_atoms) {
+		u32 alloc = jsf->alloc_prop_atoms ? 2*jsf->alloc_prop_atoms : 16;
+		JSAtom *atoms;
+		u32 *ids;
+		//on allocation failure, keep the current cache and do not cache this name
+		atoms = gf_realloc(jsf->prop_atoms, sizeof(JSAtom) * alloc);
+		if (!atoms) {
+			JS_FreeAtom(ctx, atom);
+			return p4cc;
+		}
+		jsf->prop_atoms = atoms;
+		ids = gf_realloc(jsf->prop_ids, sizeof(u32) * alloc);
+		if (!ids) {
+			JS_FreeAtom(ctx, atom);
+			return p4cc;
+		}
+		jsf->prop_ids = ids;
+		jsf->alloc_prop_atoms = alloc;
+	}
+	//atom reference is kept until filter finalize
+	jsf->prop_atoms[jsf->nb_prop_atoms] = atom;
+	jsf->prop_ids[jsf->nb_prop_atoms] = p4cc;
+	jsf->nb_prop_atoms++;
+	return p4cc;
+}
+
 
 static JSClassID jsf_filter_class_id;
 
@@ -1963,10 +2022,10 @@ static JSValue jsf_pid_get_property_ex(JSContext *ctx, JSValueConst this_val, in
 	const GF_PropertyValue *prop;
 	GF_PropertyEntry *pe = NULL;
 	GF_JSPidCtx *pctx = JS_GetOpaque(this_val, jsf_pid_class_id);
-    if (!pctx) return JS_EXCEPTION;
-    name = JS_ToCString(ctx, argv[0]);
-	if (!name) return JS_EXCEPTION;
+    if (!pctx || !argc) return JS_EXCEPTION;
 	if ((argc>1) && JS_ToBool(ctx, argv[1])) {
+		name = JS_ToCString(ctx, argv[0]);
+		if (!name) return JS_EXCEPTION;
 		if (is_info) {
 			prop = gf_filter_pid_get_info_str(pctx->pid, name, &pe);
 		} else {
@@ -1977,8 +2036,7 @@ static JSValue jsf_pid_get_property_ex(JSContext *ctx, JSValueConst this_val, in
 		res = jsf_NewProp(ctx, prop);
 		JS_SetPropertyStr(ctx, res, "type", JS_NewInt32(ctx, prop->type));
 	} else {
-		u32 p4cc = gf_props_get_id(name);
-		JS_FreeCString(ctx, name);
+		u32 p4cc = jsf_get_prop_id(pctx->jsf, ctx, argv[0]);
 		if (!p4cc) return JS_EXCEPTION;
 		if (is_info) {
 			prop = gf_filter_pid_get_info(pctx->pid, p4cc, &pe);
@@ -2412,11 +2470,11 @@ static JSValue jsf_pid_set_property_ex(JSContext *ctx, JSValueConst this_val, in
 	const GF_PropertyValue *the_prop = NULL;
 	const char *name=NULL;
 	GF_JSPidCtx *pctx = JS_GetOpaque(this_val, jsf_pid_class_id);
-    if (!pctx) return JS_EXCEPTION;
-    name = JS_ToCString(ctx, argv[0]);
-	if (!name) return JS_EXCEPTION;
+    if (!pctx || (argc<2)) return JS_EXCEPTION;
 
 	if ((argc>2) && JS_ToBool(ctx, argv[2])) {
+		name = JS_ToCString(ctx, argv[0]);
+		if (!name) return JS_EXCEPTION;
 		if (!JS_IsNull(argv[1])) {
 			e = jsf_ToProp(pctx->jsf->filter, ctx, argv[1], 0, &prop);
 			JS_FreeCString(ctx, name);
@@ -2432,8 +2490,7 @@ static JSValue jsf_pid_set_property_ex(JSContext *ctx, JSValueConst this_val, in
 			e = gf_filter_pid_set_property_dyn(pctx->pid, (char *) name, &prop);
 		}
 	} else {
-		u32 p4cc = gf_props_get_id(name);
-		JS_FreeCString(ctx, name);
+		u32 p4cc = jsf_get_prop_id(pctx->jsf, ctx, argv[0]);
 		if (!p4cc) return JS_EXCEPTION;
 		if (!JS_IsNull(argv[1])) {
 			e = jsf_ToProp(pctx->jsf->filter, ctx, argv[1], p4cc, &prop);
@@ -2515,6 +2572,30 @@ static JSValue jsf_pid_forward(JSContext *ctx, JSValueConst this_val, int argc,
     return JS_UNDEFINED;
 }
 
+static JSValue jsf_pid_forward_packets(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
+{
+	s32 max_pck = -1;
+	u32 nb_pck = 0;
+	GF_JSPidCtx *ipctx;
+	GF_JSPidCtx *pctx = JS_GetOpaque(this_val, jsf_pid_class_id);
+    if (!pctx || !argc) return JS_EXCEPTION;
+	ipctx = JS_GetOpaque(argv[0], jsf_pid_class_id);
+    if (!ipctx) return JS_EXCEPTION;
+	if ((argc>1) && JS_ToInt32(ctx, &max_pck, argv[1])) return JS_EXCEPTION;
+
+	//forward and drop input packets in a single call, avoiding packet object creation and 3 calls per packet
+	while ((max_pck<0) || (nb_pck < (u32) max_pck)) {
+		GF_Err e;
+		GF_FilterPacket *pck = gf_filter_pid_get_packet(ipctx->pid);
+		if (!pck) break;
+		e = gf_filter_pck_forward(pck, pctx->pid);
+		if (e) return js_throw_err(ctx, e);
+		//releases the JS object of the packet if any
+		jsf_pid_drop_packet(ctx, argv[0], 0, NULL);
+		nb_pck++;
+	}
+    return JS_NewInt32(ctx, nb_pck);
+}
 
 static const JSCFunctionListEntry jsf_pid_funcs[] = {
     JS_CGETSET_MAGIC_DEF("name", jsf_pid_get_prop, jsf_pid_set_prop, JSF_PID_NAME),
@@ -2565,6 +2646,7 @@ static const JSCFunctionListEntry jsf_pid_funcs[] = {
     JS_CFUNC_DEF("reset_props", 0, jsf_pid_reset_props),
     JS_CFUNC_DEF("copy_props", 0, jsf_pid_copy_props),
     JS_CFUNC_DEF("forward", 0, jsf_pid_forward),
+    JS_CFUNC_DEF("forward_packets", 0, jsf_pid_forward_packets),
     JS_CFUNC_DEF("negociate_prop", 0, jsf_pid_negociate_prop),
 };
 
@@ -3498,20 +3580,19 @@ static JSValue jsf_pck_get_property(JSContext *ctx, JSValueConst this_val, int a
 	const GF_PropertyValue *prop;
 	GF_FilterPacket *pck;
 	GF_JSPckCtx *pckctx = JS_GetOpaque(this_val, jsf_pck_class_id);
-    if (!pckctx || !pckctx->pck) return JS_EXCEPTION;
+    if (!pckctx || !pckctx->pck || !argc) return JS_EXCEPTION;
     pck = pckctx->pck;
 
-    name = JS_ToCString(ctx, argv[0]);
-	if (!name) return JS_EXCEPTION;
 	if ((argc>1) && JS_ToBool(ctx, argv[1])) {
+		name = JS_ToCString(ctx, argv[0]);
+		if (!name) return JS_EXCEPTION;
 		prop = gf_filter_pck_get_property_str(pck, name);
 		JS_FreeCString(ctx, name);
 		if (!prop) return JS_NULL;
 		res = jsf_NewProp(ctx, prop);
 		JS_SetPropertyStr(ctx, res, "type", JS_NewInt32(ctx, prop->type));
 	} else {
-		u32 p4cc = gf_props_get_id(name);
-		JS_FreeCString(ctx, name);
+		u32 p4cc = jsf_get_prop_id(pckctx->jspid->jsf, ctx, argv[0]);
 		if (!p4cc)
 			return js_throw_err(ctx, GF_BAD_PARAM);
 
@@ -3603,14 +3684,13 @@ static JSValue jsf_pck_set_property(JSContext *ctx, JSValueConst this_val, int a
 	const char *name=NULL;
 	GF_FilterPacket *pck;
 	GF_JSPckCtx *pckctx = JS_GetOpaque(this_val, jsf_pck_class_id);
-    if (!pckctx || !pckctx->pck) return JS_EXCEPTION;
+    if (!pckctx || !pckctx->pck || (argc<2)) return JS_EXCEPTION;
     pck = pckctx->pck;
 
-    name = JS_ToCString(ctx, argv[0]);
-	if (!name) return JS_EXCEPTION;
-
 	if ((argc>2) && JS_ToBool(ctx, argv[2])) {
-		if (!JS_IsNull(argv[2])) {
+		name = JS_ToCString(ctx, argv[0]);
+		if (!name) return JS_EXCEPTION;
+		if (!JS_IsNull(argv[1])) {
 			e = jsf_ToProp(pckctx->jspid->jsf->filter, ctx, argv[1], 0, &prop);
 			JS_FreeCString(ctx, name);
 			if (e) return js_throw_err(ctx, e);
@@ -3620,10 +3700,9 @@ static JSValue jsf_pck_set_property(JSContext *ctx, JSValueConst this_val, int a
 			e = gf_filter_pck_set_property_dyn(pck, (char *) name, NULL);
 		}
 	} else {
-		u32 p4cc = gf_props_get_id(name);
-		JS_FreeCString(ctx, name);
-		if (!p4cc) return js_throw_err(ctx, GF_OUT_OF_MEM);
-		if (!!JS_IsNull(argv[1])) {
+		u32 p4cc = jsf_get_prop_id(pckctx->jspid->jsf, ctx, argv[0]);
+		if (!p4cc) return js_throw_err(ctx, GF_BAD_PARAM);
+		if (!JS_IsNull(argv[1])) {
 			e = jsf_ToProp(pckctx->jspid->jsf->filter, ctx, argv[1], p4cc, &prop);
 			if (e) return js_throw_err(ctx, e);
 			e = gf_filter_pck_set_property(pck, p4cc, &prop);
@@ -4167,6 +4246,12 @@ static void jsfilter_finalize(GF_Filter *filter)
 
 	JS_SetOpaque(jsf->filter_obj, NULL);
 
+	for (i=0; i<jsf->nb_prop_atoms; i++) {
+		JS_FreeAtom(jsf->ctx, jsf->prop_atoms[i]);
+	}
+	if (jsf->prop_atoms) gf_free(jsf->prop_atoms);
+	if (jsf->prop_ids) gf_free(jsf->prop_ids);
+
 	if (jsf->unload_session_api)
 		gf_fs_unload_script(filter->session, jsf->ctx);
 
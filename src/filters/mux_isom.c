@@ -304,6 +304,11 @@ typedef struct
 
 	u32 next_file_idx;
 	const char *next_file_suffix;
+
+	//LL-HLS mode, each fragment is signaled to the dasher
+	Bool llhls_mode;
+	u64 frag_offset, frag_dur;
+	Bool frag_has_ref, frag_independent;
 } GF_MP4MuxCtx;
 
 static void mp4_mux_set_hevc_groups(GF_MP4MuxCtx *ctx, TrackWriter *tkw);
@@ -957,6 +962,17 @@ static GF_Err mp4_mux_setup_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_tr
 	else if (ctx->noinit) {
 		ctx->dash_mode = MP4MX_DASH_ON;
 	}
+	//LL-HLS: fragments are the parts, use part duration as fragment duration
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_LLHLS);
+	if (p && (p->value.number>0) && ctx->dash_mode && !ctx->llhls_mode) {
+		if ((ctx->cdur>=0) && (ctx->cdur != p->value.number)) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[MP4Mux] LL-HLS mode, using part duration %g instead of chunk duration %g\n", p->value.number, ctx->cdur));
+		}
+		ctx->llhls_mode = GF_TRUE;
+		ctx->cdur = p->value.number;
+		ctx->cdur_set = GF_TRUE;
+		ctx->fragdur = GF_TRUE;
+	}
 
 	if (!ctx->cdur_set) {
 		ctx->cdur_set = GF_TRUE;
@@ -3648,6 +3664,30 @@ static void mp4_mux_flush_frag(GF_MP4MuxCtx *ctx, Bool is_init, u64 idx_start_ra
 }
 
 
+//signals LL-HLS part written since last call
+static void mp4_mux_flush_llhls_frag(GF_MP4MuxCtx *ctx, Bool is_last)
+{
+	GF_FilterEvent evt;
+	TrackWriter *tkw = gf_list_get(ctx->tracks, 0);
+
+	if (!is_last && (ctx->current_size <= ctx->frag_offset))
+		return;
+
+	//send event on first track only
+	GF_FEVT_INIT(evt, GF_FEVT_FRAGMENT_SIZE, tkw->ipid);
+	evt.frag_size.is_last = is_last;
+	evt.frag_size.offset = ctx->frag_offset;
+	evt.frag_size.size = (u32) (ctx->current_size - ctx->frag_offset);
+	evt.frag_size.duration.num = ctx->frag_dur;
+	evt.frag_size.duration.den = ctx->ref_tkw->src_timescale;
+	evt.frag_size.independent = ctx->frag_independent;
+	gf_filter_pid_send_event(tkw->ipid, &evt);
+
+	ctx->frag_offset = is_last ? 0 : ctx->current_size;
+	ctx->frag_dur = 0;
+	ctx->frag_has_ref = GF_FALSE;
+}
+
 static GF_Err mp4_mux_initialize_movie(GF_MP4MuxCtx *ctx)
 {
 	GF_Err e;
@@ -4353,6 +4393,8 @@ static GF_Err mp4_mux_process_fragmented(GF_Filter *filter, GF_MP4MuxCtx *ctx)
 					if (ctx->dash_seg_num && (ctx->dash_seg_num != p->value.uint) ) {
 						tkw->fragment_done = GF_TRUE;
 						tkw->samples_in_frag = 0;
+						//parts restart at segment boundaries
+						if (ctx->llhls_mode) tkw->dur_in_frag = 0;
 						nb_done ++;
 						//make sure we flush until the end of the segment
 						ctx->flush_seg = GF_TRUE;
@@ -4397,6 +4439,14 @@ static GF_Err mp4_mux_process_fragmented(GF_Filter *filter, GF_MP4MuxCtx *ctx)
 				break;
 			} else if (ctx->fragdur && (!ctx->dash_mode || !tkw->fragment_done) ) {
 				u32 dur = gf_filter_pck_get_duration(pck);
+				//in LL-HLS mode, parts shall not exceed the target duration
+				if (tkw->dur_in_frag && ctx->llhls_mode && (tkw->dur_in_frag + dur > (u64) (ctx->cdur * tkw->src_timescale + 0.5)) ) {
+					tkw->fragment_done = GF_TRUE;
+					nb_done ++;
+					tkw->dur_in_frag = 0;
+					tkw->samples_in_frag = 0;
+					break;
+				}
 				if (tkw->dur_in_frag && (tkw->dur_in_frag >= ctx->cdur * tkw->src_timescale)) {
 					tkw->fragment_done = GF_TRUE;
 					nb_done ++;
@@ -4452,6 +4502,14 @@ static GF_Err mp4_mux_process_fragmented(GF_Filter *filter, GF_MP4MuxCtx *ctx)
 				}
 			}
 
+			if (ctx->llhls_mode && (tkw==ctx->ref_tkw)) {
+				if (!ctx->frag_has_ref) {
+					ctx->frag_has_ref = GF_TRUE;
+					ctx->frag_independent = mp4_mux_get_sap(ctx, pck) ? GF_TRUE : GF_FALSE;
+				}
+				ctx->frag_dur += gf_filter_pck_get_duration(pck);
+			}
+
 			//process packet
 			e = mp4_mux_process_sample(ctx, tkw, pck, GF_TRUE);
 
@@ -4524,6 +4582,9 @@ static GF_Err mp4_mux_process_fragmented(GF_Filter *filter, GF_MP4MuxCtx *ctx)
 			e = gf_isom_close_segment(ctx->file, subs_sidx, track_ref_id, ctx->ref_tkw->first_dts_in_seg, ctx->ref_tkw->ts_delay, next_ref_ts, ctx->chain_sidx, ctx->ssix, ctx->sseg ? GF_FALSE : is_eos, GF_FALSE, ctx->eos_marker, &idx_start_range, &idx_end_range, &segment_size_in_bytes);
 			if (e) return e;
 
+			if (ctx->llhls_mode)
+				mp4_mux_flush_llhls_frag(ctx, GF_TRUE);
+
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MP4Mux] Done writing segment %d - estimated next fragment times start %g end %g\n", ctx->dash_seg_num, ref_start, ctx->next_frag_start ));
 
 			if (ctx->dash_mode != MP4MX_DASH_VOD) {
@@ -4545,8 +4606,13 @@ static GF_Err mp4_mux_process_fragmented(GF_Filter *filter, GF_MP4MuxCtx *ctx)
 		else if (!ctx->dash_mode || ((ctx->subs_sidx<0) && (ctx->dash_mode<MP4MX_DASH_VOD) && !ctx->cloned_sidx) ) {
 			gf_isom_flush_fragments(ctx->file, GF_FALSE);
 
-			if (!ctx->dash_mode || ctx->flush_seg)
+			if (!ctx->dash_mode || ctx->flush_seg) {
 				mp4_mux_flush_frag(ctx, GF_FALSE, 0, 0);
+			} else if (ctx->llhls_mode) {
+				//don't hold the end of the part until next write
+				mp4mux_send_output(ctx);
+				mp4_mux_flush_llhls_frag(ctx, GF_FALSE);
+			}
 
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MP4Mux] Done writing fragment - next fragment start time %g\n", ctx->next_frag_start ));
 		}
@@ -34,7 +34,8 @@ typedef struct
 	Double start, speed;
 	char *dst, *mime, *ext;
 	Bool append, dynext, cat, ow, redund;
-	u32 mvbk;
+	u32 mvbk, hash;
+	char *hashf;
 
 	//only one input pid
 	GF_FilterPid *pid;
@@ -54,18 +55,85 @@ typedef struct
 	u64 offset_at_seg_start;
 	const char *original_url;
 	GF_FileIO *gfio_ref;
+
+	//hash of file being written, computed as data is written
+	GF_SHA1Context *sha1_ctx;
+	GF_SHA256Context *sha256_ctx;
+	//set when file is patched or appended, hash is computed from file when closing it
+	Bool hash_from_file;
+	FILE *hash_out;
 } GF_FileOutCtx;
 
+enum
+{
+	FOUT_HASH_NONE=0,
+	FOUT_HASH_SHA1,
+	FOUT_HASH_SHA256,
+};
+
 #ifdef WIN32
 #include <io.h>
 #include <fcntl.h>
 #endif //WIN32
 
+static void fileout_hash_start(GF_FileOutCtx *ctx, Bool from_file)
+{
+	if (ctx->hash==FOUT_HASH_SHA1) ctx->sha1_ctx = gf_sha1_starts();
+	else ctx->sha256_ctx = gf_sha256_starts();
+	ctx->hash_from_file = from_file;
+}
+
+static void fileout_hash_update(GF_FileOutCtx *ctx, const u8 *data, u32 size)
+{
+	if (ctx->hash_from_file) return;
+	if (ctx->sha1_ctx) gf_sha1_update(ctx->sha1_ctx, (u8 *) data, size);
+	else if (ctx->sha256_ctx) gf_sha256_update(ctx->sha256_ctx, (u8 *) data, size);
+}
+
+//called once the file is closed
+static void fileout_hash_end(GF_FileOutCtx *ctx)
+{
+	u8 hash[GF_SHA256_DIGEST_SIZE];
+	char szHash[2*GF_SHA256_DIGEST_SIZE+1];
+	u32 i, hash_size;
+	GF_Err e = GF_OK;
+
+	if (ctx->hash==FOUT_HASH_SHA1) {
+		hash_size = GF_SHA1_DIGEST_SIZE;
+		if (!ctx->sha1_ctx) return;
+		gf_sha1_finish(ctx->sha1_ctx, hash);
+		if (ctx->hash_from_file) e = gf_sha1_file(ctx->szFileName, hash);
+	} else {
+		hash_size = GF_SHA256_DIGEST_SIZE;
+		if (!ctx->sha256_ctx) return;
+		gf_sha256_finish(ctx->sha256_ctx, hash);
+		if (ctx->hash_from_file) e = gf_sha256_file(ctx->szFileName, hash);
+	}
+	ctx->sha1_ctx = NULL;
+	ctx->sha256_ctx = NULL;
+	if (e) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] Failed to compute hash of %s: %s\n", ctx->szFileName, gf_error_to_string(e) ));
+		return;
+	}
+	for (i=0; i<hash_size; i++) {
+		sprintf(szHash + 2*i, "%02x", hash[i]);
+	}
+	szHash[2*hash_size] = 0;
+	if (ctx->hash_out) {
+		//same format as sha1sum/sha256sum
+		gf_fprintf(ctx->hash_out, "%s  %s\n", szHash, ctx->szFileName);
+		gf_fflush(ctx->hash_out);
+	} else {
+		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] %s hash of %s: %s\n", (ctx->hash==FOUT_HASH_SHA1) ? "SHA-1" : "SHA-256", ctx->szFileName, szHash));
+	}
+}
+
 static GF_Err fileout_open_close(GF_FileOutCtx *ctx, const char *filename, const char *ext, u32 file_idx, Bool explicit_overwrite, char *file_suffix)
 {
 	if (ctx->file && !ctx->is_std) {
 		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] closing output file %s\n", ctx->szFileName));
 		gf_fclose(ctx->file);
+		if (ctx->hash) fileout_hash_end(ctx);
 	}
 	ctx->file = NULL;
 
@@ -124,6 +192,8 @@ static GF_Err fileout_open_close(GF_FileOutCtx *ctx, const char *filename, const
 			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] re-opening in write mode output file %s, content overwrite\n", szFinalName));
 		}
 		strcpy(ctx->szFileName, szFinalName);
+		//existing content in append mode, hash will be computed from file
+		if (ctx->file && ctx->hash) fileout_hash_start(ctx, append);
 	}
 	ctx->nb_write = 0;
 	if (!ctx->file) {
@@ -190,6 +260,15 @@ static GF_Err fileout_initialize(GF_Filter *filter)
 	if (!ctx->mvbk)
 		ctx->mvbk = 1;
 
+	if (ctx->hash && ctx->hashf) {
+		//several fout instances may share the same hash file (e.g. manifest and segments), always append
+		ctx->hash_out = gf_fopen(ctx->hashf, "a");
+		if (!ctx->hash_out) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] cannot open hash file %s\n", ctx->hashf));
+			return GF_IO_ERR;
+		}
+	}
+
 	if (strnicmp(ctx->dst, "file:/", 6) && strnicmp(ctx->dst, "gfio:/", 6) && strstr(ctx->dst, "://"))  {
 		gf_filter_setup_failure(filter, GF_NOT_SUPPORTED);
 		return GF_NOT_SUPPORTED;
@@ -258,6 +337,7 @@ static void fileout_finalize(GF_Filter *filter)
 	GF_Err e;
 	GF_FileOutCtx *ctx = (GF_FileOutCtx *) gf_filter_get_udta(filter);
 	fileout_open_close(ctx, NULL, NULL, 0, GF_FALSE, NULL);
+	if (ctx->hash_out) gf_fclose(ctx->hash_out);
 	if (ctx->gfio_ref)
 		gf_fileio_open_url((GF_FileIO *)ctx->gfio_ref, NULL, "unref", &e);
 }
@@ -470,6 +550,8 @@ static GF_Err fileout_process(GF_Filter *filter)
 					gf_fseek(ctx->file, bo, SEEK_SET);
 					nb_write = (u32) gf_fwrite(pck_data, pck_size, ctx->file);
 					gf_fseek(ctx->file, pos, SEEK_SET);
+					//file content patched, hash will be computed from file
+					ctx->hash_from_file = GF_TRUE;
 
 					if (nb_write!=pck_size) {
 						GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", nb_write, pck_size));
@@ -481,6 +563,7 @@ static GF_Err fileout_process(GF_Filter *filter)
 					GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", nb_write, pck_size));
 				}
 				ctx->nb_write += nb_write;
+				fileout_hash_update(ctx, pck_data, nb_write);
 			}
 		} else if (hwf) {
 			u32 w, h, stride, stride_uv, pf;
@@ -518,6 +601,7 @@ static GF_Err fileout_process(GF_Filter *filter)
 							GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", nb_write, lsize));
 						}
 						ctx->nb_write += nb_write;
+						fileout_hash_update(ctx, out_ptr, nb_write);
 						out_ptr += out_stride;
 					}
 				}
@@ -584,6 +668,11 @@ static const GF_FilterArgs FileOutArgs[] =
 	{ OFFS(ow), "overwrite output if existing", GF_PROP_BOOL, "true", NULL, 0},
 	{ OFFS(mvbk), "block size used when moving parts of the file around in patch mode", GF_PROP_UINT, "8192", NULL, 0},
 	{ OFFS(redund), "keep redundant packet in output file", GF_PROP_BOOL, "false", NULL, 0},
+	{ OFFS(hash), "compute hash of each output file (e.g. segments), computed while writing unless the file is patched or appended\n"
+	"- none: no hash\n"
+	"- sha1: SHA-1 hash\n"
+	"- sha256: SHA-256 hash", GF_PROP_UINT, "none", "none|sha1|sha256", GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(hashf), "file to append hashes to, one line per output file in sha1sum/sha256sum format. If not set, hashes are logged", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
 
 	{0}
 };
@@ -54,13 +54,16 @@ enum
 	MODE_SOURCE,
 };
 
+//number of LL-HLS segments kept in memory per input
+#define HTTPOUT_LLHLS_RING	4
+
 typedef struct
 {
 	//options
 	char *dst, *user_agent, *ifce, *cache_control, *ext, *mime, *wdir, *cert, *pkey, *reqlog;
 	GF_List *rdirs;
 	Bool close, hold, quit, post, dlist, ice;
-	u32 port, block_size, maxc, maxp, timeout, hmode, sutc, cors;
+	u32 port, block_size, maxc, maxp, timeout, hmode, sutc, cors, zmin;
 
 	//internal
 	GF_Filter *filter;
@@ -86,6 +89,9 @@ typedef struct
 	void *ssl_ctx;
 
 	u64 req_id;
+
+	//cache of text resources served from memory, with their gzip version
+	GF_List *res_cache;
 } GF_HTTPOutCtx;
 
 typedef struct
@@ -116,6 +122,12 @@ typedef struct
 
 	u8 *tunein_data;
 	u32 tunein_data_size;
+
+	//LL-HLS mode, last segments are kept in memory and served while being written
+	Bool llhls;
+	struct _httpout_cache_entry *llhls_ring[HTTPOUT_LLHLS_RING];
+	u32 llhls_idx;
+	struct _httpout_cache_entry *llhls_cur;
 } GF_HTTPOutInput;
 
 typedef struct
@@ -124,6 +136,30 @@ typedef struct
 	s64 end;
 } HTTByteRange;
 
+typedef struct _httpout_cache_entry
+{
+	char *path;
+	u64 modif_time;
+	//set once the file modification time can no longer match a later write
+	Bool modif_settled;
+	u8 *data;
+	u32 size;
+	//gzip version, NULL if not yet compressed or if compression is not efficient
+	u8 *gz_data;
+	u32 gz_size;
+	Bool gz_done;
+	//mime type probed when loading the resource, if any
+	char *mime;
+	//number of sessions sending this entry
+	u32 nb_users;
+	//entry was invalidated while in use, destroy when no longer used
+	Bool stale;
+	u32 last_used;
+	//for LL-HLS segments: allocated size and segment being written
+	u32 alloc;
+	Bool in_progress;
+} HTTPOutCacheEntry;
+
 typedef struct __httpout_session
 {
 	GF_HTTPOutCtx *ctx;
@@ -164,6 +200,19 @@ typedef struct __httpout_session
 	Bool do_log;
 	u64 req_id;
 	u32 method_type, reply_code;
+
+	//resource served from memory cache, and whether gzip version is used
+	HTTPOutCacheEntry *cache_entry;
+	Bool cache_gz;
+	//LL-HLS segment being written requested without range end, sent until segment end
+	Bool llhls_open;
+
+	//LL-HLS blocking playlist reload: local playlist path, requested media sequence and part, timeout
+	Bool hls_blocked, hls_wake;
+	char *hls_path;
+	u32 hls_msn;
+	s32 hls_part;
+	u64 hls_deadline;
 } GF_HTTPOutSession;
 
 static void httpout_reset_socket(GF_HTTPOutSession *sess)
@@ -478,6 +527,18 @@ static Bool httpout_sess_parse_range(GF_HTTPOutSession *sess, char *range)
 	}
 	if (!request_ok) return GF_FALSE;
 
+	//LL-HLS segment being written, size not yet known and open range sent until end of segment
+	if (sess->cache_entry && sess->cache_entry->in_progress) {
+		if (has_file_end || (sess->nb_ranges>1)) return GF_FALSE;
+		sess->bytes_in_req = 0;
+		if (sess->ranges[0].end>=0) {
+			if (sess->ranges[0].end < sess->ranges[0].start) return GF_FALSE;
+			sess->bytes_in_req = sess->ranges[0].end + 1 - sess->ranges[0].start;
+		}
+		sess->file_pos = sess->ranges[0].start;
+		return GF_TRUE;
+	}
+
 	if (sess->in_source) {
 		//cannot fetch end of file it is not yet known !
 		if (has_file_end) return GF_FALSE;
@@ -583,6 +644,301 @@ static const char *get_method_name(u32 method)
 }
 #endif //GPAC_DISABLE_LOG
 
+//max number of cached text resources and max size of a cached resource
+#define HTTPOUT_CACHE_MAX_ENTRIES	200
+#define HTTPOUT_CACHE_MAX_SIZE	10000000
+
+static void httpout_cache_del_entry(HTTPOutCacheEntry *ent)
+{
+	gf_free(ent->path);
+	if (ent->data) gf_free(ent->data);
+	if (ent->gz_data) gf_free(ent->gz_data);
+	if (ent->mime) gf_free(ent->mime);
+	gf_free(ent);
+}
+
+static void httpout_cache_remove(GF_HTTPOutCtx *ctx, HTTPOutCacheEntry *ent)
+{
+	gf_list_del_item(ctx->res_cache, ent);
+	if (ent->nb_users) ent->stale = GF_TRUE;
+	else httpout_cache_del_entry(ent);
+}
+
+static void httpout_cache_invalidate(GF_HTTPOutCtx *ctx, const char *path)
+{
+	u32 i, count;
+	if (!ctx->res_cache || !path) return;
+	count = gf_list_count(ctx->res_cache);
+	for (i=0; i<count; i++) {
+		HTTPOutCacheEntry *ent = gf_list_get(ctx->res_cache, i);
+		if (!strcmp(ent->path, path)) {
+			httpout_cache_remove(ctx, ent);
+			return;
+		}
+	}
+}
+
+static void httpout_cache_release(GF_HTTPOutSession *sess)
+{
+	HTTPOutCacheEntry *ent = sess->cache_entry;
+	if (!ent) return;
+	sess->cache_entry = NULL;
+	//restore size of resource on disk for keep-alive requests on the same resource
+	sess->file_size = sess->bytes_in_req = ent->size;
+	sess->cache_gz = GF_FALSE;
+	ent->nb_users--;
+	if (!ent->nb_users && ent->stale)
+		httpout_cache_del_entry(ent);
+}
+
+static Bool httpout_is_text_resource(const char *mime, const char *path)
+{
+	u32 i;
+	const char *ext;
+	const char *text_exts[] = {".mpd", ".m3u8", ".xml", ".txt", ".htm", ".html", ".json", ".js", ".css", ".vtt", ".srt", ".ttml", ".ism"};
+
+	if (mime) {
+		if (!strncmp(mime, "text/", 5) || strstr(mime, "xml") || strstr(mime, "mpegurl") || strstr(mime, "json") || strstr(mime, "javascript"))
+			return GF_TRUE;
+	}
+	ext = path ? gf_file_ext_start(path) : NULL;
+	if (!ext) return GF_FALSE;
+	for (i=0; i<GF_ARRAY_LENGTH(text_exts); i++) {
+		if (!stricmp(ext, text_exts[i])) return GF_TRUE;
+	}
+	return GF_FALSE;
+}
+
+//checks if gzip is listed in Accept-Encoding and not disabled by a zero quality value
+static Bool httpout_accept_gzip(const char *hdr)
+{
+	const char *gz = hdr ? strstr(hdr, "gzip") : NULL;
+	if (!gz) return GF_FALSE;
+	gz += 4;
+	while (gz[0]==' ') gz++;
+	if (gz[0]==';') {
+		const char *q = strstr(gz, "q=");
+		const char *next = strchr(gz, ',');
+		if (q && (!next || (q<next)) && (atof(q+2)<=0))
+			return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
+static u8 *httpout_load_file(const char *path, u32 *size)
+{
+	u64 fsize;
+	u8 *data;
+	FILE *f = gf_fopen(path, "rb");
+	*size = 0;
+	if (!f) return NULL;
+	fsize = gf_fsize(f);
+	if (!fsize || (fsize > HTTPOUT_CACHE_MAX_SIZE)) {
+		gf_fclose(f);
+		return NULL;
+	}
+	data = gf_malloc((u32) fsize);
+	if (data) *size = (u32) gf_fread(data, (u32) fsize, f);
+	gf_fclose(f);
+	if (data && (*size != (u32) fsize)) {
+		gf_free(data);
+		return NULL;
+	}
+	return data;
+}
+
+//gets cache entry for a text resource if loaded for the current version of the file, without accessing the file
+static HTTPOutCacheEntry *httpout_cache_find(GF_HTTPOutCtx *ctx, const char *path, u64 modif_time)
+{
+	u32 i, count = gf_list_count(ctx->res_cache);
+	for (i=0; i<count; i++) {
+		HTTPOutCacheEntry *ent = gf_list_get(ctx->res_cache, i);
+		if (!strcmp(ent->path, path))
+			return ((ent->modif_time == modif_time) && ent->modif_settled) ? ent : NULL;
+	}
+	return NULL;
+}
+
+/*gets cache entry for a text resource, loading and compressing it once per version of the file. The file
+modification time has a one second precision, so until the entry is loaded at least one second after the file
+modification, the file content is reloaded and compared to detect writes within the same second*/
+static HTTPOutCacheEntry *httpout_cache_get(GF_HTTPOutCtx *ctx, const char *path, u64 modif_time, Bool want_gz)
+{
+	u32 i, count, size;
+	u8 *data;
+	HTTPOutCacheEntry *ent=NULL, *oldest=NULL;
+
+	count = gf_list_count(ctx->res_cache);
+	for (i=0; i<count; i++) {
+		HTTPOutCacheEntry *an_ent = gf_list_get(ctx->res_cache, i);
+		if (!strcmp(an_ent->path, path)) {
+			ent = an_ent;
+			break;
+		}
+		if (!oldest || (an_ent->last_used < oldest->last_used))
+			oldest = an_ent;
+	}
+	if (ent && (ent->modif_time == modif_time) && ent->modif_settled) {
+		goto check_gz;
+	}
+
+	data = httpout_load_file(path, &size);
+	if (!data) {
+		if (ent) httpout_cache_remove(ctx, ent);
+		return NULL;
+	}
+	if (ent && (ent->modif_time == modif_time) && (ent->size == size) && !memcmp(ent->data, data, size)) {
+		gf_free(data);
+	} else {
+		if (ent) httpout_cache_remove(ctx, ent);
+		else if (count >= HTTPOUT_CACHE_MAX_ENTRIES) httpout_cache_remove(ctx, oldest);
+
+		GF_SAFEALLOC(ent, HTTPOutCacheEntry);
+		if (!ent) {
+			gf_free(data);
+			return NULL;
+		}
+		ent->path = gf_strdup(path);
+		ent->data = data;
+		ent->size = size;
+		gf_list_add(ctx->res_cache, ent);
+	}
+	ent->modif_time = modif_time;
+	ent->modif_settled = (gf_net_get_utc()/1000 > modif_time + 1) ? GF_TRUE : GF_FALSE;
+
+check_gz:
+	ent->last_used = gf_sys_clock();
+	//compress once per version of the resource, regardless of the number of clients
+	if (want_gz && !ent->gz_done && (ent->size >= ctx->zmin)) {
+#ifndef GPAC_DISABLE_ZLIB
+		GF_Err e = gf_gz_compress_payload_ex(&ent->data, ent->size, &ent->gz_size, 0, GF_TRUE, &ent->gz_data);
+		if (e || (ent->gz_size >= ent->size)) {
+			if (ent->gz_data) gf_free(ent->gz_data);
+			ent->gz_data = NULL;
+			ent->gz_size = 0;
+		}
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Compressed %s from %u to %u bytes\n", path, ent->size, ent->gz_size));
+#endif
+		ent->gz_done = GF_TRUE;
+	}
+	return ent;
+}
+
+//gets LL-HLS segment kept in memory for the given URL
+static HTTPOutCacheEntry *httpout_llhls_get(GF_HTTPOutCtx *ctx, const char *url, GF_HTTPOutInput **llhls_in)
+{
+	u32 i, j, count = gf_list_count(ctx->inputs);
+	for (i=0; i<count; i++) {
+		GF_HTTPOutInput *in = gf_list_get(ctx->inputs, i);
+		if (!in->llhls) continue;
+		for (j=0; j<HTTPOUT_LLHLS_RING; j++) {
+			HTTPOutCacheEntry *ent = in->llhls_ring[j];
+			if (ent && !strcmp(ent->path, url)) {
+				*llhls_in = in;
+				return ent;
+			}
+		}
+	}
+	return NULL;
+}
+
+//gets next segment, media sequence number and number of parts of the segment in progress in an HLS playlist
+static Bool httpout_hls_playlist_state(const char *path, u32 *next_msn, u32 *nb_parts, u32 *target_dur)
+{
+	u32 size, msn=0, nb_seg=0;
+	char *data, *line;
+
+	data = (char *) httpout_load_file(path, &size);
+	if (!data) return GF_FALSE;
+	data = gf_realloc(data, size+1);
+	if (!data) return GF_FALSE;
+	data[size] = 0;
+
+	*nb_parts = *target_dur = 0;
+	line = data;
+	while (line && line[0]) {
+		if (!strncmp(line, "#EXT-X-MEDIA-SEQUENCE:", 22)) msn = atoi(line+22);
+		else if (!strncmp(line, "#EXT-X-TARGETDURATION:", 22)) *target_dur = atoi(line+22);
+		//parts are listed before the segment they belong to
+		else if (!strncmp(line, "#EXTINF:", 8)) {
+			nb_seg++;
+			*nb_parts = 0;
+		}
+		else if (!strncmp(line, "#EXT-X-PART:", 12)) (*nb_parts)++;
+		line = strchr(line, '\n');
+		if (line) line++;
+	}
+	gf_free(data);
+	*next_msn = msn + nb_seg;
+	return GF_TRUE;
+}
+
+/*checks LL-HLS blocking playlist reload, returns 1 if request is held until playlist update, -1 if request
+is not valid or timeout occured, 0 otherwise*/
+static s32 httpout_hls_check_block(GF_HTTPOutSession *sess, const char *url, const char *query, const char **response)
+{
+	char *dir, *hls_path=NULL;
+	u32 len, next_msn, nb_parts, target_dur;
+	Bool ready;
+	const char *msn_str = strstr(query, "_HLS_msn=");
+	const char *part_str = strstr(query, "_HLS_part=");
+
+	if (!msn_str) {
+		if (part_str) {
+			*response = "HTTP/1.1 400 Bad Request\r\n";
+			return -1;
+		}
+		return 0;
+	}
+	//playlist is produced by the server, resolve it against the record directory
+	dir = gf_list_get(sess->ctx->rdirs, 0);
+	len = dir ? (u32) strlen(dir) : 0;
+	if (!len) return 0;
+
+	gf_dynstrcat(&hls_path, dir, NULL);
+	if (!strchr("/\\", dir[len-1]))
+		gf_dynstrcat(&hls_path, "/", NULL);
+	gf_dynstrcat(&hls_path, url+1, NULL);
+	if (!httpout_hls_playlist_state(hls_path, &next_msn, &nb_parts, &target_dur)) {
+		gf_free(hls_path);
+		return 0;
+	}
+	sess->hls_msn = atoi(msn_str+9);
+	sess->hls_part = part_str ? atoi(part_str+10) : -1;
+
+	//too far in the future
+	if (sess->hls_msn > next_msn+1) {
+		gf_free(hls_path);
+		*response = "HTTP/1.1 400 Bad Request\r\n";
+		return -1;
+	}
+	ready = GF_FALSE;
+	if (sess->hls_msn < next_msn) ready = GF_TRUE;
+	else if ((sess->hls_msn == next_msn) && (sess->hls_part>=0) && ((u32) sess->hls_part < nb_parts)) ready = GF_TRUE;
+
+	if (ready) {
+		gf_free(hls_path);
+		sess->hls_deadline = 0;
+		return 0;
+	}
+	if (sess->hls_deadline && (gf_sys_clock_high_res() >= sess->hls_deadline)) {
+		gf_free(hls_path);
+		sess->hls_deadline = 0;
+		*response = "HTTP/1.1 503 Service Unavailable\r\n";
+		return -1;
+	}
+	if (!sess->hls_deadline) {
+		if (!target_dur) target_dur = 1;
+		sess->hls_deadline = gf_sys_clock_high_res() + 3 * target_dur * 1000000;
+	}
+	if (sess->hls_path) gf_free(sess->hls_path);
+	sess->hls_path = hls_path;
+	sess->hls_blocked = GF_TRUE;
+	sess->last_active_time = gf_sys_clock_high_res();
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Holding %s request from %s until media sequence %u part %d\n", url, sess->peer_address, sess->hls_msn, sess->hls_part));
+	return 1;
+}
+
 static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 {
 	char *rsp_buf = NULL;
@@ -603,6 +959,11 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 	GF_HTTPOutInput *source_pid = NULL;
 	GF_HTTPOutSession *source_sess = NULL;
 	GF_HTTPOutSession *sess = usr_cbk;
+	Bool is_text_res = GF_FALSE;
+	char szURL[GF_MAX_PATH];
+	const char *query;
+	HTTPOutCacheEntry *llhls_ent = NULL;
+	GF_HTTPOutInput *llhls_in = NULL;
 
 	if (parameter->msg_type != GF_NETIO_PARSE_REPLY) {
 		parameter->error = GF_BAD_PARAM;
@@ -627,8 +988,30 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		response = "HTTP/1.1 400 Bad Request\r\n";
 		goto exit;
 	}
+	//strip query string, only used for LL-HLS blocking playlist reload
+	query = strchr(url, '?');
+	if (query) {
+		u32 len = (u32) (query - url);
+		if (len >= GF_MAX_PATH) {
+			response = "HTTP/1.1 414 URI Too Long\r\n";
+			url = "/";
+			goto exit;
+		}
+		memcpy(szURL, url, len);
+		szURL[len] = 0;
+		url = szURL;
+		query++;
+		if (sess->hls_wake) {
+			sess->hls_wake = GF_FALSE;
+		} else if (sess->ctx->rdirs && (parameter->reply==GF_HTTP_GET)) {
+			s32 res = httpout_hls_check_block(sess, url, query, (const char **) &response);
+			if (res<0) goto exit;
+			if (res>0) return;
+		}
+	}
 
 	sess->do_log = httpout_do_log(sess, parameter->reply);
+	httpout_cache_release(sess);
 
 	//resolve name against upload dir
 	if (is_upload) {
@@ -693,6 +1076,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 			else
 				sess->upload_type = 1;
 
+			httpout_cache_invalidate(sess->ctx, sess->path);
 			sess->resource = gf_fopen(sess->path, range ? "rb+" : "wb");
 			if (!sess->resource) {
 				response = "HTTP/1.1 403 Forbidden\r\n";
@@ -739,10 +1123,14 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		return;
 	}
 
+	//LL-HLS segments are served from memory
+	if (parameter->reply != GF_HTTP_DELETE)
+		llhls_ent = httpout_llhls_get(sess->ctx, url, &llhls_in);
+
 	/*first check active inputs*/
 	count = gf_list_count(sess->ctx->inputs);
 	//delete only accepts local files
-	if (parameter->reply == GF_HTTP_DELETE)
+	if ((parameter->reply == GF_HTTP_DELETE) || llhls_ent)
 		count = 0;
 
 	for (i=0; i<count; i++) {
@@ -756,7 +1144,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 	}
 
 	/*not resolved and no source matching, check file on disk*/
-	if (!source_pid && !full_path) {
+	if (!source_pid && !full_path && !llhls_ent) {
 		count = gf_list_count(sess->ctx->rdirs);
 		for (i=0; i<count; i++) {
 			char *mdir = gf_list_get(sess->ctx->rdirs, i);
@@ -776,7 +1164,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		}
 	}
 
-	if (!full_path && !source_pid) {
+	if (!full_path && !source_pid && !llhls_ent) {
 		if (!sess->ctx->dlist || strcmp(url, "/")) {
 			sess->reply_code = 404;
 			response = "HTTP/1.1 404 Not Found\r\n";
@@ -825,6 +1213,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 	sess->put_in_progress = 0;
 	sess->nb_bytes = 0;
 	sess->upload_type = 0;
+	sess->llhls_open = GF_FALSE;
 
 	if (parameter->reply==GF_HTTP_DELETE) {
 		sess->upload_type = 0;
@@ -835,6 +1224,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		sess->file_pos = sess->file_size = 0;
 
 		if (gf_file_exists(full_path)) {
+			httpout_cache_invalidate(sess->ctx, full_path);
 			e = gf_file_delete(full_path);
 
 			if (e) {
@@ -871,12 +1261,27 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		sess->file_pos = sess->file_size = 0;
 		sess->use_chunk_transfer = GF_TRUE;
 	}
-	/*we have matching etag*/
-	else if (etag && !strcmp(etag, szETag) && !sess->ctx->no_etag) {
+	/*we have matching etag, for the plain or gzip version*/
+	else if (etag && !strncmp(etag, szETag, strlen(szETag)) && (!etag[strlen(szETag)] || !strcmp(etag+strlen(szETag), "-gz")) && !sess->ctx->no_etag) {
 		if (sess->path) gf_free(sess->path);
 		sess->path = full_path;
 		not_modified = GF_TRUE;
 	}
+	/*LL-HLS segment in memory, possibly being written*/
+	else if (llhls_ent) {
+		if (sess->path) gf_free(sess->path);
+		sess->path = gf_strdup(url);
+		if (sess->resource) gf_fclose(sess->resource);
+		sess->resource = NULL;
+		sess->cache_entry = llhls_ent;
+		llhls_ent->nb_users++;
+		sess->file_pos = 0;
+		sess->file_size = sess->bytes_in_req = llhls_ent->in_progress ? 0 : llhls_ent->size;
+		mime = llhls_in->mime;
+		if (sess->mime) gf_free(sess->mime);
+		sess->mime = ( mime && strcmp(mime, "*")) ? gf_strdup(mime) : NULL;
+		sess->last_file_modif = 0;
+	}
 	/*we have the same URL and no associated source*/
 	else if (!sess->in_source && (sess->last_file_modif == modif_time) && sess->path && full_path && !strcmp(sess->path, full_path) ) {
 		gf_free(full_path);
@@ -911,40 +1316,52 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 				goto exit;
 			}
 		} else {
-			sess->resource = gf_fopen(full_path, "rb");
-			//we may not have the file if it is currently being created
-			if (!sess->resource && !sess->in_source) {
-				response = "HTTP/1.1 500 Internal Server Error\r\n";
-				gf_dynstrcat(&response_body, "File exists but no read access", NULL);
-				goto exit;
-			}
+			HTTPOutCacheEntry *cached = NULL;
+			//text resource already in memory for this version of the file, no need to open and probe it
+			if (sess->ctx->res_cache && !sess->in_source && !source_sess && !range && httpout_is_text_resource(NULL, full_path))
+				cached = httpout_cache_find(sess->ctx, full_path, modif_time);
+
+			if (cached) {
+				if (sess->resource) gf_fclose(sess->resource);
+				sess->resource = NULL;
+				mime = cached->mime;
+				sess->file_size = cached->size;
+			} else {
+				sess->resource = gf_fopen(full_path, "rb");
+				//we may not have the file if it is currently being created
+				if (!sess->resource && !sess->in_source) {
+					response = "HTTP/1.1 500 Internal Server Error\r\n";
+					gf_dynstrcat(&response_body, "File exists but no read access", NULL);
+					goto exit;
+				}
 
-			if (!sess->in_source) {
-				u8 probe_buf[5001];
-				u32 read = (u32) gf_fread(probe_buf, 5000, sess->resource);
-				if ((s32) read < 0) {
-					if (source_sess) {
-						read = 0;
-					} else {
-						response = "HTTP/1.1 500 Internal Server Error\r\n";
-						gf_dynstrcat(&response_body, "File opened but read operation failed", NULL);
-						goto exit;
+				if (!sess->in_source) {
+					u8 probe_buf[5001];
+					u32 read = (u32) gf_fread(probe_buf, 5000, sess->resource);
+					if ((s32) read < 0) {
+						if (source_sess) {
+							read = 0;
+						} else {
+							response = "HTTP/1.1 500 Internal Server Error\r\n";
+							gf_dynstrcat(&response_body, "File opened but read operation failed", NULL);
+							goto exit;
+						}
+					}
+					if (read) {
+						probe_buf[read] = 0;
+						mime = gf_filter_probe_data(sess->ctx->filter, probe_buf, read);
 					}
-				}
-				if (read) {
-					probe_buf[read] = 0;
-					mime = gf_filter_probe_data(sess->ctx->filter, probe_buf, read);
-				}
 
-				sess->file_size = gf_fsize(sess->resource);
-				if (source_sess) {
+					sess->file_size = gf_fsize(sess->resource);
+					if (source_sess) {
+						sess->file_size = 0;
+						sess->use_chunk_transfer = GF_TRUE;
+						sess->put_in_progress = 1;
+					}
+				} else {
+					mime = source_pid ? source_pid->mime : NULL;
 					sess->file_size = 0;
-					sess->use_chunk_transfer = GF_TRUE;
-					sess->put_in_progress = 1;
 				}
-			} else {
-				mime = source_pid ? source_pid->mime : NULL;
-				sess->file_size = 0;
 			}
 		}
 		sess->file_pos = 0;
@@ -955,6 +1372,28 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		sess->last_file_modif = gf_file_modification_time(full_path);
 	}
 
+	//text resources (manifests, ...) are served from memory, compressed once per version if accepted by client
+	if (sess->ctx->res_cache && !sess->in_source && !source_sess && !llhls_ent && sess->path && (parameter->reply!=GF_HTTP_DELETE)
+		&& !response_body && httpout_is_text_resource(sess->mime, sess->path)
+	) {
+		is_text_res = GF_TRUE;
+		if (!not_modified && !range) {
+			Bool accept_gz = sess->ctx->zmin ? httpout_accept_gzip(gf_dm_sess_get_header(sess->http_sess, "Accept-Encoding")) : GF_FALSE;
+			HTTPOutCacheEntry *ent = httpout_cache_get(sess->ctx, sess->path, modif_time, accept_gz);
+			if (ent) {
+				if (sess->resource) gf_fclose(sess->resource);
+				sess->resource = NULL;
+				//keep probed mime for requests served without opening the file
+				if (!ent->mime && sess->mime) ent->mime = gf_strdup(sess->mime);
+				sess->cache_entry = ent;
+				ent->nb_users++;
+				sess->cache_gz = (accept_gz && ent->gz_data) ? GF_TRUE : GF_FALSE;
+				sess->file_size = sess->bytes_in_req = sess->cache_gz ? ent->gz_size : ent->size;
+				sess->file_pos = 0;
+			}
+		}
+	}
+
 	if (!sess->in_source && ! httpout_sess_parse_range(sess, (char *) range) ) {
 		GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTPOut] Unsupported Range format: %s", range));
 		response = "416 Requested Range Not Satisfiable\r\n";
@@ -962,6 +1401,12 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		gf_dynstrcat(&response_body, range, NULL);
 		goto exit;
 	}
+	//LL-HLS segment being written and no range end, send until end of segment
+	if (llhls_ent && llhls_ent->in_progress && (!sess->nb_ranges || (sess->ranges[0].end<0))) {
+		sess->llhls_open = GF_TRUE;
+		sess->use_chunk_transfer = GF_TRUE;
+		sess->bytes_in_req = 0;
+	}
 
 	if (not_modified) {
 		gf_dynstrcat(&rsp_buf, "HTTP/1.1 304 Not Modified\r\n", NULL);
@@ -1013,9 +1458,11 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 	}
 	//for HEAD/GET only
 	else if (!not_modified && (parameter->reply!=GF_HTTP_DELETE) ) {
-		if (!sess->in_source && !sess->ctx->no_etag) {
+		if (!sess->in_source && !llhls_ent && !sess->ctx->no_etag) {
 			gf_dynstrcat(&rsp_buf, "ETag: ", NULL);
 			gf_dynstrcat(&rsp_buf, szETag, NULL);
+			if (sess->cache_gz)
+				gf_dynstrcat(&rsp_buf, "-gz", NULL);
 			gf_dynstrcat(&rsp_buf, "\r\n", NULL);
 			if (sess->ctx->cache_control) {
 				gf_dynstrcat(&rsp_buf, "Cache-Control: ", NULL);
@@ -1025,6 +1472,8 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		} else if (sess->in_source && !sess->ctx->rdirs) {
 			sess->nb_ranges = 0;
 			gf_dynstrcat(&rsp_buf, "Cache-Control: no-cache, no-store\r\n", NULL);
+		} else if (llhls_ent && llhls_ent->in_progress) {
+			gf_dynstrcat(&rsp_buf, "Cache-Control: no-cache\r\n", NULL);
 		}
 		if (sess->bytes_in_req) {
 			sprintf(szFmt, LLU, sess->bytes_in_req);
@@ -1039,12 +1488,19 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 			gf_dynstrcat(&rsp_buf, mime, NULL);
 			gf_dynstrcat(&rsp_buf, "\r\n", NULL);
 		}
+		if (sess->cache_gz) {
+			gf_dynstrcat(&rsp_buf, "Content-Encoding: gzip\r\n", NULL);
+		}
+		if (is_text_res && sess->ctx->zmin) {
+			gf_dynstrcat(&rsp_buf, "Vary: Accept-Encoding\r\n", NULL);
+		}
 		//data comes either directly from source pid, or from file written by source pid, we must use chunk transfer
 		if (!sess->is_head && sess->use_chunk_transfer) {
 			gf_dynstrcat(&rsp_buf, "Transfer-Encoding: chunked\r\n", NULL);
 		}
 
-		if (!sess->is_head && sess->nb_ranges) {
+		//end of range not yet known for open range on LL-HLS segment being written
+		if (!sess->is_head && sess->nb_ranges && !sess->llhls_open) {
 			gf_dynstrcat(&rsp_buf, "Content-Range: bytes=", NULL);
 			for (i=0; i<sess->nb_ranges; i++) {
 				if (sess->in_source || !sess->file_size) {
@@ -1352,6 +1808,10 @@ static GF_Err httpout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 			p = gf_filter_pid_get_property(pid, GF_PROP_PID_MIME);
 			if (p && p->value.string) pctx->mime = gf_strdup(p->value.string);
 
+			//LL-HLS segments are only served from memory when recording
+			p = gf_filter_pid_get_property(pid, GF_PROP_PID_LLHLS);
+			if (p && (p->value.number>0) && ctx->rdirs) pctx->llhls = GF_TRUE;
+
 			gf_filter_pid_set_udta(pid, pctx);
 			gf_list_add(ctx->inputs, pctx);
 
@@ -1552,6 +2012,7 @@ static GF_Err httpout_initialize(GF_Filter *filter)
 		ctx->hold = GF_FALSE;
 		return GF_OK;
 	}
+	ctx->res_cache = gf_list_new();
 	ctx->port = port;
 	if (ctx->cert && !ctx->pkey) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] missing server private key file\n"));
@@ -1614,11 +2075,14 @@ static void httpout_del_session(GF_HTTPOutSession *s)
 	if (s->opid) gf_filter_pid_remove(s->opid);
 	if (s->resource) gf_fclose(s->resource);
 	if (s->ranges) gf_free(s->ranges);
+	if (s->hls_path) gf_free(s->hls_path);
+	httpout_cache_release(s);
 	gf_free(s);
 }
 
 static void httpout_finalize(GF_Filter *filter)
 {
+	u32 i;
 	GF_HTTPOutCtx *ctx = (GF_HTTPOutCtx *) gf_filter_get_udta(filter);
 
 	/*this is an alias for our main filter, nothing to finalize*/
@@ -1640,6 +2104,9 @@ static void httpout_finalize(GF_Filter *filter)
 		if (tmp->mime) gf_free(tmp->mime);
 		if (tmp->resource) gf_fclose(tmp->resource);
 		if (tmp->upload) gf_dm_sess_del(tmp->upload);
+		for (i=0; i<HTTPOUT_LLHLS_RING; i++) {
+			if (tmp->llhls_ring[i]) httpout_cache_del_entry(tmp->llhls_ring[i]);
+		}
 		if (tmp->file_deletes) {
 			while (gf_list_count(tmp->file_deletes)) {
 				char *url = gf_list_pop_back(tmp->file_deletes);
@@ -1650,6 +2117,13 @@ static void httpout_finalize(GF_Filter *filter)
 		gf_free(tmp);
 	}
 	gf_list_del(ctx->inputs);
+	if (ctx->res_cache) {
+		while (gf_list_count(ctx->res_cache)) {
+			HTTPOutCacheEntry *ent = gf_list_pop_back(ctx->res_cache);
+			httpout_cache_del_entry(ent);
+		}
+		gf_list_del(ctx->res_cache);
+	}
 	if (ctx->server_sock) gf_sk_del(ctx->server_sock);
 	if (ctx->sg) gf_sk_group_del(ctx->sg);
 	if (ctx->ip) gf_free(ctx->ip);
@@ -1756,13 +2230,46 @@ static void log_request_done(GF_HTTPOutSession *sess)
 	}
 }
 
+//process again a request held for LL-HLS blocking playlist reload
+static void httpout_hls_unblock(GF_HTTPOutCtx *ctx, GF_HTTPOutSession *sess, Bool is_ready)
+{
+	GF_Err e;
+	GF_NETIO_Parameter par;
+	memset(&par, 0, sizeof(GF_NETIO_Parameter));
+	par.msg_type = GF_NETIO_PARSE_REPLY;
+	par.reply = GF_HTTP_GET;
+
+	sess->hls_blocked = GF_FALSE;
+	sess->hls_wake = is_ready;
+	httpout_sess_io(sess, &par);
+	if (sess->hls_blocked) return;
+	sess->hls_wake = GF_FALSE;
+	sess->hls_deadline = 0;
+	ctx->next_wake_us = 0;
+
+	if (sess->http_sess) gf_dm_sess_del(sess->http_sess);
+	sess->http_sess = NULL;
+	//reply sent without body (error or not modified)
+	if (sess->done && sess->socket) {
+		sess->http_sess = gf_dm_sess_new_server(sess->socket, sess->ssl, httpout_sess_io, sess, &e);
+		if (e) httpout_reset_socket(sess);
+	}
+}
+
 static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HTTPOutSession *sess)
 {
 	u32 read;
+	const u8 *send_buf;
 	u64 to_read=0;
 	GF_Err e = GF_OK;
 	Bool close_session = ctx->close;
 
+	//waiting for playlist update, check timeout
+	if (sess->hls_blocked) {
+		if (gf_sys_clock_high_res() >= sess->hls_deadline)
+			httpout_hls_unblock(ctx, sess, GF_FALSE);
+		return;
+	}
 
 	if (sess->upload_type) {
 		u32 i, count;
@@ -1916,6 +2423,9 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 		sess->last_active_time = gf_sys_clock_high_res();
 		ctx->next_wake_us = 0;
 
+		//request held until playlist update, keep the session to process the request later
+		if (sess->hls_blocked) return;
+
 		//request has been process, if not an upload we don't need the session anymore
 		//otherwise we use the session to parse transfered data
 		if (!sess->upload_type) {
@@ -1938,7 +2448,7 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 		return;
 	}
 	//resource is not set
-	if (!sess->resource && sess->path) {
+	if (!sess->resource && sess->path && !sess->cache_entry) {
 		if (sess->in_source && !sess->in_source->nb_write) {
 			sess->last_active_time = gf_sys_clock_high_res();
 			return;
@@ -1955,10 +2465,15 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 		gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
 	}
 
+	//LL-HLS segment being written, send until end of segment
+	if (sess->llhls_open) {
+		if (sess->file_pos < sess->cache_entry->size)
+			to_read = sess->cache_entry->size - sess->file_pos;
+	}
 	//we have ranges
-	if (sess->nb_ranges) {
+	else if (sess->nb_ranges) {
 		//current range is done
-		if ((s64) sess->file_pos >= sess->ranges[sess->range_idx].end) {
+		if ((s64) sess->file_pos > sess->ranges[sess->range_idx].end) {
 			sess->range_idx++;
 			//load next range, seeking file
 			if (sess->range_idx<sess->nb_ranges) {
@@ -1973,13 +2488,31 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 		to_read = sess->file_size - sess->file_pos;
 	}
 
+	//resource in memory, only send available data and wait for more if LL-HLS segment is being written
+	if (sess->cache_entry) {
+		u64 avail = (sess->file_pos < sess->cache_entry->size) ? (sess->cache_entry->size - sess->file_pos) : 0;
+		if (to_read > avail) to_read = avail;
+		if (!to_read && sess->cache_entry->in_progress && (sess->llhls_open || (sess->range_idx < sess->nb_ranges))) {
+			sess->last_active_time = gf_sys_clock_high_res();
+			return;
+		}
+	}
+
 	if (to_read) {
 		ctx->next_wake_us = 0;
 
 		if (to_read > (u64) sess->ctx->block_size)
 			to_read = (u64) sess->ctx->block_size;
 
-		read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
+		//resource in memory, send directly from cache
+		if (sess->cache_entry) {
+			send_buf = sess->cache_gz ? sess->cache_entry->gz_data : sess->cache_entry->data;
+			send_buf += sess->file_pos;
+			read = (u32) to_read;
+		} else {
+			send_buf = sess->buffer;
+			read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
+		}
 
 		//transfer of file being uploaded, use chunk transfer
 		if (sess->use_chunk_transfer) {
@@ -1989,10 +2522,10 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 			len = (u32) strlen(szHdr);
 
 			e = httpout_sess_send(sess, szHdr, len);
-			e |= httpout_sess_send(sess, sess->buffer, read);
+			e |= httpout_sess_send(sess, send_buf, read);
 			e |= httpout_sess_send(sess, "\r\n", 2);
 		} else {
-			e = httpout_sess_send(sess, sess->buffer, read);
+			e = httpout_sess_send(sess, send_buf, read);
 		}
 		sess->last_active_time = gf_sys_clock_high_res();
 
@@ -2040,6 +2573,7 @@ session_done:
 		}
 		if (sess->resource) gf_fclose(sess->resource);
 		sess->resource = NULL;
+		httpout_cache_release(sess);
 		//keep resource active
 		sess->done = GF_TRUE;
 	}
@@ -2054,6 +2588,68 @@ session_done:
 	}
 }
 
+static void httpout_llhls_del_entry(HTTPOutCacheEntry *ent)
+{
+	ent->in_progress = GF_FALSE;
+	if (ent->nb_users) ent->stale = GF_TRUE;
+	else httpout_cache_del_entry(ent);
+}
+
+//starts a new LL-HLS segment in memory, recycling the oldest one
+static void httpout_llhls_open(GF_HTTPOutInput *in)
+{
+	u32 i;
+	HTTPOutCacheEntry *ent;
+
+	//segment rewritten, remove previous version
+	for (i=0; i<HTTPOUT_LLHLS_RING; i++) {
+		ent = in->llhls_ring[i];
+		if (ent && !strcmp(ent->path, in->path)) {
+			httpout_llhls_del_entry(ent);
+			in->llhls_ring[i] = NULL;
+		}
+	}
+	ent = in->llhls_ring[in->llhls_idx];
+	if (ent) httpout_llhls_del_entry(ent);
+
+	GF_SAFEALLOC(ent, HTTPOutCacheEntry);
+	in->llhls_ring[in->llhls_idx] = ent;
+	in->llhls_idx = (in->llhls_idx + 1) % HTTPOUT_LLHLS_RING;
+	in->llhls_cur = ent;
+	if (!ent) return;
+	ent->path = gf_strdup(in->path);
+	ent->in_progress = GF_TRUE;
+}
+
+static void httpout_llhls_write(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, const u8 *data, u32 size)
+{
+	u32 i, count;
+	HTTPOutCacheEntry *ent = in->llhls_cur;
+
+	if (ent->size + size > ent->alloc) {
+		u8 *new_data;
+		u32 new_alloc = 2*ent->alloc;
+		if (new_alloc < ent->size + size) new_alloc = ent->size + size;
+		new_data = gf_realloc(ent->data, new_alloc);
+		if (!new_data) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] Failed to allocate LL-HLS segment %s\n", ent->path));
+			return;
+		}
+		ent->data = new_data;
+		ent->alloc = new_alloc;
+	}
+	memcpy(ent->data + ent->size, data, size);
+	ent->size += size;
+
+	//send new data right away to all clients waiting for this segment
+	count = gf_list_count(ctx->active_sessions);
+	for (i=0; i<count; i++) {
+		GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+		if (sess->cache_entry != ent) continue;
+		httpout_process_session(ctx->filter, ctx, sess);
+	}
+}
+
 static Bool httpout_open_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, const char *name, Bool is_delete)
 {
 //	Bool reassign_clients = GF_TRUE;
@@ -2115,6 +2711,7 @@ static Bool httpout_open_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, const ch
 	}
 	httpout_set_local_path(ctx, in);
 
+	httpout_cache_invalidate(ctx, in->local_path);
 	if (is_delete) {
 		gf_file_delete(in->local_path);
 		in->done = GF_TRUE;
@@ -2124,10 +2721,33 @@ static Bool httpout_open_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, const ch
 		in->resource = gf_fopen(in->local_path, "wb");
 		if (!in->resource)
 			in->is_open = GF_FALSE;
+		else if (in->llhls)
+			httpout_llhls_open(in);
 	}
 	return GF_TRUE;
 }
 
+//wakes up requests waiting for an update of the given playlist
+static void httpout_hls_check_blocked(GF_HTTPOutCtx *ctx, const char *hls_path)
+{
+	u32 i, count, next_msn, nb_parts, target_dur;
+	Bool state_loaded = GF_FALSE;
+
+	count = gf_list_count(ctx->active_sessions);
+	for (i=0; i<count; i++) {
+		GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+		if (!sess->hls_blocked || strcmp(sess->hls_path, hls_path)) continue;
+		//parse playlist once for all waiting clients
+		if (!state_loaded) {
+			if (!httpout_hls_playlist_state(hls_path, &next_msn, &nb_parts, &target_dur))
+				return;
+			state_loaded = GF_TRUE;
+		}
+		if ((sess->hls_msn < next_msn) || ((sess->hls_msn == next_msn) && (sess->hls_part>=0) && ((u32) sess->hls_part < nb_parts)) )
+			httpout_hls_unblock(ctx, sess, GF_TRUE);
+	}
+}
+
 static void httpout_close_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 {
 	if (!in->is_open) return;
@@ -2167,6 +2787,21 @@ static void httpout_close_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 			}
 			gf_fclose(in->resource);
 			in->resource = NULL;
+
+			if (in->llhls_cur) {
+				in->llhls_cur->in_progress = GF_FALSE;
+				in->llhls_cur = NULL;
+				//flush end of segment to clients
+				count = gf_list_count(ctx->active_sessions);
+				for (i=0; i<count; i++) {
+					GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+					if (sess->cache_entry && !sess->cache_entry->in_progress && sess->llhls_open)
+						httpout_process_session(ctx->filter, ctx, sess);
+				}
+			}
+			//playlist updated, process requests waiting for it
+			if (strstr(in->local_path, ".m3u8"))
+				httpout_hls_check_blocked(ctx, in->local_path);
 		} else {
 			count = gf_list_count(ctx->active_sessions);
 			for (i=0; i<count; i++) {
@@ -2221,6 +2856,8 @@ retry:
 
 		if (in->resource) {
 			out = (u32) gf_fwrite(pck_data, pck_size, in->resource);
+			if (in->llhls_cur)
+				httpout_llhls_write(ctx, in, pck_data, pck_size);
 		}
 
 		for (i=0; i<count; i++) {
@@ -2662,6 +3299,7 @@ static const GF_FilterArgs HTTPOutArgs[] =
 	{ OFFS(maxc), "maximum number of connections, 0 is unlimited", GF_PROP_UINT, "100", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(maxp), "maximum number of connections for one peer, 0 is unlimited", GF_PROP_UINT, "6", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(cache_control), "specify the `Cache-Control` string to add; `none` disable ETag", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(zmin), "minimum size in bytes of text resources to send with gzip content encoding when accepted by client; 0 disables compression - see filter help", GF_PROP_UINT, "1024", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(hold), "hold packets until one client connects", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(hmode), "filter operation mode, ignored if [-wdir]() is set. See filter help for more details. Mode can be\n"
 	"- default: run in server mode (see filter help)\n"
@@ -2707,6 +3345,9 @@ GF_FilterRegister HTTPOutRegister = {
 		"When disabled, a GET on a directory will fail.\n"
 		"When enabled, a GET on a directory will return a simple HTML listing of the content inspired from Apache.\n"
 		"  \n"
+		"Text resources (MPD, M3U8, XML, ...) served from disk are kept in memory and only reloaded when modified.\n"
+		"If the client accepts gzip encoding, resources larger than [-zmin]() bytes are sent compressed. Each version of a resource is compressed once, regardless of the number of clients.\n"
+		"  \n"
 		"# Simple HTTP server\n"
 		"In this mode, the filter doesn't need any input connection and exposes all files in the directories given by [-rdirs]().\n"
 		"PUT and POST methods are only supported if a write directory is specified by [-wdir]() option.\n"
@@ -2746,6 +3387,11 @@ GF_FilterRegister HTTPOutRegister = {
 		"EX gpac -i SOURCE reframer:rt=on @ -o http://localhost:8080/live.mpd --rdirs=temp --dmode=dynamic --cdur=0.1\n"
 		"In this example, a real-time dynamic DASH session with chunks of 100ms is created, outputing files in `temp`. A client connecting to the live edge will receive segments as they are produced using HTTP chunk transfer.\n"
 		"  \n"
+		"When the dasher produces low-latency HLS (`llhls` option of dasher), the server also:\n"
+		"- keeps the last segments being produced in memory and serves their parts (byte ranges) from memory, an open byte range on a segment being produced is served using chunk transfer until the segment is done\n"
+		"- handles blocking playlist reload requests (`_HLS_msn` and `_HLS_part` queries), holding the response until the playlist announces the requested part\n"
+		"EX gpac -i SOURCE reframer:rt=on @ -o http://localhost:8080/live.m3u8 --rdirs=temp --dmode=dynamic --llhls=0.5\n"
+		"  \n"
 		"# HTTP client sink\n"
 		"In this mode, the filter will upload input PIDs data to remote server using PUT (or POST if [-post]() is set).\n"
 		"This mode must be explicitly activated using [-hmode]().\n"
@@ -1836,6 +1836,17 @@ GF_FilterRegister ReframerRegister = {
 		"- 'S'VAL: split source by chunks of estimated size VAL bytes, VAL can use property multipliers\n"
 		"\n"
 		"Note: In these modes, [-splitrange]() and [-xadjust]() are implicitly set.\n"
+		"\n"
+		"# Parallel range processing\n"
+		"Since each source instance can be seeked independently, range extraction can be used to process several parts of a source concurrently in a single session, "
+		"for example to run several instances of a single-threaded encoder. Each range uses its own source, reframer and encoder instances, and the session threads (`-threads` option of gpac) process these chains in parallel. "
+		"Each filter must be linked to the previous one using `@`, otherwise a reframer could connect to the source of another range.\n"
+		"To get non-overlapping chunks starting on SAP boundaries, a range end must be extended up to the next SAP using [-xadjust]() and the following range must start at this SAP using `xround=after`. "
+		"With the default `xround=before`, the next range would start at the SAP preceding its start time and frames between this SAP and the start time would be present in both chunks.\n"
+		"EX gpac -threads=2 src=m.mp4 @ reframer:xs=0:xe=60000:xadjust @ enc:c=avc @ dst=chunk_1.mp4 src=m.mp4 @ reframer:xs=60000:xround=after @ enc:c=avc @ dst=chunk_2.mp4\n"
+		"The resulting chunks can then be concatenated in order using the `flist` filter:\n"
+		"EX gpac flist:srcs=chunk_1.mp4,chunk_2.mp4 -o full.mp4\n"
+		"Note: Ranges are not split, scheduled and reassembled automatically, each range chain has to be described as above.\n"
 	)
 	.private_size = sizeof(GF_ReframerCtx),
 	.max_extra_pids = (u32) -1,
@@ -40,6 +40,10 @@ typedef struct
 
 	u8 *pck_buffer;
 	u32 nb_pck;
+
+	//pending run of packets in current input packet, zero-copy mode
+	const u8 *run_start;
+	u32 run_size;
 } GF_M2TSSplit_SPTS;
 
 
@@ -50,6 +54,7 @@ typedef struct
 	s32 mux_id;
 	Bool avonly;
 	u32 nb_pack;
+	Bool zc;
 
 	//internal
 	GF_Filter *filter;
@@ -62,15 +67,50 @@ typedef struct
 	u8 tsbuf[192];
 	GF_BitStream *bsw;
 
+	//input packet being processed and its data, zero-copy mode
+	GF_FilterPacket *ipck;
+	const u8 *idata;
+	u32 idata_size;
 } GF_M2TSSplitCtx;
 
 
+static void m2tssplit_flush_run(GF_M2TSSplitCtx *ctx, GF_M2TSSplit_SPTS *stream)
+{
+	GF_FilterPacket *pck;
+	if (!stream->run_size) return;
+	pck = gf_filter_pck_new_ref(stream->opid, stream->run_start, stream->run_size, ctx->ipck);
+	if (pck) {
+		gf_filter_pck_set_framing(pck, GF_FALSE, GF_FALSE);
+		gf_filter_pck_send(pck);
+	}
+	stream->run_start = NULL;
+	stream->run_size = 0;
+}
 
 void m2tssplit_send_packet(GF_M2TSSplitCtx *ctx, GF_M2TSSplit_SPTS *stream, u8 *data, u32 size)
 {
 	u8 *buffer;
 	GF_FilterPacket *pck;
-	if (ctx->nb_pack) {
+	if (ctx->zc) {
+		//packet in current input block: extend pending run if contiguous, otherwise start a new run
+		if (ctx->ipck && (data >= ctx->idata) && (data + size <= ctx->idata + ctx->idata_size)) {
+			if (stream->run_size && (stream->run_start + stream->run_size == data)) {
+				stream->run_size += size;
+				return;
+			}
+			m2tssplit_flush_run(ctx, stream);
+			stream->run_start = data;
+			stream->run_size = size;
+			return;
+		}
+		//packet straddling two input blocks, copy it
+		m2tssplit_flush_run(ctx, stream);
+		pck = gf_filter_pck_new_alloc(stream->opid, size, &buffer);
+		gf_filter_pck_set_framing(pck, GF_FALSE, GF_FALSE);
+		memcpy(buffer, data, size);
+		gf_filter_pck_send(pck);
+	} else if (ctx->nb_pack) {
+		u32 osize;
 		assert (stream->nb_pck<ctx->nb_pack);
 		if (data) {
 			memcpy(stream->pck_buffer + size*stream->nb_pck, data, size);
@@ -79,7 +119,8 @@ void m2tssplit_send_packet(GF_M2TSSplitCtx *ctx, GF_M2TSSplit_SPTS *stream, u8 *
 				return;
 			}
 		}
-		u32 osize = size*stream->nb_pck;
+		//size is 0 when flushing
+		osize = (ctx->dmx->prefix_present ? 192 : 188) * stream->nb_pck;
 		pck = gf_filter_pck_new_alloc(stream->opid, osize, &buffer);
 		gf_filter_pck_set_framing(pck, GF_FALSE, GF_FALSE);
 		memcpy(buffer, stream->pck_buffer, osize);
@@ -93,6 +134,13 @@ void m2tssplit_send_packet(GF_M2TSSplitCtx *ctx, GF_M2TSSplit_SPTS *stream, u8 *
 	}
 }
 
+//send pending packets of stream before a generated PAT
+static void m2tssplit_flush_stream(GF_M2TSSplitCtx *ctx, GF_M2TSSplit_SPTS *stream)
+{
+	if (ctx->zc) m2tssplit_flush_run(ctx, stream);
+	else if (ctx->nb_pack && stream->nb_pck) m2tssplit_send_packet(ctx, stream, NULL, 0);
+}
+
 void m2tssplit_flush(GF_M2TSSplitCtx *ctx)
 {
 	u32 i;
@@ -164,7 +212,23 @@ GF_Err m2tssplit_process(GF_Filter *filter)
 	}
 	data = gf_filter_pck_get_data(pck, &data_size);
 	if (data) {
+		if (ctx->zc) {
+			ctx->ipck = pck;
+			ctx->idata = data;
+			ctx->idata_size = data_size;
+		}
 		gf_m2ts_process_data(ctx->dmx, (u8 *)data, data_size);
+		//runs cannot span input packets
+		if (ctx->zc) {
+			u32 i, count = gf_list_count(ctx->streams);
+			for (i=0; i<count; i++) {
+				GF_M2TSSplit_SPTS *stream = gf_list_get(ctx->streams, i);
+				if (stream->opid) m2tssplit_flush_run(ctx, stream);
+			}
+			ctx->ipck = NULL;
+			ctx->idata = NULL;
+			ctx->idata_size = 0;
+		}
 	}
 	gf_filter_pid_drop_packet(ctx->ipid);
 	return GF_OK;
@@ -268,7 +332,9 @@ void m2tssplit_on_event(struct tag_m2ts_demux *ts, u32 evt_type, void *par)
 
 			//output new PAT
 			if (stream->opid) {
-				GF_FilterPacket *pck = gf_filter_pck_new_alloc(stream->opid, tot_len, &buffer);
+				GF_FilterPacket *pck;
+				m2tssplit_flush_stream(ctx, stream);
+				pck = gf_filter_pck_new_alloc(stream->opid, tot_len, &buffer);
 				gf_filter_pck_set_framing(pck, first_pck, GF_FALSE);
 				memcpy(buffer, ctx->tsbuf, tot_len);
 				gf_filter_pck_send(pck);
@@ -284,6 +350,7 @@ void m2tssplit_on_event(struct tag_m2ts_demux *ts, u32 evt_type, void *par)
 			GF_M2TSSplit_SPTS *stream = prog->user;
 			if (!stream) continue;
 			if (!stream->opid) continue;
+			m2tssplit_flush_stream(ctx, stream);
 
 			GF_FilterPacket *pck = gf_filter_pck_new_alloc(stream->opid, stream->pat_pck_size, &buffer);
 			gf_filter_pck_set_framing(pck, GF_FALSE, GF_FALSE);
@@ -417,7 +484,7 @@ GF_Err m2tssplit_initialize(GF_Filter *filter)
 	ctx->dmx->user = ctx;
 	ctx->filter = filter;
 	ctx->bsw = gf_bs_new(ctx->tsbuf, 192, GF_BITSTREAM_WRITE);
-	if (ctx->nb_pack<=1)
+	if ((ctx->nb_pack<=1) || ctx->zc)
 		ctx->nb_pack = 0;
 	return GF_OK;
 }
@@ -450,6 +517,7 @@ static const GF_FilterArgs M2TSSplitArgs[] =
 	{ OFFS(mux_id), "set initial ID of output mux; the first program will use mux_id, the second mux_id+1, etc. If not set, this value will be set to sourceMuxId*255", GF_PROP_SINT, "-1", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(avonly), "do not forward programs with no AV component", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(nb_pack), "pack N packets before sending", GF_PROP_UINT, "10", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(zc), "zero-copy mode, send references to input data rather than copying packets (see filter help)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 
 	{0}
 };
@@ -461,7 +529,10 @@ GF_FilterRegister M2TSSplitRegister = {
 	GF_FS_SET_DESCRIPTION("MPEG Transport Stream splitter")
 	GF_FS_SET_HELP("This filter splits an MPEG-2 transport stream into several single program transport streams.\n"
 	"Only the PAT table is rewritten, the CAT table, PMT and all program streams are forwarded as is.\n"
-	"In [-full]() mode, global DVB tables of the input multiplex are forwarded to each output mux; otherwise these tables are discarded.")
+	"In [-full]() mode, global DVB tables of the input multiplex are forwarded to each output mux; otherwise these tables are discarded.\n"
+	"\n"
+	"In zero-copy mode ([-zc]()), consecutive packets of a program in an input block are sent as a single packet referencing the input data, "
+	"and [-nb_pack]() is ignored. This avoids copying the multiplex but keeps input blocks in memory until all outputs have consumed them.")
 	.flags = GF_FS_REG_EXPLICIT_ONLY,
 	.private_size = sizeof(GF_M2TSSplitCtx),
 	.initialize = m2tssplit_initialize,
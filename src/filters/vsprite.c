@@ -0,0 +1,440 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / video sprite sheet filter
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/filters.h>
+#include <gpac/constants.h>
+#include <gpac/evg.h>
+
+typedef struct
+{
+	//options
+	GF_PropVec2i grid;
+	GF_Fraction step;
+	char *vtt, *img;
+
+	//internal data
+	GF_FilterPid *ipid, *opid;
+	u32 w, h, s_pfmt, timescale;
+	Bool passthrough;
+
+	//strides signaled on the input pid, 0 if not set
+	u32 in_stride, in_stride_uv;
+	u32 src_stride[5];
+	u32 nb_src_planes, src_uv_height;
+	//size in bytes of a tile line and number of tile lines for each plane
+	u32 tile_wib[5], tile_height[5];
+
+	u32 dst_width, dst_height;
+	u32 dst_stride[5];
+	u32 nb_planes, out_size, dst_uv_height;
+
+	GF_EVGSurface *surface;
+
+	GF_FilterPacket *sprite_pck;
+	u8 *sprite_data;
+	u32 nb_tiles, sprite_idx;
+	u64 sprite_cts, next_cts, last_cts, last_dur;
+	Bool has_next_cts;
+
+	FILE *vtt_file;
+	u64 *tile_cts;
+} GF_VSpriteCtx;
+
+
+static void vsprite_write_vtt_time(FILE *f, u64 ts, u32 timescale)
+{
+	u32 h, m, s, ms;
+	ts = ts * 1000 / timescale;
+	h = (u32) (ts / 3600000);
+	m = (u32) (ts / 60000) - 60*h;
+	s = (u32) (ts / 1000) - 3600*h - 60*m;
+	ms = (u32) (ts % 1000);
+	gf_fprintf(f, "%02d:%02d:%02d.%03d", h, m, s, ms);
+}
+
+static void vsprite_write_vtt(GF_VSpriteCtx *ctx, u64 end_cts)
+{
+	u32 i;
+	char szNum[20];
+	char *url;
+	if (!ctx->vtt_file) return;
+
+	//file numbering of image writers starts at 1
+	sprintf(szNum, "%d", ctx->sprite_idx+1);
+	url = gf_strdup(ctx->img ? ctx->img : "");
+	while (1) {
+		char *sep = strstr(url, "$num$");
+		char *new_url;
+		if (!sep) break;
+		sep[0] = 0;
+		new_url = gf_strdup(url);
+		gf_dynstrcat(&new_url, szNum, NULL);
+		gf_dynstrcat(&new_url, sep+5, NULL);
+		gf_free(url);
+		url = new_url;
+	}
+
+	for (i=0; i<ctx->nb_tiles; i++) {
+		u64 end = (i+1<ctx->nb_tiles) ? ctx->tile_cts[i+1] : end_cts;
+		u32 x = ctx->w * (i % ctx->grid.x);
+		u32 y = ctx->h * (i / ctx->grid.x);
+		gf_fprintf(ctx->vtt_file, "\n");
+		vsprite_write_vtt_time(ctx->vtt_file, ctx->tile_cts[i], ctx->timescale);
+		gf_fprintf(ctx->vtt_file, " --> ");
+		vsprite_write_vtt_time(ctx->vtt_file, end, ctx->timescale);
+		gf_fprintf(ctx->vtt_file, "\n%s#xywh=%d,%d,%d,%d\n", url, x, y, ctx->w, ctx->h);
+	}
+	gf_free(url);
+}
+
+static void vsprite_flush(GF_VSpriteCtx *ctx, u64 end_cts)
+{
+	if (!ctx->sprite_pck) return;
+
+	gf_filter_pck_set_duration(ctx->sprite_pck, (u32) (end_cts - ctx->sprite_cts) );
+	gf_filter_pck_send(ctx->sprite_pck);
+	ctx->sprite_pck = NULL;
+	vsprite_write_vtt(ctx, end_cts);
+	ctx->sprite_idx++;
+	ctx->nb_tiles = 0;
+}
+
+static GF_Err vsprite_process(GF_Filter *filter)
+{
+	const u8 *data;
+	u8 *src_planes[5];
+	u8 *dst_planes[5];
+	u32 src_stride[5];
+	u32 i, j, size, col, row;
+	u64 cts;
+	GF_Err e;
+	GF_FilterFrameInterface *frame_ifce;
+	GF_VSpriteCtx *ctx = gf_filter_get_udta(filter);
+	GF_FilterPacket *pck = gf_filter_pid_get_packet(ctx->ipid);
+
+	if (!pck) {
+		if (gf_filter_pid_is_eos(ctx->ipid)) {
+			vsprite_flush(ctx, ctx->last_cts + ctx->last_dur);
+			gf_filter_pid_set_eos(ctx->opid);
+			return GF_EOS;
+		}
+		return GF_OK;
+	}
+
+	if (ctx->passthrough) {
+		gf_filter_pck_forward(pck, ctx->opid);
+		gf_filter_pid_drop_packet(ctx->ipid);
+		return GF_OK;
+	}
+
+	cts = gf_filter_pck_get_cts(pck);
+	ctx->last_cts = cts;
+	ctx->last_dur = gf_filter_pck_get_duration(pck);
+
+	//frame not sampled
+	if (ctx->has_next_cts && (cts < ctx->next_cts)) {
+		gf_filter_pid_drop_packet(ctx->ipid);
+		return GF_OK;
+	}
+	if (ctx->step.num && ctx->step.den) {
+		u64 inc = ((u64) ctx->step.num) * ctx->timescale / ctx->step.den;
+		ctx->next_cts = ctx->has_next_cts ? ctx->next_cts + inc : cts + inc;
+		//source timestamps jumped, resync
+		if (ctx->next_cts <= cts) ctx->next_cts = cts + inc;
+		ctx->has_next_cts = GF_TRUE;
+	}
+
+	data = gf_filter_pck_get_data(pck, &size);
+	frame_ifce = gf_filter_pck_get_frame_interface(pck);
+	memset(src_planes, 0, sizeof(src_planes));
+	memset(dst_planes, 0, sizeof(dst_planes));
+	//frame interfaces may use a different stride than the configured one, and for each frame
+	memcpy(src_stride, ctx->src_stride, sizeof(src_stride));
+
+	if (data) {
+		src_planes[0] = (u8 *) data;
+		if (ctx->nb_src_planes>1)
+			src_planes[1] = src_planes[0] + ctx->src_stride[0] * ctx->h;
+		if (ctx->nb_src_planes>2)
+			src_planes[2] = src_planes[1] + ctx->src_stride[1] * ctx->src_uv_height;
+		if (ctx->nb_src_planes>3)
+			src_planes[3] = src_planes[2] + ctx->src_stride[2] * ctx->src_uv_height;
+	} else if (frame_ifce && frame_ifce->get_plane) {
+		for (i=0; i<ctx->nb_src_planes; i++) {
+			if (frame_ifce->get_plane(frame_ifce, i, (const u8 **) &src_planes[i], &src_stride[i])!=GF_OK)
+				break;
+		}
+	} else {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[VSprite] No data associated with packet, not supported\n"));
+		gf_filter_pid_drop_packet(ctx->ipid);
+		return GF_NOT_SUPPORTED;
+	}
+
+	//start a new sprite
+	if (!ctx->sprite_pck) {
+		ctx->sprite_pck = gf_filter_pck_new_alloc(ctx->opid, ctx->out_size, &ctx->sprite_data);
+		if (!ctx->sprite_pck) {
+			gf_filter_pid_drop_packet(ctx->ipid);
+			return GF_OUT_OF_MEM;
+		}
+		gf_filter_pck_merge_properties(pck, ctx->sprite_pck);
+		gf_filter_pck_set_sap(ctx->sprite_pck, GF_FILTER_SAP_1);
+		gf_filter_pck_set_byte_offset(ctx->sprite_pck, GF_FILTER_NO_BO);
+		ctx->sprite_cts = cts;
+		//clear the sprite in case it is not full at end of stream
+		e = gf_evg_surface_attach_to_buffer(ctx->surface, ctx->sprite_data, ctx->dst_width, ctx->dst_height, 0, ctx->dst_stride[0], ctx->s_pfmt);
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[VSprite] Failed to attach sprite buffer: %s\n", gf_error_to_string(e)));
+			gf_filter_pck_discard(ctx->sprite_pck);
+			ctx->sprite_pck = NULL;
+			gf_filter_pid_drop_packet(ctx->ipid);
+			return e;
+		}
+		gf_evg_surface_clear(ctx->surface, NULL, 0xFF000000);
+	}
+
+	dst_planes[0] = ctx->sprite_data;
+	if (ctx->nb_planes>1)
+		dst_planes[1] = dst_planes[0] + ctx->dst_stride[0] * ctx->dst_height;
+	if (ctx->nb_planes>2)
+		dst_planes[2] = dst_planes[1] + ctx->dst_stride[1] * ctx->dst_uv_height;
+	if (ctx->nb_planes>3)
+		dst_planes[3] = dst_planes[2] + ctx->dst_stride[2] * ctx->dst_uv_height;
+
+	col = ctx->nb_tiles % ctx->grid.x;
+	row = ctx->nb_tiles / ctx->grid.x;
+	for (i=0; i<ctx->nb_planes; i++) {
+		u8 *src = src_planes[i];
+		u8 *dst = dst_planes[i] + row * ctx->tile_height[i] * ctx->dst_stride[i] + col * ctx->tile_wib[i];
+		if (!src) break;
+		for (j=0; j<ctx->tile_height[i]; j++) {
+			memcpy(dst, src, ctx->tile_wib[i]);
+			src += src_stride[i];
+			dst += ctx->dst_stride[i];
+		}
+	}
+	ctx->tile_cts[ctx->nb_tiles] = cts;
+	ctx->nb_tiles++;
+	gf_filter_pid_drop_packet(ctx->ipid);
+
+	if (ctx->nb_tiles == (u32) (ctx->grid.x * ctx->grid.y)) {
+		u64 end_cts = ctx->has_next_cts ? ctx->next_cts : cts + ctx->last_dur;
+		vsprite_flush(ctx, end_cts);
+	}
+	return GF_OK;
+}
+
+static GF_Err vsprite_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	const GF_PropertyValue *p;
+	u32 w, h, stride, stride_uv, pfmt, timescale;
+	GF_VSpriteCtx *ctx = gf_filter_get_udta(filter);
+
+	if (is_remove) {
+		if (ctx->opid) {
+			gf_filter_pid_remove(ctx->opid);
+		}
+		return GF_OK;
+	}
+	if (! gf_filter_pid_check_caps(pid))
+		return GF_NOT_SUPPORTED;
+
+	if (!ctx->opid) {
+		ctx->opid = gf_filter_pid_new(filter);
+	}
+	//copy properties at init or reconfig
+	gf_filter_pid_copy_properties(ctx->opid, pid);
+
+	if (!ctx->ipid) {
+		ctx->ipid = pid;
+	}
+	w = h = pfmt = stride = stride_uv = 0;
+	timescale = 1000;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_WIDTH);
+	if (p) w = p->value.uint;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_HEIGHT);
+	if (p) h = p->value.uint;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_STRIDE);
+	if (p) stride = p->value.uint;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_STRIDE_UV);
+	if (p) stride_uv = p->value.uint;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_PIXFMT);
+	if (p) pfmt = p->value.uint;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_TIMESCALE);
+	if (p && p->value.uint) timescale = p->value.uint;
+
+	if ((ctx->grid.x<=0) || (ctx->grid.y<=0)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[VSprite] Invalid sprite grid %dx%d\n", ctx->grid.x, ctx->grid.y));
+		return GF_BAD_PARAM;
+	}
+	if (!w || !h || !pfmt) {
+		ctx->passthrough = GF_TRUE;
+		return GF_OK;
+	}
+
+	//flush current sprite, we don't mix sizes
+	if (ctx->sprite_pck && ((ctx->w != w) || (ctx->h != h) || (ctx->s_pfmt != pfmt)))
+		vsprite_flush(ctx, ctx->last_cts + ctx->last_dur);
+
+	//compare with signaled strides, the computed ones are never 0
+	if ((ctx->w != w) || (ctx->h != h) || (ctx->s_pfmt != pfmt) || (ctx->in_stride != stride) || (ctx->in_stride_uv != stride_uv) || (ctx->timescale != timescale)) {
+		Bool res;
+		u32 i, out_size, tile_stride[2], tile_uv_height;
+
+		ctx->w = w;
+		ctx->h = h;
+		ctx->s_pfmt = pfmt;
+		ctx->timescale = timescale;
+		ctx->in_stride = stride;
+		ctx->in_stride_uv = stride_uv;
+		ctx->passthrough = GF_FALSE;
+
+		//get layout info for source
+		memset(ctx->src_stride, 0, sizeof(ctx->src_stride));
+		ctx->src_stride[0] = stride;
+		ctx->src_stride[1] = stride_uv;
+		res = gf_pixel_get_size_info(pfmt, w, h, &out_size, &ctx->src_stride[0], &ctx->src_stride[1], &ctx->nb_src_planes, &ctx->src_uv_height);
+		if (!res) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[VSprite] Failed to query source pixel format characteristics\n"));
+			return GF_NOT_SUPPORTED;
+		}
+		if (ctx->nb_src_planes==3) ctx->src_stride[2] = ctx->src_stride[1];
+		if (ctx->nb_src_planes==4) ctx->src_stride[3] = ctx->src_stride[0];
+
+		//get tile line size, ignoring source padding
+		tile_stride[0] = tile_stride[1] = 0;
+		gf_pixel_get_size_info(pfmt, w, h, &out_size, &tile_stride[0], &tile_stride[1], &ctx->nb_planes, &tile_uv_height);
+		if ((ctx->nb_planes>1) && ((w%2) || (h%2))) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[VSprite] Odd frame size %dx%d not supported for subsampled pixel formats\n", w, h));
+			return GF_NOT_SUPPORTED;
+		}
+		for (i=0; i<ctx->nb_planes; i++) {
+			Bool is_uv = ((i==1) || (i==2)) ? GF_TRUE : GF_FALSE;
+			ctx->tile_wib[i] = is_uv ? tile_stride[1] : tile_stride[0];
+			ctx->tile_height[i] = is_uv ? tile_uv_height : h;
+		}
+
+		//get layout info for dest
+		ctx->dst_width = w * ctx->grid.x;
+		ctx->dst_height = h * ctx->grid.y;
+		memset(ctx->dst_stride, 0, sizeof(ctx->dst_stride));
+		res = gf_pixel_get_size_info(pfmt, ctx->dst_width, ctx->dst_height, &ctx->out_size, &ctx->dst_stride[0], &ctx->dst_stride[1], &ctx->nb_planes, &ctx->dst_uv_height);
+		if (!res) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[VSprite] Failed to query output pixel format characteristics\n"));
+			return GF_NOT_SUPPORTED;
+		}
+		if (ctx->nb_planes==3) ctx->dst_stride[2] = ctx->dst_stride[1];
+		if (ctx->nb_planes==4) ctx->dst_stride[3] = ctx->dst_stride[0];
+
+		ctx->tile_cts = gf_realloc(ctx->tile_cts, sizeof(u64) * ctx->grid.x * ctx->grid.y);
+		ctx->has_next_cts = GF_FALSE;
+
+		GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[VSprite] Configured %dx%d sprites of %dx%d frames\n", ctx->grid.x, ctx->grid.y, w, h));
+	}
+
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_WIDTH, &PROP_UINT(ctx->dst_width));
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_HEIGHT, &PROP_UINT(ctx->dst_height));
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_STRIDE, &PROP_UINT(ctx->dst_stride[0]));
+	if (ctx->nb_planes>1)
+		gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_STRIDE_UV, &PROP_UINT(ctx->dst_stride[1]));
+	else
+		gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_STRIDE_UV, NULL);
+	//sprites are sent at irregular intervals
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_FPS, NULL);
+
+	//an access unit corresponds to a single packet
+	gf_filter_pid_set_framing_mode(pid, GF_TRUE);
+	return GF_OK;
+}
+
+static GF_Err vsprite_initialize(GF_Filter *filter)
+{
+	GF_VSpriteCtx *ctx = gf_filter_get_udta(filter);
+	ctx->surface = gf_evg_surface_new(GF_FALSE);
+	if (!ctx->surface) return GF_OUT_OF_MEM;
+
+	if (ctx->vtt) {
+		ctx->vtt_file = gf_fopen(ctx->vtt, "wt");
+		if (!ctx->vtt_file) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[VSprite] Failed to open WebVTT output %s\n", ctx->vtt));
+			return GF_IO_ERR;
+		}
+		gf_fprintf(ctx->vtt_file, "WEBVTT\n");
+	}
+	return GF_OK;
+}
+
+static void vsprite_finalize(GF_Filter *filter)
+{
+	GF_VSpriteCtx *ctx = gf_filter_get_udta(filter);
+	if (ctx->sprite_pck) gf_filter_pck_discard(ctx->sprite_pck);
+	if (ctx->surface) gf_evg_surface_delete(ctx->surface);
+	if (ctx->vtt_file) gf_fclose(ctx->vtt_file);
+	if (ctx->tile_cts) gf_free(ctx->tile_cts);
+}
+
+
+#define OFFS(_n)	#_n, offsetof(GF_VSpriteCtx, _n)
+static GF_FilterArgs VSpriteArgs[] =
+{
+	{ OFFS(grid), "number of columns and rows of frames in each sprite", GF_PROP_VEC2I, "5x5", NULL, 0},
+	{ OFFS(step), "interval in seconds between two frames kept in sprites, 0 keeps all frames", GF_PROP_FRACTION, "1/1", NULL, 0},
+	{ OFFS(vtt), "name of WebVTT thumbnail track to write", GF_PROP_STRING, NULL, NULL, 0},
+	{ OFFS(img), "URL of sprite images in the WebVTT thumbnail track, `$num$` being replaced by the sprite index (starting from 1)", GF_PROP_STRING, "sprite_$num$.png", NULL, 0},
+	{0}
+};
+
+static const GF_FilterCapability VSpriteCaps[] =
+{
+	CAP_UINT(GF_CAPS_INPUT_OUTPUT,GF_PROP_PID_STREAM_TYPE, GF_STREAM_VISUAL),
+	CAP_UINT(GF_CAPS_INPUT_OUTPUT,GF_PROP_PID_CODECID, GF_CODECID_RAW)
+};
+
+GF_FilterRegister VSpriteRegister = {
+	.name = "vsprite",
+	GF_FS_SET_DESCRIPTION("Video sprite sheet generator")
+	GF_FS_SET_HELP("This filter samples frames of a raw video stream at a given interval and tiles them in sprite sheets of `grid` frames.\n"
+	"Each sprite is output as a single raw frame, which can be encoded using an image encoder and written to a set of files.\n"
+	"The filter can also write a WebVTT thumbnail track giving, for each sampled frame, the sprite image URL and the frame position in the sprite (`#xywh=`).\n"
+	"\n"
+	"EX gpac -i video.mp4 vsprite:grid=4x4:step=2:vtt=thumbs.vtt @ -o sprite_$num$.png\n"
+	"\n"
+	"Note: when running the session with several threads, sprite composition and image encoding of different sources or outputs are processed in parallel.\n")
+	.private_size = sizeof(GF_VSpriteCtx),
+	.flags = GF_FS_REG_EXPLICIT_ONLY,
+	.args = VSpriteArgs,
+	.initialize = vsprite_initialize,
+	.configure_pid = vsprite_configure_pid,
+	SETCAPS(VSpriteCaps),
+	.process = vsprite_process,
+	.finalize = vsprite_finalize,
+};
+
+
+
+const GF_FilterRegister *vsprite_register(GF_FilterSession *session)
+{
+	return &VSpriteRegister;
+}
@@ -348,10 +348,7 @@ u32 gf_rtp_read_flush(GF_RTPChannel *ch, u8 *buffer, u32 buffer_size)
 
 	//pck queue may need to be flushed
 	pck = (char *) gf_rtp_reorderer_get(ch->po, &res, GF_TRUE);
-	if (pck) {
-		memcpy(buffer, pck, res);
-		gf_free(pck);
-	}
+	if (pck) memcpy(buffer, pck, res);
 	return res;
 }
 
@@ -368,7 +365,6 @@ u32 gf_rtp_flush_rtp(GF_RTPChannel *ch, u8 *buffer, u32 buffer_size)
 	pck = (char *) gf_rtp_reorderer_get(ch->po, &res, GF_FALSE);
 	if (pck) {
 		memcpy(buffer, pck, res);
-		gf_free(pck);
 		return res;
 	}
 	return 0;
@@ -406,10 +402,7 @@ u32 gf_rtp_read_rtp(GF_RTPChannel *ch, u8 *buffer, u32 buffer_size)
 
 		//pck queue may need to be flushed
 		pck = (char *) gf_rtp_reorderer_get(ch->po, &res, GF_FALSE);
-		if (pck) {
-			memcpy(buffer, pck, res);
-			gf_free(pck);
-		}
+		if (pck) memcpy(buffer, pck, res);
 	}
 	/*monitor keep-alive period*/
 	if (ch->nat_keepalive_time_period && !ch->send_interleave) {
@@ -838,9 +831,73 @@ void gf_rtp_get_ports(GF_RTPChannel *ch, u16 *rtp_port, u16 *rtcp_port)
 
 /*
 	RTP packet reorderer
+
+	Packets are stored in a ring of slots indexed by their extended sequence number, so that insertion
+	and output are done in constant time. When FEC is enabled, output packets are kept in the ring
+	for a while to be used for SMPTE 2022-1 (row/column XOR) recovery of missing packets.
 */
 
 #define SN_CHECK_OFFSET		0x0A
+//max number of packets, extended sequence numbers are computed from 16 bit sequence numbers relative to the head
+#define PO_MAX_COUNT		0x2000
+//number of output packets kept for FEC recovery, 2022-1 matrices are at most 100 packets
+#define PO_FEC_HISTORY		256
+//number of FEC packets kept
+#define PO_FEC_MAX			64
+
+static GF_Err po_alloc_slots(GF_RTPReorder *po)
+{
+	u32 nb_slots = 1;
+	//keep room for twice the max count before forcing a resync
+	while (nb_slots < 2*po->MaxCount + po->history) nb_slots <<= 1;
+
+	po->slots = gf_malloc(sizeof(GF_POSlot) * nb_slots);
+	if (!po->slots) return GF_OUT_OF_MEM;
+	memset(po->slots, 0, sizeof(GF_POSlot) * nb_slots);
+	po->nb_slots = nb_slots;
+	return GF_OK;
+}
+
+static void po_free_slots(GF_RTPReorder *po)
+{
+	u32 i;
+	if (!po->slots) return;
+	for (i=0; i<po->nb_slots; i++) {
+		if (po->slots[i].pck) gf_free(po->slots[i].pck);
+	}
+	gf_free(po->slots);
+	po->slots = NULL;
+	po->nb_slots = 0;
+}
+
+static Bool po_slot_store(GF_POSlot *slot, const void *pck, u32 size)
+{
+	if (slot->alloc_size < size) {
+		slot->pck = gf_realloc(slot->pck, size);
+		if (!slot->pck) {
+			slot->alloc_size = 0;
+			return GF_FALSE;
+		}
+		slot->alloc_size = size;
+	}
+	if (pck) memcpy(slot->pck, pck, size);
+	slot->size = size;
+	return GF_TRUE;
+}
+
+//get extended sequence number from a 16 bit one, relative to the head
+static GFINLINE u32 po_ext_seqnum(GF_RTPReorder *po, u32 seqnum)
+{
+	s16 diff = (s16) (u16) (seqnum - po->head_seqnum);
+	return po->head_seqnum + diff;
+}
+
+static GFINLINE GF_POSlot *po_get_slot(GF_RTPReorder *po, u32 ext_seqnum)
+{
+	GF_POSlot *slot = &po->slots[ext_seqnum & (po->nb_slots-1)];
+	if ((slot->state != GF_PO_SLOT_EMPTY) && (slot->ext_seq_num == ext_seqnum)) return slot;
+	return NULL;
+}
 
 GF_EXPORT
 GF_RTPReorder *gf_rtp_reorderer_new(u32 MaxCount, u32 MaxDelay)
@@ -851,199 +908,378 @@ GF_RTPReorder *gf_rtp_reorderer_new(u32 MaxCount, u32 MaxDelay)
 
 	GF_SAFEALLOC(tmp , GF_RTPReorder);
 	if (!tmp) return NULL;
-	tmp->MaxCount = MaxCount;
+	tmp->MaxCount = MIN(MaxCount, PO_MAX_COUNT);
 	tmp->MaxDelay = MaxDelay;
+	if (po_alloc_slots(tmp) != GF_OK) {
+		gf_free(tmp);
+		return NULL;
+	}
 	return tmp;
 }
 
 GF_EXPORT
 void gf_rtp_reorderer_del(GF_RTPReorder *po)
 {
-	gf_rtp_reorderer_reset(po);
+	u32 i;
+	if (!po) return;
+	if (po->nb_pck) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[rtp] Packet Reorderer: %u packets received - %u lost - %u recovered by FEC in "LLU" us - %u duplicated - %u late\n", po->nb_pck, po->nb_lost, po->nb_recovered, po->fec_time, po->nb_dup, po->nb_late));
+	}
+	po_free_slots(po);
+	if (po->resync.pck) gf_free(po->resync.pck);
+	if (po->fec) {
+		for (i=0; i<po->nb_fec; i++) {
+			if (po->fec[i].data) gf_free(po->fec[i].data);
+		}
+		gf_free(po->fec);
+	}
 	gf_free(po);
 }
 
 GF_EXPORT
 void gf_rtp_reorderer_reset(GF_RTPReorder *po)
 {
-	GF_POItem *item;
+	u32 i;
 	if (!po) return;
 
-	item = po->in;
-	while (item) {
-		GF_POItem *next = item->next;
-		gf_free(item->pck);
-		gf_free(item);
-		item = next;
+	for (i=0; i<po->nb_slots; i++) {
+		po->slots[i].state = GF_PO_SLOT_EMPTY;
 	}
-
+	for (i=0; i<po->nb_fec; i++) {
+		po->fec[i].used = GF_FALSE;
+	}
+	po->resync.state = GF_PO_SLOT_EMPTY;
+	po->fec_idx = 0;
 	po->head_seqnum = 0;
+	po->max_seqnum = 0;
 	po->Count = 0;
 	po->IsInit = 0;
-	po->in = NULL;
+	po->LastTime = 0;
 }
 
 GF_EXPORT
-GF_Err gf_rtp_reorderer_add(GF_RTPReorder *po, const void * pck, u32 pck_size, u32 pck_seqnum)
+GF_Err gf_rtp_reorderer_enable_fec(GF_RTPReorder *po)
 {
-	GF_POItem *it, *cur;
-	u32 bounds;
-
 	if (!po) return GF_BAD_PARAM;
+	if (po->fec) return GF_OK;
 
-	it = (GF_POItem *) gf_malloc(sizeof(GF_POItem));
-	it->pck_seq_num = pck_seqnum;
-	it->next = NULL;
-	it->size = pck_size;
-	it->pck = gf_malloc(pck_size);
-	memcpy(it->pck, pck, pck_size);
-	/*reset timeout*/
-	po->LastTime = 0;
+	po->fec = gf_malloc(sizeof(GF_POFec) * PO_FEC_MAX);
+	if (!po->fec) return GF_OUT_OF_MEM;
+	memset(po->fec, 0, sizeof(GF_POFec) * PO_FEC_MAX);
+	po->nb_fec = PO_FEC_MAX;
 
-	//no input, this packet will be the input
-	if (!po->in) {
-		//the seq num was not initialized
-		if (!po->head_seqnum) {
-			po->head_seqnum = pck_seqnum;
-		} else if (!po->IsInit) {
-			//this is not in our current range for init
-			if (ABSDIFF(po->head_seqnum, pck_seqnum) > SN_CHECK_OFFSET) goto discard;
-			po->IsInit = 1;
-		}
+	gf_rtp_reorderer_reset(po);
+	po_free_slots(po);
+	po->history = PO_FEC_HISTORY;
+	return po_alloc_slots(po);
+}
 
-		po->in = it;
-		po->Count += 1;
-		return GF_OK;
+//flush pending packets and restart from the packet received too far ahead
+static void po_resync(GF_RTPReorder *po)
+{
+	u32 i;
+	u8 *pck;
+	u32 alloc_size;
+	GF_POSlot *slot;
+
+	GF_LOG(GF_LOG_WARNING, GF_LOG_RTP, ("[rtp] Packet Reorderer: resyncing from %u to %u, %u packets dropped\n", po->head_seqnum & 0xFFFF, po->resync.ext_seq_num & 0xFFFF, po->Count));
+	//backward jumps (sender restart) don't lose packets
+	if ((s32) (po->resync.ext_seq_num - po->head_seqnum) > 0)
+		po->nb_lost += po->resync.ext_seq_num - po->head_seqnum;
+
+	for (i=0; i<po->nb_slots; i++) {
+		po->slots[i].state = GF_PO_SLOT_EMPTY;
 	}
+	po->head_seqnum = po->max_seqnum = po->resync.ext_seq_num;
+	po->LastTime = 0;
 
-	//this is 16 bitr seq num, as we work with RTP only for now
-	bounds = 0;
-	if ( (po->head_seqnum >= 0xf000 ) || (po->head_seqnum <= 0x1000) ) bounds = 0x2000;
-
-	//first check the head of the list
-	//same seq num, we drop
-	if (po->in->pck_seq_num == pck_seqnum) goto discard;
+	//swap buffers with the target slot
+	slot = &po->slots[po->head_seqnum & (po->nb_slots-1)];
+	pck = slot->pck;
+	alloc_size = slot->alloc_size;
+	slot->pck = po->resync.pck;
+	slot->alloc_size = po->resync.alloc_size;
+	slot->size = po->resync.size;
+	slot->ext_seq_num = po->head_seqnum;
+	slot->state = GF_PO_SLOT_PENDING;
+	po->resync.pck = pck;
+	po->resync.alloc_size = alloc_size;
+	po->resync.state = GF_PO_SLOT_EMPTY;
+	po->Count = 1;
+}
 
-	if ( ( (u16) (pck_seqnum + bounds) <= (u16) (po->in->pck_seq_num + bounds) ) ) {
+GF_EXPORT
+GF_Err gf_rtp_reorderer_add(GF_RTPReorder *po, const void * pck, u32 pck_size, u32 pck_seqnum)
+{
+	s32 diff;
+	u32 ext_seqnum, window;
+	GF_POSlot *slot;
 
-		it->next = po->in;
-		po->in = it;
-		po->Count += 1;
+	if (!po) return GF_BAD_PARAM;
+	po->nb_pck++;
 
-		GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: inserting packet %d at head\n", pck_seqnum));
-		return GF_OK;
+	//first packet
+	if (!po->IsInit) {
+		po->head_seqnum = po->max_seqnum = 0x10000 + (pck_seqnum & 0xFFFF);
+		po->IsInit = 1;
+	}
+	window = po->nb_slots - po->history;
+	ext_seqnum = po_ext_seqnum(po, pck_seqnum);
+	diff = (s32) (ext_seqnum - po->head_seqnum);
+
+	//too far ahead, or behind the whole ring (sender restart, backward sequence jump): the queue must be flushed first
+	if ((diff >= (s32) window) || (-diff >= (s32) po->nb_slots)) {
+		//previous resync not processed, drop pending packets and check again from the new head
+		if (po->resync.state) {
+			po_resync(po);
+			ext_seqnum = po_ext_seqnum(po, pck_seqnum);
+			diff = (s32) (ext_seqnum - po->head_seqnum);
+		}
+		if ((diff >= (s32) window) || (-diff >= (s32) po->nb_slots)) {
+			if (!po_slot_store(&po->resync, pck, pck_size)) return GF_OUT_OF_MEM;
+			po->resync.ext_seq_num = ext_seqnum;
+			po->resync.state = GF_PO_SLOT_PENDING;
+			return GF_OK;
+		}
 	}
 
-	//no, insert at the right place
-	cur = po->in;
-
-	while (1) {
-		//same seq num, we drop
-		if (cur->pck_seq_num == pck_seqnum) goto discard;
-
-		//end of list
-		if (!cur->next) {
-			cur->next = it;
-			po->Count += 1;
-			GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Appending packet %d (last %d)\n", pck_seqnum, cur->pck_seq_num));
+	if (diff < 0) {
+		//nothing output yet, this packet may be the real start of the stream
+		if ((po->IsInit==1) && (-diff <= SN_CHECK_OFFSET) && ((s32) (po->max_seqnum - ext_seqnum) < (s32) window)) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: moving head to %d\n", pck_seqnum));
+			po->head_seqnum = ext_seqnum;
+		} else {
+			if (po_get_slot(po, ext_seqnum)) po->nb_dup++;
+			else po->nb_late++;
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Dropping late packet %d (expecting %d)\n", pck_seqnum, po->head_seqnum & 0xFFFF));
 			return GF_OK;
 		}
+	}
 
-		//are we in the bounds ??
-		if ( ( (u16) (cur->pck_seq_num + bounds) < (u16) (pck_seqnum + bounds) )
-		        && ( (u16) (pck_seqnum + bounds) < (u16) (cur->next->pck_seq_num + bounds)) ) {
+	slot = &po->slots[ext_seqnum & (po->nb_slots-1)];
+	//same seq num, we drop
+	if ((slot->state == GF_PO_SLOT_PENDING) && (slot->ext_seq_num == ext_seqnum)) {
+		po->nb_dup++;
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Dropping duplicated packet %d\n", pck_seqnum));
+		return GF_OK;
+	}
+	if (!po_slot_store(slot, pck, pck_size)) return GF_OUT_OF_MEM;
+	slot->ext_seq_num = ext_seqnum;
+	slot->state = GF_PO_SLOT_PENDING;
+	po->Count++;
+	if ((s32) (ext_seqnum - po->max_seqnum) > 0)
+		po->max_seqnum = ext_seqnum;
 
-			//insert
-			it->next = cur->next;
-			cur->next = it;
-			po->Count += 1;
+	return GF_OK;
+}
 
-			GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Inserting packet %d\n", pck_seqnum));
-			//done
-			return GF_OK;
+GF_EXPORT
+GF_Err gf_rtp_reorderer_add_fec(GF_RTPReorder *po, const void * pck, u32 pck_size)
+{
+	u32 hdr_size, offset, na;
+	const u8 *data = (const u8 *) pck;
+	GF_POFec *fec;
+
+	if (!po || !po->fec || !pck) return GF_BAD_PARAM;
+	if (pck_size < 12) return GF_NON_COMPLIANT_BITSTREAM;
+
+	//skip RTP header, CSRCs and extension
+	hdr_size = 12 + 4 * (data[0] & 0x0F);
+	if ((data[0] & 0x10) && (pck_size >= hdr_size + 4))
+		hdr_size += 4 + 4 * ( ((u32) data[hdr_size+2] << 8) | data[hdr_size+3]);
+	//FEC header is 16 bytes
+	if (pck_size < hdr_size + 16) return GF_NON_COMPLIANT_BITSTREAM;
+	data += hdr_size;
+	pck_size -= hdr_size;
+
+	//only XOR FEC is supported
+	if ((data[12] >> 3) & 0x7) return GF_NOT_SUPPORTED;
+	offset = data[13];
+	na = data[14];
+	if (!offset || !na) return GF_NON_COMPLIANT_BITSTREAM;
+	//protected packets must fit in the history
+	if ((na-1) * offset >= po->history) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_RTP, ("[rtp] Packet Reorderer: FEC matrix too large (offset %u NA %u), ignoring\n", offset, na));
+		return GF_NOT_SUPPORTED;
+	}
+	//no reference yet
+	if (!po->IsInit) return GF_OK;
+
+	fec = &po->fec[po->fec_idx];
+	po->fec_idx = (po->fec_idx + 1) % po->nb_fec;
+	if (fec->alloc_size < pck_size) {
+		fec->data = gf_realloc(fec->data, pck_size);
+		if (!fec->data) {
+			fec->alloc_size = 0;
+			fec->used = GF_FALSE;
+			return GF_OUT_OF_MEM;
 		}
-		cur = cur->next;
+		fec->alloc_size = pck_size;
 	}
+	memcpy(fec->data, data, pck_size);
+	fec->size = pck_size;
+	fec->sn_base = po_ext_seqnum(po, ((u32) data[0] << 8) | data[1]);
+	fec->offset = offset;
+	fec->na = na;
+	fec->used = GF_TRUE;
+	return GF_OK;
+}
 
+//recovers the packet with the given sequence number from one FEC packet and the other packets it protects
+static Bool po_fec_recover(GF_RTPReorder *po, u32 ext_seqnum)
+{
+	u32 i, j, k;
+	u64 start = gf_sys_clock_high_res();
+
+	for (i=0; i<po->nb_fec; i++) {
+		u32 diff, idx, len, ts, ssrc=0;
+		u8 pt, *dst;
+		GF_POSlot *slot;
+		GF_POFec *fec = &po->fec[i];
+		if (!fec->used) continue;
+
+		diff = ext_seqnum - fec->sn_base;
+		if ((s32) diff < 0) continue;
+		if (diff % fec->offset) continue;
+		idx = diff / fec->offset;
+		if (idx >= fec->na) continue;
+
+		//all other protected packets must be available
+		for (j=0; j<fec->na; j++) {
+			if (j==idx) continue;
+			slot = po_get_slot(po, fec->sn_base + j * fec->offset);
+			if (!slot || (slot->size < 12)) break;
+		}
+		if (j<fec->na) continue;
+
+		//recover length, payload type and timestamp
+		len = ((u32) fec->data[2] << 8) | fec->data[3];
+		pt = fec->data[4] & 0x7F;
+		ts = GF_4CC(fec->data[8], fec->data[9], fec->data[10], fec->data[11]);
+		for (j=0; j<fec->na; j++) {
+			u8 *src;
+			if (j==idx) continue;
+			slot = po_get_slot(po, fec->sn_base + j * fec->offset);
+			src = slot->pck;
+			len ^= slot->size - 12;
+			pt ^= src[1] & 0x7F;
+			ts ^= GF_4CC(src[4], src[5], src[6], src[7]);
+			ssrc = GF_4CC(src[8], src[9], src[10], src[11]);
+		}
+		if (len > fec->size - 16) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_RTP, ("[rtp] Packet Reorderer: corrupted FEC packet for %d\n", ext_seqnum & 0xFFFF));
+			fec->used = GF_FALSE;
+			continue;
+		}
 
-discard:
-	gf_free(it->pck);
-	gf_free(it);
-	GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("[rtp] Packet Reorderer: Dropping packet %d\n", pck_seqnum));
-	return GF_OK;
+		slot = &po->slots[ext_seqnum & (po->nb_slots-1)];
+		if (!po_slot_store(slot, NULL, 12 + len)) break;
+		dst = slot->pck;
+		dst[0] = 0x80;
+		dst[1] = pt;
+		dst[2] = (ext_seqnum >> 8) & 0xFF;
+		dst[3] = ext_seqnum & 0xFF;
+		dst[4] = (ts >> 24) & 0xFF;
+		dst[5] = (ts >> 16) & 0xFF;
+		dst[6] = (ts >> 8) & 0xFF;
+		dst[7] = ts & 0xFF;
+		dst[8] = (ssrc >> 24) & 0xFF;
+		dst[9] = (ssrc >> 16) & 0xFF;
+		dst[10] = (ssrc >> 8) & 0xFF;
+		dst[11] = ssrc & 0xFF;
+		dst += 12;
+		memcpy(dst, fec->data + 16, len);
+		for (j=0; j<fec->na; j++) {
+			u32 plen;
+			u8 *src;
+			GF_POSlot *sib;
+			if (j==idx) continue;
+			sib = po_get_slot(po, fec->sn_base + j * fec->offset);
+			src = sib->pck + 12;
+			plen = MIN(len, sib->size - 12);
+			for (k=0; k<plen; k++)
+				dst[k] ^= src[k];
+		}
+		slot->ext_seq_num = ext_seqnum;
+		slot->state = GF_PO_SLOT_PENDING;
+		po->Count++;
+		po->nb_recovered++;
+		po->fec_time += gf_sys_clock_high_res() - start;
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: recovered packet %d using FEC base %d offset %d NA %d\n", ext_seqnum & 0xFFFF, fec->sn_base & 0xFFFF, fec->offset, fec->na));
+		return GF_TRUE;
+	}
+	po->fec_time += gf_sys_clock_high_res() - start;
+	return GF_FALSE;
 }
 
-//retrieve the first available packet. Note that the behavior will be undefined if the first
-//ever received packet if its SeqNum was unknown
-//the BUFFER is yours, you must delete it
+//retrieve the first available packet. Packets are output as soon as they are in order (the first one is held until
+//SN_CHECK_OFFSET packets are queued), missing packets
+//are waited for at most MaxDelay ms or until MaxCount packets are queued
 GF_EXPORT
 void *gf_rtp_reorderer_get(GF_RTPReorder *po, u32 *pck_size, Bool force_flush)
 {
-	GF_POItem *t;
-	u32 bounds;
-	void *ret;
+	GF_POSlot *slot;
+	Bool skip = GF_FALSE;
 
 	if (!po || !pck_size) return NULL;
 
 	*pck_size = 0;
 
 	//empty queue
-	if (!po->in) return NULL;
-
-	//check we have received the first packet
-	if ( po->head_seqnum && po->MaxCount
-	        && (po->MaxCount > po->Count)
-	        && (po->in->pck_seq_num != po->head_seqnum))
-		return NULL;
-
-	//no entry
-	if (!po->in->next) goto check_timeout;
-
-	bounds = 0;
-	if ( (po->head_seqnum >= 0xf000 ) || (po->head_seqnum <= 0x1000) ) bounds = 0x2000;
-
-	//release the output if SN in order or maxCount reached
-	if (( (u16) (po->in->pck_seq_num + bounds + 1) == (u16) (po->in->next->pck_seq_num + bounds))
-	        || (po->MaxCount && (po->Count >= po->MaxCount)) ) {
-
-#ifndef GPAC_DISABLE_LOG
-		if (po->in->pck_seq_num + 1 != po->in->next->pck_seq_num)
-			GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[rtp] WARNING Packet Loss: Sending %d out of the queue but next is %d\n", po->in->pck_seq_num, po->in->next->pck_seq_num ));
-#endif
-		goto send_it;
+	if (!po->Count) {
+		if (!po->resync.state) return NULL;
+		po_resync(po);
 	}
-	//update timing
-	else {
-check_timeout:
-
-		if (force_flush) goto send_it;
 
+	//nothing output yet: hold the head until enough packets are received (or MaxDelay expires) so that
+	//a first packet received out of order can still move the head backward
+	if ((po->IsInit==1) && !force_flush && !po->resync.state && (po->Count < SN_CHECK_OFFSET) && (!po->MaxCount || (po->Count < po->MaxCount)) ) {
+		u32 now = gf_sys_clock();
 		if (!po->LastTime) {
-			po->LastTime = gf_sys_clock();
-			GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: starting timeout at %d\n", po->LastTime));
+			po->LastTime = now;
 			return NULL;
 		}
-		//if exceeding the delay send the head
-		if (gf_sys_clock() - po->LastTime >= po->MaxDelay) {
-			GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Forcing output after %d ms wait (max allowed %d)\n", gf_sys_clock() - po->LastTime, po->MaxDelay));
-			goto send_it;
-		}
+		if (now - po->LastTime < po->MaxDelay)
+			return NULL;
 	}
-	return NULL;
 
+	while (1) {
+		slot = &po->slots[po->head_seqnum & (po->nb_slots-1)];
+		if ((slot->state == GF_PO_SLOT_PENDING) && (slot->ext_seq_num == po->head_seqnum))
+			break;
+
+		//missing packet, try FEC
+		if (po->fec && po_fec_recover(po, po->head_seqnum))
+			continue;
+
+		//wait for the packet unless forced to output or maxCount reached
+		if (!skip && !force_flush && !po->resync.state && (!po->MaxCount || (po->Count < po->MaxCount)) ) {
+			u32 now = gf_sys_clock();
+			if (!po->LastTime) {
+				po->LastTime = now;
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: starting timeout at %d\n", po->LastTime));
+				return NULL;
+			}
+			if (now - po->LastTime < po->MaxDelay)
+				return NULL;
+
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Forcing output after %d ms wait (max allowed %d)\n", now - po->LastTime, po->MaxDelay));
+		}
+		//skip all missing packets up to the next received one
+		skip = GF_TRUE;
+		GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[rtp] WARNING Packet Loss: packet %d missing\n", po->head_seqnum & 0xFFFF));
+		po->nb_lost++;
+		po->head_seqnum++;
+	}
 
-send_it:
-	GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Fetching %d\n", po->in->pck_seq_num));
-	*pck_size = po->in->size;
-	t = po->in;
-	po->in = po->in->next;
-	//no other output. reset the head seqnum
-	po->head_seqnum = po->in ? po->in->pck_seq_num : 0;
-	po->Count -= 1;
-	//release the item
-	ret = t->pck;
-	gf_free(t);
-	return ret;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_RTP, ("[rtp] Packet Reorderer: Fetching %d\n", po->head_seqnum & 0xFFFF));
+	slot->state = GF_PO_SLOT_OUTPUT;
+	po->Count--;
+	po->head_seqnum++;
+	po->LastTime = 0;
+	po->IsInit = 2;
+	*pck_size = slot->size;
+	return slot->pck;
 }
 
 GF_Err gf_rtp_set_interleave_callbacks(GF_RTPChannel *ch, gf_rtp_tcp_callback RTP_TCPCallback, void *cbk1, void *cbk2)
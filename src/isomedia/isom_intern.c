@@ -187,6 +187,132 @@ static void FixSDTPInTRAF(GF_MovieFragmentBox *moof)
 	}
 }
 
+/*records the start time and SAP status of a moof, so that seeking without sidx can locate it
+moof_offset is the position in the data being parsed, the index is kept sorted by file offset*/
+static GF_FragmentIndexEntry *FragmentIndexAdd(GF_ISOFile *mov, GF_MovieFragmentBox *moof, u64 moof_offset)
+{
+	u32 i, lo, hi;
+	Double start_time = 0;
+	Bool is_sap = GF_TRUE;
+	GF_TrackFragmentBox *traf;
+	GF_FragmentIndexEntry *ent;
+
+	if (mov->frag_index_frozen || mov->bytes_removed) return NULL;
+	moof_offset += mov->frag_index_base;
+
+	//incomplete files may get the same moofs parsed again, and fragments may have been scanned ahead of parsing
+	lo = 0;
+	hi = mov->frag_index_count;
+	if (hi && (mov->frag_index[hi-1].moof_offset < moof_offset)) {
+		lo = hi;
+	} else {
+		while (lo < hi) {
+			u32 mid = (lo + hi) / 2;
+			if (mov->frag_index[mid].moof_offset < moof_offset) lo = mid + 1;
+			else hi = mid;
+		}
+		if ((lo < mov->frag_index_count) && (mov->frag_index[lo].moof_offset == moof_offset))
+			return NULL;
+	}
+
+	i=0;
+	while ((traf = (GF_TrackFragmentBox*)gf_list_enum(moof->TrackList, &i))) {
+		u32 flags;
+		Double t;
+		GF_TrackBox *trak;
+		GF_TrackExtendsBox *trex;
+		GF_TrackFragmentRunBox *trun = (GF_TrackFragmentRunBox*)gf_list_get(traf->TrackRuns, 0);
+		if (!trun || !trun->nb_samples) continue;
+		//without decode time, timing is lost when restarting parsing at this fragment
+		if (!traf->tfhd || !traf->tfdt) return NULL;
+		trex = traf->trex ? traf->trex : GetTrex(mov->moov, traf->tfhd->trackID);
+		trak = gf_isom_get_track_from_id(mov->moov, traf->tfhd->trackID);
+		if (!trex || !trak || !trak->Media->mediaHeader->timeScale) return NULL;
+
+		t = (Double) traf->tfdt->baseMediaDecodeTime;
+		t /= trak->Media->mediaHeader->timeScale;
+		if (t > start_time) start_time = t;
+
+		if (trun->flags & GF_ISOM_TRUN_FIRST_FLAG) flags = trun->first_sample_flags;
+		else if (trun->flags & GF_ISOM_TRUN_FLAGS) flags = trun->samples[0].flags;
+		else if (traf->tfhd->flags & GF_ISOM_TRAF_SAMPLE_FLAGS) flags = traf->tfhd->def_sample_flags;
+		else flags = trex->def_sample_flags;
+
+		if (!GF_ISOM_GET_FRAG_SYNC(flags)) is_sap = GF_FALSE;
+	}
+
+	if (mov->frag_index_count == mov->frag_index_alloc) {
+		u32 new_alloc = mov->frag_index_alloc ? 2*mov->frag_index_alloc : 64;
+		GF_FragmentIndexEntry *new_index = gf_realloc(mov->frag_index, sizeof(GF_FragmentIndexEntry) * new_alloc);
+		//keep the current index, this fragment is not indexed
+		if (!new_index) return NULL;
+		mov->frag_index = new_index;
+		mov->frag_index_alloc = new_alloc;
+	}
+	if (lo < mov->frag_index_count)
+		memmove(&mov->frag_index[lo+1], &mov->frag_index[lo], sizeof(GF_FragmentIndexEntry) * (mov->frag_index_count - lo));
+	mov->frag_index_count++;
+	ent = &mov->frag_index[lo];
+	ent->moof_offset = moof_offset;
+	ent->start_time = start_time;
+	ent->is_sap = is_sap;
+	return ent;
+}
+
+void gf_isom_fragment_index_scan(GF_ISOFile *mov, Double start_time)
+{
+	u64 pos, file_size, prev_pos;
+	GF_BitStream *bs;
+
+	if (mov->frag_index_frozen || mov->bytes_removed) return;
+	if (!mov->moov || !mov->moov->mvex || !mov->movieFileMap || !mov->movieFileMap->bs) return;
+	bs = mov->movieFileMap->bs;
+	prev_pos = gf_bs_get_position(bs);
+	file_size = gf_bs_get_refreshed_size(bs);
+
+	//boxes before the one being parsed are already indexed, positions are in the data being parsed
+	pos = (mov->frag_index_scan_pos > mov->frag_index_base) ? mov->frag_index_scan_pos - mov->frag_index_base : 0;
+	if (pos < mov->current_top_box_start) pos = mov->current_top_box_start;
+
+	while (pos + 8 <= file_size) {
+		u64 size;
+		u32 type;
+		gf_bs_seek(bs, pos);
+		size = gf_bs_read_u32(bs);
+		type = gf_bs_read_u32(bs);
+		if (size == 1) {
+			if (pos + 16 > file_size) break;
+			size = gf_bs_read_u64(bs);
+		}
+		//box extending to the end of the file, or invalid size
+		if (size < 8) break;
+
+		//only moof boxes are loaded, media data and other boxes are skipped
+		if (type == GF_ISOM_BOX_TYPE_MOOF) {
+			GF_Err e;
+			GF_Box *a = NULL;
+			GF_FragmentIndexEntry *ent;
+			if (pos + size > file_size) break;
+			gf_bs_seek(bs, pos);
+			e = gf_isom_box_parse(&a, bs);
+			if (e || !a) {
+				if (a) gf_isom_box_del(a);
+				break;
+			}
+			ent = FragmentIndexAdd(mov, (GF_MovieFragmentBox *)a, pos);
+			gf_isom_box_del(a);
+
+			if (ent && ent->is_sap && (ent->start_time > start_time)) {
+				pos += size;
+				break;
+			}
+		}
+		pos += size;
+	}
+	mov->frag_index_scan_pos = mov->frag_index_base + pos;
+	gf_bs_seek(bs, prev_pos);
+}
+
 void gf_isom_push_mdat_end(GF_ISOFile *mov, u64 mdat_end)
 {
 	u32 i, count = gf_list_count(mov->moov->trackList);
@@ -237,6 +363,8 @@ GF_Err gf_isom_parse_movie_boxes(GF_ISOFile *mov, u32 *boxType, u64 *bytesMissin
 	if (mov->single_moof_mode && mov->single_moof_state == 2) {
 		return e;
 	}
+	//a seek offset is only used as fragment index base if the data offset is reset before parsing
+	mov->frag_index_seek_pending = GF_FALSE;
 
 	/*restart from where we stopped last*/
 	totSize = mov->current_top_box_start;
@@ -523,6 +651,7 @@ GF_Err gf_isom_parse_movie_boxes(GF_ISOFile *mov, u32 *boxType, u64 *bytesMissin
 			} else {
 				/*merge all info*/
 				e = MergeFragment((GF_MovieFragmentBox *)a, mov);
+				if (!e) FragmentIndexAdd(mov, (GF_MovieFragmentBox *)a, mov->current_top_box_start);
 				gf_isom_box_del(a);
 				if (e) return e;
 			}
@@ -814,6 +943,8 @@ void gf_isom_delete_movie(GF_ISOFile *mov)
 
 	if (mov->main_sidx)
 		gf_isom_box_del((GF_Box*)mov->main_sidx);
+	if (mov->frag_index)
+		gf_free(mov->frag_index);
 
 	if (mov->block_buffer)
 		gf_free(mov->block_buffer);
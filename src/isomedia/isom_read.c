@@ -2877,6 +2877,16 @@ GF_Err gf_isom_reset_data_offset(GF_ISOFile *movie, u64 *top_box_start)
 	if (top_box_start) *top_box_start = movie->current_top_box_start;
 	movie->current_top_box_start = 0;
 	movie->NextMoofNumber = 0;
+	//after a seek in the source, data starts at the returned fragment, otherwise file offsets of fragments are no longer known
+	if (movie->frag_index_seek_pending) {
+		movie->frag_index_base = movie->frag_index_seek_offset;
+		movie->frag_index_seek_pending = GF_FALSE;
+	} else {
+		movie->frag_index_frozen = GF_TRUE;
+		if (movie->frag_index) gf_free(movie->frag_index);
+		movie->frag_index = NULL;
+		movie->frag_index_count = movie->frag_index_alloc = 0;
+	}
 	if (movie->moov->mvex && movie->single_moof_mode) {
 		movie->single_moof_state = 0;
 	}
@@ -3190,6 +3200,7 @@ GF_Err gf_isom_open_segment(GF_ISOFile *movie, const char *fileName, u64 start_r
 	GF_DataMap *orig_file_map = NULL;
 	if (!movie || !movie->moov || !movie->moov->mvex) return GF_BAD_PARAM;
 	if (movie->openMode != GF_ISOM_OPEN_READ) return GF_BAD_PARAM;
+	movie->frag_index_frozen = GF_TRUE;
 
 	/*this is a scalable segment - use a temp data map for the associated track(s) but do NOT touch the movie file map*/
 	if (is_scalable_segment) {
@@ -5030,7 +5041,30 @@ GF_Err gf_isom_get_file_offset_for_time(GF_ISOFile *movie, Double start_time, u6
 	if (!movie || !movie->moov)
 		return GF_BAD_PARAM;
 
-	if (!movie->main_sidx) return GF_NOT_SUPPORTED;
+	if (!movie->main_sidx) {
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+		//use the last fragment starting with a SAP before the requested time
+		Bool found = GF_FALSE;
+		//fragments available after the parsed ones are indexed on demand from their moof
+		if (!movie->frag_index_count || (movie->frag_index[movie->frag_index_count-1].start_time <= start_time))
+			gf_isom_fragment_index_scan(movie, start_time);
+
+		for (i=0; i<movie->frag_index_count; i++) {
+			GF_FragmentIndexEntry *ent = &movie->frag_index[i];
+			if (!ent->is_sap) continue;
+			if (found && (ent->start_time > start_time)) break;
+			offset = ent->moof_offset;
+			found = GF_TRUE;
+		}
+		if (found) {
+			*max_offset = offset;
+			movie->frag_index_seek_offset = offset;
+			movie->frag_index_seek_pending = GF_TRUE;
+			return GF_OK;
+		}
+#endif
+		return GF_NOT_SUPPORTED;
+	}
 	start_ts = (u64) (start_time * movie->main_sidx->timescale);
 	cur_start_time = 0;
 	offset = movie->main_sidx->first_offset + movie->main_sidx_end_pos;
@@ -34,6 +34,10 @@
 #define GF_ATSC_MCAST_ADDR	"224.0.23.60"
 #define GF_ATSC_MCAST_PORT	4937
 #define GF_ATSC_SOCK_SIZE	0x80000
+//max number of datagrams read from a single socket per process call
+#define GF_ATSC_MAX_PCK_PER_SOCK	50
+//max number of LCT objects kept for reuse in the object reservoir
+#define GF_ATSC_MAX_RESERVOIR	20
 
 typedef struct
 {
@@ -144,6 +148,7 @@ struct __gf_atscdmx {
 	GF_List *services;
 
 	GF_List *object_reservoir;
+	u32 max_reservoir;
 	GF_BitStream *bs;
 
 	GF_DOMParser *dom;
@@ -314,6 +319,7 @@ GF_ATSCDmx *gf_atsc3_dmx_new(const char *ifce, const char *dir, u32 sock_buffer_
 	atscd->bs = gf_bs_new((char*)&e, 1, GF_BITSTREAM_READ);
 
 	atscd->reorder_timeout = 5000;
+	atscd->max_reservoir = GF_ATSC_MAX_RESERVOIR;
 	return atscd;
 }
 
@@ -454,7 +460,8 @@ static GF_Err gf_atsc3_dmx_process_slt(GF_ATSCDmx *atscd, GF_XMLNode *root)
 				continue;
 			}
 			gf_sk_set_buffer_size(service->sock, GF_FALSE, atscd->unz_buffer_size);
-			//gf_sk_set_block_mode(service->sock, GF_TRUE);
+			//non-blocking so that we can drain the socket after select
+			gf_sk_set_block_mode(service->sock, GF_TRUE);
 
 			service->dst_ip = gf_strdup(dst_ip);
 			service->port = dst_port;
@@ -549,6 +556,21 @@ static void gf_atsc3_obj_to_reservoir(GF_ATSCDmx *atscd, GF_ATSCService *s, GF_L
 	obj->last_gather_time = 0;
 	obj->status = GF_LCT_OBJ_INIT;
 	gf_list_del_item(s->objects, obj);
+	//reservoir is full, trash the object with the smallest payload
+	if (atscd->max_reservoir && (gf_list_count(atscd->object_reservoir) >= atscd->max_reservoir)) {
+		u32 i, count = gf_list_count(atscd->object_reservoir);
+		GF_LCTObject *smallest = obj;
+		for (i=0; i<count; i++) {
+			GF_LCTObject *o = gf_list_get(atscd->object_reservoir, i);
+			if (o->alloc_size < smallest->alloc_size) smallest = o;
+		}
+		if (smallest != obj) {
+			gf_list_del_item(atscd->object_reservoir, smallest);
+			gf_list_add(atscd->object_reservoir, obj);
+		}
+		gf_atsc3_lct_obj_del(smallest);
+		return;
+	}
 	gf_list_add(atscd->object_reservoir, obj);
 
 }
@@ -743,6 +765,28 @@ static GF_Err gf_atsc3_service_flush_object(GF_ATSCService *s, GF_LCTObject *obj
 	return GF_EOS;
 }
 
+//get an object from the reservoir, using the smallest payload buffer large enough to hold the object if total size is known
+static GF_LCTObject *gf_atsc3_get_reservoir_object(GF_ATSCDmx *atscd, u32 total_len)
+{
+	u32 i, count = gf_list_count(atscd->object_reservoir);
+	GF_LCTObject *best = NULL;
+	if (!count) return NULL;
+	if (!total_len) return gf_list_pop_back(atscd->object_reservoir);
+
+	for (i=0; i<count; i++) {
+		GF_LCTObject *o = gf_list_get(atscd->object_reservoir, i);
+		if (o->alloc_size < total_len) continue;
+		if (!best || (o->alloc_size < best->alloc_size)) {
+			best = o;
+			if (best->alloc_size == total_len) break;
+		}
+	}
+	//none large enough, pick the last one and let it realloc
+	if (!best) return gf_list_pop_back(atscd->object_reservoir);
+	gf_list_del_item(atscd->object_reservoir, best);
+	return best;
+}
+
 static GF_Err gf_atsc3_service_gather_object(GF_ATSCDmx *atscd, GF_ATSCService *s, u32 tsi, u32 toi, u32 start_offset, char *data, u32 size, u32 total_len, Bool close_flag, Bool in_order, GF_ATSCLCTChannel *rlct, GF_LCTObject **gather_obj)
 {
 	Bool inserted, done;
@@ -784,7 +828,7 @@ static GF_Err gf_atsc3_service_gather_object(GF_ATSCDmx *atscd, GF_ATSCService *
 		}
 	}
 	if (!obj) {
-		obj = gf_list_pop_back(atscd->object_reservoir);
+		obj = gf_atsc3_get_reservoir_object(atscd, total_len);
 		if (!obj) {
 			GF_SAFEALLOC(obj, GF_LCTObject);
 			if (!obj) {
@@ -1103,7 +1147,8 @@ static GF_Err gf_atsc3_service_setup_stsid(GF_ATSCDmx *atscd, GF_ATSCService *s,
 				return e;
 			}
 			gf_sk_set_buffer_size(rsess->sock, GF_FALSE, atscd->unz_buffer_size);
-			//gf_sk_set_block_mode(rsess->sock, GF_TRUE);
+			//non-blocking so that we can drain the socket after select
+			gf_sk_set_block_mode(rsess->sock, GF_TRUE);
 			s->secondary_sockets++;
 			if (s->tune_mode == GF_ATSC_TUNE_ON) gf_sk_group_register(atscd->active_sockets, rsess->sock);
 		}
@@ -1710,6 +1755,21 @@ static GF_Err gf_atsc3_dmx_process_lls(GF_ATSCDmx *atscd)
 	return GF_OK;
 }
 
+//read as many datagrams as available on a ready socket, up to GF_ATSC_MAX_PCK_PER_SOCK, to avoid one select per packet
+static GF_Err gf_atsc3_dmx_drain_socket(GF_ATSCDmx *atscd, GF_ATSCService *s, GF_ATSCRouteSession *route_sess)
+{
+	u32 nb_pck = 0;
+	while (nb_pck < GF_ATSC_MAX_PCK_PER_SOCK) {
+		GF_Err e = gf_atsc3_dmx_process_service(atscd, s, route_sess);
+		//socket drained
+		if ((e==GF_IP_NETWORK_EMPTY) || (e==GF_IP_SOCK_WOULD_BLOCK))
+			break;
+		if (e) return e;
+		nb_pck++;
+	}
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_atsc3_dmx_process(GF_ATSCDmx *atscd)
 {
@@ -1733,7 +1793,7 @@ GF_Err gf_atsc3_dmx_process(GF_ATSCDmx *atscd)
 		if (s->tune_mode==GF_ATSC_TUNE_OFF) continue;
 
 		if (gf_sk_group_sock_is_set(atscd->active_sockets, s->sock, GF_SK_SELECT_READ)) {
-			e = gf_atsc3_dmx_process_service(atscd, s, NULL);
+			e = gf_atsc3_dmx_drain_socket(atscd, s, NULL);
 			if (e) return e;
 		}
 		if (s->tune_mode!=GF_ATSC_TUNE_ON) continue;
@@ -1742,7 +1802,7 @@ GF_Err gf_atsc3_dmx_process(GF_ATSCDmx *atscd)
 		j=0;
 		while ((rsess = (GF_ATSCRouteSession *)gf_list_enum(s->route_sessions, &j) )) {
 			if (gf_sk_group_sock_is_set(atscd->active_sockets, rsess->sock, GF_SK_SELECT_READ)) {
-				e = gf_atsc3_dmx_process_service(atscd, s, rsess);
+				e = gf_atsc3_dmx_drain_socket(atscd, s, rsess);
 				if (e) return e;
 			}
 		}
@@ -4981,6 +4981,32 @@ u32 gf_media_nalu_remove_emulation_bytes(const u8 *buffer_src, u8 *buffer_dst, u
 	return nal_size - emulation_bytes_count;
 }
 
+void gf_media_nalu_copy_rbsp_end(GF_BitStream *bs_in, GF_BitStream *bs_out)
+{
+	//the NAL size includes the removed bytes, so copy until no more bytes are available rather than using the NAL size
+	u32 val, nb_bits = gf_bs_get_bit_offset(bs_in) % 8;
+	if (nb_bits) {
+		nb_bits = 8 - nb_bits;
+		val = gf_bs_read_int(bs_in, nb_bits);
+	} else {
+		nb_bits = gf_bs_available(bs_in) ? 8 : 0;
+		val = gf_bs_read_int(bs_in, nb_bits);
+	}
+	while (gf_bs_available(bs_in)) {
+		gf_bs_write_int(bs_out, val, nb_bits);
+		val = gf_bs_read_int(bs_in, 8);
+		nb_bits = 8;
+	}
+	//last byte: strip alignment zero bits and rbsp_stop_one_bit
+	while (nb_bits && !(val & 1)) {
+		val >>= 1;
+		nb_bits--;
+	}
+	if (nb_bits>1) gf_bs_write_int(bs_out, val>>1, nb_bits-1);
+	//rbsp_stop_one_bit
+	gf_bs_write_int(bs_out, 1, 1);
+}
+
 static s32 gf_media_avc_read_sps_bs_internal(GF_BitStream *bs, AVCState *avc, u32 subseq_sps, u32 *vui_flag_pos, u32 nal_hdr)
 {
 	AVC_SPS *sps;
@@ -208,13 +208,16 @@ GF_Err gf_media_remove_non_rap(GF_ISOFile *file, u32 track, Bool non_ref_only)
 
 #endif /*GPAC_DISABLE_ISOM_WRITE*/
 
+//read size used when hashing files, large reads avoid I/O call overhead
+#define HASH_BLOCK_SIZE	65536
+
 GF_EXPORT
 GF_Err gf_media_get_file_hash(const char *file, u8 hash[20])
 {
 #ifdef GPAC_DISABLE_CORE_TOOLS
 	return GF_NOT_SUPPORTED;
 #else
-	u8 block[4096];
+	u8 *block;
 	u32 read;
 	u64 size, tot;
 	FILE *in;
@@ -229,7 +232,14 @@ GF_Err gf_media_get_file_hash(const char *file, u8 hash[20])
     if (!in) return GF_URL_ERROR;
 	size = gf_fsize(in);
 
+	block = gf_malloc(HASH_BLOCK_SIZE);
 	ctx = gf_sha1_starts();
+	if (!block || !ctx) {
+		if (block) gf_free(block);
+		if (ctx) gf_free(ctx);
+		gf_fclose(in);
+		return GF_OUT_OF_MEM;
+	}
 	tot = 0;
 #ifndef GPAC_DISABLE_ISOM
 	if (is_isom) bs = gf_bs_from_file(in, GF_BITSTREAM_READ);
@@ -253,7 +263,7 @@ GF_Err gf_media_get_file_hash(const char *file, u8 hash[20])
 			} else {
 				u64 bsize = 0;
 				while (bsize<box_size) {
-					u32 to_read = (u32) ((box_size-bsize<4096) ? (box_size-bsize) : 4096);
+					u32 to_read = (u32) ((box_size-bsize<HASH_BLOCK_SIZE) ? (box_size-bsize) : HASH_BLOCK_SIZE);
 					read = gf_bs_read_data(bs, (char *) block, to_read);
 					if (!read || (read != to_read) ) {
 						GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("corrupted isobmf file, box read "LLU" but expected still "LLU" bytes\n", bsize, box_size));
@@ -267,7 +277,7 @@ GF_Err gf_media_get_file_hash(const char *file, u8 hash[20])
 		} else
 #endif
 		{
-			read = (u32) gf_fread(block, 4096, in);
+			read = (u32) gf_fread(block, HASH_BLOCK_SIZE, in);
 			if ((s32) read <= 0) {
 				if (ferror(in))
 					e = GF_IO_ERR;
@@ -278,6 +288,7 @@ GF_Err gf_media_get_file_hash(const char *file, u8 hash[20])
 		}
 	}
 	gf_sha1_finish(ctx, hash);
+	gf_free(block);
 #ifndef GPAC_DISABLE_ISOM
 	if (bs) gf_bs_del(bs);
 #endif
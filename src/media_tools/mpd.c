@@ -698,6 +698,7 @@ static void gf_mpd_init_common_attributes(GF_MPD_CommonAttributes *com)
 	com->max_playout_rate = 1.0;
 }
 
+GF_EXPORT
 GF_MPD_Representation *gf_mpd_representation_new()
 {
 	GF_MPD_Representation *rep;
@@ -788,6 +789,8 @@ static GF_List *gf_mpd_parse_segments_context(GF_MPD *mpd, GF_XMLNode *root)
 			else if (!strcmp(att->name, "seg_num")) sctx->seg_num = gf_mpd_parse_int(att->value);
 
 		}
+		//reloaded segments are complete, LL-HLS parts are not stored
+		sctx->llhls_done = GF_TRUE;
 	}
 	return res;
 }
@@ -854,6 +857,7 @@ static GF_Err gf_mpd_parse_representation(GF_MPD *mpd, GF_List *container, GF_XM
 	return GF_OK;
 }
 
+GF_EXPORT
 GF_MPD_AdaptationSet *gf_mpd_adaptation_set_new() {
 	GF_MPD_AdaptationSet *set;
 	GF_SAFEALLOC(set, GF_MPD_AdaptationSet);
@@ -966,6 +970,7 @@ static GF_Err gf_mpd_parse_adaptation_set(GF_MPD *mpd, GF_List *container, GF_XM
 	return GF_OK;
 }
 
+GF_EXPORT
 GF_MPD_Period *gf_mpd_period_new() {
 	GF_MPD_Period *period;
 	GF_SAFEALLOC(period, GF_MPD_Period);
@@ -1273,6 +1278,7 @@ void gf_mpd_representation_free(void *_item)
 			GF_DASH_SegmentContext *s = gf_list_pop_back(ptr->state_seg_list);
 			if (s->filename) gf_free(s->filename);
 			if (s->filepath) gf_free(s->filepath);
+			if (s->frags) gf_free(s->frags);
 			gf_free(s);
 		}
 		gf_list_del(ptr->state_seg_list);
@@ -2397,16 +2403,18 @@ void gf_mpd_delete_segment_list(GF_MPD_SegmentList *segment_list)
 
 static GFINLINE void gf_mpd_lf(FILE *out, s32 indent)
 {
-	if (indent>=0) gf_fprintf(out, "\n");
+	if (indent>=0) gf_fputc('\n', out);
 }
 static GFINLINE void gf_mpd_nl(FILE *out, s32 indent)
 {
-	if (indent>=0) {
+	static const char *spaces = "                ";
+	if (indent>0) {
 		u32 i=(u32)indent;
-		while (i) {
-			gf_fprintf(out, " ");
-			i--;
+		while (i>16) {
+			gf_fwrite(spaces, 16, out);
+			i-=16;
 		}
+		gf_fwrite(spaces, i, out);
 	}
 }
 
@@ -2526,17 +2534,22 @@ static void gf_mpd_print_segment_timeline(FILE *out, GF_MPD_SegmentTimeline *tl,
 
 	i = 0;
 	while ( (se = gf_list_enum(tl->entries, &i))) {
-		gf_mpd_nl(out, indent+1);
-		gf_fprintf(out, "<S");
+		//timelines can be large in live, format each entry in a single call
+		char szEntry[100];
+		u32 len = 2;
+		strcpy(szEntry, "<S");
 		if (!start_time || (se->start_time != start_time)) {
-			gf_fprintf(out, " t=\""LLD"\"", se->start_time);
+			len += sprintf(szEntry+len, " t=\""LLD"\"", se->start_time);
 			start_time = se->start_time;
 		}
 		start_time += (se->repeat_count+1) * se->duration;
 
-		if (se->duration) gf_fprintf(out, " d=\"%d\"", se->duration);
-		if (se->repeat_count) gf_fprintf(out, " r=\"%d\"", se->repeat_count);
-		gf_fprintf(out, "/>");
+		if (se->duration) len += sprintf(szEntry+len, " d=\"%d\"", se->duration);
+		if (se->repeat_count) len += sprintf(szEntry+len, " r=\"%d\"", se->repeat_count);
+		strcpy(szEntry+len, "/>");
+		len += 2;
+		gf_mpd_nl(out, indent+1);
+		gf_fwrite(szEntry, len, out);
 		gf_mpd_lf(out, indent);
 	}
 	gf_mpd_nl(out, indent);
@@ -2544,6 +2557,7 @@ static void gf_mpd_print_segment_timeline(FILE *out, GF_MPD_SegmentTimeline *tl,
 	gf_mpd_lf(out, indent);
 }
 
+GF_EXPORT
 GF_MPD_SegmentTimeline *gf_mpd_segmentimeline_new(void)
 {
 	GF_MPD_SegmentTimeline *seg_tl;
@@ -3304,10 +3318,11 @@ static const char *gf_mpd_m3u8_get_init_seg(const GF_MPD_Period *period, const G
 
 static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period *period, const GF_MPD_AdaptationSet *as, GF_MPD_Representation *rep, char *m3u8_name, u32 hls_version)
 {
-	u32 i, count;
+	u32 i, j, count;
 	GF_DASH_SegmentContext *sctx;
 	FILE *out;
 	Bool close_file = GF_FALSE;
+	Bool llhls = (mpd->llhls_part_dur>0) ? GF_TRUE : GF_FALSE;
 
 	if (!strcmp(m3u8_name, "std")) out = stdout;
 	else if (mpd->create_m3u8_files) {
@@ -3315,9 +3330,13 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 		if (!out) return GF_IO_ERR;
 		close_file = GF_TRUE;
 	} else {
-		out = gf_file_temp(NULL);
-		if (rep->m3u8_var_file) gf_fclose(rep->m3u8_var_file);
-		rep->m3u8_var_file = out;
+		//render in memory, reusing the buffer of the previous update
+		if (!rep->m3u8_var_file) {
+			rep->m3u8_var_file = gf_file_temp_mem();
+			if (!rep->m3u8_var_file) return GF_OUT_OF_MEM;
+		}
+		out = rep->m3u8_var_file;
+		gf_file_temp_mem_reset(out);
 	}
 
 	count = gf_list_count(rep->state_seg_list);
@@ -3327,6 +3346,12 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 	gf_fprintf(out,"#EXT-X-TARGETDURATION:%d\n",(u32) (rep->dash_dur) );
 	gf_fprintf(out,"#EXT-X-VERSION:%d\n", hls_version);
 	gf_fprintf(out,"#EXT-X-MEDIA-SEQUENCE:%d\n", sctx->seg_num);
+	if (llhls && sctx->filename) {
+		gf_fprintf(out,"#EXT-X-SERVER-CONTROL:CAN-BLOCK-RELOAD=YES,PART-HOLD-BACK=%g\n", 3*mpd->llhls_part_dur);
+		gf_fprintf(out,"#EXT-X-PART-INF:PART-TARGET=%g\n", mpd->llhls_part_dur);
+	} else {
+		llhls = GF_FALSE;
+	}
 
 	if (as->starts_with_sap<SAP_TYPE_3)
 		gf_fprintf(out,"#EXT-X-INDEPENDENT-SEGMENTS\n");
@@ -3340,18 +3365,63 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 	}
 
 	if (sctx->filename) {
+		u64 last_dur = 0;
+		char szExtInf[100];
+		u32 first_part_seg = 0;
+		GF_DASH_SegmentContext *in_progress = NULL;
 		if (rep->hls_single_file_name) {
 			gf_fprintf(out,"#EXT-X-MAP:URI=\"%s\"\n", rep->hls_single_file_name);
 		}
+
+		//parts are only listed for the segments in the last three target durations
+		if (llhls) {
+			u64 acc_dur = 0;
+			u64 part_window = (u64) (3 * rep->dash_dur * rep->timescale);
+			first_part_seg = count;
+			while (first_part_seg && (acc_dur < part_window)) {
+				first_part_seg--;
+				sctx = gf_list_get(rep->state_seg_list, first_part_seg);
+				if (sctx->llhls_done) {
+					acc_dur += sctx->dur;
+				} else {
+					for (j=0; j<sctx->nb_frags; j++)
+						acc_dur += sctx->frags[j].dur;
+				}
+			}
+		}
 		for (i=0; i<count; i++) {
-			Double dur;
 			sctx = gf_list_get(rep->state_seg_list, i);
 			assert(sctx->filename);
-			
-			dur = (Double) sctx->dur;
-			dur /= rep->timescale;
-			gf_fprintf(out,"#EXTINF:%g,\n", dur);
-			gf_fprintf(out,"%s\n", sctx->filename);
+
+			if (llhls && (i>=first_part_seg)) {
+				for (j=0; j<sctx->nb_frags; j++) {
+					GF_DASH_FragmentContext *frag = &sctx->frags[j];
+					Double dur = (Double) frag->dur;
+					dur /= rep->timescale;
+					gf_fprintf(out, "#EXT-X-PART:DURATION=%g,URI=\"%s\",BYTERANGE=\"%d@"LLU"\"%s\n", dur, sctx->filename, frag->size, frag->offset, frag->independent ? ",INDEPENDENT=YES" : "");
+				}
+			}
+			//segment being produced, only its parts are listed
+			if (llhls && !sctx->llhls_done) {
+				in_progress = sctx;
+				break;
+			}
+
+			//segment durations are mostly constant, only format the tag when it changes
+			if (!i || (sctx->dur != last_dur)) {
+				Double dur = (Double) sctx->dur;
+				dur /= rep->timescale;
+				snprintf(szExtInf, 100, "#EXTINF:%g,\n", dur);
+				last_dur = sctx->dur;
+			}
+			gf_fputs(szExtInf, out);
+			gf_fputs(sctx->filename, out);
+			gf_fputc('\n', out);
+		}
+		//hint the next part of the segment being produced, clients can request it before it is complete
+		if (in_progress && in_progress->nb_frags) {
+			GF_DASH_FragmentContext *frag = &in_progress->frags[in_progress->nb_frags-1];
+			gf_fprintf(out, "#EXT-X-PRELOAD-HINT:TYPE=PART,URI=\"%s\",BYTERANGE-START="LLU"\n", in_progress->filename, frag->offset + frag->size);
 		}
 	} else {
 		GF_MPD_BaseURL *base_url=NULL;
@@ -3384,9 +3454,7 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 
 			dur = (Double) sctx->dur;
 			dur /= rep->timescale;
-			gf_fprintf(out,"#EXTINF:%g\n", dur);
-			gf_fprintf(out,"#EXT-X-BYTERANGE:%d@"LLU"\n", sctx->file_size, sctx->file_offset);
-			gf_fprintf(out,"%s\n", base_url->URL);
+			gf_fprintf(out,"#EXTINF:%g\n#EXT-X-BYTERANGE:%d@"LLU"\n%s\n", dur, sctx->file_size, sctx->file_offset, base_url->URL);
 		}
 	}
 
@@ -3400,6 +3468,7 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 }
 
 
+GF_EXPORT
 GF_Err gf_mpd_write_m3u8_master_playlist(GF_MPD const * const mpd, FILE *out, const char* m3u8_name, GF_MPD_Period *period)
 {
 	u32 i, j, hls_version;
@@ -3597,6 +3666,7 @@ GF_Err gf_mpd_write_m3u8_file(GF_MPD *mpd, const char *file_name, GF_MPD_Period
 }
 #endif
 
+GF_EXPORT
 GF_Err gf_mpd_write(GF_MPD const * const mpd, FILE *out, Bool compact)
 {
 	u32 i, count;
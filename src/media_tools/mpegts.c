@@ -601,6 +601,13 @@ static void gf_m2ts_section_complete(GF_M2TS_Demuxer *ts, GF_M2TS_SectionFilter
 
 			}
 
+			//PAT, CAT and PMT updates may reconfigure or destroy streams, process pending PES packets first
+			if (ts->workers && ((table_id==GF_M2TS_TABLE_ID_PAT) || (table_id==GF_M2TS_TABLE_ID_CAT) || (table_id==GF_M2TS_TABLE_ID_PMT))
+				&& (!(status & GF_M2TS_TABLE_REPEAT) || (status & GF_M2TS_TABLE_UPDATE))
+			) {
+				gf_m2ts_demux_dispatch(ts);
+			}
+
 			if (sec->process_individual) {
 				/*send each section of the table and not the aggregated table*/
 				if (sec->process_section)
@@ -2104,7 +2111,422 @@ void gf_m2ts_flush_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes)
 	pes->rap = 0;
 }
 
-static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_Header *hdr, unsigned char *data, u32 data_size, GF_M2TS_AdaptationField *paf)
+/*multi-threaded PES reassembly: the routing pass (gf_m2ts_process_packet) queues PES packets per PID to a set of shards,
+each shard being processed by a single thread. Events produced while processing a shard are queued, then dispatched
+by the calling thread in TS packet order*/
+
+#define M2TS_DEFAULT_BATCH	512
+
+/*PES packet queued for a worker*/
+typedef struct
+{
+	GF_M2TS_PES *pes;
+	u32 pck_number;
+	u8 payload_start, adaptation_field, continuity_counter, rap;
+	u32 size;
+	/*program PCR state when the packet was routed*/
+	u64 last_pcr_value, before_last_pcr_value;
+	u32 last_pcr_value_pck_number, before_last_pcr_value_pck_number;
+	u8 data[184];
+} GF_M2TS_RoutedPacket;
+
+typedef struct
+{
+	u32 type;
+	u32 pck_number;
+	/*offset of the event payload in the queue data buffer*/
+	u32 data_offset;
+	union {
+		GF_M2TS_PES_PCK pes;
+		GF_M2TS_SL_PCK sl;
+		GF_M2TS_TemiTimecodeDescriptor temi;
+	} par;
+} GF_M2TS_QueuedEvent;
+
+typedef struct
+{
+	GF_M2TS_QueuedEvent *evts;
+	u32 nb_evts, alloc_evts;
+	u8 *data;
+	u32 data_size, data_alloc;
+	/*read position when dispatching*/
+	u32 pos;
+} GF_M2TS_EventQueue;
+
+typedef struct
+{
+	struct __m2ts_dmx_workers *pool;
+	GF_Thread *th;
+	GF_Semaphore *run;
+	GF_M2TS_RoutedPacket *pcks;
+	u32 nb_pcks;
+	GF_M2TS_EventQueue queue;
+	/*number of the TS packet being processed*/
+	u32 pck_number;
+	/*bytes assigned when balancing PIDs*/
+	u64 load;
+} GF_M2TS_Shard;
+
+struct __m2ts_dmx_workers
+{
+	GF_M2TS_Demuxer *ts;
+	u32 nb_shards, batch_size;
+	GF_M2TS_Shard *shards;
+	GF_Semaphore *done;
+	Bool exit, in_dispatch;
+	/*user callback, replaced while shards are processed*/
+	void (*on_event)(struct tag_m2ts_demux *ts, u32 evt_type, void *par);
+	/*events of the routing pass (PCR) delayed until pending packets are processed*/
+	GF_M2TS_EventQueue router;
+	/*1-based shard index of each PID, 0 if not assigned*/
+	u8 pid_shard[GF_M2TS_MAX_STREAMS];
+	/*last continuity counter routed for each PID*/
+	s8 pid_cc[GF_M2TS_MAX_STREAMS];
+	/*bytes routed for each PID since last balancing*/
+	u32 pid_bytes[GF_M2TS_MAX_STREAMS];
+	u16 *active_pids;
+};
+
+typedef struct __m2ts_dmx_workers GF_M2TS_Workers;
+
+static GF_Err gf_m2ts_queue_event(GF_M2TS_EventQueue *q, u32 pck_number, u32 evt_type, void *par)
+{
+	GF_M2TS_QueuedEvent *evt;
+	u8 *data = NULL;
+	u32 size = 0;
+
+	if (q->nb_evts == q->alloc_evts) {
+		u32 alloc_evts = q->alloc_evts ? 2*q->alloc_evts : 64;
+		GF_M2TS_QueuedEvent *evts = gf_realloc(q->evts, sizeof(GF_M2TS_QueuedEvent) * alloc_evts);
+		if (!evts) return GF_OUT_OF_MEM;
+		q->evts = evts;
+		q->alloc_evts = alloc_evts;
+	}
+	evt = &q->evts[q->nb_evts];
+	evt->type = evt_type;
+	evt->pck_number = pck_number;
+	switch (evt_type) {
+	case GF_M2TS_EVT_PES_PCK:
+	case GF_M2TS_EVT_PES_PCR:
+		evt->par.pes = *(GF_M2TS_PES_PCK *)par;
+		data = evt->par.pes.data;
+		size = evt->par.pes.data_len;
+		break;
+	case GF_M2TS_EVT_SL_PCK:
+		evt->par.sl = *(GF_M2TS_SL_PCK *)par;
+		data = evt->par.sl.data;
+		size = evt->par.sl.data_len;
+		break;
+	case GF_M2TS_EVT_TEMI_TIMECODE:
+		evt->par.temi = *(GF_M2TS_TemiTimecodeDescriptor *)par;
+		break;
+	default:
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[MPEG-2 TS] Event type %d cannot be sent from PES workers, discarding\n", evt_type));
+		return GF_NOT_SUPPORTED;
+	}
+	evt->data_offset = q->data_size;
+	if (data && size) {
+		if (q->data_size + size > q->data_alloc) {
+			u32 data_alloc = MAX(2*q->data_alloc, q->data_size + size);
+			u8 *new_data = gf_realloc(q->data, data_alloc);
+			if (!new_data) return GF_OUT_OF_MEM;
+			q->data = new_data;
+			q->data_alloc = data_alloc;
+		}
+		memcpy(q->data + q->data_size, data, size);
+		q->data_size += size;
+	}
+	q->nb_evts++;
+	return GF_OK;
+}
+
+static void gf_m2ts_worker_on_event(GF_M2TS_Demuxer *ts, u32 evt_type, void *par)
+{
+	u32 pid;
+	GF_M2TS_Shard *shard;
+	switch (evt_type) {
+	case GF_M2TS_EVT_PES_PCK:
+		pid = ((GF_M2TS_PES_PCK *)par)->stream->pid;
+		break;
+	case GF_M2TS_EVT_SL_PCK:
+		pid = ((GF_M2TS_SL_PCK *)par)->stream->pid;
+		break;
+	case GF_M2TS_EVT_TEMI_TIMECODE:
+		pid = ((GF_M2TS_TemiTimecodeDescriptor *)par)->pid;
+		break;
+	default:
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[MPEG-2 TS] Event type %d cannot be sent from PES workers, discarding\n", evt_type));
+		return;
+	}
+	//PID to shard mapping does not change while shards are processed
+	shard = &ts->workers->shards[ts->workers->pid_shard[pid] - 1];
+	if (gf_m2ts_queue_event(&shard->queue, shard->pck_number, evt_type, par) == GF_OUT_OF_MEM) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[MPEG-2 TS] Out of memory queuing event from PID %d, discarding\n", pid));
+	}
+}
+
+static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_Header *hdr, unsigned char *data, u32 data_size, GF_M2TS_AdaptationField *paf, GF_M2TS_RoutedPacket *rp);
+
+static void gf_m2ts_shard_process(GF_M2TS_Demuxer *ts, GF_M2TS_Shard *shard)
+{
+	u32 i;
+	GF_M2TS_Header hdr;
+	GF_M2TS_AdaptationField af;
+
+	memset(&hdr, 0, sizeof(GF_M2TS_Header));
+	memset(&af, 0, sizeof(GF_M2TS_AdaptationField));
+	for (i=0; i<shard->nb_pcks; i++) {
+		GF_M2TS_RoutedPacket *rp = &shard->pcks[i];
+		hdr.pid = rp->pes->pid;
+		hdr.payload_start = rp->payload_start;
+		hdr.adaptation_field = rp->adaptation_field;
+		hdr.continuity_counter = rp->continuity_counter;
+		af.random_access_indicator = rp->rap;
+		shard->pck_number = rp->pck_number;
+		gf_m2ts_process_pes(ts, rp->pes, &hdr, rp->data, rp->size, &af, rp);
+	}
+}
+
+static u32 gf_m2ts_worker_run(void *par)
+{
+	GF_M2TS_Shard *shard = (GF_M2TS_Shard *)par;
+	GF_M2TS_Workers *pool = shard->pool;
+	while (1) {
+		gf_sema_wait(shard->run);
+		if (pool->exit) break;
+		gf_m2ts_shard_process(pool->ts, shard);
+		gf_sema_notify(pool->done, 1);
+	}
+	return 0;
+}
+
+/*assign PIDs to shards, largest PIDs of the last batches first, each to the least loaded shard*/
+static void gf_m2ts_workers_balance(GF_M2TS_Workers *pool)
+{
+	u32 i, j, nb_pids = 0;
+	for (i=0; i<GF_M2TS_MAX_STREAMS; i++) {
+		if (pool->pid_bytes[i]) pool->active_pids[nb_pids++] = i;
+	}
+	if (!nb_pids) return;
+	memset(pool->pid_shard, 0, sizeof(u8) * GF_M2TS_MAX_STREAMS);
+	for (i=0; i<pool->nb_shards; i++)
+		pool->shards[i].load = 0;
+
+	//insertion sort, we usually have a few tens of active PIDs
+	if (nb_pids <= 256) {
+		for (i=1; i<nb_pids; i++) {
+			u16 pid = pool->active_pids[i];
+			j = i;
+			while (j && (pool->pid_bytes[pool->active_pids[j-1]] < pool->pid_bytes[pid])) {
+				pool->active_pids[j] = pool->active_pids[j-1];
+				j--;
+			}
+			pool->active_pids[j] = pid;
+		}
+	}
+
+	for (i=0; i<nb_pids; i++) {
+		u32 pid = pool->active_pids[i];
+		u32 best = 0;
+		for (j=1; j<pool->nb_shards; j++) {
+			if (pool->shards[j].load < pool->shards[best].load) best = j;
+		}
+		pool->shards[best].load += pool->pid_bytes[pid];
+		pool->pid_shard[pid] = best + 1;
+		pool->pid_bytes[pid] = 0;
+	}
+}
+
+static void gf_m2ts_route_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_Header *hdr, u8 *data, u32 data_size, GF_M2TS_AdaptationField *paf)
+{
+	GF_M2TS_RoutedPacket *rp;
+	GF_M2TS_Shard *shard;
+	GF_M2TS_Workers *pool = ts->workers;
+	u32 idx = pool->pid_shard[pes->pid];
+
+	//new PID, assign to least loaded shard
+	if (!idx) {
+		u32 i;
+		idx = 1;
+		for (i=1; i<pool->nb_shards; i++) {
+			if (pool->shards[i].nb_pcks < pool->shards[idx-1].nb_pcks) idx = i+1;
+		}
+		pool->pid_shard[pes->pid] = idx;
+	}
+	shard = &pool->shards[idx-1];
+	rp = &shard->pcks[shard->nb_pcks];
+	rp->pes = pes;
+	rp->pck_number = ts->pck_number;
+	rp->payload_start = hdr->payload_start;
+	rp->adaptation_field = hdr->adaptation_field;
+	rp->continuity_counter = hdr->continuity_counter;
+	rp->rap = (paf && paf->random_access_indicator) ? 1 : 0;
+	rp->last_pcr_value = pes->program->last_pcr_value;
+	rp->last_pcr_value_pck_number = pes->program->last_pcr_value_pck_number;
+	rp->before_last_pcr_value = pes->program->before_last_pcr_value;
+	rp->before_last_pcr_value_pck_number = pes->program->before_last_pcr_value_pck_number;
+	rp->size = data_size;
+	memcpy(rp->data, data, data_size);
+
+	pool->pid_cc[pes->pid] = hdr->continuity_counter;
+	pool->pid_bytes[pes->pid] += data_size;
+	shard->nb_pcks++;
+	if (shard->nb_pcks == pool->batch_size)
+		gf_m2ts_demux_dispatch(ts);
+}
+
+GF_EXPORT
+void gf_m2ts_demux_dispatch(GF_M2TS_Demuxer *ts)
+{
+	u32 i, nb_pcks=0, nb_run=0, pck_number;
+	GF_M2TS_Workers *pool = ts ? ts->workers : NULL;
+	if (!pool || pool->in_dispatch) return;
+
+	for (i=0; i<pool->nb_shards; i++)
+		nb_pcks += pool->shards[i].nb_pcks;
+	if (!nb_pcks && !pool->router.nb_evts) return;
+
+	pool->in_dispatch = GF_TRUE;
+	if (nb_pcks) {
+		pool->on_event = ts->on_event;
+		ts->on_event = gf_m2ts_worker_on_event;
+		//not worth waking up workers
+		if (nb_pcks < 32) {
+			for (i=0; i<pool->nb_shards; i++)
+				gf_m2ts_shard_process(ts, &pool->shards[i]);
+		} else {
+			for (i=1; i<pool->nb_shards; i++) {
+				if (!pool->shards[i].nb_pcks) continue;
+				gf_sema_notify(pool->shards[i].run, 1);
+				nb_run++;
+			}
+			gf_m2ts_shard_process(ts, &pool->shards[0]);
+			for (i=0; i<nb_run; i++)
+				gf_sema_wait(pool->done);
+		}
+		ts->on_event = pool->on_event;
+		for (i=0; i<pool->nb_shards; i++)
+			pool->shards[i].nb_pcks = 0;
+	}
+
+	//dispatch events in TS packet order, routing pass events first
+	pck_number = ts->pck_number;
+	while (1) {
+		GF_M2TS_QueuedEvent *evt;
+		GF_M2TS_EventQueue *q = NULL;
+		if (pool->router.pos < pool->router.nb_evts)
+			q = &pool->router;
+		for (i=0; i<pool->nb_shards; i++) {
+			GF_M2TS_EventQueue *sq = &pool->shards[i].queue;
+			if (sq->pos == sq->nb_evts) continue;
+			if (!q || (sq->evts[sq->pos].pck_number < q->evts[q->pos].pck_number))
+				q = sq;
+		}
+		if (!q) break;
+		evt = &q->evts[q->pos];
+		q->pos++;
+
+		switch (evt->type) {
+		case GF_M2TS_EVT_PES_PCK:
+		case GF_M2TS_EVT_PES_PCR:
+			if (evt->par.pes.data) evt->par.pes.data = q->data + evt->data_offset;
+			break;
+		case GF_M2TS_EVT_SL_PCK:
+			if (evt->par.sl.data) evt->par.sl.data = q->data + evt->data_offset;
+			break;
+		}
+		ts->pck_number = evt->pck_number;
+		if (ts->on_event) ts->on_event(ts, evt->type, &evt->par);
+	}
+	ts->pck_number = pck_number;
+
+	pool->router.nb_evts = pool->router.data_size = pool->router.pos = 0;
+	for (i=0; i<pool->nb_shards; i++) {
+		GF_M2TS_EventQueue *sq = &pool->shards[i].queue;
+		sq->nb_evts = sq->data_size = sq->pos = 0;
+	}
+	if (nb_pcks)
+		gf_m2ts_workers_balance(pool);
+	pool->in_dispatch = GF_FALSE;
+}
+
+static void gf_m2ts_workers_del(GF_M2TS_Workers *pool)
+{
+	u32 i;
+	pool->exit = GF_TRUE;
+	for (i=0; i<pool->nb_shards; i++) {
+		GF_M2TS_Shard *shard = &pool->shards[i];
+		if (shard->th) {
+			gf_sema_notify(shard->run, 1);
+			gf_th_stop(shard->th);
+			gf_th_del(shard->th);
+		}
+		if (shard->run) gf_sema_del(shard->run);
+		if (shard->pcks) gf_free(shard->pcks);
+		if (shard->queue.evts) gf_free(shard->queue.evts);
+		if (shard->queue.data) gf_free(shard->queue.data);
+	}
+	gf_free(pool->shards);
+	if (pool->router.evts) gf_free(pool->router.evts);
+	if (pool->router.data) gf_free(pool->router.data);
+	if (pool->done) gf_sema_del(pool->done);
+	if (pool->active_pids) gf_free(pool->active_pids);
+	gf_free(pool);
+}
+
+GF_EXPORT
+GF_Err gf_m2ts_demux_set_threads(GF_M2TS_Demuxer *ts, u32 nb_threads, u32 batch_size)
+{
+	u32 i;
+	GF_M2TS_Workers *pool;
+	if (!ts) return GF_BAD_PARAM;
+	if (ts->workers) {
+		gf_m2ts_demux_dispatch(ts);
+		gf_m2ts_workers_del(ts->workers);
+		ts->workers = NULL;
+	}
+	if (nb_threads<=1) return GF_OK;
+	//shard index is stored on 8 bits
+	if (nb_threads>255) nb_threads = 255;
+
+	GF_SAFEALLOC(pool, GF_M2TS_Workers);
+	if (!pool) return GF_OUT_OF_MEM;
+	pool->ts = ts;
+	pool->nb_shards = nb_threads;
+	pool->batch_size = batch_size ? batch_size : M2TS_DEFAULT_BATCH;
+	memset(pool->pid_cc, 0xFF, sizeof(s8) * GF_M2TS_MAX_STREAMS);
+	pool->shards = gf_malloc(sizeof(GF_M2TS_Shard) * nb_threads);
+	pool->active_pids = gf_malloc(sizeof(u16) * GF_M2TS_MAX_STREAMS);
+	pool->done = gf_sema_new(nb_threads, 0);
+	if (!pool->shards || !pool->active_pids || !pool->done) {
+		if (pool->shards) memset(pool->shards, 0, sizeof(GF_M2TS_Shard) * nb_threads);
+		else pool->nb_shards = 0;
+		gf_m2ts_workers_del(pool);
+		return GF_OUT_OF_MEM;
+	}
+	memset(pool->shards, 0, sizeof(GF_M2TS_Shard) * nb_threads);
+	for (i=0; i<nb_threads; i++) {
+		GF_M2TS_Shard *shard = &pool->shards[i];
+		shard->pool = pool;
+		shard->pcks = gf_malloc(sizeof(GF_M2TS_RoutedPacket) * pool->batch_size);
+		if (!shard->pcks) {
+			gf_m2ts_workers_del(pool);
+			return GF_OUT_OF_MEM;
+		}
+		//first shard is processed by the calling thread
+		if (!i) continue;
+		shard->run = gf_sema_new(1, 0);
+		shard->th = gf_th_new("M2TSDmxWorker");
+		if (!shard->run || !shard->th || gf_th_run(shard->th, gf_m2ts_worker_run, shard)) {
+			gf_m2ts_workers_del(pool);
+			return GF_IO_ERR;
+		}
+	}
+	ts->workers = pool;
+	return GF_OK;
+}
+
+static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_Header *hdr, unsigned char *data, u32 data_size, GF_M2TS_AdaptationField *paf, GF_M2TS_RoutedPacket *rp)
 {
 	u8 expect_cc;
 	Bool disc=0;
@@ -2150,11 +2572,20 @@ static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_H
 
 	if (hdr->payload_start) {
 		flush_pes = 1;
-		pes->pes_start_packet_number = ts->pck_number;
-		pes->before_last_pcr_value = pes->program->before_last_pcr_value;
-		pes->before_last_pcr_value_pck_number = pes->program->before_last_pcr_value_pck_number;
-		pes->last_pcr_value = pes->program->last_pcr_value;
-		pes->last_pcr_value_pck_number = pes->program->last_pcr_value_pck_number;
+		//PCR state at the time the packet was routed
+		if (rp) {
+			pes->pes_start_packet_number = rp->pck_number;
+			pes->before_last_pcr_value = rp->before_last_pcr_value;
+			pes->before_last_pcr_value_pck_number = rp->before_last_pcr_value_pck_number;
+			pes->last_pcr_value = rp->last_pcr_value;
+			pes->last_pcr_value_pck_number = rp->last_pcr_value_pck_number;
+		} else {
+			pes->pes_start_packet_number = ts->pck_number;
+			pes->before_last_pcr_value = pes->program->before_last_pcr_value;
+			pes->before_last_pcr_value_pck_number = pes->program->before_last_pcr_value_pck_number;
+			pes->last_pcr_value = pes->program->last_pcr_value;
+			pes->last_pcr_value_pck_number = pes->program->last_pcr_value_pck_number;
+		}
 	} else if (pes->pes_len && (pes->pck_data_len + data_size == pes->pes_len + 6)) {
 		/* 6 = startcode+stream_id+length*/
 		/*reassemble pes*/
@@ -2198,9 +2629,11 @@ static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_H
 	}
 }
 
+GF_EXPORT
 void gf_m2ts_flush_all(GF_M2TS_Demuxer *ts)
 {
 	u32 i;
+	gf_m2ts_demux_dispatch(ts);
 	for (i=0; i<GF_M2TS_MAX_STREAMS; i++) {
 		GF_M2TS_ES *stream = ts->ess[i];
 		if (stream && (stream->flags & GF_M2TS_ES_IS_PES)) {
@@ -2287,6 +2720,9 @@ static void gf_m2ts_get_adaptation_field(GF_M2TS_Demuxer *ts, GF_M2TS_Adaptation
 		}
 
 		if (! af_desc_not_present) {
+			//TEMI descriptors are attached to the next PES packets, process pending ones first
+			if (afext_bytes) gf_m2ts_demux_dispatch(ts);
+
 			while (afext_bytes) {
 				GF_BitStream *bs;
 				char *desc;
@@ -2398,6 +2834,19 @@ static GF_Err gf_m2ts_process_packet(GF_M2TS_Demuxer *ts, unsigned char *data)
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS] TS Packet %d PID %d CC %d Encrypted %d\n", ts->pck_number, hdr.pid, hdr.continuity_counter, hdr.scrambling_ctrl));
 //#endif
 
+	//split mode, forward packets other than PAT and PMT as is without looking at adaptation field or payload
+	if (ts->split_mode && (hdr.pid != GF_M2TS_PID_PAT)) {
+		es = ts->ess[hdr.pid];
+		if (!es || !(es->flags & GF_M2TS_ES_IS_PMT)) {
+			GF_M2TS_TSPCK tspck;
+			tspck.stream = es;
+			tspck.pid = hdr.pid;
+			tspck.data = data;
+			ts->on_event(ts, GF_M2TS_EVT_PCK, &tspck);
+			return GF_OK;
+		}
+	}
+
 	if (hdr.scrambling_ctrl) {
 		//TODO add decyphering
 		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[MPEG-2 TS] TS Packet %d is scrambled - not supported\n", ts->pck_number, hdr.pid));
@@ -2515,7 +2964,11 @@ static GF_Err gf_m2ts_process_packet(GF_M2TS_Demuxer *ts, unsigned char *data)
 				cc = es->program->pcr_cc;
 				es->program->pcr_cc = hdr.continuity_counter;
 			}
-			else if (es->flags & GF_M2TS_ES_IS_PES) cc = ((GF_M2TS_PES*)es)->cc;
+			else if (es->flags & GF_M2TS_ES_IS_PES) {
+				//packets of the PID may still be pending in PES workers
+				if (ts->workers) cc = ts->workers->pid_cc[es->pid];
+				else cc = ((GF_M2TS_PES*)es)->cc;
+			}
 			else if (((GF_M2TS_SECTION_ES*)es)->sec) cc = ((GF_M2TS_SECTION_ES*)es)->sec->cc;
 
 			discontinuity = paf->discontinuity_indicator;
@@ -2581,7 +3034,12 @@ static GF_Err gf_m2ts_process_packet(GF_M2TS_Demuxer *ts, unsigned char *data)
 				gf_m2ts_reset_parsers_for_program(ts, es->program);
 			}
 
-			if (ts->on_event) {
+			//PCR is sent once all previous packets of the program are dispatched
+			if (ts->workers) {
+				if (gf_m2ts_queue_event(&ts->workers->router, ts->pck_number, GF_M2TS_EVT_PES_PCR, &pck) != GF_OK) {
+					GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[MPEG-2 TS] Out of memory queuing PCR of PID %d, discarding\n", es->pid));
+				}
+			} else if (ts->on_event) {
 				ts->on_event(ts, GF_M2TS_EVT_PES_PCR, &pck);
 			}
 		}
@@ -2611,7 +3069,12 @@ static GF_Err gf_m2ts_process_packet(GF_M2TS_Demuxer *ts, unsigned char *data)
 	} else {
 		GF_M2TS_PES *pes = (GF_M2TS_PES *)es;
 		/* regular stream using PES packets */
-		if (pes->reframe && payload_size) gf_m2ts_process_pes(ts, pes, &hdr, data, payload_size, paf);
+		if (pes->reframe && payload_size) {
+			if (ts->workers && !ts->notify_pes_timing)
+				gf_m2ts_route_pes(ts, pes, &hdr, data, payload_size, paf);
+			else
+				gf_m2ts_process_pes(ts, pes, &hdr, data, payload_size, paf, NULL);
+		}
 	}
 
 	return GF_OK;
@@ -2751,6 +3214,8 @@ void gf_m2ts_reset_parsers_for_program(GF_M2TS_Demuxer *ts, GF_M2TS_Program *pro
 {
 	u32 i;
 
+	gf_m2ts_demux_dispatch(ts);
+
 	for (i=0; i<GF_M2TS_MAX_STREAMS; i++) {
 		GF_M2TS_ES *es = (GF_M2TS_ES *) ts->ess[i];
 		if (!es) continue;
@@ -2763,6 +3228,7 @@ void gf_m2ts_reset_parsers_for_program(GF_M2TS_Demuxer *ts, GF_M2TS_Program *pro
 			GF_M2TS_PES *pes = (GF_M2TS_PES *)es;
 			if (pes->pid==pes->program->pmt_pid) continue;
 			pes->cc = -1;
+			if (ts->workers) ts->workers->pid_cc[i] = -1;
 			pes->pck_data_len = 0;
 			if (pes->prev_data) gf_free(pes->prev_data);
 			pes->prev_data = NULL;
@@ -2843,6 +3309,8 @@ GF_Err gf_m2ts_set_pes_framing(GF_M2TS_PES *pes, GF_M2TSPesFraming mode)
 
 	if (pes->pid==pes->program->pmt_pid) return GF_BAD_PARAM;
 
+	gf_m2ts_demux_dispatch(pes->program->ts);
+
 	//if component reuse, disable previous pes
 	if ((mode > GF_M2TS_PES_FRAMING_SKIP) && (pes->program->ts->ess[pes->pid] != (GF_M2TS_ES *) pes)) {
 		GF_M2TS_PES *o_pes = (GF_M2TS_PES *) pes->program->ts->ess[pes->pid];
@@ -2961,6 +3429,8 @@ GF_EXPORT
 void gf_m2ts_demux_del(GF_M2TS_Demuxer *ts)
 {
 	u32 i;
+	//pending packets and events are discarded
+	if (ts->workers) gf_m2ts_workers_del(ts->workers);
 	if (ts->pat) gf_m2ts_section_filter_del(ts->pat);
 	if (ts->cat) gf_m2ts_section_filter_del(ts->cat);
 	if (ts->sdt) gf_m2ts_section_filter_del(ts->sdt);
@@ -3115,34 +3585,96 @@ static void rewrite_pts_dts(unsigned char *ptr, u64 TS)
 	else _TS = _TS + ts_shift; \
 	while (_TS > pcr_mod) _TS -= pcr_mod; \
 
+static GFINLINE Bool m2ts_scan_packet(const u8 *p, GF_M2TS_PacketInfo *info)
+{
+	u8 flags = 0, af_len = 0;
+	if (p[0] != 0x47) return GF_FALSE;
+	if (p[1] & 0x40) flags |= GF_M2TS_SCAN_PUSI;
+	if (p[3] & 0xC0) flags |= GF_M2TS_SCAN_SCRAMBLED;
+	if (p[3] & 0x10) flags |= GF_M2TS_SCAN_PAYLOAD;
+	if (p[3] & 0x20) {
+		af_len = p[4];
+		//broken AF length, don't look into it
+		if (af_len > 183) af_len = 0;
+		else {
+			flags |= GF_M2TS_SCAN_AF;
+			if ((af_len >= 7) && (p[5] & 0x10)) flags |= GF_M2TS_SCAN_PCR;
+		}
+	}
+	info->pid = ((p[1] & 0x1f) << 8) | p[2];
+	info->flags = flags;
+	info->af_len = af_len;
+	return GF_TRUE;
+}
+
+GF_EXPORT
+u32 gf_m2ts_scan_packets(const u8 *data, u32 size, u32 pck_size, Bool all_packets, GF_M2TS_PacketInfo *infos, u32 max_infos, u32 *nb_infos)
+{
+	u32 pos = 0, nb = 0;
+	u32 hdr_offset = (pck_size==192) ? 4 : 0;
+
+	*nb_infos = 0;
+	if ((pck_size != 188) && (pck_size != 192)) return 0;
+
+	while (pos + pck_size <= size) {
+		u32 i, nb_test = 1;
+		const u8 *p = data + pos + hdr_offset;
+		//most packets of a multiplex are PES continuation packets: test 4 headers at once and skip them if all
+		//have a valid sync byte, no payload unit start and no adaptation field, otherwise check them one by one
+		if (!all_packets && (pos + 4*pck_size <= size)) {
+			const u8 *p1 = p + pck_size;
+			const u8 *p2 = p1 + pck_size;
+			const u8 *p3 = p2 + pck_size;
+			if ( !((p[0] ^ 0x47) | (p1[0] ^ 0x47) | (p2[0] ^ 0x47) | (p3[0] ^ 0x47))
+				&& !((p[1] | p1[1] | p2[1] | p3[1]) & 0x40)
+				&& !((p[3] | p1[3] | p2[3] | p3[3]) & 0x20)
+			) {
+				pos += 4*pck_size;
+				continue;
+			}
+			nb_test = 4;
+		}
+		for (i=0; i<nb_test; i++) {
+			if (nb == max_infos) goto exit;
+			if (!m2ts_scan_packet(p, &infos[nb])) goto exit;
+			if (all_packets || (infos[nb].flags & (GF_M2TS_SCAN_PUSI|GF_M2TS_SCAN_AF)) ) {
+				infos[nb].offset = pos + hdr_offset;
+				nb++;
+			}
+			pos += pck_size;
+			p += pck_size;
+		}
+	}
+
+exit:
+	*nb_infos = nb;
+	return pos;
+}
+
+#define M2TS_RESTAMP_SCAN	64
+
 GF_EXPORT
 GF_Err gf_m2ts_restamp(u8 *buffer, u32 size, s64 ts_shift, u8 is_pes[GF_M2TS_MAX_STREAMS])
 {
 	u32 done = 0;
 	u64 pcr_mod;
+	GF_M2TS_PacketInfo infos[M2TS_RESTAMP_SCAN];
 //	if (!ts_shift) return GF_OK;
 
 	pcr_mod = 0x80000000;
 	pcr_mod*=4;
 	while (done + 188 <= size) {
-		u8 *pesh;
-		u8 *pck;
-		u64 pcr_base=0, pcr_ext=0;
-		u16 pid;
-		u8 adaptation_field, adaptation_field_length;
-
-		pck = (u8*) buffer+done;
-		if (pck[0]!=0x47) {
-			GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[M2TS Restamp] Invalid sync byte %X\n", pck[0]));
-			return GF_NON_COMPLIANT_BITSTREAM;
-		}
-		pid = ((pck[1] & 0x1f) <<8 ) + pck[2];
+		u32 i, nb_infos;
+		u32 scanned = gf_m2ts_scan_packets(buffer+done, size-done, 188, GF_FALSE, infos, M2TS_RESTAMP_SCAN, &nb_infos);
+
+		for (i=0; i<nb_infos; i++) {
+			u8 *pesh;
+			u8 *pck = buffer + done + infos[i].offset;
+			u16 pid = infos[i].pid;
+			u32 pes_offset;
 
-		adaptation_field_length = 0;
-		adaptation_field = (pck[3] >> 4) & 0x3;
-		if ((adaptation_field==2) || (adaptation_field==3)) {
-			adaptation_field_length = pck[4];
-			if ( pck[5]&0x10 /*PCR_flag*/) {
+			if (infos[i].flags & GF_M2TS_SCAN_PCR) {
+				u64 pcr_base, pcr_ext;
 				pcr_base = (((u64)pck[6])<<25) + (pck[7]<<17) + (pck[8]<<9) + (pck[9]<<1) + (pck[10]>>7);
 				pcr_ext  = ((pck[10]&1)<<8) + pck[11];
 
@@ -3152,54 +3684,63 @@ GF_Err gf_m2ts_restamp(u8 *buffer, u32 size, s64 ts_shift, u8 is_pes[GF_M2TS_MAX
 				pck[7]  = (unsigned char)(0xff&(pcr_base>>17));
 				pck[8]  = (unsigned char)(0xff&(pcr_base>>9));
 				pck[9]  = (unsigned char)(0xff&(pcr_base>>1));
-				pck[10] = (unsigned char)(((0x1&pcr_base)<<7) | 0x7e | ((0x100&pcr_ext)>>8));
+				//keep reserved bits as in source
+				pck[10] = (unsigned char)(((0x1&pcr_base)<<7) | (pck[10] & 0x7e) | ((0x100&pcr_ext)>>8));
 				if (pcr_ext != ((pck[10]&1)<<8) + pck[11]) {
 					GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[M2TS Restamp] Sanity check failed for PCR restamping\n"));
 					return GF_IO_ERR;
 				}
 				pck[11] = (unsigned char)(0xff&pcr_ext);
 			}
-			/*add adaptation_field_length field*/
-			adaptation_field_length++;
-		}
-		if (!is_pes[pid] || !(pck[1]&0x40)) {
-			done+=188;
-			continue;
-		}
-
-		pesh = &pck[4+adaptation_field_length];
+			if (!is_pes[pid] || !(infos[i].flags & GF_M2TS_SCAN_PUSI) || !(infos[i].flags & GF_M2TS_SCAN_PAYLOAD))
+				continue;
 
-		if ((pesh[0]==0x00) && (pesh[1]==0x00) && (pesh[2]==0x01)) {
-			Bool has_pts, has_dts;
-			if ((pesh[6]&0xc0)!=0x80) {
-				done+=188;
+			pes_offset = 4;
+			if (infos[i].flags & GF_M2TS_SCAN_AF) pes_offset += 1 + infos[i].af_len;
+			//PES header up to PTS
+			if (pes_offset + 14 > 188) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TS Restamp] PID %4d: PES header not in first packet\n", pid));
 				continue;
 			}
-			has_pts = (pesh[7]&0x80);
-			has_dts = has_pts ? (pesh[7]&0x40) : 0;
+			pesh = &pck[pes_offset];
 
-			if (has_pts) {
-				u64 PTS;
-				if (((pesh[9]&0xe0)>>4)!=0x2) {
-					GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TS Restamp] PID %4d: Wrong PES header, PTS decoding: '0010' expected\n", pid));
-					done+=188;
+			if ((pesh[0]==0x00) && (pesh[1]==0x00) && (pesh[2]==0x01)) {
+				Bool has_pts, has_dts;
+				if ((pesh[6]&0xc0)!=0x80) {
 					continue;
 				}
+				has_pts = (pesh[7]&0x80);
+				has_dts = has_pts ? (pesh[7]&0x40) : 0;
+				if (has_dts && (pes_offset + 19 > 188))
+					has_dts = 0;
+
+				if (has_pts) {
+					u64 PTS;
+					if (((pesh[9]&0xe0)>>4)!=0x2) {
+						GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TS Restamp] PID %4d: Wrong PES header, PTS decoding: '0010' expected\n", pid));
+						continue;
+					}
 
-				PTS = gf_m2ts_get_pts(pesh + 9);
-				ADJUST_TIMESTAMP(PTS);
-				rewrite_pts_dts(pesh+9, PTS);
-			}
+					PTS = gf_m2ts_get_pts(pesh + 9);
+					ADJUST_TIMESTAMP(PTS);
+					rewrite_pts_dts(pesh+9, PTS);
+				}
 
-			if (has_dts) {
-				u64 DTS = gf_m2ts_get_pts(pesh + 14);
-				ADJUST_TIMESTAMP(DTS);
-				rewrite_pts_dts(pesh+14, DTS);
+				if (has_dts) {
+					u64 DTS = gf_m2ts_get_pts(pesh + 14);
+					ADJUST_TIMESTAMP(DTS);
+					rewrite_pts_dts(pesh+14, DTS);
+				}
+			} else {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TS Restamp] PID %4d: Wrong PES not beginning with start code\n", pid));
 			}
-		} else {
-			GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TS Restamp] PID %4d: Wrong PES not beginning with start code\n", pid));
 		}
-		done+=188;
+		done += scanned;
+		//scan stopped before end of buffer with room left in infos: sync loss
+		if ((nb_infos < M2TS_RESTAMP_SCAN) && (done + 188 <= size)) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[M2TS Restamp] Invalid sync byte %X\n", buffer[done]));
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
 	}
 	return GF_OK;
 }
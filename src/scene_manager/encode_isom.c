@@ -441,19 +441,288 @@ static GF_ESD *gf_sm_locate_esd(GF_SceneManager *ctx, u16 ES_ID)
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
 
-static GF_Err gf_sm_encode_scene(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEncodeOptions *opts, u32 scene_type)
+void gf_sm_reset_stream(GF_StreamContext *sc);
+
+/*ID ranges used when encoding progressively if not set in the BIFS config*/
+#define SM_PROGRESSIVE_ID_BITS	16
+
+/*scene track being encoded*/
+typedef struct
+{
+	GF_StreamContext *sc;
+	GF_ESD *esd;
+	Bool delete_desc;
+	u32 track, di;
+#ifndef GPAC_DISABLE_BIFS_ENC
+	GF_BifsEncoder *bifs_enc;
+	/*ID ranges of the BIFS config, fixed when encoding progressively*/
+	u32 node_id_bits, route_id_bits, proto_id_bits;
+#endif
+#ifndef GPAC_DISABLE_LASER
+	GF_LASeRCodec *lsr_enc;
+#endif
+	u32 nb_aus, init_offset, rate, rap_delay;
+	u64 last_rap, dur, time_slice, avg_rate, prev_dts;
+	/*sync shadow state when encoding progressively*/
+	u64 last_shadow;
+	Bool shadow_pending;
+} SMSceneTrack;
+
+typedef struct
+{
+	GF_SceneManager *ctx;
+	GF_ISOFile *mp4;
+	u32 rap_mode;
+	/*if set, scene tracks are kept in the track list and access units are encoded as they are loaded*/
+	Bool progressive;
+	GF_List *tracks;
+#ifndef GPAC_DISABLE_BIFS_ENC
+	GF_BifsEncoder *bifs_enc;
+#endif
+#ifndef GPAC_DISABLE_LASER
+	GF_LASeRCodec *lsr_enc;
+#endif
+} SMSceneEncoder;
+
+static void gf_sm_scene_track_del(SMSceneTrack *st)
+{
+	if (st->delete_desc) gf_odf_desc_del((GF_Descriptor *) st->esd);
+	gf_free(st);
+}
+
+static GF_Err gf_sm_encode_scene_au(SMSceneEncoder *senc, SMSceneTrack *st, GF_AUContext *au)
+{
+	u32 samp_size;
+	GF_ISOSample *samp;
+	GF_Err e = GF_OK;
+	GF_ESD *esd = st->esd;
+	GF_ISOFile *mp4 = senc->mp4;
+
+	samp = gf_isom_sample_new();
+	/*time in sec conversion*/
+	if (au->timing_sec) au->timing = (u64) (au->timing_sec * esd->slConfig->timestampResolution + 0.0005);
+
+	if (!st->nb_aus) st->init_offset = (u32) au->timing;
+	st->nb_aus++;
+
+	samp->DTS = au->timing - st->init_offset;
+	if ((st->nb_aus>1) && (samp->DTS == st->prev_dts)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[OD-SL] Same sample time %d for Access Unit %d and %d\n", au->timing, st->nb_aus, st->nb_aus-1));
+		e = GF_BAD_PARAM;
+		goto exit;
+	}
+	/*can only happen when encoding progressively, previous AUs are already written*/
+	if ((st->nb_aus>1) && ((au->timing < st->init_offset) || (samp->DTS < st->prev_dts))) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[OD-SL] Access Unit %d time "LLU" is before previous Access Unit time\n", st->nb_aus, au->timing));
+		e = GF_BAD_PARAM;
+		goto exit;
+	}
+	samp->IsRAP = au->flags & GF_SM_AU_RAP;
+	if (samp->IsRAP) st->last_rap = au->timing;
+
+
+#ifndef GPAC_DISABLE_BIFS_ENC
+	if (st->bifs_enc)
+		e = gf_bifs_encode_au(st->bifs_enc, st->sc->ESID, au->commands, &samp->data, &samp->dataLength);
+#endif
+#ifndef GPAC_DISABLE_LASER
+	if (st->lsr_enc)
+		e = gf_laser_encode_au(st->lsr_enc, st->sc->ESID, au->commands, 0, &samp->data, &samp->dataLength);
+#endif
+
+	samp_size = samp->dataLength;
+
+	/*inband RAP */
+	if (senc->rap_mode==3) {
+		/*current sample before or at the next rep - apply commands*/
+		if (samp->DTS <= st->last_rap + st->rap_delay) {
+			e = gf_sg_command_apply_list(senc->ctx->scene_graph, au->commands, 0);
+		}
+
+		/*current sample is after or at next rap, insert rap*/
+		while (samp->DTS >= st->last_rap + st->rap_delay) {
+			GF_ISOSample *rap_sample = gf_isom_sample_new();
+
+#ifndef GPAC_DISABLE_BIFS_ENC
+			if (st->bifs_enc)
+				e = gf_bifs_encoder_get_rap(st->bifs_enc, &rap_sample->data, &rap_sample->dataLength);
+#endif
+
+#ifndef GPAC_DISABLE_LASER
+			if (st->lsr_enc)
+				e = gf_laser_encoder_get_rap(st->lsr_enc, &rap_sample->data, &rap_sample->dataLength);
+#endif
+
+			rap_sample->DTS = st->last_rap + st->rap_delay;
+			rap_sample->IsRAP = RAP;
+			st->last_rap = rap_sample->DTS;
+
+
+			if (!e) e = gf_isom_add_sample(mp4, st->track, st->di, rap_sample);
+			if (samp_size < rap_sample->dataLength) samp_size = rap_sample->dataLength;
+
+			gf_isom_sample_del(&rap_sample);
+			/*same timing, don't add sample*/
+			if (st->last_rap == samp->DTS) {
+				if (samp->data) gf_free(samp->data);
+				samp->data = NULL;
+				samp->dataLength = 0;
+			}
+		}
+
+		/*apply commands */
+		if (samp->DTS > st->last_rap + st->rap_delay) {
+			e = gf_sg_command_apply_list(senc->ctx->scene_graph, au->commands, 0);
+		}
+	}
+
+	/*carousel generation*/
+	if (!e && (senc->rap_mode == 1)) {
+		if (samp->DTS - st->last_rap > st->rap_delay) {
+			GF_ISOSample *car_samp = gf_isom_sample_new();
+			u64 r_dts = samp->DTS;
+
+			/*then get RAP*/
+#ifndef GPAC_DISABLE_BIFS_ENC
+			if (st->bifs_enc) {
+				e = gf_bifs_encoder_get_rap(st->bifs_enc, &car_samp->data, &car_samp->dataLength);
+				if (e) goto exit;
+			}
+#endif
+
+#ifndef GPAC_DISABLE_LASER
+			if (st->lsr_enc) {
+				e = gf_laser_encoder_get_rap(st->lsr_enc, &car_samp->data, &car_samp->dataLength);
+				if (e) goto exit;
+			}
+#endif
+			car_samp->IsRAP = RAP_REDUNDANT;
+			while (1) {
+				car_samp->DTS = st->last_rap + st->rap_delay;
+				if (car_samp->DTS==st->prev_dts) car_samp->DTS++;
+				e = gf_isom_add_sample(mp4, st->track, st->di, car_samp);
+				if (e) break;
+				st->last_rap += st->rap_delay;
+				if (st->last_rap + st->rap_delay >= r_dts) break;
+			}
+			gf_isom_sample_del(&car_samp);
+			if (e) goto exit;
+		}
+		if (samp->dataLength) {
+			e = gf_isom_add_sample(mp4, st->track, st->di, samp);
+			if (e) goto exit;
+		}
+		/*accumulate commmands*/
+		e = gf_sg_command_apply_list(senc->ctx->scene_graph, au->commands, 0);
+	} else {
+		/*if no commands don't add the AU*/
+		if (!e && samp->dataLength) e = gf_isom_add_sample(mp4, st->track, st->di, samp);
+	}
+
+	st->dur = au->timing;
+	st->avg_rate += samp_size;
+	st->rate += samp_size;
+	if (esd->decoderConfig->bufferSizeDB < samp_size) esd->decoderConfig->bufferSizeDB = samp_size;
+	if (samp->DTS - st->time_slice > esd->slConfig->timestampResolution) {
+		if (esd->decoderConfig->maxBitrate < st->rate) esd->decoderConfig->maxBitrate = st->rate;
+		st->rate = 0;
+		st->time_slice = samp->DTS;
+	}
+
+	st->prev_dts = samp->DTS;
+
+exit:
+	gf_isom_sample_del(&samp);
+	return e;
+}
+
+static GF_Err gf_sm_encode_scene_shadow(SMSceneEncoder *senc, SMSceneTrack *st, u64 dts)
+{
+	GF_Err e = GF_OK;
+	GF_ISOSample *samp = gf_isom_sample_new();
+	samp->DTS = dts;
+	samp->IsRAP = RAP;
+	/*RAP generation*/
+#ifndef GPAC_DISABLE_BIFS_ENC
+	if (st->bifs_enc)
+		e = gf_bifs_encoder_get_rap(st->bifs_enc, &samp->data, &samp->dataLength);
+#endif
+
+	if (!e) e = gf_isom_add_sample_shadow(senc->mp4, st->track, samp);
+	gf_isom_sample_del(&samp);
+	return e;
+}
+
+static GF_Err gf_sm_finalize_scene_track(SMSceneEncoder *senc, SMSceneTrack *st)
+{
+	GF_Err e;
+	GF_MuxInfo *mux;
+	GF_ESD *esd = st->esd;
+	GF_ISOFile *mp4 = senc->mp4;
+
+	if (st->dur) {
+		esd->decoderConfig->avgBitrate = (u32) (st->avg_rate * esd->slConfig->timestampResolution * 8 / st->dur);
+		esd->decoderConfig->maxBitrate *= 8;
+	} else {
+		esd->decoderConfig->avgBitrate = 0;
+		esd->decoderConfig->maxBitrate = 0;
+	}
+	gf_isom_change_mpeg4_description(mp4, st->track, 1, esd);
+
+	/*sync shadow generation*/
+	if (senc->rap_mode==2) {
+		/*shadows are generated as AUs are applied, force a RAP shadow on last sample*/
+		if (senc->progressive) {
+			if (st->shadow_pending) {
+				e = gf_sm_encode_scene_shadow(senc, st, st->prev_dts);
+				if (e) return e;
+			}
+		} else {
+			u32 j, au_count = gf_list_count(st->sc->AUs);
+			st->last_rap = 0;
+			for (j=0; j<au_count; j++) {
+				GF_AUContext *au = (GF_AUContext *)gf_list_get(st->sc->AUs, j);
+				e = gf_sg_command_apply_list(senc->ctx->scene_graph, au->commands, 0);
+				if (!j) continue;
+				/*force a RAP shadow on last sample*/
+				if ((au->timing - st->last_rap < st->rap_delay) && (j+1<au_count) ) continue;
+
+				st->last_rap = au->timing - st->init_offset;
+				e = gf_sm_encode_scene_shadow(senc, st, st->last_rap);
+				if (e) return e;
+			}
+		}
+	}
+
+	/*if offset add edit list*/
+	gf_sm_finalize_mux(mp4, esd, (u32) st->init_offset);
+	gf_isom_set_last_sample_duration(mp4, st->track, 0);
+
+	mux = gf_sm_get_mux_info(esd);
+	if (mux && mux->duration) {
+		u64 tot_dur = mux->duration * esd->slConfig->timestampResolution / 1000;
+		u64 mdur = gf_isom_get_media_duration(mp4, st->track);
+		if (mdur <= tot_dur)
+			gf_isom_set_last_sample_duration(mp4, st->track, (u32) (tot_dur - mdur));
+	}
+	return GF_OK;
+}
+
+static GF_Err gf_sm_encode_scene(SMSceneEncoder *senc, GF_SMEncodeOptions *opts, u32 scene_type)
 {
 	u8 *data;
 	Bool is_in_iod, delete_desc;
-	u32 i, j, di, rate, init_offset, data_len, count, track, rap_delay, flags, rap_mode;
-	u64 last_rap, dur, time_slice, avg_rate, prev_dts;
+	u32 i, j, di, data_len, count, track, flags;
+	u32 node_id_bits, route_id_bits, proto_id_bits;
 	GF_Err e;
 	GF_InitialObjectDescriptor *iod;
 	GF_AUContext *au;
 	GF_ISOSample *samp;
 	GF_StreamContext *sc;
 	GF_ESD *esd;
-	GF_MuxInfo *mux;
+	SMSceneTrack *st;
+	GF_SceneManager *ctx = senc->ctx;
+	GF_ISOFile *mp4 = senc->mp4;
 #ifndef GPAC_DISABLE_BIFS_ENC
 	GF_BifsEncoder *bifs_enc;
 #endif
@@ -461,11 +730,11 @@ static GF_Err gf_sm_encode_scene(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEnc
 	GF_LASeRCodec *lsr_enc;
 #endif
 
-	rap_mode = 0;
+	senc->rap_mode = 0;
 	if (opts && opts->rap_freq) {
-		if (opts->flags & GF_SM_ENCODE_RAP_INBAND) rap_mode = 3;
-		else if (opts->flags & GF_SM_ENCODE_RAP_SHADOW) rap_mode = 2;
-		else rap_mode = 1;
+		if (opts->flags & GF_SM_ENCODE_RAP_INBAND) senc->rap_mode = 3;
+		else if (opts->flags & GF_SM_ENCODE_RAP_SHADOW) senc->rap_mode = 2;
+		else senc->rap_mode = 1;
 	}
 
 	e = GF_OK;
@@ -483,6 +752,7 @@ static GF_Err gf_sm_encode_scene(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEnc
 	count = gf_list_count(ctx->streams);
 
 	sc = NULL;
+	node_id_bits = route_id_bits = proto_id_bits = 0;
 
 	flags = opts ? opts->flags : 0;
 	delete_desc = 0;
@@ -696,16 +966,35 @@ force_scene_rap:
 				}
 				delete_bcfg = 1;
 			}
+			/*IDs used by the next chunks are not known yet, keep the configured ranges or use large ones*/
+			if (senc->progressive) {
+				if (!bcfg->nodeIDbits) bcfg->nodeIDbits = SM_PROGRESSIVE_ID_BITS;
+				if (!bcfg->routeIDbits) bcfg->routeIDbits = SM_PROGRESSIVE_ID_BITS;
+				/*a non-zero proto range signals BIFSv2Config, only use one if the scene has protos or is already v2*/
+				if (!bcfg->protoIDbits
+				        && ((bcfg->version==2) || (esd->decoderConfig->objectTypeIndication==2) || ctx->max_proto_id
+				            || gf_list_count(ctx->scene_graph->protos) || gf_list_count(ctx->scene_graph->unregistered_protos))
+				   ) {
+					bcfg->protoIDbits = SM_PROGRESSIVE_ID_BITS;
+				}
+			}
 			/*update NodeIDbits and co*/
 			/*nodeID bits shall include NULL node*/
 			if (!bcfg->nodeIDbits || (bcfg->nodeIDbits<gf_get_bit_size(ctx->max_node_id)) )
 				bcfg->nodeIDbits = gf_get_bit_size(ctx->max_node_id);
 
-			if (!bcfg->routeIDbits || (bcfg->routeIDbits != gf_get_bit_size(ctx->max_route_id)) )
-				bcfg->routeIDbits = gf_get_bit_size(ctx->max_route_id);
+			if (senc->progressive) {
+				if (bcfg->routeIDbits<gf_get_bit_size(ctx->max_route_id))
+					bcfg->routeIDbits = gf_get_bit_size(ctx->max_route_id);
+				if (bcfg->protoIDbits<gf_get_bit_size(ctx->max_proto_id))
+					bcfg->protoIDbits = gf_get_bit_size(ctx->max_proto_id);
+			} else {
+				if (!bcfg->routeIDbits || (bcfg->routeIDbits != gf_get_bit_size(ctx->max_route_id)) )
+					bcfg->routeIDbits = gf_get_bit_size(ctx->max_route_id);
 
-			if (!bcfg->protoIDbits || (bcfg->protoIDbits != gf_get_bit_size(ctx->max_proto_id)) )
-				bcfg->protoIDbits = gf_get_bit_size(ctx->max_proto_id);
+				if (!bcfg->protoIDbits || (bcfg->protoIDbits != gf_get_bit_size(ctx->max_proto_id)) )
+					bcfg->protoIDbits = gf_get_bit_size(ctx->max_proto_id);
+			}
 
 			if (!bcfg->elementaryMasks) {
 				bcfg->pixelMetrics = ctx->is_pixel_metrics;
@@ -716,6 +1005,9 @@ force_scene_rap:
 
 			/*this is for safety, otherwise some players may not understand NULL node*/
 			if (!bcfg->nodeIDbits) bcfg->nodeIDbits = 1;
+			node_id_bits = bcfg->nodeIDbits;
+			route_id_bits = bcfg->routeIDbits;
+			proto_id_bits = bcfg->protoIDbits;
 			gf_bifs_encoder_new_stream(bifs_enc, esd->ESID, bcfg, (flags & GF_SM_ENCODE_USE_NAMES) ? 1 : 0, 0);
 			if (delete_bcfg) gf_odf_desc_del((GF_Descriptor *)bcfg);
 			/*create final BIFS config*/
@@ -798,201 +1090,46 @@ force_scene_rap:
 			goto exit;
 		}
 
-		dur = 0;
-		avg_rate = 0;
-		esd->decoderConfig->bufferSizeDB = 0;
-		esd->decoderConfig->maxBitrate = 0;
-		rate = 0;
-		time_slice = 0;
-		last_rap = 0;
-		rap_delay = 0;
-		if (opts) rap_delay = opts->rap_freq * esd->slConfig->timestampResolution / 1000;
-
-		prev_dts = 0;
-		init_offset = 0;
-		j=0;
-		while ((au = (GF_AUContext *)gf_list_enum(sc->AUs, &j))) {
-			u32 samp_size;
-			samp = gf_isom_sample_new();
-			/*time in sec conversion*/
-			if (au->timing_sec) au->timing = (u64) (au->timing_sec * esd->slConfig->timestampResolution + 0.0005);
-
-			if (j==1) init_offset = (u32) au->timing;
-
-			samp->DTS = au->timing - init_offset;
-			if ((j>1) && (samp->DTS == prev_dts)) {
-				GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[OD-SL] Same sample time %d for Access Unit %d and %d\n", au->timing, j, j-1));
-				e = GF_BAD_PARAM;
-				goto exit;
-			}
-			samp->IsRAP = au->flags & GF_SM_AU_RAP;
-			if (samp->IsRAP) last_rap = au->timing;
-
-
-#ifndef GPAC_DISABLE_BIFS_ENC
-			if (bifs_enc)
-				e = gf_bifs_encode_au(bifs_enc, sc->ESID, au->commands, &samp->data, &samp->dataLength);
-#endif
-#ifndef GPAC_DISABLE_LASER
-			if (lsr_enc)
-				e = gf_laser_encode_au(lsr_enc, sc->ESID, au->commands, 0, &samp->data, &samp->dataLength);
-#endif
-
-			samp_size = samp->dataLength;
-
-			/*inband RAP */
-			if (rap_mode==3) {
-				/*current sample before or at the next rep - apply commands*/
-				if (samp->DTS <= last_rap + rap_delay) {
-					e = gf_sg_command_apply_list(ctx->scene_graph, au->commands, 0);
-				}
-
-				/*current sample is after or at next rap, insert rap*/
-				while (samp->DTS >= last_rap + rap_delay) {
-					GF_ISOSample *rap_sample = gf_isom_sample_new();
-
-#ifndef GPAC_DISABLE_BIFS_ENC
-					if (bifs_enc)
-						e = gf_bifs_encoder_get_rap(bifs_enc, &rap_sample->data, &rap_sample->dataLength);
-#endif
-
-#ifndef GPAC_DISABLE_LASER
-					if (lsr_enc)
-						e = gf_laser_encoder_get_rap(lsr_enc, &rap_sample->data, &rap_sample->dataLength);
-#endif
-
-					rap_sample->DTS = last_rap + rap_delay;
-					rap_sample->IsRAP = RAP;
-					last_rap = rap_sample->DTS;
-
-
-					if (!e) e = gf_isom_add_sample(mp4, track, di, rap_sample);
-					if (samp_size < rap_sample->dataLength) samp_size = rap_sample->dataLength;
-
-					gf_isom_sample_del(&rap_sample);
-					/*same timing, don't add sample*/
-					if (last_rap == samp->DTS) {
-						if (samp->data) gf_free(samp->data);
-						samp->data = NULL;
-						samp->dataLength = 0;
-					}
-				}
-
-				/*apply commands */
-				if (samp->DTS > last_rap + rap_delay) {
-					e = gf_sg_command_apply_list(ctx->scene_graph, au->commands, 0);
-				}
-			}
-
-			/*carousel generation*/
-			if (!e && (rap_mode == 1)) {
-				if (samp->DTS - last_rap > rap_delay) {
-					GF_ISOSample *car_samp = gf_isom_sample_new();
-					u64 r_dts = samp->DTS;
-
-					/*then get RAP*/
+		GF_SAFEALLOC(st, SMSceneTrack);
+		if (!st) {
+			e = GF_OUT_OF_MEM;
+			goto exit;
+		}
+		st->sc = sc;
+		st->track = track;
+		st->di = di;
 #ifndef GPAC_DISABLE_BIFS_ENC
-					if (bifs_enc) {
-						e = gf_bifs_encoder_get_rap(bifs_enc, &car_samp->data, &car_samp->dataLength);
-						if (e) goto exit;
-					}
+		st->bifs_enc = bifs_enc;
+		st->node_id_bits = node_id_bits;
+		st->route_id_bits = route_id_bits;
+		st->proto_id_bits = proto_id_bits;
 #endif
-
 #ifndef GPAC_DISABLE_LASER
-					if (lsr_enc) {
-						e = gf_laser_encoder_get_rap(lsr_enc, &car_samp->data, &car_samp->dataLength);
-						if (e) goto exit;
-					}
-#endif
-					car_samp->IsRAP = RAP_REDUNDANT;
-					while (1) {
-						car_samp->DTS = last_rap+rap_delay;
-						if (car_samp->DTS==prev_dts) car_samp->DTS++;
-						e = gf_isom_add_sample(mp4, track, di, car_samp);
-						if (e) break;
-						last_rap+=rap_delay;
-						if (last_rap + rap_delay >= r_dts) break;
-					}
-					gf_isom_sample_del(&car_samp);
-					if (e) goto exit;
-				}
-				if (samp->dataLength) {
-					e = gf_isom_add_sample(mp4, track, di, samp);
-					if (e) goto exit;
-				}
-				/*accumulate commmands*/
-				e = gf_sg_command_apply_list(ctx->scene_graph, au->commands, 0);
-			} else {
-				/*if no commands don't add the AU*/
-				if (!e && samp->dataLength) e = gf_isom_add_sample(mp4, track, di, samp);
-			}
-
-			dur = au->timing;
-			avg_rate += samp_size;
-			rate += samp_size;
-			if (esd->decoderConfig->bufferSizeDB < samp_size) esd->decoderConfig->bufferSizeDB = samp_size;
-			if (samp->DTS - time_slice > esd->slConfig->timestampResolution) {
-				if (esd->decoderConfig->maxBitrate < rate) esd->decoderConfig->maxBitrate = rate;
-				rate = 0;
-				time_slice = samp->DTS;
-			}
-
-			prev_dts = samp->DTS;
-			gf_isom_sample_del(&samp);
-			if (e) goto exit;
-		}
-
-		if (dur) {
-			esd->decoderConfig->avgBitrate = (u32) (avg_rate * esd->slConfig->timestampResolution * 8 / dur);
-			esd->decoderConfig->maxBitrate *= 8;
-		} else {
-			esd->decoderConfig->avgBitrate = 0;
-			esd->decoderConfig->maxBitrate = 0;
-		}
-		gf_isom_change_mpeg4_description(mp4, track, 1, esd);
-
-		/*sync shadow generation*/
-		if (rap_mode==2) {
-			u32 au_count = gf_list_count(sc->AUs);
-			last_rap = 0;
-			for (j=0; j<au_count; j++) {
-				au = (GF_AUContext *)gf_list_get(sc->AUs, j);
-				e = gf_sg_command_apply_list(ctx->scene_graph, au->commands, 0);
-				if (!j) continue;
-				/*force a RAP shadow on last sample*/
-				if ((au->timing - last_rap < rap_delay) && (j+1<au_count) ) continue;
-
-				samp = gf_isom_sample_new();
-				last_rap = samp->DTS = au->timing - init_offset;
-				samp->IsRAP = RAP;
-				/*RAP generation*/
-#ifndef GPAC_DISABLE_BIFS_ENC
-				if (bifs_enc)
-					e = gf_bifs_encoder_get_rap(bifs_enc, &samp->data, &samp->dataLength);
+		st->lsr_enc = lsr_enc;
 #endif
+		esd->decoderConfig->bufferSizeDB = 0;
+		esd->decoderConfig->maxBitrate = 0;
+		if (opts) st->rap_delay = opts->rap_freq * esd->slConfig->timestampResolution / 1000;
 
-				if (!e) e = gf_isom_add_sample_shadow(mp4, track, samp);
-				gf_isom_sample_del(&samp);
-				if (e) goto exit;
-			}
-		}
+		/*descriptor is now owned by the track*/
+		st->esd = esd;
+		st->delete_desc = delete_desc;
+		esd = NULL;
+		delete_desc = 0;
 
-		/*if offset add edit list*/
-		gf_sm_finalize_mux(mp4, esd, (u32) init_offset);
-		gf_isom_set_last_sample_duration(mp4, track, 0);
-
-		mux = gf_sm_get_mux_info(esd);
-		if (mux && mux->duration) {
-			u64 tot_dur = mux->duration * esd->slConfig->timestampResolution / 1000;
-			u64 mdur = gf_isom_get_media_duration(mp4, track);
-			if (mdur <= tot_dur)
-				gf_isom_set_last_sample_duration(mp4, track, (u32) (tot_dur - mdur));
+		if (senc->progressive) {
+			gf_list_add(senc->tracks, st);
+			continue;
 		}
 
-		if (delete_desc) {
-			gf_odf_desc_del((GF_Descriptor *) esd);
-			esd = NULL;
+		j=0;
+		while ((au = (GF_AUContext *)gf_list_enum(sc->AUs, &j))) {
+			e = gf_sm_encode_scene_au(senc, st, au);
+			if (e) break;
 		}
+		if (!e) e = gf_sm_finalize_scene_track(senc, st);
+		gf_sm_scene_track_del(st);
+		if (e) goto exit;
 	}
 
 	/*to do - proper PL setup according to node used...*/
@@ -1000,11 +1137,18 @@ force_scene_rap:
 	gf_isom_set_pl_indication(mp4, GF_ISOM_PL_GRAPHICS, 1);
 
 exit:
+	/*when encoding progressively, encoders are kept until all tracks are finalized*/
 #ifndef GPAC_DISABLE_BIFS_ENC
-	if (bifs_enc) gf_bifs_encoder_del(bifs_enc);
+	if (bifs_enc) {
+		if (senc->progressive) senc->bifs_enc = bifs_enc;
+		else gf_bifs_encoder_del(bifs_enc);
+	}
 #endif
 #ifndef GPAC_DISABLE_LASER
-	if (lsr_enc) gf_laser_encoder_del(lsr_enc);
+	if (lsr_enc) {
+		if (senc->progressive) senc->lsr_enc = lsr_enc;
+		else gf_laser_encoder_del(lsr_enc);
+	}
 #endif
 	if (esd && delete_desc) gf_odf_desc_del((GF_Descriptor *) esd);
 	return e;
@@ -1362,10 +1506,8 @@ err_exit:
 	return e;
 }
 
-GF_EXPORT
-GF_Err gf_sm_encode_to_file(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEncodeOptions *opts)
+static GF_Err gf_sm_encode_setup(GF_SceneManager *ctx, GF_ISOFile *mp4)
 {
-	u32 i, count;
 	GF_Err e;
 	if (!ctx->scene_graph) return GF_BAD_PARAM;
 	if (ctx->root_od && (ctx->root_od->tag != GF_ODF_IOD_TAG) && (ctx->root_od->tag != GF_ODF_OD_TAG)) return GF_BAD_PARAM;
@@ -1381,15 +1523,14 @@ GF_Err gf_sm_encode_to_file(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEncodeOp
 #else
 	e = GF_BAD_PARAM;
 #endif
-	if (e) return e;
+	return e;
+}
 
+static GF_Err gf_sm_encode_root_od(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEncodeOptions *opts)
+{
+	u32 i, count;
+	GF_Err e;
 
-	/*encode BIFS*/
-	e = gf_sm_encode_scene(ctx, mp4, opts, 0);
-	if (e) return e;
-	/*encode LASeR*/
-	e = gf_sm_encode_scene(ctx, mp4, opts, 1);
-	if (e) return e;
 	/*then encode OD to setup all streams*/
 	e = gf_sm_encode_od(ctx, mp4, opts ? opts->mediaSource : NULL, opts);
 	if (e) return e;
@@ -1433,6 +1574,172 @@ GF_Err gf_sm_encode_to_file(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEncodeOp
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_sm_encode_to_file(GF_SceneManager *ctx, GF_ISOFile *mp4, GF_SMEncodeOptions *opts)
+{
+	GF_Err e;
+	SMSceneEncoder senc;
+
+	e = gf_sm_encode_setup(ctx, mp4);
+	if (e) return e;
+
+	memset(&senc, 0, sizeof(SMSceneEncoder));
+	senc.ctx = ctx;
+	senc.mp4 = mp4;
+	/*encode BIFS*/
+	e = gf_sm_encode_scene(&senc, opts, 0);
+	if (e) return e;
+	/*encode LASeR*/
+	e = gf_sm_encode_scene(&senc, opts, 1);
+	if (e) return e;
+
+	return gf_sm_encode_root_od(ctx, mp4, opts);
+}
+
+/*encodes all loaded scene AUs, applies them to the scene graph and discards them*/
+#ifndef GPAC_DISABLE_BIFS_ENC
+void gf_bifs_encoder_node_destroyed(GF_BifsEncoder *codec, GF_Node *node);
+#endif
+
+/*nodes destroyed when applying or discarding commands may have their memory reused by nodes of the next chunks, remove them from the encoder context*/
+static void gf_sm_encode_on_node_event(void *_senc, GF_SGNodeCbkType type, GF_Node *node, void *ctxdata)
+{
+#ifndef GPAC_DISABLE_BIFS_ENC
+	SMSceneEncoder *senc = (SMSceneEncoder *)_senc;
+	if (type==GF_SG_CALLBACK_NODE_DESTROY)
+		gf_bifs_encoder_node_destroyed(senc->bifs_enc, node);
+#endif
+}
+
+static GF_Err gf_sm_encode_scene_flush(SMSceneEncoder *senc)
+{
+	u32 i, j;
+	GF_Err e;
+	GF_AUContext *au;
+	SMSceneTrack *st;
+	GF_SceneManager *ctx = senc->ctx;
+
+	i=0;
+	while ((st = (SMSceneTrack *)gf_list_enum(senc->tracks, &i))) {
+#ifndef GPAC_DISABLE_BIFS_ENC
+		if (st->bifs_enc) {
+			if ((gf_get_bit_size(ctx->max_node_id) > st->node_id_bits)
+			        || (gf_get_bit_size(ctx->max_route_id) > st->route_id_bits)
+			        || (gf_get_bit_size(ctx->max_proto_id) > st->proto_id_bits)
+			   ) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[BIFS] Node, route or proto IDs exceed the BIFSConfig ID ranges of stream %d, increase nodeIDbits, routeIDbits or protoIDbits in the BIFS config\n", st->sc->ESID));
+				return GF_NOT_SUPPORTED;
+			}
+		}
+#endif
+		j=0;
+		while ((au = (GF_AUContext *)gf_list_enum(st->sc->AUs, &j))) {
+			e = gf_sm_encode_scene_au(senc, st, au);
+			if (e) return e;
+			/*already applied by carousel and inband RAP generation*/
+			if ((senc->rap_mode==1) || (senc->rap_mode==3)) continue;
+
+			e = gf_sg_command_apply_list(ctx->scene_graph, au->commands, 0);
+			if (e) return e;
+
+			if ((senc->rap_mode!=2) || (st->nb_aus==1)) continue;
+			if (au->timing - st->last_shadow < st->rap_delay) {
+				st->shadow_pending = GF_TRUE;
+				continue;
+			}
+			st->last_shadow = au->timing - st->init_offset;
+			st->shadow_pending = GF_FALSE;
+			e = gf_sm_encode_scene_shadow(senc, st, st->last_shadow);
+			if (e) return e;
+		}
+		gf_sm_reset_stream(st->sc);
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_sm_encode_to_file_streaming(GF_SceneLoader *load, GF_ISOFile *mp4, GF_SMEncodeOptions *opts)
+{
+	u32 i;
+	GF_Err e;
+	Bool loaded;
+	SMSceneTrack *st;
+	SMSceneEncoder senc;
+	gf_sg_node_init_callback prev_node_cbk;
+	void *prev_udta;
+	GF_SceneManager *ctx = load ? load->ctx : NULL;
+
+	if (!ctx) return GF_BAD_PARAM;
+
+	switch (load->type) {
+	case GF_SM_LOAD_BT:
+	case GF_SM_LOAD_VRML:
+	case GF_SM_LOAD_X3DV:
+	case GF_SM_LOAD_XMTA:
+	case GF_SM_LOAD_X3D:
+		break;
+	default:
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CODING, ("[Scene Encode] Streaming encoding not supported for this scene type, loading the complete scene\n"));
+		e = gf_sm_load_run(load);
+		if (e<0) return e;
+		return gf_sm_encode_to_file(ctx, mp4, opts);
+	}
+	if (!load->au_window) load->au_window = 128;
+
+	/*first chunk gets the IOD, stream declarations and initial scene*/
+	e = gf_sm_load_run(load);
+	if (e<0) return e;
+	loaded = (e==GF_EOS) ? GF_TRUE : GF_FALSE;
+
+	e = gf_sm_encode_setup(ctx, mp4);
+	if (e) return e;
+
+	memset(&senc, 0, sizeof(SMSceneEncoder));
+	senc.ctx = ctx;
+	senc.mp4 = mp4;
+	senc.progressive = GF_TRUE;
+	senc.tracks = gf_list_new();
+	if (!senc.tracks) return GF_OUT_OF_MEM;
+
+	e = gf_sm_encode_scene(&senc, opts, 0);
+	if (!e) e = gf_sm_encode_scene(&senc, opts, 1);
+
+	prev_node_cbk = ctx->scene_graph->NodeCallback;
+	prev_udta = gf_sg_get_private(ctx->scene_graph);
+	gf_sg_set_node_callback(ctx->scene_graph, gf_sm_encode_on_node_event);
+	gf_sg_set_private(ctx->scene_graph, &senc);
+
+	while (!e) {
+		e = gf_sm_encode_scene_flush(&senc);
+		if (e || loaded) break;
+
+		e = gf_sm_load_run(load);
+		if (e==GF_EOS) {
+			loaded = GF_TRUE;
+			e = GF_OK;
+		}
+	}
+
+	gf_sg_set_node_callback(ctx->scene_graph, prev_node_cbk);
+	gf_sg_set_private(ctx->scene_graph, prev_udta);
+
+	i=0;
+	while ((st = (SMSceneTrack *)gf_list_enum(senc.tracks, &i))) {
+		if (!e) e = gf_sm_finalize_scene_track(&senc, st);
+		gf_sm_scene_track_del(st);
+	}
+	gf_list_del(senc.tracks);
+#ifndef GPAC_DISABLE_BIFS_ENC
+	if (senc.bifs_enc) gf_bifs_encoder_del(senc.bifs_enc);
+#endif
+#ifndef GPAC_DISABLE_LASER
+	if (senc.lsr_enc) gf_laser_encoder_del(senc.lsr_enc);
+#endif
+	if (e) return e;
+
+	return gf_sm_encode_root_od(ctx, mp4, opts);
+}
+
 #endif /*GPAC_DISABLE_ISOM_WRITE*/
 
 #endif /*GPAC_DISABLE_SCENE_ENCODER*/
@@ -109,6 +109,8 @@ typedef struct
 
 	u32 def_w, def_h;
 
+	/*number of AUs loaded in the current run when loading by chunks*/
+	u32 nb_window_aus;
 } GF_BTParser;
 
 GF_Err gf_bt_parse_bifs_command(GF_BTParser *parser, char *name, GF_List *cmdList);
@@ -3355,6 +3357,12 @@ GF_Err gf_bt_loader_run_intern(GF_BTParser *parser, GF_Command *init_com, Bool i
 			}
 			/*done loading init frame*/
 			if (init_com && parser->au_time) break;
+
+			/*previous AU is complete, suspend parsing if enough AUs have been loaded for this chunk*/
+			if (!init_com && parser->load->au_window) {
+				parser->nb_window_aus++;
+				if (parser->nb_window_aus >= parser->load->au_window) break;
+			}
 		}
 		else if (!strcmp(str, "PROTO") || !strcmp(str, "EXTERNPROTO")) {
 			gf_bt_parse_proto(parser, str, init_com ? init_com->new_proto_list : NULL);
@@ -3488,7 +3496,16 @@ GF_Err gf_bt_loader_run_intern(GF_BTParser *parser, GF_Command *init_com, Bool i
 			parser->au_is_rap = 0;
 		}
 	}
-	gf_bt_resolve_routes(parser, 0);
+	/*chunk loaded: the loaded AUs will be encoded and discarded, so forget about routes and DEF nodes declared in these AUs.
+	Routes are then resolved by name from the scene graph once applied, as done for REPLACE SCENE*/
+	if (parser->nb_window_aus && (parser->nb_window_aus >= parser->load->au_window)) {
+		parser->nb_window_aus = 0;
+		parser->bifs_au = NULL;
+		gf_bt_resolve_routes(parser, 1);
+		gf_list_reset(parser->def_nodes);
+	} else {
+		gf_bt_resolve_routes(parser, 0);
+	}
 	gf_bt_check_unresolved_nodes(parser);
 
 	/*load scripts*/
@@ -3679,6 +3696,9 @@ GF_Err load_bt_run(GF_SceneLoader *load)
 	e = gf_bt_loader_run_intern(parser, NULL, 0);
 
 	if ((e<0) || parser->done) {
+		/*signal end of input when loading by chunks*/
+		if (!e && load->au_window) e = GF_EOS;
+		parser->nb_window_aus = 0;
 		parser->done = 0;
 		parser->initialized = 0;
 		if (parser->gz_in) {
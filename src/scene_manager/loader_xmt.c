@@ -115,6 +115,11 @@ typedef struct
 	Bool au_is_rap;
 	Bool in_com;
 	GF_List *script_to_load;
+
+	/*loading by chunks: set while parsing a par element, number of par elements loaded in the current run and chunk end flag*/
+	Bool in_par;
+	u32 nb_window_aus;
+	Bool window_suspended;
 } GF_XMTParser;
 
 
@@ -2033,6 +2038,7 @@ static void xmt_parse_command(GF_XMTParser *parser, const char *name, const GF_X
 
 	if (!strcmp(name, "par")) {
 		parser->in_com = 1;
+		parser->in_par = 1;
 		for (i=0; i<nb_attributes; i++) {
 			GF_XMLAttribute *att = (GF_XMLAttribute *) &attributes[i];
 			if (!att->value || !strlen(att->value)) continue;
@@ -2757,8 +2763,18 @@ static void xmt_node_end(void *sax_cbck, const char *name, const char *name_spac
 				parser->od_command = NULL;
 			}
 
-			else if (!strcmp(name, "par"))
+			else if (!strcmp(name, "par")) {
 				parser->in_com = 1;
+				parser->in_par = 0;
+				/*AU is complete, suspend parsing if enough AUs have been loaded for this chunk*/
+				if (parser->load->au_window) {
+					parser->nb_window_aus++;
+					if (parser->nb_window_aus >= parser->load->au_window) {
+						parser->window_suspended = 1;
+						gf_xml_sax_suspend(parser->sax_parser, 1);
+					}
+				}
+			}
 
 
 		}
@@ -3128,15 +3144,39 @@ static GF_Err load_xmt_run(GF_SceneLoader *load)
 		if (!parser) return GF_OUT_OF_MEM;
 	}
 
-	e = gf_xml_sax_parse_file(parser->sax_parser, (const char *)load->fileName, xmt_progress);
+	if (parser->window_suspended) {
+		parser->window_suspended = 0;
+		e = gf_xml_sax_suspend(parser->sax_parser, 0);
+	} else {
+		e = gf_xml_sax_parse_file(parser->sax_parser, (const char *)load->fileName, xmt_progress);
+	}
+	/*entities may force parsing past the end of the chunk, finish loading the current AU*/
+	while ((e==GF_OK) && parser->window_suspended && parser->in_par) {
+		parser->window_suspended = 0;
+		e = gf_xml_sax_suspend(parser->sax_parser, 0);
+	}
 	if (e==GF_OK) e = parser->last_error;
 
 	xmt_resolve_routes(parser);
 	xmt_resolve_od_links(parser);
 
+	/*chunk loaded: the loaded AUs will be encoded and discarded, so forget about routes and DEF nodes declared in these AUs.
+	Routes are then resolved by name from the scene graph once applied, as done for scene replace*/
+	if (parser->window_suspended) {
+		parser->nb_window_aus = 0;
+		parser->scene_au = NULL;
+		gf_list_reset(parser->inserted_routes);
+		while (gf_list_count(parser->def_nodes)) {
+			GF_Node *anode = gf_list_pop_back(parser->def_nodes);
+			gf_node_unregister(anode, NULL);
+		}
+	}
+
 	parser->last_error=GF_OK;
 	if (e<0) return xmt_report(parser, e, "Invalid XML document: %s", gf_xml_sax_get_error(parser->sax_parser));
 
+	/*signal end of input when loading by chunks*/
+	if (load->au_window && !parser->window_suspended) return GF_EOS;
 	return GF_OK;
 }
 
@@ -118,7 +118,7 @@ static void gf_sm_au_del(GF_StreamContext *sc, GF_AUContext *au)
 	gf_free(au);
 }
 
-static void gf_sm_reset_stream(GF_StreamContext *sc)
+void gf_sm_reset_stream(GF_StreamContext *sc)
 {
 	while (gf_list_count(sc->AUs)) {
 		GF_AUContext *au = (GF_AUContext *)gf_list_last(sc->AUs);
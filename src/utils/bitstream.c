@@ -1558,6 +1558,52 @@ GF_Err gf_bs_transfer(GF_BitStream *dst, GF_BitStream *src, Bool keep_src)
 	return GF_OK;
 }
 
+GF_EXPORT
+void gf_bs_copy_bits(GF_BitStream *dst, GF_BitStream *src, u64 nbBits)
+{
+	u32 shift;
+	if (!src || !nbBits) return;
+
+	//read up to source byte boundary
+	while (nbBits && (src->nbBits != 8)) {
+		u32 nb = 8 - src->nbBits;
+		u32 val;
+		if (nb > nbBits) nb = (u32) nbBits;
+		val = gf_bs_read_int(src, nb);
+		if (dst) gf_bs_write_int(dst, val, nb);
+		nbBits -= nb;
+	}
+	if (!nbBits) return;
+
+	//source is aligned, copy bytes
+	if (!dst) {
+		while (nbBits >= 8) {
+			gf_bs_read_u8(src);
+			nbBits -= 8;
+		}
+	} else if (!dst->nbBits) {
+		while (nbBits >= 8) {
+			gf_bs_write_u8(dst, gf_bs_read_u8(src));
+			nbBits -= 8;
+		}
+	} else {
+		//destination not aligned: each source byte completes the pending bits of the destination,
+		//and its remaining low bits become the new pending bits
+		shift = dst->nbBits;
+		while (nbBits >= 8) {
+			u8 val = gf_bs_read_u8(src);
+			BS_WriteByte(dst, (u8) ((dst->current << (8 - shift)) | (val >> shift)) );
+			dst->current = val & ((1 << shift) - 1);
+			nbBits -= 8;
+		}
+	}
+	//remaining bits
+	if (nbBits) {
+		u32 val = gf_bs_read_int(src, (u32) nbBits);
+		if (dst) gf_bs_write_int(dst, val, (u32) nbBits);
+	}
+}
+
 GF_EXPORT
 void gf_bs_flush(GF_BitStream *bs)
 {
@@ -168,6 +168,10 @@ struct __DownloadedCacheEntryStruct
 	u32 downtime;
 
 	GF_Blob cache_blob;
+
+	/*cache index tracking the entry files, if any*/
+	GF_CacheIndex *index;
+	struct __cache_index_item *index_item;
 };
 
 Bool delete_cache_files(void *cbck, char *item_name, char *item_path, GF_FileEnumInfo *file_info) {
@@ -186,6 +190,8 @@ Bool delete_cache_files(void *cbck, char *item_name, char *item_path, GF_FileEnu
 }
 
 static const char * cache_file_prefix = "gpac_cache_";
+static const char * cache_file_info_suffix = ".txt";
+#define _CACHE_HASH_SIZE 20
 
 Bool gather_cache_size(void *cbck, char *item_name, char *item_path, GF_FileEnumInfo *file_info)
 {
@@ -196,12 +202,395 @@ Bool gather_cache_size(void *cbck, char *item_name, char *item_path, GF_FileEnum
 	return 0;
 }
 
+GF_EXPORT
 u64 gf_cache_get_size(const char * directory) {
 	u64 size = 0;
 	gf_enum_directory(directory, GF_FALSE, gather_cache_size, (void*)&size, NULL);
 	return size;
 }
 
+typedef struct __cache_index_item
+{
+	/*data file name, without directory*/
+	char *name;
+	/*size of data and info files*/
+	u64 size;
+	/*last modification time, only used when building the index*/
+	u64 last_modified;
+	/*cache entry using these files, if any*/
+	DownloadedCacheEntry entry;
+	/*least recently used first*/
+	struct __cache_index_item *prev, *next;
+	struct __cache_index_item *hash_next;
+} CacheIndexItem;
+
+struct __gf_cache_index
+{
+	char *directory;
+	CacheIndexItem *lru_first, *lru_last;
+	/*hash table of items by data file name*/
+	CacheIndexItem **buckets;
+	u32 nb_buckets, nb_items;
+	u64 size;
+	GF_Mutex *mx;
+};
+
+static u32 cache_index_hash(GF_CacheIndex *index, const char *name)
+{
+	return gf_crc_32((const u8 *) name, (u32) strlen(name)) & (index->nb_buckets-1);
+}
+
+static CacheIndexItem *cache_index_find(GF_CacheIndex *index, const char *name)
+{
+	CacheIndexItem *item = index->buckets[cache_index_hash(index, name)];
+	while (item) {
+		if (!strcmp(item->name, name)) return item;
+		item = item->hash_next;
+	}
+	return NULL;
+}
+
+static void cache_index_lru_remove(GF_CacheIndex *index, CacheIndexItem *item)
+{
+	if (item->prev) item->prev->next = item->next;
+	else index->lru_first = item->next;
+	if (item->next) item->next->prev = item->prev;
+	else index->lru_last = item->prev;
+	item->prev = item->next = NULL;
+}
+
+static void cache_index_lru_append(GF_CacheIndex *index, CacheIndexItem *item)
+{
+	item->prev = index->lru_last;
+	item->next = NULL;
+	if (index->lru_last) index->lru_last->next = item;
+	else index->lru_first = item;
+	index->lru_last = item;
+}
+
+static CacheIndexItem *cache_index_add(GF_CacheIndex *index, const char *name)
+{
+	u32 h;
+	CacheIndexItem *item;
+	/*keep at most one item per bucket on average*/
+	if (index->nb_items >= index->nb_buckets) {
+		u32 i, nb_buckets = 2*index->nb_buckets;
+		CacheIndexItem **buckets = gf_malloc(sizeof(CacheIndexItem *) * nb_buckets);
+		if (buckets) {
+			memset(buckets, 0, sizeof(CacheIndexItem *) * nb_buckets);
+			for (i=0; i<index->nb_buckets; i++) {
+				while (index->buckets[i]) {
+					item = index->buckets[i];
+					index->buckets[i] = item->hash_next;
+					h = gf_crc_32((const u8 *) item->name, (u32) strlen(item->name)) & (nb_buckets-1);
+					item->hash_next = buckets[h];
+					buckets[h] = item;
+				}
+			}
+			gf_free(index->buckets);
+			index->buckets = buckets;
+			index->nb_buckets = nb_buckets;
+		}
+	}
+	GF_SAFEALLOC(item, CacheIndexItem);
+	if (!item) return NULL;
+	item->name = gf_strdup(name);
+	if (!item->name) {
+		gf_free(item);
+		return NULL;
+	}
+	h = cache_index_hash(index, name);
+	item->hash_next = index->buckets[h];
+	index->buckets[h] = item;
+	index->nb_items++;
+	return item;
+}
+
+static void cache_index_remove(GF_CacheIndex *index, CacheIndexItem *item)
+{
+	CacheIndexItem **prev = &index->buckets[cache_index_hash(index, item->name)];
+	while (*prev != item) prev = &(*prev)->hash_next;
+	*prev = item->hash_next;
+	cache_index_lru_remove(index, item);
+	if (item->entry) item->entry->index_item = NULL;
+	index->size -= item->size;
+	index->nb_items--;
+	gf_free(item->name);
+	gf_free(item);
+}
+
+/*data files are named prefix + hash + extension, info files are named data file + info suffix
+a data file of an URL with the info suffix as extension is not an info file*/
+static Bool cache_index_is_info_file(const char *name, u32 len)
+{
+	u32 suf_len = (u32) strlen(cache_file_info_suffix);
+	if (len <= strlen(cache_file_prefix) + 2*_CACHE_HASH_SIZE + suf_len) return GF_FALSE;
+	return strcmp(name + len - suf_len, cache_file_info_suffix) ? GF_FALSE : GF_TRUE;
+}
+
+static Bool cache_index_get_path(GF_CacheIndex *index, const char *name, Bool info_file, char szPath[GF_MAX_PATH])
+{
+	u32 len = snprintf(szPath, GF_MAX_PATH, "%s%s%s", index->directory, name, info_file ? cache_file_info_suffix : "");
+	return (len < GF_MAX_PATH) ? GF_TRUE : GF_FALSE;
+}
+
+static u64 cache_index_get_file_size(const char *path)
+{
+	u64 size;
+	FILE *f = gf_fopen(path, "rb");
+	if (!f) return 0;
+	size = gf_fsize(f);
+	gf_fclose(f);
+	return size;
+}
+
+static Bool cache_index_gather_files(void *cbck, char *item_name, char *item_path, GF_FileEnumInfo *file_info)
+{
+	char szName[GF_MAX_PATH];
+	CacheIndexItem *item;
+	GF_CacheIndex *index = (GF_CacheIndex *)cbck;
+	u32 len = (u32) strlen(item_name);
+	if (strncmp(cache_file_prefix, item_name, strlen(cache_file_prefix))) return GF_FALSE;
+	if (len >= GF_MAX_PATH) return GF_FALSE;
+
+	memcpy(szName, item_name, len+1);
+	if (cache_index_is_info_file(szName, len))
+		szName[len - strlen(cache_file_info_suffix)] = 0;
+
+	item = cache_index_find(index, szName);
+	if (!item) {
+		item = cache_index_add(index, szName);
+		if (!item) return GF_TRUE;
+	}
+	item->size += file_info->size;
+	if (item->last_modified < file_info->last_modified) item->last_modified = file_info->last_modified;
+	index->size += file_info->size;
+	return GF_FALSE;
+}
+
+static int cache_index_item_cmp(const void *a, const void *b)
+{
+	const CacheIndexItem *i1 = *(const CacheIndexItem **)a;
+	const CacheIndexItem *i2 = *(const CacheIndexItem **)b;
+	if (i1->last_modified < i2->last_modified) return -1;
+	if (i1->last_modified > i2->last_modified) return 1;
+	return strcmp(i1->name, i2->name);
+}
+
+GF_EXPORT
+GF_CacheIndex *gf_cache_index_new(const char *directory)
+{
+	u32 i, j;
+	CacheIndexItem **items;
+	GF_CacheIndex *index;
+	if (!directory) return NULL;
+	GF_SAFEALLOC(index, GF_CacheIndex);
+	if (!index) return NULL;
+	index->directory = gf_strdup(directory);
+	index->nb_buckets = 256;
+	index->buckets = gf_malloc(sizeof(CacheIndexItem *) * index->nb_buckets);
+	index->mx = gf_mx_new("CacheIndex");
+	if (!index->directory || !index->buckets || !index->mx) {
+		gf_cache_index_del(index);
+		return NULL;
+	}
+	memset(index->buckets, 0, sizeof(CacheIndexItem *) * index->nb_buckets);
+	gf_enum_directory(directory, GF_FALSE, cache_index_gather_files, index, NULL);
+
+	/*files of previous sessions are ordered by modification time*/
+	items = index->nb_items ? gf_malloc(sizeof(CacheIndexItem *) * index->nb_items) : NULL;
+	if (items) {
+		for (i=0, j=0; i<index->nb_buckets; i++) {
+			CacheIndexItem *item = index->buckets[i];
+			while (item) {
+				items[j++] = item;
+				item = item->hash_next;
+			}
+		}
+		qsort(items, index->nb_items, sizeof(CacheIndexItem *), cache_index_item_cmp);
+		for (i=0; i<index->nb_items; i++)
+			cache_index_lru_append(index, items[i]);
+		gf_free(items);
+	} else {
+		for (i=0; i<index->nb_buckets; i++) {
+			CacheIndexItem *item = index->buckets[i];
+			while (item) {
+				cache_index_lru_append(index, item);
+				item = item->hash_next;
+			}
+		}
+	}
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] Indexed %d cache entries in %s, "LLU" bytes\n", index->nb_items, directory, index->size));
+	return index;
+}
+
+GF_EXPORT
+void gf_cache_index_del(GF_CacheIndex *index)
+{
+	if (!index) return;
+	if (index->buckets) {
+		while (index->lru_first)
+			cache_index_remove(index, index->lru_first);
+		gf_free(index->buckets);
+	}
+	if (index->mx) gf_mx_del(index->mx);
+	if (index->directory) gf_free(index->directory);
+	gf_free(index);
+}
+
+GF_EXPORT
+u64 gf_cache_index_get_size(GF_CacheIndex *index)
+{
+	return index ? index->size : 0;
+}
+
+GF_EXPORT
+u32 gf_cache_index_get_count(GF_CacheIndex *index)
+{
+	return index ? index->nb_items : 0;
+}
+
+GF_EXPORT
+Bool gf_cache_index_touch(GF_CacheIndex *index, const char *name)
+{
+	CacheIndexItem *item;
+	if (!index || !name) return GF_FALSE;
+	gf_mx_p(index->mx);
+	item = cache_index_find(index, name);
+	if (item && (item != index->lru_last)) {
+		cache_index_lru_remove(index, item);
+		cache_index_lru_append(index, item);
+	}
+	gf_mx_v(index->mx);
+	return item ? GF_TRUE : GF_FALSE;
+}
+
+static GF_Err cache_index_update(GF_CacheIndex *index, const char *name, DownloadedCacheEntry entry)
+{
+	u64 size;
+	char szPath[GF_MAX_PATH];
+	CacheIndexItem *item;
+
+	if (!name || !cache_index_get_path(index, name, GF_TRUE, szPath)) return GF_BAD_PARAM;
+	size = cache_index_get_file_size(szPath);
+	cache_index_get_path(index, name, GF_FALSE, szPath);
+	size += cache_index_get_file_size(szPath);
+
+	gf_mx_p(index->mx);
+	item = entry ? entry->index_item : NULL;
+	if (!item) item = cache_index_find(index, name);
+	if (!size) {
+		if (item) cache_index_remove(index, item);
+		gf_mx_v(index->mx);
+		return GF_OK;
+	}
+	if (!item) {
+		item = cache_index_add(index, name);
+		if (!item) {
+			gf_mx_v(index->mx);
+			return GF_OUT_OF_MEM;
+		}
+	} else {
+		cache_index_lru_remove(index, item);
+	}
+	if (entry && (item->entry != entry)) {
+		if (item->entry) item->entry->index_item = NULL;
+		item->entry = entry;
+		entry->index_item = item;
+	}
+	cache_index_lru_append(index, item);
+	index->size -= item->size;
+	item->size = size;
+	index->size += size;
+	gf_mx_v(index->mx);
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_cache_index_update(GF_CacheIndex *index, const char *name)
+{
+	if (!index || !name) return GF_BAD_PARAM;
+	return cache_index_update(index, name, NULL);
+}
+
+GF_EXPORT
+u64 gf_cache_index_evict(GF_CacheIndex *index, u64 max_size)
+{
+	u32 nb_evicted = 0;
+	u64 size;
+	CacheIndexItem *item;
+	if (!index) return 0;
+
+	gf_mx_p(index->mx);
+	item = index->lru_first;
+	while (item && (index->size > max_size)) {
+		char szPath[GF_MAX_PATH];
+		CacheIndexItem *next = item->next;
+		DownloadedCacheEntry entry = item->entry;
+		szPath[0] = 0;
+		/*files of entries being written or read are kept*/
+		if (entry && (entry->write_session || gf_list_count(entry->sessions))) {
+			item = next;
+			continue;
+		}
+		if (cache_index_get_path(index, item->name, GF_FALSE, szPath)) {
+			if (gf_file_exists(szPath) && (gf_file_delete(szPath) != GF_OK)) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CACHE, ("[CACHE] : failed to cleanup file %s\n", szPath));
+				item = next;
+				continue;
+			}
+			cache_index_get_path(index, item->name, GF_TRUE, szPath);
+			if (gf_file_exists(szPath)) gf_file_delete(szPath);
+		}
+		/*the entry is kept by the download manager, reusing it will download the resource again*/
+		if (entry) {
+			entry->flags |= CORRUPTED;
+			entry->file_exists = GF_FALSE;
+			entry->cacheSize = 0;
+			/*config files are saved at destruction once modified, restart from an empty info file so that it is not written back*/
+			if (entry->properties && szPath[0]) {
+				gf_cfg_discard_changes(entry->properties);
+				gf_cfg_del(entry->properties);
+				entry->properties = gf_cfg_force_new(NULL, szPath);
+			}
+		}
+		cache_index_remove(index, item);
+		nb_evicted++;
+		item = next;
+	}
+	size = index->size;
+	gf_mx_v(index->mx);
+	if (nb_evicted) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[CACHE] Removed %d least recently used cache entries, cache size now "LLU" bytes\n", nb_evicted, size));
+	}
+	return size;
+}
+
+static const char *cache_entry_get_file_name(const DownloadedCacheEntry entry)
+{
+	if (!entry->cache_filename || entry->memory_stored) return NULL;
+	return gf_file_basename(entry->cache_filename);
+}
+
+GF_EXPORT
+void gf_cache_index_attach_entry(GF_CacheIndex *index, DownloadedCacheEntry entry)
+{
+	const char *name;
+	CacheIndexItem *item;
+	if (!index || !entry || entry->index) return;
+	name = cache_entry_get_file_name(entry);
+	if (!name) return;
+	entry->index = index;
+	gf_mx_p(index->mx);
+	item = cache_index_find(index, name);
+	if (item) {
+		item->entry = entry;
+		entry->index_item = item;
+	}
+	gf_mx_v(index->mx);
+}
+
+GF_EXPORT
 GF_Err gf_cache_delete_all_cached_files(const char * directory) {
 	GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("Deleting cached files in %s...\n", directory));
 	return gf_enum_directory( directory, GF_FALSE, delete_cache_files, (void*)cache_file_prefix, NULL);
@@ -374,10 +763,8 @@ GF_Err gf_cache_append_http_headers(const DownloadedCacheEntry entry, char * htt
 	return GF_OK;
 }
 
-#define _CACHE_HASH_SIZE 20
 #define _CACHE_MAX_EXTENSION_SIZE 6
 static const char * default_cache_file_suffix = ".dat";
-static const char * cache_file_info_suffix = ".txt";
 
 DownloadedCacheEntry gf_cache_create_entry ( GF_DownloadManager * dm, const char * cache_directory, const char * url , u64 start_range, u64 end_range, Bool mem_storage)
 {
@@ -615,6 +1002,8 @@ GF_Err gf_cache_close_write_cache( const DownloadedCacheEntry entry, const GF_Do
 #ifdef ENABLE_WRITE_MX
 	gf_mx_v(entry->write_mutex);
 #endif
+	if (entry->index && !entry->memory_stored)
+		cache_index_update(entry->index, cache_entry_get_file_name(entry), entry);
 	return e;
 }
 
@@ -706,6 +1095,8 @@ GF_Err gf_cache_write_to_cache( const DownloadedCacheEntry entry, const GF_Downl
 		       ("[CACHE] Error while writting %d bytes of data to cache : has written only %d bytes.", size, read));
 		gf_cache_close_write_cache(entry, sess, GF_FALSE);
 		gf_file_delete(entry->cache_filename);
+		if (entry->index)
+			cache_index_update(entry->index, cache_entry_get_file_name(entry), entry);
 		return GF_IO_ERR;
 	}
 	if (gf_fflush(entry->writeFilePtr)) {
@@ -713,6 +1104,8 @@ GF_Err gf_cache_write_to_cache( const DownloadedCacheEntry entry, const GF_Downl
 		       ("[CACHE] Error while flushing data bytes to cache file : %s.", entry->cache_filename));
 		gf_cache_close_write_cache(entry, sess, GF_FALSE);
 		gf_file_delete(entry->cache_filename);
+		if (entry->index)
+			cache_index_update(entry->index, cache_entry_get_file_name(entry), entry);
 		return GF_IO_ERR;
 	}
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] Writing %d bytes to cache\n", size));
@@ -721,8 +1114,23 @@ GF_Err gf_cache_write_to_cache( const DownloadedCacheEntry entry, const GF_Downl
 
 GF_Err gf_cache_delete_entry ( const DownloadedCacheEntry entry )
 {
+	char szName[GF_MAX_PATH];
+	GF_CacheIndex *index;
 	if ( !entry )
 		return GF_OK;
+	szName[0] = 0;
+	index = entry->index;
+	if (index) {
+		gf_mx_p(index->mx);
+		if (entry->index_item) entry->index_item->entry = NULL;
+		entry->index_item = NULL;
+		gf_mx_v(index->mx);
+		/*files are deleted below, update index once done*/
+		if (entry->deletableFilesOnDelete && cache_entry_get_file_name(entry)) {
+			strncpy(szName, cache_entry_get_file_name(entry), GF_MAX_PATH-1);
+			szName[GF_MAX_PATH-1] = 0;
+		}
+	}
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] gf_cache_delete_entry:%d, entry=%p, url=%s\n", __LINE__, entry, entry->url));
 	if (entry->writeFilePtr) {
 		/** Cache should have been close before, abornormal situation */
@@ -796,6 +1204,8 @@ GF_Err gf_cache_delete_entry ( const DownloadedCacheEntry entry )
         gf_cfg_del ( entry->properties );
         entry->properties = NULL;
     }
+	if (szName[0])
+		cache_index_update(index, szName, NULL);
 	entry->dm = NULL;
 	if (entry->sessions) {
 		assert( gf_list_count(entry->sessions) == 0);
@@ -888,6 +1298,14 @@ s32 gf_cache_add_session_to_cache_entry(DownloadedCacheEntry entry, GF_DownloadS
 		}
 	}
 	gf_list_add(entry->sessions, sess);
+	if (entry->index) {
+		gf_mx_p(entry->index->mx);
+		if (entry->index_item && (entry->index_item != entry->index->lru_last)) {
+			cache_index_lru_remove(entry->index, entry->index_item);
+			cache_index_lru_append(entry->index, entry->index_item);
+		}
+		gf_mx_v(entry->index->mx);
+	}
 	return count + 1;
 }
 
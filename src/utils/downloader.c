@@ -217,6 +217,7 @@ struct __gf_download_manager
 	Bool disable_cache, simulate_no_connection, allow_offline_cache, clean_cache;
 	u32 limit_data_rate, read_buf_size;
 	u64 max_cache_size;
+	GF_CacheIndex *cache_index;
 	Bool allow_broken_certificate;
 
 	GF_List *skip_proxy_servers;
@@ -644,9 +645,11 @@ Bool gf_cache_set_downtime(const DownloadedCacheEntry entry, u32 download_time_m
  * If the cache entry is marked for deletion and has no sessions associated with it, it will be
  * removed (so some modules using a streaming like cache will still work).
  */
+static void gf_dm_clean_cache(GF_DownloadManager *dm);
+
 static void gf_dm_remove_cache_entry_from_session(GF_DownloadSession * sess) {
 	if (sess && sess->cache_entry) {
-		gf_cache_remove_session_from_cache_entry(sess->cache_entry, sess);
+		s32 nb_sessions = gf_cache_remove_session_from_cache_entry(sess->cache_entry, sess);
 		if (sess->dm
 		        /*JLF - not sure what the rationale of this test is, and it prevents cleanup of cache entry
 		        which then results to crash when restarting the session (entry->writeFilePtr i snot set back to NULL)*/
@@ -668,6 +671,9 @@ static void gf_dm_remove_cache_entry_from_session(GF_DownloadSession * sess) {
 			}
 			gf_mx_v( sess->dm->cache_mx );
 		}
+		/*files of entries no longer used can now be evicted*/
+		if (!nb_sessions && sess->dm && sess->dm->cache_index && (gf_cache_index_get_size(sess->dm->cache_index) >= sess->dm->max_cache_size))
+			gf_dm_clean_cache(sess->dm);
 	}
 }
 
@@ -717,6 +723,7 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 				sess->cache_entry = NULL;
 			}
 			entry = gf_cache_create_entry(sess->dm, sess->dm->cache_directory, sess->orig_url, sess->range_start, sess->range_end, (sess->flags&GF_NETIO_SESSION_MEMORY_CACHE) ? GF_TRUE : GF_FALSE);
+			gf_cache_index_attach_entry(sess->dm->cache_index, entry);
 			gf_mx_p( sess->dm->cache_mx );
 			gf_list_add(sess->dm->cache_entries, entry);
 			gf_mx_v( sess->dm->cache_mx );
@@ -2062,10 +2069,22 @@ typedef struct
 
 static void gf_dm_clean_cache(GF_DownloadManager *dm)
 {
-	u64 out_size = gf_cache_get_size(dm->cache_directory);
-	if (out_size >= dm->max_cache_size) {
-		GF_LOG(dm->max_cache_size ? GF_LOG_WARNING : GF_LOG_INFO, GF_LOG_HTTP, ("[Cache] Cache size %d exceeds max allowed %d, deleting entire cache\n", out_size, dm->max_cache_size));
+	u64 out_size;
+	if (!dm->max_cache_size) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[Cache] Deleting entire cache\n"));
 		gf_cache_delete_all_cached_files(dm->cache_directory);
+		return;
+	}
+	//the directory is only scanned once, the index is then updated by the cache entries
+	if (!dm->cache_index) {
+		dm->cache_index = gf_cache_index_new(dm->cache_directory);
+		if (!dm->cache_index) return;
+	}
+	out_size = gf_cache_index_get_size(dm->cache_index);
+	if (out_size >= dm->max_cache_size) {
+		//remove least recently used entries until we are below 90% of allowed size, so that we don't trigger cleanup at each new download
+		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[Cache] Cache size "LLU" exceeds max allowed "LLU", removing least recently used entries\n", out_size, dm->max_cache_size));
+		gf_cache_index_evict(dm->cache_index, dm->max_cache_size - dm->max_cache_size/10);
 	}
 }
 
@@ -2234,6 +2253,8 @@ void gf_dm_del(GF_DownloadManager *dm)
 		gf_list_del( dm->cache_entries );
 		dm->cache_entries = NULL;
 	}
+	if (dm->cache_index) gf_cache_index_del(dm->cache_index);
+	dm->cache_index = NULL;
 
 	gf_list_del( dm->partial_downloads );
 	dm->partial_downloads = NULL;
@@ -2522,6 +2543,10 @@ static GFINLINE void gf_dm_data_received(GF_DownloadSession *sess, u8 *payload,
 			gf_cache_close_write_cache(sess->cache_entry, sess, GF_TRUE);
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP,
 			       ("[CACHE] url %s saved as %s\n", gf_cache_get_url(sess->cache_entry), gf_cache_get_cache_filename(sess->cache_entry)));
+
+			//the cache index is updated when closing the cache file
+			if (sess->dm && sess->dm->cache_index && (gf_cache_index_get_size(sess->dm->cache_index) >= sess->dm->max_cache_size))
+				gf_dm_clean_cache(sess->dm);
 		}
 
 		gf_dm_disconnect(sess, GF_FALSE);
@@ -26,38 +26,43 @@
 #include <gpac/tools.h>
 
 
-//ugly patch, we have a concurrence issue with gf_4cc_to_str, for now fixed by rolling buffers
+//ugly patch, we have a concurrence issue with gf_4cc_to_str, for now fixed by rolling buffers - threads should use gf_4cc_to_str_safe
 #define NB_4CC_BUF	10
 static char szTYPE_BUF[NB_4CC_BUF][GF_4CC_MSIZE];
 static u32 buf_4cc_idx=0;
 
 GF_EXPORT
-const char *gf_4cc_to_str(u32 type)
+const char *gf_4cc_to_str_safe(u32 type, char szType[GF_4CC_MSIZE])
 {
 	u32 ch, i;
-	Bool is_ok=GF_TRUE;
-	char *szTYPE = szTYPE_BUF[buf_4cc_idx];
-	char *name = (char *)szTYPE;
-	if (!type) return "00000000";
-	buf_4cc_idx++;
-	if (buf_4cc_idx==NB_4CC_BUF)
-		buf_4cc_idx=0;
-
+	char *name = szType;
+	if (!type) {
+		strcpy(szType, "00000000");
+		return (const char *) szType;
+	}
 	for (i = 0; i < 4; i++, name++) {
 		ch = type >> (8 * (3-i) ) & 0xff;
 		if ( ch >= 0x20 && ch <= 0x7E ) {
 			*name = ch;
 		} else {
-			is_ok=GF_FALSE;
-			break;
+			sprintf(szType, "%02X%02X%02X%02X", (type>>24)&0xFF, (type>>16)&0xFF, (type>>8)&0xFF, (type)&0xFF);
+			return (const char *) szType;
 		}
 	}
-	if (is_ok) {
-		*name = 0;
-		return (const char *) szTYPE;
-	}
-	sprintf(szTYPE, "%02X%02X%02X%02X", (type>>24)&0xFF, (type>>16)&0xFF, (type>>8)&0xFF, (type)&0xFF);
-	return (const char *) szTYPE;
+	*name = 0;
+	return (const char *) szType;
+}
+
+GF_EXPORT
+const char *gf_4cc_to_str(u32 type)
+{
+	char *szTYPE = szTYPE_BUF[buf_4cc_idx];
+	if (!type) return "00000000";
+	buf_4cc_idx++;
+	if (buf_4cc_idx==NB_4CC_BUF)
+		buf_4cc_idx=0;
+
+	return gf_4cc_to_str_safe(type, szTYPE);
 }
 
 
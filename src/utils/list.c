@@ -586,11 +586,15 @@ void gf_list_reset(GF_List *ptr)
 #else	/*GF_LIST_ARRAY_GROW*/
 
 
+/*number of slots allocated with the list*/
+#define GF_LIST_INLINE_SLOTS	4
+
 struct _tag_array
 {
 	void **slots;
 	u32 entryCount;
 	u32 allocSize;
+	void *inline_slots[GF_LIST_INLINE_SLOTS];
 };
 
 GF_EXPORT
@@ -598,12 +602,13 @@ GF_List * gf_list_new()
 {
 	GF_List *nlist;
 
+	//first slots are allocated with the list, most lists (box children, ...) never grow beyond
 	nlist = (GF_List *) gf_malloc(sizeof(GF_List));
 	if (! nlist) return NULL;
 
-	nlist->slots = NULL;
+	nlist->slots = nlist->inline_slots;
 	nlist->entryCount = 0;
-	nlist->allocSize = 0;
+	nlist->allocSize = GF_LIST_INLINE_SLOTS;
 	return nlist;
 }
 
@@ -611,14 +616,22 @@ GF_EXPORT
 void gf_list_del(GF_List *ptr)
 {
 	if (!ptr) return;
-	gf_free(ptr->slots);
+	if (ptr->slots != ptr->inline_slots)
+		gf_free(ptr->slots);
 	gf_free(ptr);
 }
 
 static void realloc_chain(GF_List *ptr)
 {
-	GF_LIST_REALLOC(ptr->allocSize);
-	ptr->slots = (void**)gf_realloc(ptr->slots, ptr->allocSize*sizeof(void*));
+	if (ptr->slots == ptr->inline_slots) {
+		ptr->allocSize = 0;
+		GF_LIST_REALLOC(ptr->allocSize);
+		ptr->slots = (void**)gf_malloc(ptr->allocSize*sizeof(void*));
+		if (ptr->slots) memcpy(ptr->slots, ptr->inline_slots, sizeof(void*) * ptr->entryCount);
+	} else {
+		GF_LIST_REALLOC(ptr->allocSize);
+		ptr->slots = (void**)gf_realloc(ptr->slots, ptr->allocSize*sizeof(void*));
+	}
 }
 
 GF_EXPORT
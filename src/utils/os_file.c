@@ -1067,9 +1067,8 @@ int gf_fileio_printf(GF_FileIO *gfio, const char *format, va_list args)
 		gfio->printf_alloc = len+1;
 		gfio->printf_buf = gf_realloc(gfio->printf_buf, gfio->printf_alloc);
 	}
-	vsnprintf(gfio->printf_buf, len, format, args);
-	gfio->printf_buf[len] = 0;
-	return gfio->write(gfio, gfio->printf_buf, len+1);
+	vsnprintf(gfio->printf_buf, len+1, format, args);
+	return gfio->write(gfio, gfio->printf_buf, len);
 }
 
 GF_EXPORT
@@ -1234,6 +1233,145 @@ static GF_FileIO *gf_fileio_from_blob(const char *file_name)
 	gfio_blob->size = blob_size;
 	return gf_fileio_new((char *) file_name, gfio_blob, gfio_blob_open, gfio_blob_seek, gfio_blob_read, NULL, gfio_blob_tell, gfio_blob_eof, NULL);
 }
+
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc, pos;
+} GF_FileIOMem;
+
+static GF_FileIO *gfio_mem_open(GF_FileIO *fileio_ref, const char *url, const char *mode, GF_Err *out_error)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio_ref);
+	*out_error = GF_OK;
+	if (!url) {
+		if (mem->data) gf_free(mem->data);
+		gf_free(mem);
+		gf_fileio_del(fileio_ref);
+		return NULL;
+	}
+	*out_error = GF_NOT_SUPPORTED;
+	return NULL;
+}
+
+static GF_Err gfio_mem_seek(GF_FileIO *fileio, u64 offset, s32 whence)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	if (whence==SEEK_END) offset += mem->size;
+	else if (whence==SEEK_CUR) offset += mem->pos;
+	if (offset > mem->size) return GF_BAD_PARAM;
+	mem->pos = (u32) offset;
+	return GF_OK;
+}
+
+static u32 gfio_mem_read(GF_FileIO *fileio, u8 *buffer, u32 bytes)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	if (bytes + mem->pos > mem->size)
+		bytes = mem->size - mem->pos;
+	if (bytes) {
+		memcpy(buffer, mem->data + mem->pos, bytes);
+		mem->pos += bytes;
+	}
+	return bytes;
+}
+
+static Bool gfio_mem_realloc(GF_FileIOMem *mem, u32 size)
+{
+	u32 new_alloc;
+	if (size <= mem->alloc) return GF_TRUE;
+	new_alloc = mem->alloc ? mem->alloc : 4096;
+	while (new_alloc < size) new_alloc *= 2;
+	mem->data = gf_realloc(mem->data, new_alloc);
+	if (!mem->data) {
+		mem->size = mem->alloc = mem->pos = 0;
+		return GF_FALSE;
+	}
+	mem->alloc = new_alloc;
+	return GF_TRUE;
+}
+
+static u32 gfio_mem_write(GF_FileIO *fileio, u8 *buffer, u32 bytes)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	if (!bytes) return 0;
+	if (!gfio_mem_realloc(mem, mem->pos + bytes)) return 0;
+	memcpy(mem->data + mem->pos, buffer, bytes);
+	mem->pos += bytes;
+	if (mem->pos > mem->size) mem->size = mem->pos;
+	return bytes;
+}
+
+static int gfio_mem_printf(GF_FileIO *fileio, const char *format, va_list args)
+{
+	va_list args_copy;
+	s32 len;
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+
+	//try formatting in place, most manifest lines fit in the remaining space
+	va_copy(args_copy, args);
+	len = vsnprintf(mem->alloc ? (char *) mem->data + mem->pos : NULL, mem->alloc - mem->pos, format, args_copy);
+	va_end(args_copy);
+	if (len<0) return -1;
+
+	if (mem->pos + (u32) len + 1 > mem->alloc) {
+		if (!gfio_mem_realloc(mem, mem->pos + len + 1)) return -1;
+		vsnprintf((char *) mem->data + mem->pos, len+1, format, args);
+	}
+	mem->pos += len;
+	if (mem->pos > mem->size) mem->size = mem->pos;
+	return len;
+}
+
+static s64 gfio_mem_tell(GF_FileIO *fileio)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	return (s64) mem->pos;
+}
+
+static Bool gfio_mem_eof(GF_FileIO *fileio)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	return (mem->pos==mem->size) ? GF_TRUE : GF_FALSE;
+}
+
+GF_EXPORT
+FILE *gf_file_temp_mem()
+{
+	GF_FileIO *gfio;
+	GF_FileIOMem *mem;
+	GF_SAFEALLOC(mem, GF_FileIOMem);
+	if (!mem) return NULL;
+	gfio = gf_fileio_new(NULL, mem, gfio_mem_open, gfio_mem_seek, gfio_mem_read, gfio_mem_write, gfio_mem_tell, gfio_mem_eof, gfio_mem_printf);
+	if (!gfio) {
+		gf_free(mem);
+		return NULL;
+	}
+	gf_register_file_handle(gfio->url, (FILE *) gfio);
+	return (FILE *) gfio;
+}
+
+GF_EXPORT
+const u8 *gf_file_temp_mem_data(FILE *fp, u32 *size)
+{
+	GF_FileIOMem *mem;
+	if (size) *size = 0;
+	if (!gf_fileio_check(fp) || (((GF_FileIO *)fp)->open != gfio_mem_open))
+		return NULL;
+	mem = gf_fileio_get_udta((GF_FileIO *)fp);
+	if (size) *size = mem->size;
+	return mem->data;
+}
+
+GF_EXPORT
+void gf_file_temp_mem_reset(FILE *fp)
+{
+	GF_FileIOMem *mem;
+	if (!gf_fileio_check(fp) || (((GF_FileIO *)fp)->open != gfio_mem_open))
+		return;
+	mem = gf_fileio_get_udta((GF_FileIO *)fp);
+	mem->size = mem->pos = 0;
+}
 GF_EXPORT
 FILE *gf_fopen_ex(const char *file_name, const char *parent_name, const char *mode)
 {
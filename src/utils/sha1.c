@@ -401,14 +401,17 @@ struct __sha1_context
 
 
 /*
- *  SHA1ProcessMessageBlock
+ *  sha1_process_block_c
  *
  *  Description:
  *      This function will process the next 512 bits of the message
- *      stored in the Message_Block array.
+ *      stored in the given block, updating the given digest.
  *
  *  Parameters:
- *      None.
+ *      digest: [in/out]
+ *          The 5 words of the message digest.
+ *      block: [in]
+ *          The 64 bytes of the message block.
  *
  *  Returns:
  *      Nothing.
@@ -420,7 +423,7 @@ struct __sha1_context
  *
  *
  */
-void SHA1ProcessMessageBlock(GF_SHA1Context *context)
+static void sha1_process_block_c(unsigned *digest, const u8 *block)
 {
 	const unsigned K[] =            /* Constants defined in SHA-1   */
 	{
@@ -439,10 +442,10 @@ void SHA1ProcessMessageBlock(GF_SHA1Context *context)
 	 */
 	for(t = 0; t < 16; t++)
 	{
-		W[t] = ((unsigned) context->Message_Block[t * 4]) << 24;
-		W[t] |= ((unsigned) context->Message_Block[t * 4 + 1]) << 16;
-		W[t] |= ((unsigned) context->Message_Block[t * 4 + 2]) << 8;
-		W[t] |= ((unsigned) context->Message_Block[t * 4 + 3]);
+		W[t] = ((unsigned) block[t * 4]) << 24;
+		W[t] |= ((unsigned) block[t * 4 + 1]) << 16;
+		W[t] |= ((unsigned) block[t * 4 + 2]) << 8;
+		W[t] |= ((unsigned) block[t * 4 + 3]);
 	}
 
 	for(t = 16; t < 80; t++)
@@ -450,11 +453,11 @@ void SHA1ProcessMessageBlock(GF_SHA1Context *context)
 		W[t] = SHA1CircularShift(1,W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]);
 	}
 
-	A = context->Message_Digest[0];
-	B = context->Message_Digest[1];
-	C = context->Message_Digest[2];
-	D = context->Message_Digest[3];
-	E = context->Message_Digest[4];
+	A = digest[0];
+	B = digest[1];
+	C = digest[2];
+	D = digest[3];
+	E = digest[4];
 
 	for(t = 0; t < 20; t++)
 	{
@@ -502,17 +505,139 @@ void SHA1ProcessMessageBlock(GF_SHA1Context *context)
 		A = temp;
 	}
 
-	context->Message_Digest[0] =
-	    (context->Message_Digest[0] + A) & 0xFFFFFFFF;
-	context->Message_Digest[1] =
-	    (context->Message_Digest[1] + B) & 0xFFFFFFFF;
-	context->Message_Digest[2] =
-	    (context->Message_Digest[2] + C) & 0xFFFFFFFF;
-	context->Message_Digest[3] =
-	    (context->Message_Digest[3] + D) & 0xFFFFFFFF;
-	context->Message_Digest[4] =
-	    (context->Message_Digest[4] + E) & 0xFFFFFFFF;
+	digest[0] =
+	    (digest[0] + A) & 0xFFFFFFFF;
+	digest[1] =
+	    (digest[1] + B) & 0xFFFFFFFF;
+	digest[2] =
+	    (digest[2] + C) & 0xFFFFFFFF;
+	digest[3] =
+	    (digest[3] + D) & 0xFFFFFFFF;
+	digest[4] =
+	    (digest[4] + E) & 0xFFFFFFFF;
+}
+
+/*
+ *  SHA-NI implementation, used when the CPU supports the SHA extensions.
+ *  The instruction set is checked at run time so that generic builds still benefit from it.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(GPAC_DISABLE_SHA_NI)
+#define GPAC_HAS_SHA_NI
+#include <immintrin.h>
+#include <cpuid.h>
+
+#define SHANI_ROUND4(_en, _eo, _m0, _m1, _m2, _m3, _f) \
+	_en = _mm_sha1nexte_epu32(_en, _m0); \
+	_eo = abcd; \
+	_m1 = _mm_sha1msg2_epu32(_m1, _m0); \
+	abcd = _mm_sha1rnds4_epu32(abcd, _en, _f); \
+	_m3 = _mm_sha1msg1_epu32(_m3, _m0); \
+	_m2 = _mm_xor_si128(_m2, _m0);
+
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha1_process_blocks_shani(unsigned *digest, const u8 *data, u32 nb_blocks)
+{
+	__m128i abcd, abcd_save, e0, e0_save, e1;
+	__m128i msg0, msg1, msg2, msg3;
+	const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+	abcd = _mm_loadu_si128((const __m128i *) digest);
+	e0 = _mm_set_epi32(digest[4], 0, 0, 0);
+	abcd = _mm_shuffle_epi32(abcd, 0x1B);
+
+	while (nb_blocks) {
+		abcd_save = abcd;
+		e0_save = e0;
+
+		/* rounds 0-3 */
+		msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) data), mask);
+		e0 = _mm_add_epi32(e0, msg0);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+		/* rounds 4-7 */
+		msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 16)), mask);
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+		/* rounds 8-11 */
+		msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 32)), mask);
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		/* rounds 12-79 */
+		msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 48)), mask);
+		SHANI_ROUND4(e1, e0, msg3, msg0, msg1, msg2, 0)
+		SHANI_ROUND4(e0, e1, msg0, msg1, msg2, msg3, 0)
+		SHANI_ROUND4(e1, e0, msg1, msg2, msg3, msg0, 1)
+		SHANI_ROUND4(e0, e1, msg2, msg3, msg0, msg1, 1)
+		SHANI_ROUND4(e1, e0, msg3, msg0, msg1, msg2, 1)
+		SHANI_ROUND4(e0, e1, msg0, msg1, msg2, msg3, 1)
+		SHANI_ROUND4(e1, e0, msg1, msg2, msg3, msg0, 1)
+		SHANI_ROUND4(e0, e1, msg2, msg3, msg0, msg1, 2)
+		SHANI_ROUND4(e1, e0, msg3, msg0, msg1, msg2, 2)
+		SHANI_ROUND4(e0, e1, msg0, msg1, msg2, msg3, 2)
+		SHANI_ROUND4(e1, e0, msg1, msg2, msg3, msg0, 2)
+		SHANI_ROUND4(e0, e1, msg2, msg3, msg0, msg1, 2)
+		SHANI_ROUND4(e1, e0, msg3, msg0, msg1, msg2, 3)
+		SHANI_ROUND4(e0, e1, msg0, msg1, msg2, msg3, 3)
+		SHANI_ROUND4(e1, e0, msg1, msg2, msg3, msg0, 3)
+		SHANI_ROUND4(e0, e1, msg2, msg3, msg0, msg1, 3)
+		SHANI_ROUND4(e1, e0, msg3, msg0, msg1, msg2, 3)
+
+		e0 = _mm_sha1nexte_epu32(e0, e0_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+
+		data += 64;
+		nb_blocks--;
+	}
+
+	abcd = _mm_shuffle_epi32(abcd, 0x1B);
+	_mm_storeu_si128((__m128i *) digest, abcd);
+	digest[4] = (unsigned) _mm_extract_epi32(e0, 3);
+}
+#undef SHANI_ROUND4
 
+static Bool sha1_has_shani()
+{
+	unsigned int eax, ebx, ecx, edx;
+	if (__get_cpuid_max(0, NULL) < 7) return GF_FALSE;
+	__cpuid(1, eax, ebx, ecx, edx);
+	//SSSE3 and SSE4.1
+	if (!(ecx & (1<<9)) || !(ecx & (1<<19))) return GF_FALSE;
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+	return (ebx & (1<<29)) ? GF_TRUE : GF_FALSE;
+}
+#endif
+
+/*
+ *  Process nb_blocks 512-bit blocks
+ */
+static void sha1_process_blocks(unsigned *digest, const u8 *data, u32 nb_blocks)
+{
+#ifdef GPAC_HAS_SHA_NI
+	static s32 use_shani = -1;
+	if (use_shani<0) use_shani = sha1_has_shani() ? 1 : 0;
+	if (use_shani) {
+		sha1_process_blocks_shani(digest, data, nb_blocks);
+		return;
+	}
+#endif
+	while (nb_blocks) {
+		sha1_process_block_c(digest, data);
+		data += 64;
+		nb_blocks--;
+	}
+}
+
+static void SHA1ProcessMessageBlock(GF_SHA1Context *context)
+{
+	sha1_process_blocks(context->Message_Digest, context->Message_Block, 1);
 	context->Message_Block_Index = 0;
 }
 
@@ -624,6 +749,7 @@ GF_SHA1Context *gf_sha1_starts()
 
 void gf_sha1_update(GF_SHA1Context *context, u8 *message_array, u32 length )
 {
+	u64 nb_bits;
 	if (!length)
 	{
 		return;
@@ -635,32 +761,44 @@ void gf_sha1_update(GF_SHA1Context *context, u8 *message_array, u32 length )
 		return;
 	}
 
-	while(length-- && !context->Corrupted)
+	nb_bits = ((u64) context->Length_High << 32) | context->Length_Low;
+	if (nb_bits + (u64) length * 8 < nb_bits)
 	{
-		context->Message_Block[context->Message_Block_Index++] =
-		    (*message_array & 0xFF);
+		/* Message is too long */
+		context->Corrupted = 1;
+		return;
+	}
+	nb_bits += (u64) length * 8;
+	context->Length_Low = (unsigned) (nb_bits & 0xFFFFFFFF);
+	context->Length_High = (unsigned) (nb_bits >> 32);
 
-		context->Length_Low += 8;
-		/* Force it to 32 bits */
-		context->Length_Low &= 0xFFFFFFFF;
-		if (context->Length_Low == 0)
-		{
-			context->Length_High++;
-			/* Force it to 32 bits */
-			context->Length_High &= 0xFFFFFFFF;
-			if (context->Length_High == 0)
-			{
-				/* Message is too long */
-				context->Corrupted = 1;
-			}
-		}
+	/* complete pending block */
+	if (context->Message_Block_Index)
+	{
+		u32 fill = 64 - context->Message_Block_Index;
+		if (fill > length) fill = length;
+		memcpy(context->Message_Block + context->Message_Block_Index, message_array, fill);
+		context->Message_Block_Index += fill;
+		message_array += fill;
+		length -= fill;
+		if (context->Message_Block_Index < 64)
+			return;
+		SHA1ProcessMessageBlock(context);
+	}
 
-		if (context->Message_Block_Index == 64)
-		{
-			SHA1ProcessMessageBlock(context);
-		}
+	/* process full blocks directly from input */
+	if (length >= 64)
+	{
+		u32 nb_blocks = length / 64;
+		sha1_process_blocks(context->Message_Digest, message_array, nb_blocks);
+		message_array += nb_blocks * 64;
+		length -= nb_blocks * 64;
+	}
 
-		message_array++;
+	if (length)
+	{
+		memcpy(context->Message_Block, message_array, length);
+		context->Message_Block_Index = length;
 	}
 }
 void gf_sha1_finish(GF_SHA1Context *context, u8 output[GF_SHA1_DIGEST_SIZE] )
@@ -686,6 +824,9 @@ void gf_sha1_finish(GF_SHA1Context *context, u8 output[GF_SHA1_DIGEST_SIZE] )
 
 #endif
 
+//read size used when hashing files
+#define SHA1_FILE_BLOCK_SIZE	65536
+
 /*
  * Output = SHA-1( file contents )
  */
@@ -695,7 +836,7 @@ GF_Err gf_sha1_file( const char *path, u8 output[GF_SHA1_DIGEST_SIZE] )
 	FILE *f;
 	size_t n;
 	GF_SHA1Context *ctx;
-	u8 buf[1024];
+	u8 *buf;
 
 	if (!strncmp(path, "gmem://", 7)) {
 		u32 size;
@@ -710,13 +851,22 @@ GF_Err gf_sha1_file( const char *path, u8 output[GF_SHA1_DIGEST_SIZE] )
 	if( ( f = gf_fopen( path, "rb" ) ) == NULL )
 		return GF_URL_ERROR;
 
+	//use large reads, block processing is much faster than the I/O calls for small blocks
+	buf = gf_malloc(SHA1_FILE_BLOCK_SIZE);
 	ctx  = gf_sha1_starts();
+	if (!buf || !ctx) {
+		if (buf) gf_free(buf);
+		if (ctx) gf_free(ctx);
+		gf_fclose( f );
+		return GF_OUT_OF_MEM;
+	}
 
-	while( ( n = gf_fread( buf, sizeof( buf ), f ) ) > 0 )
-		gf_sha1_update(ctx, buf, (s32) n );
+	while( ( n = gf_fread( buf, SHA1_FILE_BLOCK_SIZE, f ) ) > 0 )
+		gf_sha1_update(ctx, buf, (u32) n );
 
 	gf_sha1_finish(ctx, output );
 
+	gf_free(buf);
 	gf_fclose( f );
 	return GF_OK;
 }
@@ -0,0 +1,249 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: GPAC contributors
+ *			Copyright (c) GPAC contributors 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / common tools sub-project
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/tools.h>
+
+#ifndef GPAC_DISABLE_CORE_TOOLS
+
+/*
+ * SHA-256 as specified in FIPS 180-4
+ */
+
+//read size used when hashing files
+#define SHA256_FILE_BLOCK_SIZE	65536
+
+struct __sha256_context
+{
+	u32 state[8];
+	u64 nb_bytes;
+	u8 block[64];
+	u32 block_size;
+};
+
+static const u32 sha256_k[64] =
+{
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR(_x, _n)	(((_x) >> (_n)) | ((_x) << (32 - (_n))))
+#define CH(_x, _y, _z)	(((_x) & (_y)) ^ (~(_x) & (_z)))
+#define MAJ(_x, _y, _z)	(((_x) & (_y)) ^ ((_x) & (_z)) ^ ((_y) & (_z)))
+#define EP0(_x)	(ROTR(_x, 2) ^ ROTR(_x, 13) ^ ROTR(_x, 22))
+#define EP1(_x)	(ROTR(_x, 6) ^ ROTR(_x, 11) ^ ROTR(_x, 25))
+#define SIG0(_x)	(ROTR(_x, 7) ^ ROTR(_x, 18) ^ ((_x) >> 3))
+#define SIG1(_x)	(ROTR(_x, 17) ^ ROTR(_x, 19) ^ ((_x) >> 10))
+
+static void sha256_process_blocks(u32 *state, const u8 *data, u32 nb_blocks)
+{
+	u32 i, a, b, c, d, e, f, g, h, t1, t2, w[64];
+
+	while (nb_blocks) {
+		for (i=0; i<16; i++) {
+			w[i] = ((u32) data[4*i] << 24) | ((u32) data[4*i+1] << 16) | ((u32) data[4*i+2] << 8) | ((u32) data[4*i+3]);
+		}
+		for (i=16; i<64; i++) {
+			w[i] = SIG1(w[i-2]) + w[i-7] + SIG0(w[i-15]) + w[i-16];
+		}
+
+		a = state[0];
+		b = state[1];
+		c = state[2];
+		d = state[3];
+		e = state[4];
+		f = state[5];
+		g = state[6];
+		h = state[7];
+
+		for (i=0; i<64; i++) {
+			t1 = h + EP1(e) + CH(e, f, g) + sha256_k[i] + w[i];
+			t2 = EP0(a) + MAJ(a, b, c);
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+
+		data += 64;
+		nb_blocks--;
+	}
+}
+
+#undef ROTR
+#undef CH
+#undef MAJ
+#undef EP0
+#undef EP1
+#undef SIG0
+#undef SIG1
+
+GF_EXPORT
+GF_SHA256Context *gf_sha256_starts()
+{
+	GF_SHA256Context *ctx;
+	GF_SAFEALLOC(ctx, GF_SHA256Context);
+	if (!ctx) return NULL;
+	ctx->state[0] = 0x6a09e667;
+	ctx->state[1] = 0xbb67ae85;
+	ctx->state[2] = 0x3c6ef372;
+	ctx->state[3] = 0xa54ff53a;
+	ctx->state[4] = 0x510e527f;
+	ctx->state[5] = 0x9b05688c;
+	ctx->state[6] = 0x1f83d9ab;
+	ctx->state[7] = 0x5be0cd19;
+	return ctx;
+}
+
+GF_EXPORT
+void gf_sha256_update(GF_SHA256Context *ctx, u8 *input, u32 length)
+{
+	if (!ctx || !length) return;
+
+	ctx->nb_bytes += length;
+	//complete pending block
+	if (ctx->block_size) {
+		u32 fill = 64 - ctx->block_size;
+		if (fill > length) fill = length;
+		memcpy(ctx->block + ctx->block_size, input, fill);
+		ctx->block_size += fill;
+		input += fill;
+		length -= fill;
+		if (ctx->block_size < 64) return;
+		sha256_process_blocks(ctx->state, ctx->block, 1);
+		ctx->block_size = 0;
+	}
+	//process full blocks directly from input
+	if (length >= 64) {
+		u32 nb_blocks = length / 64;
+		sha256_process_blocks(ctx->state, input, nb_blocks);
+		input += nb_blocks * 64;
+		length -= nb_blocks * 64;
+	}
+	if (length) {
+		memcpy(ctx->block, input, length);
+		ctx->block_size = length;
+	}
+}
+
+GF_EXPORT
+void gf_sha256_finish(GF_SHA256Context *ctx, u8 digest[GF_SHA256_DIGEST_SIZE])
+{
+	u32 i;
+	u64 nb_bits;
+	if (!ctx) return;
+
+	nb_bits = ctx->nb_bytes * 8;
+	ctx->block[ctx->block_size++] = 0x80;
+	if (ctx->block_size > 56) {
+		memset(ctx->block + ctx->block_size, 0, 64 - ctx->block_size);
+		sha256_process_blocks(ctx->state, ctx->block, 1);
+		ctx->block_size = 0;
+	}
+	memset(ctx->block + ctx->block_size, 0, 56 - ctx->block_size);
+	for (i=0; i<8; i++) {
+		ctx->block[56+i] = (u8) (nb_bits >> (56 - 8*i));
+	}
+	sha256_process_blocks(ctx->state, ctx->block, 1);
+
+	for (i=0; i<8; i++) {
+		digest[4*i] = (u8) (ctx->state[i] >> 24);
+		digest[4*i+1] = (u8) (ctx->state[i] >> 16);
+		digest[4*i+2] = (u8) (ctx->state[i] >> 8);
+		digest[4*i+3] = (u8) (ctx->state[i]);
+	}
+	gf_free(ctx);
+}
+
+GF_EXPORT
+GF_Err gf_sha256_file(const char *path, u8 digest[GF_SHA256_DIGEST_SIZE])
+{
+	FILE *f;
+	size_t n;
+	u8 *buf;
+	GF_SHA256Context *ctx;
+
+	if (!strncmp(path, "gmem://", 7)) {
+		u32 size;
+		u8 *mem_address;
+		GF_Err e = gf_blob_get_data(path, &mem_address, &size);
+		if (e) return e;
+
+		gf_sha256_csum(mem_address, size, digest);
+		return GF_OK;
+	}
+
+	f = gf_fopen(path, "rb");
+	if (!f) return GF_URL_ERROR;
+
+	buf = gf_malloc(SHA256_FILE_BLOCK_SIZE);
+	ctx = gf_sha256_starts();
+	if (!buf || !ctx) {
+		if (buf) gf_free(buf);
+		if (ctx) gf_free(ctx);
+		gf_fclose(f);
+		return GF_OUT_OF_MEM;
+	}
+	while ((n = gf_fread(buf, SHA256_FILE_BLOCK_SIZE, f)) > 0)
+		gf_sha256_update(ctx, buf, (u32) n);
+
+	gf_sha256_finish(ctx, digest);
+	gf_free(buf);
+	gf_fclose(f);
+	return GF_OK;
+}
+
+GF_EXPORT
+void gf_sha256_csum(u8 *buf, u32 buflen, u8 digest[GF_SHA256_DIGEST_SIZE])
+{
+	GF_SHA256Context *ctx;
+
+	memset(digest, 0, sizeof(u8)*GF_SHA256_DIGEST_SIZE);
+	ctx = gf_sha256_starts();
+	if (ctx) {
+		gf_sha256_update(ctx, buf, buflen);
+		gf_sha256_finish(ctx, digest);
+	}
+}
+
+#endif //GPAC_DISABLE_CORE_TOOLS
@@ -1181,10 +1181,11 @@ static GF_Err xml_sax_read_file(GF_SAXParser *parser)
 		if (parser->on_progress) parser->on_progress(parser->sax_cbck, parser->file_pos, parser->file_size);
 	}
 
+	/*if suspended, data may still be pending in the buffer*/
 #ifdef NO_GZIP
-	if (gf_feof(parser->f_in)) {
+	if (!parser->suspended && gf_feof(parser->f_in)) {
 #else
-	if (gf_gzeof(parser->gz_in)) {
+	if (!parser->suspended && gf_gzeof(parser->gz_in)) {
 #endif
 		if (!e) e = GF_EOS;
 		if (parser->on_progress) parser->on_progress(parser->sax_cbck, parser->file_size, parser->file_size);
@@ -1339,10 +1340,17 @@ GF_Err gf_xml_sax_suspend(GF_SAXParser *parser, Bool do_suspend)
 	parser->suspended = do_suspend;
 	if (!do_suspend) {
 #ifdef NO_GZIP
-		if (parser->f_in) return xml_sax_read_file(parser);
+		if (parser->f_in) {
 #else
-		if (parser->gz_in) return xml_sax_read_file(parser);
+		if (parser->gz_in) {
 #endif
+			/*parse data left in the buffer before reading more, the file may already be completely read*/
+			if (!parser->in_entity) {
+				GF_Err e = xml_sax_parse(parser, GF_FALSE);
+				if (e || parser->suspended) return e;
+			}
+			return xml_sax_read_file(parser);
+		}
 		return xml_sax_parse(parser, GF_FALSE);
 	}
 	return GF_OK;